@@ -0,0 +1,88 @@
+#ifndef Alloc_h
+#define Alloc_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ * A pluggable memory allocator "interface".  Anything in the library
+ * that allocates memory for the caller (e.g. the buffer of a
+ * 'String_t', see 'ConstructStringAlloc()' in 'String.h') can be given
+ * an 'Alloc_t' to get it from instead of 'malloc()'.  So memory can
+ * come from a per-request arena, a thread-local pool, huge pages, etc..
+ * A NULL 'Alloc_t *' always means the C library's 'malloc()',
+ * 'realloc()', and 'free()'.
+ *
+ * The functions are passed 'Ctx' (the allocator's own data) and,
+ * unlike the C library, are told the size of the block being freed or
+ * resized (the size it was allocated or last resized with), so they
+ * don't have to keep track of it themselves.  On failure 'Malloc()'
+ * and 'Realloc()' return NULL and set 'errno' (to ENOMEM), and
+ * 'Realloc()' leaves the old block alone.
+ *
+ * 'Realloc' may be NULL, in which case 'Malloc()', 'memcpy()', and
+ * 'Free()' are used instead.  'Free' may be NULL for allocators that
+ * release everything at once (e.g. arenas).
+ *
+ * Use 'AllocMalloc()', 'AllocRealloc()', and 'AllocFree()' rather than
+ * calling through the pointers directly; they take care of the
+ * defaults.
+ *****************************************************************************/
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct Alloc
+{ /* Alloc */
+  void *(*Malloc)(void *Ctx, size_t Size);
+  void *(*Realloc)(void *Ctx, void *Ptr, size_t OldSize, size_t NewSize);
+  void (*Free)(void *Ctx, void *Ptr, size_t Size);
+  void *Ctx;
+} Alloc_t; /* Alloc */
+
+  static inline void *AllocMalloc(const Alloc_t *This, size_t Size);
+  static inline void *AllocRealloc(const Alloc_t *This, void *Ptr,
+                                   size_t OldSize, size_t NewSize);
+  static inline void AllocFree(const Alloc_t *This, void *Ptr, size_t Size);
+
+/******************************************************************************
+ * Inline method definitions.
+ *****************************************************************************/
+  static inline void *AllocMalloc(const Alloc_t *This, size_t Size)
+  { /* AllocMalloc() */
+    return (This == NULL ? malloc(Size) : This->Malloc(This->Ctx, Size));
+  } /* AllocMalloc() */
+
+  static inline void *AllocRealloc(const Alloc_t *This, void *Ptr,
+                                   size_t OldSize, size_t NewSize)
+  { /* AllocRealloc() */
+    void *New;
+
+    if (This == NULL)
+      return realloc(Ptr, NewSize);
+    if (This->Realloc != NULL)
+      return This->Realloc(This->Ctx, Ptr, OldSize, NewSize);
+
+    if ((New = This->Malloc(This->Ctx, NewSize)) != NULL)
+    { /* Move it. */
+      memcpy(New, Ptr, (OldSize < NewSize ? OldSize : NewSize));
+      if (This->Free != NULL)
+        This->Free(This->Ctx, Ptr, OldSize);
+    } /* Move it. */
+
+    return New;
+  } /* AllocRealloc() */
+
+  static inline void AllocFree(const Alloc_t *This, void *Ptr, size_t Size)
+  { /* AllocFree() */
+    if (This == NULL)
+      free(Ptr);
+    else if (This->Free != NULL)
+      This->Free(This->Ctx, Ptr, Size);
+  } /* AllocFree() */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif
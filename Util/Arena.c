@@ -0,0 +1,261 @@
+/******************************************************************************
+ * Function definitions for our 'struct Arena' "class".  See Arena.h.
+ *****************************************************************************/
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Arena.h"
+#include "Diag.h"
+#include "Errors.h"
+
+/* A chunk is a header followed by the memory handed out.  The chunks
+ * are a list from the newest back to the oldest. */
+struct ArenaChunk
+{ /* ArenaChunk */
+  ArenaChunk_t *Prev;           /* Next older chunk. */
+  size_t Size;                  /* Of 'Data[]'. */
+  max_align_t Data[];
+}; /* ArenaChunk */
+
+#define CHUNK_HEAD_SIZE offsetof(ArenaChunk_t, Data)
+
+/******************************************************************************
+ * These would be 'private' in C++.
+ *****************************************************************************/
+/* The space 'ArenaMalloc(Size)' actually takes. */
+static inline size_t RoundSize(size_t Size)
+{ /* RoundSize() */
+  return (Size == 0 ? ARENA_ALIGN :
+          (Size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1));
+} /* RoundSize() */
+
+static inline char *ChunkData(ArenaChunk_t *Chunk)
+{ /* ChunkData() */
+  return (char *) Chunk->Data;
+} /* ChunkData() */
+
+/* Give back the newest chunk. */
+static void FreeChunk(Arena_t *This)
+{ /* FreeChunk() */
+  ArenaChunk_t *Chunk = This->Chunk;
+
+  This->Chunk = Chunk->Prev;
+  AllocFree(This->Parent, Chunk, CHUNK_HEAD_SIZE + Chunk->Size);
+} /* FreeChunk() */
+
+/* Make the newest chunk, if any, current and empty. */
+static void EmptyChunk(Arena_t *This)
+{ /* EmptyChunk() */
+  if (This->Chunk == NULL)
+    This->Ptr = This->End = NULL;
+  else
+  { /* Have one. */
+    This->Ptr = ChunkData(This->Chunk);
+    This->End = This->Ptr + This->Chunk->Size;
+  } /* Have one. */
+} /* EmptyChunk() */
+
+/* The 'Alloc_t' methods. */
+static void *AllocArenaMalloc(void *Ctx, size_t Size)
+{ /* AllocArenaMalloc() */
+  return ArenaMalloc(Ctx, Size);
+} /* AllocArenaMalloc() */
+
+static void *AllocArenaRealloc(void *Ctx, void *Ptr, size_t OldSize,
+                               size_t NewSize)
+{ /* AllocArenaRealloc() */
+  return ArenaRealloc(Ctx, Ptr, OldSize, NewSize);
+} /* AllocArenaRealloc() */
+
+static void AllocArenaFree(void *Ctx, void *Ptr, size_t Size)
+{ /* AllocArenaFree() */
+  ArenaFree(Ctx, Ptr, Size);
+} /* AllocArenaFree() */
+
+/******************************************************************************
+ * Public methods.
+ *****************************************************************************/
+bool ConstructArena(Arena_t *This, size_t ChunkSize, const Alloc_t *Parent)
+{ /* ConstructArena() */
+  /* Error checking. */
+  if (This == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    errno = EFAULT;
+    return false;
+  } /* Error. */
+
+  if (ChunkSize == 0)
+    ChunkSize = ARENA_CHUNK_SIZE;
+  else if (ChunkSize > SIZE_MAX / 2)
+    ChunkSize = (SIZE_MAX / 2) & ~(ARENA_ALIGN - 1);
+  else
+    ChunkSize = RoundSize(ChunkSize);
+
+  This->Ptr = This->End = NULL;
+  This->Chunk = NULL;
+  This->ChunkSize = ChunkSize;
+  This->Parent = Parent;
+  This->Alloc.Malloc = AllocArenaMalloc;
+  This->Alloc.Realloc = AllocArenaRealloc;
+  This->Alloc.Free = AllocArenaFree;
+  This->Alloc.Ctx = This;
+
+  return true;
+} /* ConstructArena() */
+
+Arena_t *NewArena(size_t ChunkSize, const Alloc_t *Parent)
+{ /* NewArena() */
+  int ErrNo;
+  Arena_t *This, *_RetVal;
+
+  if ((This = AllocMalloc(Parent, sizeof(Arena_t))) == NULL)
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: malloc(%zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, sizeof(Arena_t),
+         StrError(ErrNo));
+    EXIT(NULL);
+  } /* Error. */
+
+  /* We know this never fails if '(This != NULL)'. */
+  ConstructArena(This, ChunkSize, Parent);
+  RETURN(This);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* NewArena() */
+
+void DestroyArena(Arena_t *This)
+{ /* DestroyArena() */
+  if (This != NULL)
+  { /* Exists. */
+    while (This->Chunk != NULL)
+      FreeChunk(This);
+    This->Ptr = This->End = NULL;
+  } /* Exists. */
+} /* DestroyArena() */
+
+void DeleteArena(Arena_t *This)
+{ /* DeleteArena() */
+  if (This != NULL)
+  { /* Exists. */
+    DestroyArena(This);
+    AllocFree(This->Parent, This, sizeof(*This));
+  } /* Exists. */
+} /* DeleteArena() */
+
+/******************************************************************************
+ * Start a new chunk big enough for 'Size' bytes and allocate them from
+ * it.  What's left of the current chunk is wasted, but it's the end of
+ * a chunk that's already at least as big as all the ones before it.
+ *****************************************************************************/
+void *ArenaGrow(Arena_t *This, size_t Size)
+{ /* ArenaGrow() */
+  int ErrNo;
+  size_t ChunkSize;
+  ArenaChunk_t *Chunk;
+  void *_RetVal;
+
+  if (Size > SIZE_MAX - CHUNK_HEAD_SIZE - ARENA_ALIGN)
+  { /* Error. */
+    ErrNo = ENOMEM;
+    Diag("%s %s %d: %zu bytes is too big.  %s.\n",
+         __FILE__, __func__, __LINE__, Size, StrError(ErrNo));
+    EXIT(NULL);
+  } /* Error. */
+  Size = RoundSize(Size);
+
+  /* 'This->ChunkSize' is always aligned and never too big. */
+  ChunkSize = (Size > This->ChunkSize ? Size : This->ChunkSize);
+  if ((Chunk = AllocMalloc(This->Parent,
+                           CHUNK_HEAD_SIZE + ChunkSize)) == NULL)
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: malloc(%zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, CHUNK_HEAD_SIZE + ChunkSize,
+         StrError(ErrNo));
+    EXIT(NULL);
+  } /* Error. */
+
+  Chunk->Prev = This->Chunk;
+  Chunk->Size = ChunkSize;
+  This->Chunk = Chunk;
+  This->Ptr = ChunkData(Chunk) + Size;
+  This->End = ChunkData(Chunk) + ChunkSize;
+  if (ChunkSize <= (SIZE_MAX - CHUNK_HEAD_SIZE) / 2)
+    This->ChunkSize = 2 * ChunkSize;
+  RETURN(ChunkData(Chunk));
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* ArenaGrow() */
+
+void *ArenaRealloc(Arena_t *This, void *Ptr, size_t OldSize,
+                   size_t NewSize)
+{ /* ArenaRealloc() */
+  char *Old = Ptr;
+  void *New;
+
+  if (Old == NULL)
+    return ArenaMalloc(This, NewSize);
+
+  /* The most recent allocation grows (or shrinks) in place if it can. */
+  if (Old + RoundSize(OldSize) == This->Ptr &&
+      NewSize <= (size_t) (This->End - Old))
+  { /* In place. */
+    This->Ptr = Old + RoundSize(NewSize);
+    return Old;
+  } /* In place. */
+
+  /* Anything else can shrink where it is. */
+  if (NewSize <= OldSize)
+    return Old;
+
+  if ((New = ArenaMalloc(This, NewSize)) != NULL)
+    memcpy(New, Old, OldSize);
+  return New;
+} /* ArenaRealloc() */
+
+void ArenaFree(Arena_t *This, void *Ptr, size_t Size)
+{ /* ArenaFree() */
+  /* A chunk's header is right before its data, so a block can only
+   * end at 'This->Ptr' if it's in the current chunk. */
+  if (Ptr != NULL && (char *) Ptr + RoundSize(Size) == This->Ptr)
+    This->Ptr = Ptr;
+} /* ArenaFree() */
+
+void ArenaRewind(Arena_t *This, ArenaMark_t Mark)
+{ /* ArenaRewind() */
+  while (This->Chunk != Mark.Chunk && This->Chunk != NULL)
+    FreeChunk(This);
+
+  EmptyChunk(This);
+  if (This->Chunk != NULL)
+    This->Ptr = Mark.Ptr;
+} /* ArenaRewind() */
+
+void ArenaReset(Arena_t *This)
+{ /* ArenaReset() */
+  ArenaChunk_t *Chunk = This->Chunk;
+
+  if (Chunk != NULL)
+  { /* Keep the newest. */
+    This->Chunk = Chunk->Prev;
+    while (This->Chunk != NULL)
+      FreeChunk(This);
+    Chunk->Prev = NULL;
+    This->Chunk = Chunk;
+  } /* Keep the newest. */
+
+  EmptyChunk(This);
+} /* ArenaReset() */
@@ -0,0 +1,145 @@
+#ifndef Arena_h
+#define Arena_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ * An arena (a.k.a. region) allocator.  Memory is handed out by bumping
+ * a pointer through big chunks, which are only given back all at once:
+ * by 'ArenaReset()', by 'ArenaRewind()' to an earlier 'ArenaMark()', or
+ * by destroying the arena.  So tearing down everything a request built
+ * is one call, not one 'free()' per object.
+ *
+ * Chunks come from the 'Parent' allocator given to the constructor
+ * (NULL for 'malloc()', see 'Alloc.h').  The first is 'ChunkSize'
+ * bytes (0 for 'ARENA_CHUNK_SIZE') and each new one is twice the size
+ * of the one before (or bigger if the allocation needs it).
+ * 'ArenaReset()' keeps the newest, and biggest, chunk, so once it has
+ * grown big enough a reused arena doesn't allocate at all.
+ *
+ * An arena is also an allocator, 'ArenaAlloc()', which can be passed
+ * to anything that takes an 'Alloc_t', e.g. 'ConstructStringAlloc()'.
+ * Through that interface freeing the most recent allocation gives it
+ * back and a most recent allocation can grow in place (so a string
+ * growing at the end of an arena never moves); anything else is
+ * only freed by a reset or rewind.  It is then up to the caller not to
+ * use (or destroy) anything allocated after the mark it rewound to.
+ *
+ * All memory is aligned as for 'malloc()'.  An arena is _not_ thread
+ * safe.  Use one per thread (or per request).
+ *
+ * For example:
+ *
+ *   Arena_t Arena;
+ *   String_t Str;
+ *
+ *   ConstructArena(&Arena, 0, NULL);
+ *   for (;;)
+ *   { // For each request.
+ *     ConstructStringAlloc(&Str, ArenaAlloc(&Arena));
+ *     ...                       // Build lots of strings.
+ *     ArenaReset(&Arena);       // Instead of 'DestroyString()'s.
+ *   } // For each request.
+ *   DestroyArena(&Arena);
+ *****************************************************************************/
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <Alloc.h>
+
+/* Default size of the first chunk. */
+#define ARENA_CHUNK_SIZE ((size_t) 64 * 1024)
+
+/* Alignment of everything the arena hands out. */
+#define ARENA_ALIGN _Alignof(max_align_t)
+
+typedef struct ArenaChunk ArenaChunk_t;
+
+typedef struct Arena
+{ /* Arena */
+  char *Ptr;                    /* Next free byte of 'Chunk'. */
+  char *End;                    /* End of 'Chunk'. */
+  ArenaChunk_t *Chunk;          /* Newest chunk, or NULL. */
+  size_t ChunkSize;             /* Size of the next chunk. */
+  const Alloc_t *Parent;        /* Where chunks come from. */
+  Alloc_t Alloc;                /* See 'ArenaAlloc()'. */
+} Arena_t; /* Arena */
+
+/* A checkpoint for 'ArenaRewind()'. */
+typedef struct ArenaMark
+{ /* ArenaMark */
+  ArenaChunk_t *Chunk;
+  char *Ptr;
+} ArenaMark_t; /* ArenaMark */
+
+  /* Constructors and destructors, as for 'String_t'.  The constructors
+   * don't allocate anything, so they only fail if 'This' is NULL. */
+  extern bool ConstructArena(Arena_t *This, size_t ChunkSize,
+                             const Alloc_t *Parent);
+  extern Arena_t *NewArena(size_t ChunkSize, const Alloc_t *Parent);
+  extern void DestroyArena(Arena_t *This);
+  extern void DeleteArena(Arena_t *This);
+
+  /* Allocate 'Size' bytes.  Returns NULL and sets 'errno' on error. */
+  static inline void *ArenaMalloc(Arena_t *This, size_t Size);
+
+  /* Resize the block at 'Ptr' (which was 'OldSize' bytes) to
+   * 'NewSize', in place if it is the most recent allocation and
+   * there's room.  Returns NULL and sets 'errno' on error. */
+  extern void *ArenaRealloc(Arena_t *This, void *Ptr, size_t OldSize,
+                            size_t NewSize);
+
+  /* Give back the 'Size' byte block at 'Ptr' if it is the most recent
+   * allocation.  Otherwise do nothing. */
+  extern void ArenaFree(Arena_t *This, void *Ptr, size_t Size);
+
+  /* The current position, and going back to it, freeing everything
+   * allocated since. */
+  static inline ArenaMark_t ArenaMark(Arena_t *This);
+  extern void ArenaRewind(Arena_t *This, ArenaMark_t Mark);
+
+  /* Free everything.  Invalidates all marks. */
+  extern void ArenaReset(Arena_t *This);
+
+  /* The arena as an 'Alloc_t'. */
+  static inline const Alloc_t *ArenaAlloc(Arena_t *This);
+
+  /* Private.  The slow path of 'ArenaMalloc()'. */
+  extern void *ArenaGrow(Arena_t *This, size_t Size);
+
+/******************************************************************************
+ * Inline method definitions.
+ *****************************************************************************/
+  static inline void *ArenaMalloc(Arena_t *This, size_t Size)
+  { /* ArenaMalloc() */
+    char *Ptr = This->Ptr;
+
+    /* 'Ptr' and 'End' are both aligned, so if 'Size' fits then so does
+     * 'Size' rounded up.  0 goes the slow way. */
+    if (Size - 1 < (size_t) (This->End - Ptr))
+    { /* Fits. */
+      This->Ptr = Ptr + ((Size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1));
+      return Ptr;
+    } /* Fits. */
+
+    return ArenaGrow(This, Size);
+  } /* ArenaMalloc() */
+
+  static inline ArenaMark_t ArenaMark(Arena_t *This)
+  { /* ArenaMark() */
+    ArenaMark_t Mark = { This->Chunk, This->Ptr };
+
+    return Mark;
+  } /* ArenaMark() */
+
+  static inline const Alloc_t *ArenaAlloc(Arena_t *This)
+  { /* ArenaAlloc() */
+    return &This->Alloc;
+  } /* ArenaAlloc() */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif
@@ -0,0 +1,1252 @@
+/******************************************************************************
+ * Benchmarks for the string to number conversions, 'String_t', and
+ * 'StrError()'.  Built, and run, by 'make bench' but not by 'make' or
+ * installed.  Options for it go in 'BENCH_ARGS', either on the 'make'
+ * command line or in the environment.
+ *
+ *   Bench [-f csv|json] [-t Ms] [-r Reps] [-s Seed] [-l] [Pattern ...]
+ *
+ * Every benchmark is run over each of the input distributions that
+ * make sense for it, and is named "Group/Function/Distribution", e.g.
+ * "StrToX/StrToI32/uniform".  Only those whose name contains one of
+ * the 'Pattern's are run (all of them if there are none), and '-l'
+ * lists the names instead of running them.
+ *
+ * The inputs are made up, before each benchmark, by a pseudo-random
+ * generator started from 'Seed' (1 by default), so the same seed
+ * always gives the same inputs, and every function of the same type
+ * sees the same ones.  The integer distributions are "short" (1 to 3
+ * digits), "uniform" (the number of digits uniform from 1 up to the
+ * most the type can have), and "max" (all of them).  The floating
+ * point ones are "short" (1 to 3 digits, no exponent), "uniform" (1 to
+ * the type's significant digits, half with an exponent), and "long"
+ * (all the digits, and an exponent).
+ *
+ * Each benchmark is repeated until one run takes at least 'Ms'
+ * milliseconds (20 by default), then timed 'Reps' times (5 by
+ * default).  The results, one line or object per benchmark, go to
+ * standard output as CSV (the default) or JSON, with the minimum,
+ * median, and maximum nanoseconds per operation, the input bytes per
+ * operation (the characters converted, or appended), and bytes per
+ * second at the median.  For meaningful numbers, pin it to one CPU
+ * (e.g. 'taskset -c 2 ./Bench') on an otherwise idle machine.
+ *
+ * A benchmark that fails (it can't get its inputs, or the function
+ * returns an error) is left out of the results, with a message on
+ * standard error, and the exit status is 1.
+ *
+ * The "batch" group are the larger, whole-column benchmarks: one
+ * operation converts a column of 'BENCH_COLUMN' fields.
+ *****************************************************************************/
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Errors.h"
+#include "StrToX.h"
+#include "String.h"
+
+#ifndef BENCH_VERSION
+#define BENCH_VERSION "unknown"
+#endif
+
+/* Number of different inputs.  A power of 2. */
+#define BENCH_NINPUTS 4096
+#define BENCH_MASK ((uint64_t) BENCH_NINPUTS - 1)
+
+/* Number of fields in a "batch" column, and so how many times the
+ * inputs are repeated in it. */
+#define BENCH_COLUMN (64 * BENCH_NINPUTS)
+
+/* How big a 'String_t' gets before it's thrown away and started again,
+ * so that the growth benchmarks keep on growing. */
+#define BENCH_STR_LIMIT (64 * 1024)
+
+/* Kinds of input. */
+#define BENCH_INT 0             /* Integers, in decimal. */
+#define BENCH_CHR 1             /* Characters, possibly escaped. */
+#define BENCH_FLT 2             /* Floating point numbers. */
+#define BENCH_STR 3             /* Random text. */
+#define BENCH_ERR 4             /* 'errno' values. */
+
+typedef struct BenchIn
+{ /* BenchIn */
+  char *Buff;                   /* The characters of all of 'Strs'. */
+  const char *Strs[BENCH_NINPUTS];
+  size_t Lens[BENCH_NINPUTS];
+  int ErrNos[BENCH_NINPUTS];
+  size_t Bytes;                 /* Total of 'Lens'. */
+
+  /* All of 'Strs', 'BENCH_COLUMN / BENCH_NINPUTS' times, each followed
+   * by a '\n', and the same as fields.  Only for the "batch" group. */
+  char *Col;
+  size_t ColLen;
+  StrField_t *Fields;
+} BenchIn_t; /* BenchIn */
+
+/* Does 'Iters' operations on 'In' and returns something that depends
+ * on all of them, so that the compiler can't leave any out.  One that
+ * can fail sets 'BenchErrNo' and stops, and the result is thrown
+ * away. */
+typedef uint64_t BenchFn_t(const BenchIn_t *In, uint64_t Iters);
+
+typedef struct Bench
+{ /* Bench */
+  const char *Group;
+  const char *Name;
+  BenchFn_t *Fn;
+  int Kind;
+  int Bits;                     /* The size of the result type. */
+  bool Signed;
+  bool Batch;                   /* An operation is a whole column. */
+} Bench_t; /* Bench */
+
+typedef struct BenchResult
+{ /* BenchResult */
+  uint64_t Iters;               /* Per timed run. */
+  double NsMin, NsMedian, NsMax;        /* Per operation. */
+  double BytesOp;
+} BenchResult_t; /* BenchResult */
+
+/* The results of the float conversions end up here. */
+static volatile long double FltSink;
+
+/* And everything else here. */
+static volatile uint64_t Sink;
+
+/* Why the current benchmark failed, or 0. */
+static int BenchErrNo;
+
+/* The pseudo-random generator (xorshift64*). */
+static uint64_t RandState;
+
+/******************************************************************************
+ * These would be 'private' in C++.
+ *****************************************************************************/
+static uint64_t Rand(void)
+{ /* Rand() */
+  RandState ^= RandState >> 12;
+  RandState ^= RandState << 25;
+  RandState ^= RandState >> 27;
+  return RandState * UINT64_C(2685821657736338717);
+} /* Rand() */
+
+/* Uniform in ['Lo', 'Hi'].  Close enough, anyway. */
+static uint64_t RandRange(uint64_t Lo, uint64_t Hi)
+{ /* RandRange() */
+  if (Hi - Lo == UINT64_MAX)
+    return Rand();
+  return Lo + Rand() % (Hi - Lo + 1);
+} /* RandRange() */
+
+static double NowNs(void)
+{ /* NowNs() */
+  struct timespec Now;
+
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return (double) Now.tv_sec * 1e9 + (double) Now.tv_nsec;
+} /* NowNs() */
+
+/* The distributions for each kind of input. */
+static const char *const *Dists(int Kind)
+{ /* Dists() */
+  static const char *const IntDists[] = { "short", "uniform", "max", NULL };
+  static const char *const ChrDists[] = { "plain", "escape", NULL };
+  static const char *const FltDists[] = { "short", "uniform", "long", NULL };
+  static const char *const StrDists[] = { "small", "medium", "large", NULL };
+  static const char *const ErrDists[] = { "known", "unknown", NULL };
+
+  switch (Kind)
+  { /* switch */
+  case BENCH_INT:
+    return IntDists;
+  case BENCH_CHR:
+    return ChrDists;
+  case BENCH_FLT:
+    return FltDists;
+  case BENCH_STR:
+    return StrDists;
+  default:
+    return ErrDists;
+  } /* switch */
+} /* Dists() */
+
+/* Write a decimal integer of a type of 'Bits' bits into 'Out' (which
+ * has room for 24 characters). */
+static size_t MakeInt(char *Out, int Bits, bool Signed, int Dist)
+{ /* MakeInt() */
+  uint64_t Max, Lo, Hi, Pow;
+  int MaxDigits, Digits;
+  bool Neg = false;
+
+  Max = (Bits == 64 ? UINT64_MAX : (UINT64_C(1) << Bits) - 1);
+  if (Signed)
+  { /* Signed. */
+    Max >>= 1;
+    Neg = (Rand() & 1);
+  } /* Signed. */
+  for (MaxDigits = 1, Pow = Max; Pow >= 10; Pow /= 10)
+    ++MaxDigits;
+
+  if (Dist == 0)
+    Digits = (int) RandRange(1, MaxDigits < 3 ? MaxDigits : 3);
+  else if (Dist == 1)
+    Digits = (int) RandRange(1, MaxDigits);
+  else
+    Digits = MaxDigits;
+
+  for (Lo = 1; Digits > 1; --Digits)
+    Lo *= 10;
+  Hi = (Lo > Max / 10 ? Max : Lo * 10 - 1);
+  if (Lo == 1)
+    Lo = 0;
+
+  return (size_t) sprintf(Out, "%s%" PRIu64, Neg ? "-" : "",
+                          RandRange(Lo, Hi));
+} /* MakeInt() */
+
+/* A character: a letter or digit, or an escape sequence. */
+static size_t MakeChr(char *Out, int Dist)
+{ /* MakeChr() */
+  static const char Plain[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+  static const char Simple[] = "abfnrtv\\'\"?";
+
+  if (Dist == 0)
+    return (size_t) sprintf(Out, "%c", Plain[Rand() % (sizeof(Plain) - 1)]);
+
+  switch (Rand() % 3)
+  { /* switch */
+  case 0:
+    return (size_t) sprintf(Out, "\\%c", Simple[Rand() % (sizeof(Simple) - 1)]);
+  case 1:
+    return (size_t) sprintf(Out, "\\x%02x", (unsigned) RandRange(1, 127));
+  default:
+    return (size_t) sprintf(Out, "\\%03o", (unsigned) RandRange(1, 127));
+  } /* switch */
+} /* MakeChr() */
+
+/* A floating point number for a type of 'Bits' bits, with as many
+ * significant digits as 'Dist' says.  'Out' has room for 48
+ * characters. */
+static size_t MakeFlt(char *Out, int Bits, int Dist)
+{ /* MakeFlt() */
+  int MaxDigits, MaxExp, Digits, Point, I;
+  bool Exp;
+  char *P = Out;
+
+  MaxDigits = (Bits == 32 ? 9 : Bits == 64 ? 17 : 21);
+  MaxExp = (Bits == 32 ? 30 : 300);
+  if (Dist == 0)
+  { /* Short. */
+    Digits = (int) RandRange(1, 3);
+    Exp = false;
+  } /* Short. */
+  else if (Dist == 1)
+  { /* Uniform. */
+    Digits = (int) RandRange(1, MaxDigits);
+    Exp = (Rand() & 1);
+  } /* Uniform. */
+  else
+  { /* Long. */
+    Digits = MaxDigits;
+    Exp = true;
+  } /* Long. */
+
+  if (Rand() & 1)
+    *P++ = '-';
+  Point = (Exp ? 1 : (int) RandRange(1, Digits));
+  for (I = 0; I < Digits; ++I)
+  { /* Each digit. */
+    if (I == Point)
+      *P++ = '.';
+    *P++ = (char) ('0' + (I == 0 ? RandRange(1, 9) : RandRange(0, 9)));
+  } /* Each digit. */
+  if (Exp)
+    P += sprintf(P, "e%d", (int) RandRange(0, 2 * MaxExp) - MaxExp);
+  *P = '\0';
+
+  return (size_t) (P - Out);
+} /* MakeFlt() */
+
+/* Printable text, of a length depending on 'Dist'.  'Out' has room for
+ * 2049 characters. */
+static size_t MakeStr(char *Out, int Dist)
+{ /* MakeStr() */
+  size_t Len, I;
+
+  if (Dist == 0)
+    Len = RandRange(1, 16);
+  else if (Dist == 1)
+    Len = RandRange(16, 128);
+  else
+    Len = RandRange(512, 2048);
+
+  for (I = 0; I < Len; ++I)
+    Out[I] = (char) RandRange(' ', '~');
+  Out[Len] = '\0';
+
+  return Len;
+} /* MakeStr() */
+
+/* Make up the inputs for 'B' and distribution 'Dist'.  Returns false
+ * (and sets 'errno') if it runs out of memory. */
+static bool MakeInputs(BenchIn_t *In, const Bench_t *B, int Dist,
+                       uint64_t Seed)
+{ /* MakeInputs() */
+  size_t Max = (B->Kind == BENCH_STR ? 2049 : 48), Used = 0, I, J;
+  char *P;
+
+  memset(In, 0, sizeof(*In));
+  RandState = Seed * UINT64_C(0x9E3779B97F4A7C15) + 1;
+  if ((In->Buff = malloc(BENCH_NINPUTS * Max)) == NULL)
+    return false;
+
+  for (I = 0; I < BENCH_NINPUTS; ++I)
+  { /* Each input. */
+    P = &In->Buff[Used];
+    switch (B->Kind)
+    { /* switch */
+    case BENCH_INT:
+      In->Lens[I] = MakeInt(P, B->Bits, B->Signed, Dist);
+      break;
+    case BENCH_CHR:
+      In->Lens[I] = MakeChr(P, Dist);
+      break;
+    case BENCH_FLT:
+      In->Lens[I] = MakeFlt(P, B->Bits, Dist);
+      break;
+    case BENCH_STR:
+      In->Lens[I] = MakeStr(P, Dist);
+      break;
+    default:
+      /* Every known value, in turn, or values that aren't. */
+      In->ErrNos[I] = (Dist == 0 ? 1 + (int) (I % 133) : 4096 + (int) I);
+      P[0] = '\0';
+      In->Lens[I] = 0;
+      break;
+    } /* switch */
+    In->Strs[I] = P;
+    In->Bytes += In->Lens[I];
+    Used += In->Lens[I] + 1;
+  } /* Each input. */
+
+  if (!B->Batch)
+    return true;
+
+  In->ColLen = (In->Bytes + BENCH_NINPUTS) * (BENCH_COLUMN / BENCH_NINPUTS);
+  if ((In->Col = malloc(In->ColLen)) == NULL ||
+      (In->Fields = malloc(BENCH_COLUMN * sizeof(*In->Fields))) == NULL)
+    return false;
+  for (P = In->Col, J = 0; J < BENCH_COLUMN; ++J)
+  { /* Each field. */
+    I = J & BENCH_MASK;
+    memcpy(P, In->Strs[I], In->Lens[I]);
+    In->Fields[J].Ptr = P;
+    In->Fields[J].Len = In->Lens[I];
+    P += In->Lens[I];
+    *P++ = '\n';
+  } /* Each field. */
+
+  return true;
+} /* MakeInputs() */
+
+static void FreeInputs(BenchIn_t *In)
+{ /* FreeInputs() */
+  free(In->Fields);
+  free(In->Col);
+  free(In->Buff);
+} /* FreeInputs() */
+
+/******************************************************************************
+ * The benchmarks themselves, one function for each entry point.
+ *****************************************************************************/
+/* 'strtoX(Str, &End, 10)'. */
+#define BENCH_STRTOX(F)                                                 \
+  static uint64_t Bench_##F(const BenchIn_t *In, uint64_t Iters)        \
+  {                                                                     \
+    uint64_t Sum = 0, I;                                                \
+    char *End;                                                          \
+                                                                        \
+    for (I = 0; I < Iters; ++I)                                         \
+    {                                                                   \
+      Sum += (uint64_t) F(In->Strs[I & BENCH_MASK], &End, 10);          \
+      Sum += (uint64_t) (End - In->Strs[I & BENCH_MASK]);               \
+    }                                                                   \
+    return Sum;                                                         \
+  }
+
+/* 'strtochar(Str, &End)', etc. */
+#define BENCH_STRTOCHR(F)                                               \
+  static uint64_t Bench_##F(const BenchIn_t *In, uint64_t Iters)        \
+  {                                                                     \
+    uint64_t Sum = 0, I;                                                \
+    char *End;                                                          \
+                                                                        \
+    for (I = 0; I < Iters; ++I)                                         \
+      Sum += (uint64_t) F(In->Strs[I & BENCH_MASK], &End);              \
+    return Sum;                                                         \
+  }
+
+/* 'strtod(Str, &End)', etc. */
+#define BENCH_STRTOFLT(F)                                               \
+  static uint64_t Bench_##F(const BenchIn_t *In, uint64_t Iters)        \
+  {                                                                     \
+    uint64_t Sum = 0, I;                                                \
+    char *End;                                                          \
+                                                                        \
+    for (I = 0; I < Iters; ++I)                                         \
+    {                                                                   \
+      FltSink = F(In->Strs[I & BENCH_MASK], &End);                      \
+      Sum += (uint64_t) (End - In->Strs[I & BENCH_MASK]);               \
+    }                                                                   \
+    return Sum;                                                         \
+  }
+
+/* 'StrToX(Str, 10, &Val)'. */
+#define BENCH_STRTOX_VAL(F, T)                                          \
+  static uint64_t Bench_##F(const BenchIn_t *In, uint64_t Iters)        \
+  {                                                                     \
+    uint64_t Sum = 0, I;                                                \
+    T Val = 0;                                                          \
+                                                                        \
+    for (I = 0; I < Iters; ++I)                                         \
+    {                                                                   \
+      Sum += (uint64_t) F(In->Strs[I & BENCH_MASK], 10, &Val);          \
+      Sum += (uint64_t) Val;                                            \
+    }                                                                   \
+    return Sum;                                                         \
+  }
+
+/* 'StrNToX(Str, Len, 10, &Val)'. */
+#define BENCH_STRNTOX_VAL(F, T)                                         \
+  static uint64_t Bench_##F(const BenchIn_t *In, uint64_t Iters)        \
+  {                                                                     \
+    uint64_t Sum = 0, I;                                                \
+    T Val = 0;                                                          \
+                                                                        \
+    for (I = 0; I < Iters; ++I)                                         \
+    {                                                                   \
+      Sum += (uint64_t) F(In->Strs[I & BENCH_MASK],                     \
+                          In->Lens[I & BENCH_MASK], 10, &Val);          \
+      Sum += (uint64_t) Val;                                            \
+    }                                                                   \
+    return Sum;                                                         \
+  }
+
+/* 'StrToChar(Str, &Val)' and 'StrToD(Str, &Val)', etc. */
+#define BENCH_STRTOCHR_VAL(F, T)                                        \
+  static uint64_t Bench_##F(const BenchIn_t *In, uint64_t Iters)        \
+  {                                                                     \
+    uint64_t Sum = 0, I;                                                \
+    T Val = 0;                                                          \
+                                                                        \
+    for (I = 0; I < Iters; ++I)                                         \
+    {                                                                   \
+      Sum += (uint64_t) F(In->Strs[I & BENCH_MASK], &Val);              \
+      Sum += (uint64_t) (Val != 0);                                     \
+    }                                                                   \
+    FltSink = Val;                                                      \
+    return Sum;                                                         \
+  }
+
+/* 'StrNToChar(Str, Len, &Val)' and 'StrNToD(Str, Len, &Val)', etc. */
+#define BENCH_STRNTOCHR_VAL(F, T)                                       \
+  static uint64_t Bench_##F(const BenchIn_t *In, uint64_t Iters)        \
+  {                                                                     \
+    uint64_t Sum = 0, I;                                                \
+    T Val = 0;                                                          \
+                                                                        \
+    for (I = 0; I < Iters; ++I)                                         \
+    {                                                                   \
+      Sum += (uint64_t) F(In->Strs[I & BENCH_MASK],                     \
+                          In->Lens[I & BENCH_MASK], &Val);              \
+      Sum += (uint64_t) (Val != 0);                                     \
+    }                                                                   \
+    FltSink = Val;                                                      \
+    return Sum;                                                         \
+  }
+
+/* The C library's, for comparison. */
+BENCH_STRTOX(strtol)
+BENCH_STRTOX(strtoul)
+BENCH_STRTOX(strtoll)
+BENCH_STRTOX(strtoull)
+BENCH_STRTOFLT(strtof)
+BENCH_STRTOFLT(strtod)
+BENCH_STRTOFLT(strtold)
+
+BENCH_STRTOCHR(strtochar)
+BENCH_STRTOCHR(strtoschar)
+BENCH_STRTOCHR(strtouchar)
+BENCH_STRTOX(strtoc)
+BENCH_STRTOX(strtosc)
+BENCH_STRTOX(strtouc)
+BENCH_STRTOX(strtos)
+BENCH_STRTOX(strtous)
+BENCH_STRTOX(strtoi)
+BENCH_STRTOX(strtoui)
+BENCH_STRTOX(strtoi8)
+BENCH_STRTOX(strtoui8)
+BENCH_STRTOX(strtoi16)
+BENCH_STRTOX(strtoui16)
+BENCH_STRTOX(strtoi32)
+BENCH_STRTOX(strtoui32)
+BENCH_STRTOX(strtoi64)
+BENCH_STRTOX(strtoui64)
+BENCH_STRTOX(strtoil8)
+BENCH_STRTOX(strtouil8)
+BENCH_STRTOX(strtoil16)
+BENCH_STRTOX(strtouil16)
+BENCH_STRTOX(strtoil32)
+BENCH_STRTOX(strtouil32)
+BENCH_STRTOX(strtoil64)
+BENCH_STRTOX(strtouil64)
+BENCH_STRTOX(strtoif8)
+BENCH_STRTOX(strtouif8)
+BENCH_STRTOX(strtoif16)
+BENCH_STRTOX(strtouif16)
+BENCH_STRTOX(strtoif32)
+BENCH_STRTOX(strtouif32)
+BENCH_STRTOX(strtoif64)
+BENCH_STRTOX(strtouif64)
+
+BENCH_STRTOCHR_VAL(StrToChar, char)
+BENCH_STRTOCHR_VAL(StrToSChar, signed char)
+BENCH_STRTOCHR_VAL(StrToUChar, unsigned char)
+BENCH_STRTOX_VAL(StrToC, char)
+BENCH_STRTOX_VAL(StrToSC, signed char)
+BENCH_STRTOX_VAL(StrToUC, unsigned char)
+BENCH_STRTOX_VAL(StrToS, short)
+BENCH_STRTOX_VAL(StrToUS, unsigned short)
+BENCH_STRTOX_VAL(StrToI, int)
+BENCH_STRTOX_VAL(StrToUI, unsigned int)
+BENCH_STRTOX_VAL(StrToL, long)
+BENCH_STRTOX_VAL(StrToUL, unsigned long)
+BENCH_STRTOX_VAL(StrToLL, long long)
+BENCH_STRTOX_VAL(StrToULL, unsigned long long)
+BENCH_STRTOX_VAL(StrToIMax, intmax_t)
+BENCH_STRTOX_VAL(StrToUMax, uintmax_t)
+BENCH_STRTOX_VAL(StrToI8, int8_t)
+BENCH_STRTOX_VAL(StrToUI8, uint8_t)
+BENCH_STRTOX_VAL(StrToI16, int16_t)
+BENCH_STRTOX_VAL(StrToUI16, uint16_t)
+BENCH_STRTOX_VAL(StrToI32, int32_t)
+BENCH_STRTOX_VAL(StrToUI32, uint32_t)
+BENCH_STRTOX_VAL(StrToI64, int64_t)
+BENCH_STRTOX_VAL(StrToUI64, uint64_t)
+BENCH_STRTOX_VAL(StrToIL8, int_least8_t)
+BENCH_STRTOX_VAL(StrToUIL8, uint_least8_t)
+BENCH_STRTOX_VAL(StrToIL16, int_least16_t)
+BENCH_STRTOX_VAL(StrToUIL16, uint_least16_t)
+BENCH_STRTOX_VAL(StrToIL32, int_least32_t)
+BENCH_STRTOX_VAL(StrToUIL32, uint_least32_t)
+BENCH_STRTOX_VAL(StrToIL64, int_least64_t)
+BENCH_STRTOX_VAL(StrToUIL64, uint_least64_t)
+BENCH_STRTOX_VAL(StrToIF8, int_fast8_t)
+BENCH_STRTOX_VAL(StrToUIF8, uint_fast8_t)
+BENCH_STRTOX_VAL(StrToIF16, int_fast16_t)
+BENCH_STRTOX_VAL(StrToUIF16, uint_fast16_t)
+BENCH_STRTOX_VAL(StrToIF32, int_fast32_t)
+BENCH_STRTOX_VAL(StrToUIF32, uint_fast32_t)
+BENCH_STRTOX_VAL(StrToIF64, int_fast64_t)
+BENCH_STRTOX_VAL(StrToUIF64, uint_fast64_t)
+BENCH_STRTOCHR_VAL(StrToF, float)
+BENCH_STRTOCHR_VAL(StrToD, double)
+BENCH_STRTOCHR_VAL(StrToLD, long double)
+
+BENCH_STRNTOCHR_VAL(StrNToChar, char)
+BENCH_STRNTOCHR_VAL(StrNToSChar, signed char)
+BENCH_STRNTOCHR_VAL(StrNToUChar, unsigned char)
+BENCH_STRNTOX_VAL(StrNToC, char)
+BENCH_STRNTOX_VAL(StrNToSC, signed char)
+BENCH_STRNTOX_VAL(StrNToUC, unsigned char)
+BENCH_STRNTOX_VAL(StrNToS, short)
+BENCH_STRNTOX_VAL(StrNToUS, unsigned short)
+BENCH_STRNTOX_VAL(StrNToI, int)
+BENCH_STRNTOX_VAL(StrNToUI, unsigned int)
+BENCH_STRNTOX_VAL(StrNToL, long)
+BENCH_STRNTOX_VAL(StrNToUL, unsigned long)
+BENCH_STRNTOX_VAL(StrNToLL, long long)
+BENCH_STRNTOX_VAL(StrNToULL, unsigned long long)
+BENCH_STRNTOX_VAL(StrNToIMax, intmax_t)
+BENCH_STRNTOX_VAL(StrNToUMax, uintmax_t)
+BENCH_STRNTOX_VAL(StrNToI8, int8_t)
+BENCH_STRNTOX_VAL(StrNToUI8, uint8_t)
+BENCH_STRNTOX_VAL(StrNToI16, int16_t)
+BENCH_STRNTOX_VAL(StrNToUI16, uint16_t)
+BENCH_STRNTOX_VAL(StrNToI32, int32_t)
+BENCH_STRNTOX_VAL(StrNToUI32, uint32_t)
+BENCH_STRNTOX_VAL(StrNToI64, int64_t)
+BENCH_STRNTOX_VAL(StrNToUI64, uint64_t)
+BENCH_STRNTOX_VAL(StrNToIL8, int_least8_t)
+BENCH_STRNTOX_VAL(StrNToUIL8, uint_least8_t)
+BENCH_STRNTOX_VAL(StrNToIL16, int_least16_t)
+BENCH_STRNTOX_VAL(StrNToUIL16, uint_least16_t)
+BENCH_STRNTOX_VAL(StrNToIL32, int_least32_t)
+BENCH_STRNTOX_VAL(StrNToUIL32, uint_least32_t)
+BENCH_STRNTOX_VAL(StrNToIL64, int_least64_t)
+BENCH_STRNTOX_VAL(StrNToUIL64, uint_least64_t)
+BENCH_STRNTOX_VAL(StrNToIF8, int_fast8_t)
+BENCH_STRNTOX_VAL(StrNToUIF8, uint_fast8_t)
+BENCH_STRNTOX_VAL(StrNToIF16, int_fast16_t)
+BENCH_STRNTOX_VAL(StrNToUIF16, uint_fast16_t)
+BENCH_STRNTOX_VAL(StrNToIF32, int_fast32_t)
+BENCH_STRNTOX_VAL(StrNToUIF32, uint_fast32_t)
+BENCH_STRNTOX_VAL(StrNToIF64, int_fast64_t)
+BENCH_STRNTOX_VAL(StrNToUIF64, uint_fast64_t)
+BENCH_STRNTOCHR_VAL(StrNToF, float)
+BENCH_STRNTOCHR_VAL(StrNToD, double)
+BENCH_STRNTOCHR_VAL(StrNToLD, long double)
+
+/* The batch conversions, a whole column at a time. */
+static uint64_t Bench_StrNToI64Delim(const BenchIn_t *In, uint64_t Iters)
+{ /* Bench_StrNToI64Delim() */
+  static int64_t Vals[BENCH_COLUMN];
+  static uint64_t Errs[STRTOX_ERR_WORDS(BENCH_COLUMN)];
+  uint64_t Sum = 0, I;
+  size_t NVals;
+
+  for (I = 0; I < Iters; ++I)
+  { /* Each column. */
+    NVals = BENCH_COLUMN;
+    Sum += (uint64_t) StrNToI64Delim(In->Col, In->ColLen, '\n', 10, Vals,
+                                     Errs, &NVals, NULL);
+    Sum += (uint64_t) Vals[I & BENCH_MASK] + Errs[0] + NVals;
+  } /* Each column. */
+
+  return Sum;
+} /* Bench_StrNToI64Delim() */
+
+static uint64_t Bench_StrNToDDelim(const BenchIn_t *In, uint64_t Iters)
+{ /* Bench_StrNToDDelim() */
+  static double Vals[BENCH_COLUMN];
+  static uint64_t Errs[STRTOX_ERR_WORDS(BENCH_COLUMN)];
+  uint64_t Sum = 0, I;
+  size_t NVals;
+
+  for (I = 0; I < Iters; ++I)
+  { /* Each column. */
+    NVals = BENCH_COLUMN;
+    Sum += (uint64_t) StrNToDDelim(In->Col, In->ColLen, '\n', Vals, Errs,
+                                   &NVals, NULL);
+    Sum += Errs[0] + NVals;
+    FltSink = Vals[I & BENCH_MASK];
+  } /* Each column. */
+
+  return Sum;
+} /* Bench_StrNToDDelim() */
+
+static uint64_t Bench_StrNToI64Fields(const BenchIn_t *In, uint64_t Iters)
+{ /* Bench_StrNToI64Fields() */
+  static int64_t Vals[BENCH_COLUMN];
+  static uint64_t Errs[STRTOX_ERR_WORDS(BENCH_COLUMN)];
+  uint64_t Sum = 0, I;
+
+  for (I = 0; I < Iters; ++I)
+  { /* Each column. */
+    Sum += (uint64_t) StrNToI64Fields(In->Fields, BENCH_COLUMN, 10, Vals,
+                                      Errs);
+    Sum += (uint64_t) Vals[I & BENCH_MASK] + Errs[0];
+  } /* Each column. */
+
+  return Sum;
+} /* Bench_StrNToI64Fields() */
+
+static uint64_t Bench_StrNToDFields(const BenchIn_t *In, uint64_t Iters)
+{ /* Bench_StrNToDFields() */
+  static double Vals[BENCH_COLUMN];
+  static uint64_t Errs[STRTOX_ERR_WORDS(BENCH_COLUMN)];
+  uint64_t Sum = 0, I;
+
+  for (I = 0; I < Iters; ++I)
+  { /* Each column. */
+    Sum += (uint64_t) StrNToDFields(In->Fields, BENCH_COLUMN, Vals, Errs);
+    Sum += Errs[0];
+    FltSink = Vals[I & BENCH_MASK];
+  } /* Each column. */
+
+  return Sum;
+} /* Bench_StrNToDFields() */
+
+static uint64_t Bench_StrNToI64DelimPar(const BenchIn_t *In, uint64_t Iters)
+{ /* Bench_StrNToI64DelimPar() */
+  uint64_t Sum = 0, I, *Errs;
+  int64_t *Vals;
+  size_t NVals;
+
+  for (I = 0; I < Iters; ++I)
+  { /* Each column. */
+    if ((BenchErrNo = StrNToI64DelimPar(In->Col, In->ColLen, '\n', 10, 0,
+                                        &Vals, &Errs, &NVals)) != 0)
+      break;
+    Sum += (uint64_t) Vals[I & BENCH_MASK] + Errs[0] + NVals;
+    free(Errs);
+    free(Vals);
+  } /* Each column. */
+
+  return Sum;
+} /* Bench_StrNToI64DelimPar() */
+
+static uint64_t Bench_StrNToDDelimPar(const BenchIn_t *In, uint64_t Iters)
+{ /* Bench_StrNToDDelimPar() */
+  uint64_t Sum = 0, I, *Errs;
+  double *Vals;
+  size_t NVals;
+
+  for (I = 0; I < Iters; ++I)
+  { /* Each column. */
+    if ((BenchErrNo = StrNToDDelimPar(In->Col, In->ColLen, '\n', 0, &Vals,
+                                      &Errs, &NVals)) != 0)
+      break;
+    Sum += Errs[0] + NVals;
+    FltSink = Vals[I & BENCH_MASK];
+    free(Errs);
+    free(Vals);
+  } /* Each column. */
+
+  return Sum;
+} /* Bench_StrNToDDelimPar() */
+
+/* The 'String_t' growth paths.  Each operation appends one input to a
+ * string that is started again whenever it reaches 'BENCH_STR_LIMIT',
+ * so every path from the short string buffer up is included. */
+static uint64_t Bench_StringAppendCStr(const BenchIn_t *In, uint64_t Iters)
+{ /* Bench_StringAppendCStr() */
+  uint64_t Sum = 0, I;
+  String_t Str;
+
+  ConstructString(&Str);
+  for (I = 0; I < Iters; ++I)
+  { /* Each append. */
+    if (Str.Size >= BENCH_STR_LIMIT)
+    { /* Start again. */
+      Sum += Str.Size;
+      DestroyString(&Str);
+      ConstructString(&Str);
+    } /* Start again. */
+    Sum += StringAppendCStr(&Str, In->Strs[I & BENCH_MASK]);
+  } /* Each append. */
+  Sum += Str.Size;
+  DestroyString(&Str);
+
+  return Sum;
+} /* Bench_StringAppendCStr() */
+
+static uint64_t Bench_StringAppendView(const BenchIn_t *In, uint64_t Iters)
+{ /* Bench_StringAppendView() */
+  uint64_t Sum = 0, I;
+  String_t Str;
+
+  ConstructString(&Str);
+  for (I = 0; I < Iters; ++I)
+  { /* Each append. */
+    if (Str.Size >= BENCH_STR_LIMIT)
+    { /* Start again. */
+      Sum += Str.Size;
+      DestroyString(&Str);
+      ConstructString(&Str);
+    } /* Start again. */
+    Sum += StringAppendView(&Str, StrView(In->Strs[I & BENCH_MASK],
+                                          In->Lens[I & BENCH_MASK]));
+  } /* Each append. */
+  Sum += Str.Size;
+  DestroyString(&Str);
+
+  return Sum;
+} /* Bench_StringAppendView() */
+
+static uint64_t Bench_StringStreamf(const BenchIn_t *In, uint64_t Iters)
+{ /* Bench_StringStreamf() */
+  uint64_t Sum = 0, I;
+  String_t Str;
+
+  ConstructString(&Str);
+  for (I = 0; I < Iters; ++I)
+  { /* Each append. */
+    if (Str.Size >= BENCH_STR_LIMIT)
+    { /* Start again. */
+      Sum += Str.Size;
+      DestroyString(&Str);
+      ConstructString(&Str);
+    } /* Start again. */
+    Sum += (uint64_t) StringStreamf(&Str, "%s", In->Strs[I & BENCH_MASK]);
+  } /* Each append. */
+  Sum += Str.Size;
+  DestroyString(&Str);
+
+  return Sum;
+} /* Bench_StringStreamf() */
+
+static uint64_t Bench_StringStreamFmt(const BenchIn_t *In, uint64_t Iters)
+{ /* Bench_StringStreamFmt() */
+  StringFmt_t *Fmt = NewStringFmt("%s");
+  uint64_t Sum = 0, I;
+  String_t Str;
+
+  if (Fmt == NULL)
+    return 0;
+  ConstructString(&Str);
+  for (I = 0; I < Iters; ++I)
+  { /* Each append. */
+    if (Str.Size >= BENCH_STR_LIMIT)
+    { /* Start again. */
+      Sum += Str.Size;
+      DestroyString(&Str);
+      ConstructString(&Str);
+    } /* Start again. */
+    Sum += (uint64_t) StringStreamFmt(&Str, Fmt, In->Strs[I & BENCH_MASK]);
+  } /* Each append. */
+  Sum += Str.Size;
+  DestroyString(&Str);
+  DeleteStringFmt(Fmt);
+
+  return Sum;
+} /* Bench_StringStreamFmt() */
+
+/* Just the growth: each operation reserves room for one more input. */
+static uint64_t Bench_StringReserve(const BenchIn_t *In, uint64_t Iters)
+{ /* Bench_StringReserve() */
+  uint64_t Sum = 0, I;
+  size_t Want = 0;
+  String_t Str;
+
+  ConstructString(&Str);
+  for (I = 0; I < Iters; ++I)
+  { /* Each reserve. */
+    if (Want >= BENCH_STR_LIMIT)
+    { /* Start again. */
+      Sum += StringCapacity(&Str);
+      DestroyString(&Str);
+      ConstructString(&Str);
+      Want = 0;
+    } /* Start again. */
+    Want += In->Lens[I & BENCH_MASK];
+    Sum += StringReserve(&Str, Want + 1);
+  } /* Each reserve. */
+  Sum += StringCapacity(&Str);
+  DestroyString(&Str);
+
+  return Sum;
+} /* Bench_StringReserve() */
+
+/* 'StringAppendCStr()' into a string that's had 'BENCH_STR_LIMIT'
+ * reserved up front, i.e. without the growth. */
+static uint64_t Bench_StringReserveAppend(const BenchIn_t *In, uint64_t Iters)
+{ /* Bench_StringReserveAppend() */
+  uint64_t Sum = 0, I;
+  String_t Str;
+
+  ConstructString(&Str);
+  StringReserve(&Str, 2 * BENCH_STR_LIMIT);
+  for (I = 0; I < Iters; ++I)
+  { /* Each append. */
+    if (Str.Size >= BENCH_STR_LIMIT)
+    { /* Start again. */
+      Sum += Str.Size;
+      DestroyString(&Str);
+      ConstructString(&Str);
+      StringReserve(&Str, 2 * BENCH_STR_LIMIT);
+    } /* Start again. */
+    Sum += StringAppendCStr(&Str, In->Strs[I & BENCH_MASK]);
+  } /* Each append. */
+  Sum += Str.Size;
+  DestroyString(&Str);
+
+  return Sum;
+} /* Bench_StringReserveAppend() */
+
+static uint64_t Bench_StrError(const BenchIn_t *In, uint64_t Iters)
+{ /* Bench_StrError() */
+  uint64_t Sum = 0, I;
+
+  for (I = 0; I < Iters; ++I)
+    Sum += (uint64_t) (uintptr_t) StrError(In->ErrNos[I & BENCH_MASK]);
+
+  return Sum;
+} /* Bench_StrError() */
+
+/* Table entries: the group, the function, the kind of input, and the
+ * size and signedness of the result. */
+#define B_INT(G, F, T)                                                  \
+  { G, #F, Bench_##F, BENCH_INT, (int) sizeof(T) * CHAR_BIT,            \
+    (T) -1 < 0, false }
+#define B_CHR(G, F, T)                                                  \
+  { G, #F, Bench_##F, BENCH_CHR, CHAR_BIT, (T) -1 < 0, false }
+#define B_FLT(G, F, Bits)                                               \
+  { G, #F, Bench_##F, BENCH_FLT, Bits, true, false }
+#define B_COL(F, Kind, Bits)                                            \
+  { "batch", #F, Bench_##F, Kind, Bits, true, true }
+#define B_STR(F)                                                        \
+  { "String", #F, Bench_##F, BENCH_STR, 0, false, false }
+
+/* 'long double' is only as good as 'double' on some machines. */
+#define LD_BITS (sizeof(long double) > sizeof(double) ? 80 : 64)
+
+static const Bench_t Benches[] = {
+  B_INT("libc", strtol, long),
+  B_INT("libc", strtoul, unsigned long),
+  B_INT("libc", strtoll, long long),
+  B_INT("libc", strtoull, unsigned long long),
+  B_FLT("libc", strtof, 32),
+  B_FLT("libc", strtod, 64),
+  B_FLT("libc", strtold, LD_BITS),
+
+  B_CHR("strtoX", strtochar, char),
+  B_CHR("strtoX", strtoschar, signed char),
+  B_CHR("strtoX", strtouchar, unsigned char),
+  B_INT("strtoX", strtoc, char),
+  B_INT("strtoX", strtosc, signed char),
+  B_INT("strtoX", strtouc, unsigned char),
+  B_INT("strtoX", strtos, short),
+  B_INT("strtoX", strtous, unsigned short),
+  B_INT("strtoX", strtoi, int),
+  B_INT("strtoX", strtoui, unsigned int),
+  B_INT("strtoX", strtoi8, int8_t),
+  B_INT("strtoX", strtoui8, uint8_t),
+  B_INT("strtoX", strtoi16, int16_t),
+  B_INT("strtoX", strtoui16, uint16_t),
+  B_INT("strtoX", strtoi32, int32_t),
+  B_INT("strtoX", strtoui32, uint32_t),
+  B_INT("strtoX", strtoi64, int64_t),
+  B_INT("strtoX", strtoui64, uint64_t),
+  B_INT("strtoX", strtoil8, int_least8_t),
+  B_INT("strtoX", strtouil8, uint_least8_t),
+  B_INT("strtoX", strtoil16, int_least16_t),
+  B_INT("strtoX", strtouil16, uint_least16_t),
+  B_INT("strtoX", strtoil32, int_least32_t),
+  B_INT("strtoX", strtouil32, uint_least32_t),
+  B_INT("strtoX", strtoil64, int_least64_t),
+  B_INT("strtoX", strtouil64, uint_least64_t),
+  B_INT("strtoX", strtoif8, int_fast8_t),
+  B_INT("strtoX", strtouif8, uint_fast8_t),
+  B_INT("strtoX", strtoif16, int_fast16_t),
+  B_INT("strtoX", strtouif16, uint_fast16_t),
+  B_INT("strtoX", strtoif32, int_fast32_t),
+  B_INT("strtoX", strtouif32, uint_fast32_t),
+  B_INT("strtoX", strtoif64, int_fast64_t),
+  B_INT("strtoX", strtouif64, uint_fast64_t),
+
+  B_CHR("StrToX", StrToChar, char),
+  B_CHR("StrToX", StrToSChar, signed char),
+  B_CHR("StrToX", StrToUChar, unsigned char),
+  B_INT("StrToX", StrToC, char),
+  B_INT("StrToX", StrToSC, signed char),
+  B_INT("StrToX", StrToUC, unsigned char),
+  B_INT("StrToX", StrToS, short),
+  B_INT("StrToX", StrToUS, unsigned short),
+  B_INT("StrToX", StrToI, int),
+  B_INT("StrToX", StrToUI, unsigned int),
+  B_INT("StrToX", StrToL, long),
+  B_INT("StrToX", StrToUL, unsigned long),
+  B_INT("StrToX", StrToLL, long long),
+  B_INT("StrToX", StrToULL, unsigned long long),
+  B_INT("StrToX", StrToIMax, intmax_t),
+  B_INT("StrToX", StrToUMax, uintmax_t),
+  B_INT("StrToX", StrToI8, int8_t),
+  B_INT("StrToX", StrToUI8, uint8_t),
+  B_INT("StrToX", StrToI16, int16_t),
+  B_INT("StrToX", StrToUI16, uint16_t),
+  B_INT("StrToX", StrToI32, int32_t),
+  B_INT("StrToX", StrToUI32, uint32_t),
+  B_INT("StrToX", StrToI64, int64_t),
+  B_INT("StrToX", StrToUI64, uint64_t),
+  B_INT("StrToX", StrToIL8, int_least8_t),
+  B_INT("StrToX", StrToUIL8, uint_least8_t),
+  B_INT("StrToX", StrToIL16, int_least16_t),
+  B_INT("StrToX", StrToUIL16, uint_least16_t),
+  B_INT("StrToX", StrToIL32, int_least32_t),
+  B_INT("StrToX", StrToUIL32, uint_least32_t),
+  B_INT("StrToX", StrToIL64, int_least64_t),
+  B_INT("StrToX", StrToUIL64, uint_least64_t),
+  B_INT("StrToX", StrToIF8, int_fast8_t),
+  B_INT("StrToX", StrToUIF8, uint_fast8_t),
+  B_INT("StrToX", StrToIF16, int_fast16_t),
+  B_INT("StrToX", StrToUIF16, uint_fast16_t),
+  B_INT("StrToX", StrToIF32, int_fast32_t),
+  B_INT("StrToX", StrToUIF32, uint_fast32_t),
+  B_INT("StrToX", StrToIF64, int_fast64_t),
+  B_INT("StrToX", StrToUIF64, uint_fast64_t),
+  B_FLT("StrToX", StrToF, 32),
+  B_FLT("StrToX", StrToD, 64),
+  B_FLT("StrToX", StrToLD, LD_BITS),
+
+  B_CHR("StrNToX", StrNToChar, char),
+  B_CHR("StrNToX", StrNToSChar, signed char),
+  B_CHR("StrNToX", StrNToUChar, unsigned char),
+  B_INT("StrNToX", StrNToC, char),
+  B_INT("StrNToX", StrNToSC, signed char),
+  B_INT("StrNToX", StrNToUC, unsigned char),
+  B_INT("StrNToX", StrNToS, short),
+  B_INT("StrNToX", StrNToUS, unsigned short),
+  B_INT("StrNToX", StrNToI, int),
+  B_INT("StrNToX", StrNToUI, unsigned int),
+  B_INT("StrNToX", StrNToL, long),
+  B_INT("StrNToX", StrNToUL, unsigned long),
+  B_INT("StrNToX", StrNToLL, long long),
+  B_INT("StrNToX", StrNToULL, unsigned long long),
+  B_INT("StrNToX", StrNToIMax, intmax_t),
+  B_INT("StrNToX", StrNToUMax, uintmax_t),
+  B_INT("StrNToX", StrNToI8, int8_t),
+  B_INT("StrNToX", StrNToUI8, uint8_t),
+  B_INT("StrNToX", StrNToI16, int16_t),
+  B_INT("StrNToX", StrNToUI16, uint16_t),
+  B_INT("StrNToX", StrNToI32, int32_t),
+  B_INT("StrNToX", StrNToUI32, uint32_t),
+  B_INT("StrNToX", StrNToI64, int64_t),
+  B_INT("StrNToX", StrNToUI64, uint64_t),
+  B_INT("StrNToX", StrNToIL8, int_least8_t),
+  B_INT("StrNToX", StrNToUIL8, uint_least8_t),
+  B_INT("StrNToX", StrNToIL16, int_least16_t),
+  B_INT("StrNToX", StrNToUIL16, uint_least16_t),
+  B_INT("StrNToX", StrNToIL32, int_least32_t),
+  B_INT("StrNToX", StrNToUIL32, uint_least32_t),
+  B_INT("StrNToX", StrNToIL64, int_least64_t),
+  B_INT("StrNToX", StrNToUIL64, uint_least64_t),
+  B_INT("StrNToX", StrNToIF8, int_fast8_t),
+  B_INT("StrNToX", StrNToUIF8, uint_fast8_t),
+  B_INT("StrNToX", StrNToIF16, int_fast16_t),
+  B_INT("StrNToX", StrNToUIF16, uint_fast16_t),
+  B_INT("StrNToX", StrNToIF32, int_fast32_t),
+  B_INT("StrNToX", StrNToUIF32, uint_fast32_t),
+  B_INT("StrNToX", StrNToIF64, int_fast64_t),
+  B_INT("StrNToX", StrNToUIF64, uint_fast64_t),
+  B_FLT("StrNToX", StrNToF, 32),
+  B_FLT("StrNToX", StrNToD, 64),
+  B_FLT("StrNToX", StrNToLD, LD_BITS),
+
+  B_COL(StrNToI64Delim, BENCH_INT, 64),
+  B_COL(StrNToI64Fields, BENCH_INT, 64),
+  B_COL(StrNToI64DelimPar, BENCH_INT, 64),
+  B_COL(StrNToDDelim, BENCH_FLT, 64),
+  B_COL(StrNToDFields, BENCH_FLT, 64),
+  B_COL(StrNToDDelimPar, BENCH_FLT, 64),
+
+  B_STR(StringAppendCStr),
+  B_STR(StringAppendView),
+  B_STR(StringStreamf),
+  B_STR(StringStreamFmt),
+  B_STR(StringReserve),
+  B_STR(StringReserveAppend),
+
+  { "Errors", "StrError", Bench_StrError, BENCH_ERR, 0, false, false },
+};
+
+#define BENCH_COUNT (sizeof(Benches) / sizeof(Benches[0]))
+
+static int CompareDouble(const void *A, const void *B)
+{ /* CompareDouble() */
+  double X = *(const double *) A, Y = *(const double *) B;
+
+  return (X > Y) - (X < Y);
+} /* CompareDouble() */
+
+/* Time one run of 'Iters' operations, in nanoseconds. */
+static double TimeRun(const Bench_t *B, const BenchIn_t *In, uint64_t Iters)
+{ /* TimeRun() */
+  double Start = NowNs();
+
+  Sink += B->Fn(In, Iters);
+  return NowNs() - Start;
+} /* TimeRun() */
+
+/* Time 'B' on 'In' into 'Res'.  Returns 'false' and sets 'errno' if
+ * it fails. */
+static bool Run(const Bench_t *B, const BenchIn_t *In, double MinNs,
+                int Reps, BenchResult_t *Res)
+{ /* Run() */
+  double Ns[Reps], Scale;
+  uint64_t Iters = 1;
+  int R;
+
+  /* Find how many operations take 'MinNs' (which warms things up as a
+   * side effect). */
+  BenchErrNo = 0;
+  while ((Ns[0] = TimeRun(B, In, Iters)) < MinNs && BenchErrNo == 0)
+  { /* Too quick. */
+    Scale = (Ns[0] > 0 ? 1.2 * MinNs / Ns[0] : 100);
+    Iters = (uint64_t) ((double) Iters * (Scale < 100 ? Scale : 100)) + 1;
+  } /* Too quick. */
+
+  for (R = 0; R < Reps && BenchErrNo == 0; ++R)
+    Ns[R] = TimeRun(B, In, Iters) / (double) Iters;
+  if (BenchErrNo != 0)
+  { /* Error. */
+    errno = BenchErrNo;
+    return false;
+  } /* Error. */
+  qsort(Ns, (size_t) Reps, sizeof(Ns[0]), CompareDouble);
+
+  Res->Iters = Iters;
+  Res->NsMin = Ns[0];
+  Res->NsMedian = Ns[Reps / 2];
+  Res->NsMax = Ns[Reps - 1];
+  Res->BytesOp = (B->Batch ? (double) In->ColLen :
+                  (double) In->Bytes / BENCH_NINPUTS);
+  return true;
+} /* Run() */
+
+/* Whether "Group/Name/Dist" contains any of 'Patterns'. */
+static bool Wanted(const char *Name, char **Patterns, int NPatterns)
+{ /* Wanted() */
+  int I;
+
+  if (NPatterns == 0)
+    return true;
+  for (I = 0; I < NPatterns; ++I)
+  { /* Each pattern. */
+    if (strstr(Name, Patterns[I]) != NULL)
+      return true;
+  } /* Each pattern. */
+
+  return false;
+} /* Wanted() */
+
+static void Usage(const char *Prog)
+{ /* Usage() */
+  fprintf(stderr, "Usage: %s [-f csv|json] [-t Ms] [-r Reps] [-s Seed] "
+          "[-l] [Pattern ...]\n", Prog);
+} /* Usage() */
+
+/******************************************************************************
+ * Public methods.
+ *****************************************************************************/
+int main(int argc, char **argv)
+{ /* main() */
+  const char *const *DistNames;
+  bool Json = false, List = false, First = true, Failed = false;
+  uint64_t Seed = 1;
+  double MinMs = 20;
+  int Reps = 5, Opt, Dist;
+  char Name[128];
+  BenchResult_t Res;
+  BenchIn_t *In;
+  size_t I;
+
+  while ((Opt = getopt(argc, argv, "f:t:r:s:l")) != -1)
+  { /* Each option. */
+    switch (Opt)
+    { /* switch */
+    case 'f':
+      if (strcmp(optarg, "json") == 0)
+        Json = true;
+      else if (strcmp(optarg, "csv") == 0)
+        Json = false;
+      else
+      { /* Bad format. */
+        Usage(argv[0]);
+        return 2;
+      } /* Bad format. */
+      break;
+    case 't':
+      if (StrToD(optarg, &MinMs) != 0 || MinMs <= 0)
+      { /* Bad time. */
+        Usage(argv[0]);
+        return 2;
+      } /* Bad time. */
+      break;
+    case 'r':
+      if (StrToI(optarg, 10, &Reps) != 0 || Reps < 1 || Reps > 1000)
+      { /* Bad count. */
+        Usage(argv[0]);
+        return 2;
+      } /* Bad count. */
+      break;
+    case 's':
+      if (StrToUI64(optarg, 0, &Seed) != 0)
+      { /* Bad seed. */
+        Usage(argv[0]);
+        return 2;
+      } /* Bad seed. */
+      break;
+    case 'l':
+      List = true;
+      break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    } /* switch */
+  } /* Each option. */
+  argv += optind;
+  argc -= optind;
+
+  if ((In = malloc(sizeof(*In))) == NULL)
+  { /* Error. */
+    fprintf(stderr, "Bench: %s\n", StrError(errno));
+    return 1;
+  } /* Error. */
+
+  if (List)
+    ;
+  else if (Json)
+    printf("{\n  \"meta\": {\"version\": \"%s\", \"compiler\": \"%s\", "
+           "\"seed\": %" PRIu64 ", \"min_ms\": %g, \"reps\": %d, "
+           "\"inputs\": %d},\n  \"results\": [",
+           BENCH_VERSION, __VERSION__, Seed, MinMs, Reps, BENCH_NINPUTS);
+  else
+    printf("name,group,function,dist,iters,ns_op_min,ns_op_median,"
+           "ns_op_max,bytes_op,bytes_s\n");
+
+  for (I = 0; I < BENCH_COUNT; ++I)
+  { /* Each benchmark. */
+    DistNames = Dists(Benches[I].Kind);
+    for (Dist = 0; DistNames[Dist] != NULL; ++Dist)
+    { /* Each distribution. */
+      snprintf(Name, sizeof(Name), "%s/%s/%s", Benches[I].Group,
+               Benches[I].Name, DistNames[Dist]);
+      if (!Wanted(Name, argv, argc))
+        continue;
+      if (List)
+      { /* Just the name. */
+        printf("%s\n", Name);
+        continue;
+      } /* Just the name. */
+
+      if (!MakeInputs(In, &Benches[I], Dist, Seed))
+      { /* Error. */
+        fprintf(stderr, "Bench: %s: %s\n", Name, StrError(errno));
+        FreeInputs(In);
+        Failed = true;
+        continue;
+      } /* Error. */
+      if (!Run(&Benches[I], In, MinMs * 1e6, Reps, &Res))
+      { /* Error. */
+        fprintf(stderr, "Bench: %s: %s\n", Name, StrError(errno));
+        FreeInputs(In);
+        Failed = true;
+        continue;
+      } /* Error. */
+      FreeInputs(In);
+
+      if (Json)
+        printf("%s\n    {\"name\": \"%s\", \"group\": \"%s\", "
+               "\"function\": \"%s\", \"dist\": \"%s\", "
+               "\"iters\": %" PRIu64 ", \"ns_op_min\": %.3f, "
+               "\"ns_op_median\": %.3f, \"ns_op_max\": %.3f, "
+               "\"bytes_op\": %.2f, \"bytes_s\": %.0f}",
+               First ? "" : ",", Name, Benches[I].Group, Benches[I].Name,
+               DistNames[Dist], Res.Iters, Res.NsMin, Res.NsMedian,
+               Res.NsMax, Res.BytesOp, Res.BytesOp * 1e9 / Res.NsMedian);
+      else
+        printf("%s,%s,%s,%s,%" PRIu64 ",%.3f,%.3f,%.3f,%.2f,%.0f\n",
+               Name, Benches[I].Group, Benches[I].Name, DistNames[Dist],
+               Res.Iters, Res.NsMin, Res.NsMedian, Res.NsMax, Res.BytesOp,
+               Res.BytesOp * 1e9 / Res.NsMedian);
+      First = false;
+      fflush(stdout);
+    } /* Each distribution. */
+  } /* Each benchmark. */
+
+  if (Json && !List)
+    printf("\n  ]\n}\n");
+
+  free(In);
+  return (Failed ? 1 : 0);
+} /* main() */
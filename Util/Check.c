@@ -0,0 +1,2175 @@
+/******************************************************************************
+ * Checks that the parts of the library that do something the C library
+ * (or a few lines of obvious code) also does, do exactly the same.
+ * Built, and run, by 'make check' but not by 'make' or installed.
+ * Options for it go in 'CHECK_ARGS', as for the benchmarks (see
+ * Bench.c).
+ *
+ *   Check [-n Count] [-s Seed] [-l] [Pattern ...]
+ *
+ * The checks, and what each is compared with, are:
+ *
+ *   Format    'StringPrintf()', 'StringStreamf()', 'StringPrintFmt()',
+ *             and 'StringStreamFmt()' with 'snprintf()'.
+ *   StrToInt  The integer 'StrToX()', 'StrNToX()', and 'strtoX()'
+ *             functions with 'strtoimax()' and 'strtoumax()'.
+ *   StrToFlt  'StrToF()', 'StrToD()', 'StrToLD()', and the 'StrNToX()'
+ *             versions with 'strtof()', 'strtod()', and 'strtold()'.
+ *   Batch     The 'Fields', 'Delim', and 'DelimPar' conversions with
+ *             'StrNToI64()' and 'StrNToD()' on each field.
+ *   XToStr    'UMaxToStr()' and 'IMaxToStr()' with a digit loop, and
+ *             'DToStr()' and 'FToStr()' with 'strtod()', 'strtof()',
+ *             and the '%.*e' digits.
+ *   StrMap    'StrMap_t' with an array indexed by key.
+ *   Intern    'Intern_t' with an array of the first copy returned for
+ *             each string, from one thread and from several at once.
+ *   Pool      'PoolMalloc()', 'PoolRealloc()', and 'PoolFree()' with
+ *             the bytes last written to each block, including blocks
+ *             freed by another thread.
+ *
+ * Each check does 'Count' cases (100000 by default) on inputs made up
+ * by a pseudo-random generator started from 'Seed' (1 by default), so
+ * the same seed always gives the same inputs, and a failure can be
+ * repeated with just the check that failed.  Only the checks whose name
+ * contains one of the 'Pattern's are run (all of them if there are
+ * none), and '-l' lists the names instead of running them.
+ *
+ * There is a line per check on standard output.  The first few
+ * failures of each, with the input, what was wanted, and what was got,
+ * go to standard error, and if there are any the exit status is 1.
+ *****************************************************************************/
+#include <ctype.h>
+#include <errno.h>
+#include <float.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "Errors.h"
+#include "Intern.h"
+#include "Pool.h"
+#include "StrMap.h"
+#include "StrToX.h"
+#include "String.h"
+#include "XToStr.h"
+
+/* Cases per check, unless '-n' says otherwise. */
+#define CHECK_COUNT 100000
+
+/* Failures shown per check. */
+#define CHECK_SHOW 10
+
+/* Big enough for anything 'snprintf()' is asked to write. */
+#define CHECK_BUFF_SIZE 2048
+
+/* Big enough for any made up number. */
+#define CHECK_STR_SIZE 256
+
+/* Written to a result before a conversion that should leave it alone
+ * if it fails. */
+#define CHECK_SENTINEL UINT64_C(0x5A5A5A5A5A5A5A5A)
+
+/* Keys (and interned strings), and blocks, to choose from. */
+#define CHECK_KEYS 1000
+#define CHECK_BLOCKS 256
+
+/* Threads interning the same strings at once. */
+#define CHECK_THREADS 4
+
+/* Fields in the "big" batch columns, which are split between
+ * threads. */
+#define CHECK_BIG_COLUMN 100000
+
+/* Types of 'printf()' argument. */
+#define ARG_NONE 0              /* "%%". */
+#define ARG_INT 1
+#define ARG_UINT 2
+#define ARG_LONG 3
+#define ARG_ULONG 4
+#define ARG_LLONG 5
+#define ARG_ULLONG 6
+#define ARG_IMAX 7
+#define ARG_UMAX 8
+#define ARG_SSIZE 9
+#define ARG_SIZE 10
+#define ARG_PTRDIFF 11
+#define ARG_DOUBLE 12
+#define ARG_LDOUBLE 13
+#define ARG_STR 14
+#define ARG_PTR 15
+#define ARG_CHAR 16
+
+/* Does 'Count' cases and returns how many it did.  Failures are
+ * reported with 'Fail()'. */
+typedef uint64_t CheckFn_t(uint64_t Count);
+
+typedef struct Check
+{ /* Check */
+  const char *Name;
+  CheckFn_t *Fn;
+} Check_t; /* Check */
+
+/* Calls 'StrToX()' (if 'Len' is 'SIZE_MAX') or 'StrNToX()' for one
+ * integer type, with the result in '*Val'.  Returns -1 if it failed
+ * but changed the result anyway. */
+typedef int CheckIntFn_t(const char *Str, size_t Len, int Base,
+                         uintmax_t *Val);
+
+/* Calls 'strtoX()' for one integer type. */
+typedef uintmax_t CheckStrToFn_t(const char *Str, char **End, int Base);
+
+typedef struct CheckInt
+{ /* CheckInt */
+  const char *Name;
+  CheckIntFn_t *Fn;
+  CheckStrToFn_t *StrTo;        /* NULL if there isn't one. */
+  bool Signed;
+  intmax_t Min;
+  uintmax_t Max;
+} CheckInt_t; /* CheckInt */
+
+/* As 'CheckIntFn_t' but for 'StrToF()', 'StrToD()', and 'StrToLD()'. */
+typedef int CheckFltFn_t(const char *Str, size_t Len, long double *Val);
+
+typedef struct CheckFlt
+{ /* CheckFlt */
+  const char *Name;
+  CheckFltFn_t *Fn;
+  int Type;                     /* 'f', 'd', or 'L'. */
+} CheckFlt_t; /* CheckFlt */
+
+/* A block from the pool, and the byte it's filled with. */
+typedef struct CheckBlock
+{ /* CheckBlock */
+  unsigned char *Ptr;
+  size_t Size;
+  unsigned char Fill;
+} CheckBlock_t; /* CheckBlock */
+
+/* What a thread does to the pool: allocates 'NBlocks' blocks into
+ * 'Blocks', or checks and frees them. */
+typedef struct CheckPool
+{ /* CheckPool */
+  CheckBlock_t *Blocks;
+  size_t NBlocks;
+  bool Alloc;
+  uint64_t Bad;                 /* Blocks that were wrong. */
+} CheckPool_t; /* CheckPool */
+
+/* What a thread interns, and the copies it got. */
+typedef struct CheckIntern
+{ /* CheckIntern */
+  Intern_t *Intern;
+  const String_t *Ptrs[CHECK_KEYS];
+  uint64_t Seed;
+  uint64_t Bad;                 /* Copies that were wrong. */
+} CheckIntern_t; /* CheckIntern */
+
+/* The check that's running, and how many times it's failed. */
+static const char *CheckName;
+static uint64_t Failures;
+
+/* The pseudo-random generator (xorshift64*). */
+static uint64_t RandState;
+
+/* The keys for 'StrMap_t' and 'Intern_t'. */
+static char Keys[CHECK_KEYS][64];
+static size_t KeyLens[CHECK_KEYS];
+
+/******************************************************************************
+ * These would be 'private' in C++.
+ *****************************************************************************/
+static uint64_t RandNext(uint64_t *State)
+{ /* RandNext() */
+  *State ^= *State >> 12;
+  *State ^= *State << 25;
+  *State ^= *State >> 27;
+  return *State * UINT64_C(2685821657736338717);
+} /* RandNext() */
+
+static uint64_t Rand(void)
+{ /* Rand() */
+  return RandNext(&RandState);
+} /* Rand() */
+
+/* Uniform in ['Lo', 'Hi'].  Close enough, anyway. */
+static uint64_t RandRange(uint64_t Lo, uint64_t Hi)
+{ /* RandRange() */
+  if (Hi - Lo == UINT64_MAX)
+    return Rand();
+  return Lo + Rand() % (Hi - Lo + 1);
+} /* RandRange() */
+
+#define RAND_PICK(Array) ((Array)[Rand() % (sizeof(Array) / sizeof((Array)[0]))])
+
+/* 64 bits that are often at or near an edge: a power of 2 or 10, the
+ * limits of a type, or a small number, either way up. */
+static uint64_t RandBits(void)
+{ /* RandBits() */
+  static const uint64_t Edges[] =
+  {
+    0, INT8_MAX, UINT8_MAX, INT16_MAX, UINT16_MAX, INT32_MAX, UINT32_MAX,
+    INT64_MAX, UINT64_MAX
+  };
+  uint64_t Bits;
+  int I;
+
+  switch (Rand() % 8)
+  { /* switch */
+  case 0:
+  case 1:
+    return Rand();
+  case 2:
+    return Rand() >> RandRange(1, 63);
+  case 3:
+    return RandRange(0, 300) - 150;
+  case 4:
+    return RAND_PICK(Edges) + RandRange(0, 4) - 2;
+  case 5:
+    return -(RAND_PICK(Edges) + RandRange(0, 4) - 2);
+  case 6:
+    return (uint64_t) 1 << RandRange(0, 63);
+  default:
+    for (Bits = 1, I = (int) RandRange(0, 19); I > 0; --I)
+      Bits *= 10;
+    return Bits + RandRange(0, 2) - 1;
+  } /* switch */
+} /* RandBits() */
+
+/* A 'double' that's often awkward to print or read: any bit pattern at
+ * all, a decimal fraction, a tie, a power of 10, a limit, .... */
+static double RandDouble(void)
+{ /* RandDouble() */
+  static const double Specials[] =
+  {
+    0.0, -0.0, INFINITY, -INFINITY, NAN, -NAN, DBL_MAX, DBL_MIN,
+    DBL_TRUE_MIN, DBL_EPSILON, 0.1, 0.5, 1.0, 2.5, 9.5, 0.125, 0.05,
+    1e23, 9007199254740993.0, 123456789012345678.0, 1e-5, 1e16, 1e17,
+    FLT_MAX, FLT_MIN, FLT_TRUE_MIN
+  };
+  char Buff[64];
+  uint64_t Bits;
+  double Val;
+  int I;
+
+  switch (Rand() % 8)
+  { /* switch */
+  case 0:
+    Bits = Rand();
+    memcpy(&Val, &Bits, sizeof(Val));
+    return Val;
+  case 1:
+    return (double) (int64_t) RandBits();
+  case 2:
+    Val = (double) (int64_t) (Rand() >> RandRange(1, 63));
+    for (I = (int) RandRange(0, 25); I > 0; --I)
+      Val /= 10;
+    return Val;
+  case 3:
+    return RAND_PICK(Specials);
+  case 4:
+    /* An odd number of halves, quarters, ..., so a tie somewhere. */
+    Val = (double) (2 * RandRange(0, 999) + 1);
+    for (I = (int) RandRange(1, 10); I > 0; --I)
+      Val /= 2;
+    return (Rand() & 1 ? -Val : Val);
+  case 5:
+    return (double) (Rand() >> 11) / 9007199254740992.0;
+  case 6:
+    snprintf(Buff, sizeof(Buff), "%se%d", (Rand() & 1 ? "1" : "5"),
+             (int) RandRange(0, 640) - 330);
+    return strtod(Buff, NULL);
+  default:
+    snprintf(Buff, sizeof(Buff), "%s%d.%de%d", (Rand() & 1 ? "-" : ""),
+             (int) RandRange(0, 999), (int) RandRange(0, 999),
+             (int) RandRange(0, 80) - 40);
+    return strtod(Buff, NULL);
+  } /* switch */
+} /* RandDouble() */
+
+/* Report a failure, if it's one of the first few. */
+static void Fail(const char *Fmt, ...)
+{ /* Fail() */
+  va_list ap;
+
+  if (Failures++ >= CHECK_SHOW)
+    return;
+
+  fprintf(stderr, "Check: %s: ", CheckName);
+  va_start(ap, Fmt);
+  vfprintf(stderr, Fmt, ap);
+  va_end(ap);
+  fputc('\n', stderr);
+} /* Fail() */
+
+/* 'Len' characters of 'Str', quoted and with anything unprintable
+ * escaped, for 'Fail()'.  There are a few buffers so that it can be
+ * used more than once in a call. */
+static const char *Show(const char *Str, size_t Len)
+{ /* Show() */
+  static char Buffs[4][256];
+  static int Next;
+  char *Buff = Buffs[Next++ % 4];
+  size_t Pos = 0, I;
+  unsigned char Char;
+
+  Buff[Pos++] = '"';
+  for (I = 0; I < Len && Pos < sizeof(Buffs[0]) - 12; ++I)
+  { /* Each character. */
+    Char = (unsigned char) Str[I];
+    if (Char == '"' || Char == '\\')
+      Pos += (size_t) sprintf(&Buff[Pos], "\\%c", Char);
+    else if (isprint(Char))
+      Buff[Pos++] = (char) Char;
+    else
+      Pos += (size_t) sprintf(&Buff[Pos], "\\x%02x", Char);
+  } /* Each character. */
+  if (I < Len)
+  { /* Too long. */
+    memcpy(&Buff[Pos], "...", 3);
+    Pos += 3;
+  } /* Too long. */
+  Buff[Pos++] = '"';
+  Buff[Pos] = '\0';
+
+  return Buff;
+} /* Show() */
+
+/* A copy of 'Len' characters of 'Str' in a block of exactly 'Len'
+ * bytes, or, if 'Pad', one followed by more digits, so that reading
+ * past the end is either caught (e.g. by '-fsanitize=address') or
+ * changes the result.  NULL if it can't be allocated. */
+static char *CopyField(const char *Str, size_t Len, bool Pad)
+{ /* CopyField() */
+  char *Copy;
+
+  if ((Copy = malloc(Len + (Pad ? 4 : 0) + 1)) == NULL)
+    return NULL;
+  memcpy(Copy, Str, Len);
+  if (Pad)
+    memcpy(&Copy[Len], "1234", 4);
+  return Copy;
+} /* CopyField() */
+
+/* A random literal, and sometimes "%%", for a format. */
+static size_t MakeLiteral(char *Buff)
+{ /* MakeLiteral() */
+  static const char Chars[] = "ab XYZ-09.\t";
+  size_t Pos = 0, I;
+
+  for (I = RandRange(0, 6); I > 0; --I)
+  { /* Each character. */
+    if (Rand() % 8 == 0)
+    { /* A '%'. */
+      Buff[Pos++] = '%';
+      Buff[Pos++] = '%';
+    } /* A '%'. */
+    else
+      Buff[Pos++] = Chars[Rand() % (sizeof(Chars) - 1)];
+  } /* Each character. */
+
+  return Pos;
+} /* MakeLiteral() */
+
+/* A random conversion specification, with literal text either side,
+ * in 'Fmt', and the type of its argument.  Any '*' values go in
+ * 'Stars'. */
+static int MakeFormat(char *Fmt, int *Stars, int *NStars)
+{ /* MakeFormat() */
+  static const char Convs[] = "diouxXcspeEfFgGaA%";
+  static const char *const Lens[] = { "", "hh", "h", "l", "ll", "j", "z",
+                                      "t" };
+  static const int Signed[] = { ARG_INT, ARG_INT, ARG_INT, ARG_LONG,
+                                ARG_LLONG, ARG_IMAX, ARG_SSIZE,
+                                ARG_PTRDIFF };
+  static const int Unsigned[] = { ARG_UINT, ARG_UINT, ARG_UINT, ARG_ULONG,
+                                  ARG_ULLONG, ARG_UMAX, ARG_SIZE,
+                                  ARG_SIZE };
+  const char *Flags, *Len = "";
+  size_t Pos, I;
+  bool Prec;
+  char Conv;
+  int Kind;
+
+  *NStars = 0;
+  Pos = MakeLiteral(Fmt);
+  Fmt[Pos++] = '%';
+  Conv = Convs[Rand() % (sizeof(Convs) - 1)];
+
+  /* Only what the C standard defines for the conversion. */
+  switch (Conv)
+  { /* switch */
+  case 'd':
+  case 'i':
+    Flags = "-+ 0";
+    Prec = true;
+    I = Rand() % (sizeof(Lens) / sizeof(Lens[0]));
+    Len = Lens[I];
+    Kind = Signed[I];
+    break;
+  case 'o':
+  case 'u':
+  case 'x':
+  case 'X':
+    Flags = (Conv == 'u' ? "-0" : "-#0");
+    Prec = true;
+    I = Rand() % (sizeof(Lens) / sizeof(Lens[0]));
+    Len = Lens[I];
+    Kind = Unsigned[I];
+    break;
+  case 'c':
+    Flags = "-";
+    Prec = false;
+    Kind = ARG_CHAR;
+    break;
+  case 's':
+    Flags = "-";
+    Prec = true;
+    Kind = ARG_STR;
+    break;
+  case 'p':
+    Flags = "-";
+    Prec = false;
+    Kind = ARG_PTR;
+    break;
+  case '%':
+    Fmt[Pos++] = '%';
+    Pos += MakeLiteral(&Fmt[Pos]);
+    Fmt[Pos] = '\0';
+    return ARG_NONE;
+  default:
+    Flags = "-+ #0";
+    Prec = true;
+    if (Rand() % 4 == 0)
+    { /* long double. */
+      Len = "L";
+      Kind = ARG_LDOUBLE;
+    } /* long double. */
+    else
+      Kind = ARG_DOUBLE;
+    break;
+  } /* switch */
+
+  for (I = 0; Flags[I] != '\0'; ++I)
+  { /* Each flag. */
+    if (Rand() % 4 == 0)
+      Fmt[Pos++] = Flags[I];
+  } /* Each flag. */
+
+  switch (Rand() % 4)
+  { /* Width. */
+  case 0:
+  case 1:
+    break;
+  case 2:
+    Pos += (size_t) sprintf(&Fmt[Pos], "%d", (int) RandRange(1, 40));
+    break;
+  default:
+    Fmt[Pos++] = '*';
+    Stars[(*NStars)++] = (int) RandRange(0, 80) - 40;
+    break;
+  } /* Width. */
+
+  switch (Prec ? Rand() % 5 : 0)
+  { /* Precision. */
+  case 0:
+  case 1:
+    break;
+  case 2:
+    Fmt[Pos++] = '.';
+    break;
+  case 3:
+    Pos += (size_t) sprintf(&Fmt[Pos], ".%d", (int) RandRange(0, 30));
+    break;
+  default:
+    Fmt[Pos++] = '.';
+    Fmt[Pos++] = '*';
+    Stars[(*NStars)++] = (int) RandRange(0, 45) - 5;
+    break;
+  } /* Precision. */
+
+  Pos += (size_t) sprintf(&Fmt[Pos], "%s%c", Len, Conv);
+  Pos += MakeLiteral(&Fmt[Pos]);
+  Fmt[Pos] = '\0';
+
+  return Kind;
+} /* MakeFormat() */
+
+/* Call 'Call' with the '*' values, if there are any, then 'Arg'. */
+#define CHECK_STARS(Call, Arg)                                              \
+  (NStars == 0 ? Call(Arg)                                                  \
+   : NStars == 1 ? Call(Stars[0], Arg) : Call(Stars[0], Stars[1], Arg))
+#define CHECK_WANT(...) snprintf(Want, sizeof(Want), Fmt, __VA_ARGS__)
+#define CHECK_PRINTF(...) StringPrintf(&Got[0], Fmt, __VA_ARGS__)
+#define CHECK_STREAMF(...) StringStreamf(&Got[1], Fmt, __VA_ARGS__)
+#define CHECK_PRINTFMT(...) StringPrintFmt(&Got[2], CFmt, __VA_ARGS__)
+#define CHECK_STREAMFMT(...) StringStreamFmt(&Got[3], CFmt, __VA_ARGS__)
+
+/* Describe the argument, after any '*'s, in 'Arg'. */
+#define CHECK_ARG(...)                                                      \
+  snprintf(&Arg[ArgLen], sizeof(Arg) - (size_t) ArgLen, __VA_ARGS__)
+
+/* Format 'Arg' with 'snprintf()' into 'Want' and each of the others
+ * into 'Got'. */
+#define CHECK_FORMAT(Arg)                                                   \
+  do                                                                        \
+  {                                                                         \
+    WantLen = CHECK_STARS(CHECK_WANT, Arg);                                 \
+    GotLen[0] = CHECK_STARS(CHECK_PRINTF, Arg);                             \
+    GotLen[1] = CHECK_STARS(CHECK_STREAMF, Arg);                            \
+    if (CFmt != NULL)                                                       \
+    {                                                                       \
+      GotLen[2] = CHECK_STARS(CHECK_PRINTFMT, Arg);                         \
+      GotLen[3] = CHECK_STARS(CHECK_STREAMFMT, Arg);                        \
+    }                                                                       \
+  } while (0)
+
+static uint64_t CheckFormat(uint64_t Count)
+{ /* CheckFormat() */
+  static const char *const Funcs[] = { "StringPrintf", "StringStreamf",
+                                       "StringPrintFmt", "StringStreamFmt" };
+  static const char *const Strs[] =
+  {
+    "", "a", "hello", "Hello, world!", "%s%d", "tab\there",
+    "a much longer string than the others, that needs some more room"
+  };
+  char Fmt[256], Want[CHECK_BUFF_SIZE], Arg[128];
+  String_t Got[4];
+  StringFmt_t *CFmt;
+  int Stars[2], NStars, Kind, WantLen, GotLen[4], ArgLen, I, Skip;
+  uint64_t Bits, N;
+  long double LVal;
+  const char *Str;
+  double Val;
+  void *Ptr;
+
+  for (I = 0; I < 4; ++I)
+    ConstructString(&Got[I]);
+
+  for (N = 0; N < Count; ++N)
+  { /* Each case. */
+    Kind = MakeFormat(Fmt, Stars, &NStars);
+    CFmt = NewStringFmt(Fmt);
+    StringPrintf(&Got[1], "pre");
+    StringPrintf(&Got[3], "pre");
+    GotLen[2] = GotLen[3] = -2;
+
+    Bits = RandBits();
+    Val = RandDouble();
+    LVal = (long double) Val
+      * (1 + (long double) (Rand() >> 1) / 9223372036854775808.0L);
+    Str = RAND_PICK(Strs);
+    Ptr = (Rand() % 8 == 0 ? NULL : (void *) (uintptr_t) Rand());
+    ArgLen = (NStars == 0 ? 0
+              : NStars == 1 ? snprintf(Arg, sizeof(Arg), "%d, ", Stars[0])
+              : snprintf(Arg, sizeof(Arg), "%d, %d, ", Stars[0], Stars[1]));
+    switch (Kind)
+    { /* switch */
+    case ARG_NONE:
+      CHECK_ARG("none");
+      CHECK_FORMAT(0);
+      break;
+    case ARG_CHAR:
+      Bits = RandRange(0, 255);
+      CHECK_ARG("%d", (int) Bits);
+      CHECK_FORMAT((int) Bits);
+      break;
+    case ARG_INT:
+      CHECK_ARG("%d", (int) Bits);
+      CHECK_FORMAT((int) Bits);
+      break;
+    case ARG_UINT:
+      CHECK_ARG("%u", (unsigned) Bits);
+      CHECK_FORMAT((unsigned) Bits);
+      break;
+    case ARG_LONG:
+      CHECK_ARG("%ld", (long) Bits);
+      CHECK_FORMAT((long) Bits);
+      break;
+    case ARG_ULONG:
+      CHECK_ARG("%lu", (unsigned long) Bits);
+      CHECK_FORMAT((unsigned long) Bits);
+      break;
+    case ARG_LLONG:
+      CHECK_ARG("%lld", (long long) Bits);
+      CHECK_FORMAT((long long) Bits);
+      break;
+    case ARG_ULLONG:
+      CHECK_ARG("%llu", (unsigned long long) Bits);
+      CHECK_FORMAT((unsigned long long) Bits);
+      break;
+    case ARG_IMAX:
+      CHECK_ARG("%jd", (intmax_t) Bits);
+      CHECK_FORMAT((intmax_t) Bits);
+      break;
+    case ARG_UMAX:
+      CHECK_ARG("%ju", (uintmax_t) Bits);
+      CHECK_FORMAT((uintmax_t) Bits);
+      break;
+    case ARG_SSIZE:
+      CHECK_ARG("%zd", (ssize_t) Bits);
+      CHECK_FORMAT((ssize_t) Bits);
+      break;
+    case ARG_SIZE:
+      CHECK_ARG("%zu", (size_t) Bits);
+      CHECK_FORMAT((size_t) Bits);
+      break;
+    case ARG_PTRDIFF:
+      CHECK_ARG("%td", (ptrdiff_t) Bits);
+      CHECK_FORMAT((ptrdiff_t) Bits);
+      break;
+    case ARG_DOUBLE:
+      CHECK_ARG("%a", Val);
+      CHECK_FORMAT(Val);
+      break;
+    case ARG_LDOUBLE:
+      CHECK_ARG("%La", LVal);
+      CHECK_FORMAT(LVal);
+      break;
+    case ARG_STR:
+      CHECK_ARG("%s", Show(Str, strlen(Str)));
+      CHECK_FORMAT(Str);
+      break;
+    default:
+      CHECK_ARG("%p", Ptr);
+      CHECK_FORMAT(Ptr);
+      break;
+    } /* switch */
+    if (WantLen < 0 || WantLen >= (int) sizeof(Want))
+    { /* Not one we can check. */
+      DeleteStringFmt(CFmt);
+      continue;
+    } /* Not one we can check. */
+
+    if (CFmt == NULL)
+      Fail("NewStringFmt(%s) failed.  %s.", Show(Fmt, strlen(Fmt)),
+           StrError(errno));
+    for (I = 0; I < (CFmt == NULL ? 2 : 4); ++I)
+    { /* Each function. */
+      Skip = (I % 2 == 0 ? 0 : 3);
+      if (GotLen[I] != Skip + WantLen
+          || Got[I].Size != (size_t) (Skip + WantLen)
+          || memcmp(Got[I].Ptr, "pre", (size_t) Skip) != 0
+          || memcmp(&Got[I].Ptr[Skip], Want, (size_t) WantLen) != 0)
+        Fail("%s(%s, %s): want %s (%d), got %s (%d).", Funcs[I],
+             Show(Fmt, strlen(Fmt)), Arg, Show(Want, (size_t) WantLen),
+             Skip + WantLen, Show(&Got[I].Ptr[Skip], Got[I].Size - Skip),
+             GotLen[I]);
+    } /* Each function. */
+    DeleteStringFmt(CFmt);
+  } /* Each case. */
+
+  for (I = 0; I < 4; ++I)
+    DestroyString(&Got[I]);
+
+  return Count;
+} /* CheckFormat() */
+
+/* A random integer in 'Base' (or, if it's not a valid one, base 10),
+ * often near a limit, with the odd thing wrong with it. */
+static size_t MakeInt(char *Buff, int Base)
+{ /* MakeInt() */
+  static const char Digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+  static const char Junk[] = " \t\n+-.xXgz_";
+  size_t Pos = 0, Start, I;
+  char Rev[64];
+  uint64_t Mag;
+  int B;
+
+  B = (Base >= 2 && Base <= 36 ? Base : 10);
+  if (Rand() % 50 == 0)
+    Buff[Pos++] = Junk[Rand() % 3];
+  switch (Rand() % 8)
+  { /* Sign. */
+  case 0:
+  case 1:
+    Buff[Pos++] = '-';
+    break;
+  case 2:
+    Buff[Pos++] = '+';
+    break;
+  } /* Sign. */
+  if (Rand() % 50 == 0)
+    Buff[Pos++] = (Rand() & 1 ? '+' : '-');
+
+  Start = Pos;
+  if ((Base == 16 || Base == 0) && Rand() % 3 == 0)
+  { /* Hex prefix. */
+    Buff[Pos++] = '0';
+    Buff[Pos++] = (Rand() & 1 ? 'x' : 'X');
+    B = 16;
+  } /* Hex prefix. */
+  else if (Base == 0 && Rand() % 4 == 0)
+  { /* Octal. */
+    Buff[Pos++] = '0';
+    B = 8;
+  } /* Octal. */
+  if (Rand() % 10 == 0)
+  { /* Leading zeros. */
+    for (I = RandRange(1, 20); I > 0; --I)
+      Buff[Pos++] = '0';
+  } /* Leading zeros. */
+
+  if (Rand() % 30 == 0)
+    ;
+  else if (Rand() % 3 != 0)
+  { /* A value. */
+    Mag = RandBits();
+    I = 0;
+    do
+    { /* Each digit. */
+      Rev[I++] = Digits[Mag % (unsigned) B];
+      Mag /= (unsigned) B;
+    } while (Mag != 0);
+    while (I > 0)
+      Buff[Pos++] = Rev[--I];
+  } /* A value. */
+  else
+  { /* Just digits, with the odd one that isn't. */
+    for (I = RandRange(1, 25); I > 0; --I)
+      Buff[Pos++] = (Rand() % 20 == 0 ? Digits[Rand() % 36]
+                     : Digits[Rand() % (unsigned) B]);
+  } /* Just digits, with the odd one that isn't. */
+
+  if (Rand() % 4 == 0)
+  { /* Upper case. */
+    for (I = Start; I < Pos; ++I)
+      Buff[I] = (char) toupper((unsigned char) Buff[I]);
+  } /* Upper case. */
+  if (Rand() % 30 == 0)
+    Buff[Pos++] = Junk[Rand() % (sizeof(Junk) - 1)];
+
+  return Pos;
+} /* MakeInt() */
+
+/* A random floating point number, often one that's hard to get right
+ * or isn't one at all. */
+static size_t MakeFlt(char *Buff)
+{ /* MakeFlt() */
+  static const char *const Specials[] =
+  {
+    "inf", "-INF", "Infinity", "+infinity", "infin", "nan", "-NaN",
+    "nan(123)", "nan(", "nan()", "0x1p-1074", "0x1.fffffffffffffp1023",
+    "0x", "0x.p1", "0x1p", "1e-400", "1e400", "-1e-400",
+    "2.4703282292062328e-324", "2.4703282292062327e-324",
+    "4.9406564584124654e-324", "2.2250738585072011e-308",
+    "2.2250738585072014e-308", "1.7976931348623158e308",
+    "1.7976931348623159e308", "7.0064923216240854e-46",
+    "1.4012984643248171e-45", "3.4028235677973366e38",
+    "3.4028235677973367e38", "1.17549435e-38", "9007199254740993",
+    "0.1", "-0", "+0.0e0", ".", "-.", ".e1", "e5", "1e", "1e+", "1e-",
+    "1.", ".5", "+", "-", "", " 1", "1 ", "1,5", "1..2",
+    "00000000000000000000000000001", "1e99999999999999999999",
+    "1e-99999999999999999999", "123456789012345678901234567890e-10"
+  };
+  static const char *const Fmts[] = { "%.*e", "%.*E", "%.*g", "%.*a",
+                                      "%.*f" };
+  static const char *const Signs[] = { "", "+", "-" };
+  static const char Junk[] = " .e+-x";
+  const char *Fmt;
+  size_t Pos = 0, I;
+  double Val;
+
+  switch (Rand() % 8)
+  { /* switch */
+  case 0:
+    strcpy(Buff, RAND_PICK(Specials));
+    return strlen(Buff);
+  case 1:
+  case 2:
+  case 3:
+    Val = RandDouble();
+    Fmt = RAND_PICK(Fmts);
+    if (Fmt[3] == 'f' && !(fabs(Val) < 1e30))
+      Fmt = "%.*e";
+    if (Rand() % 4 == 0)
+      Pos = (size_t) sprintf(Buff, "%.9g", (float) Val);
+    else
+      Pos = (size_t) sprintf(Buff, Fmt,
+                             (Rand() & 1 ? 17 : (int) RandRange(0, 20)),
+                             Val);
+    break;
+  default:
+    if (Rand() % 4 == 0)
+      Buff[Pos++] = '-';
+    else if (Rand() % 16 == 0)
+      Buff[Pos++] = '+';
+    for (I = (Rand() % 8 == 0 ? RandRange(0, 60) : RandRange(0, 10));
+         I > 0; --I)
+      Buff[Pos++] = (char) ('0' + Rand() % 10);
+    if (Rand() % 3 != 0)
+    { /* Fraction. */
+      Buff[Pos++] = '.';
+      for (I = (Rand() % 8 == 0 ? RandRange(0, 60) : RandRange(0, 10));
+           I > 0; --I)
+        Buff[Pos++] = (char) ('0' + Rand() % 10);
+    } /* Fraction. */
+    if (Rand() & 1)
+      Pos += (size_t) sprintf(&Buff[Pos], "%c%s%d",
+                              (Rand() & 1 ? 'e' : 'E'),
+                              RAND_PICK(Signs),
+                              (int) (Rand() % 4 == 0 ? RandRange(0, 400)
+                                     : RandRange(0, 30)));
+    break;
+  } /* switch */
+
+  if (Pos > 0 && Rand() % 50 == 0)
+    Buff[Rand() % Pos] = Junk[Rand() % (sizeof(Junk) - 1)];
+  if (Rand() % 30 == 0)
+    Buff[Pos++] = Junk[Rand() % (sizeof(Junk) - 1)];
+  Buff[Pos] = '\0';
+
+  return Pos;
+} /* MakeFlt() */
+
+/* Wrappers with the same interface for every integer type.  (The ones
+ * for 'intmax_t' and 'uintmax_t' have no 'strtoX()'.) */
+#define CHECK_INT_FN(Name, Type)                                            \
+  static int IntFn##Name(const char *Str, size_t Len, int Base,             \
+                         uintmax_t *Val)                                    \
+  { /* IntFn##Name() */                                                     \
+    Type NewVal = (Type) CHECK_SENTINEL;                                    \
+    int ErrNo;                                                              \
+                                                                            \
+    ErrNo = (Len == SIZE_MAX ? StrTo##Name(Str, Base, &NewVal)              \
+             : StrNTo##Name(Str, Len, Base, &NewVal));                      \
+    *Val = (uintmax_t) NewVal;                                              \
+    return (ErrNo != 0 && NewVal != (Type) CHECK_SENTINEL ? -1 : ErrNo);    \
+  } /* IntFn##Name() */
+#define CHECK_STRTO_FN(Name, Func)                                          \
+  static uintmax_t StrToFn##Name(const char *Str, char **End, int Base)     \
+  { /* StrToFn##Name() */                                                   \
+    return (uintmax_t) Func(Str, End, Base);                                \
+  } /* StrToFn##Name() */
+
+CHECK_INT_FN(I8, int8_t)
+CHECK_INT_FN(UI8, uint8_t)
+CHECK_INT_FN(I16, int16_t)
+CHECK_INT_FN(UI16, uint16_t)
+CHECK_INT_FN(I32, int32_t)
+CHECK_INT_FN(UI32, uint32_t)
+CHECK_INT_FN(I64, int64_t)
+CHECK_INT_FN(UI64, uint64_t)
+CHECK_INT_FN(IMax, intmax_t)
+CHECK_INT_FN(UMax, uintmax_t)
+CHECK_STRTO_FN(I8, strtoi8)
+CHECK_STRTO_FN(UI8, strtoui8)
+CHECK_STRTO_FN(I16, strtoi16)
+CHECK_STRTO_FN(UI16, strtoui16)
+CHECK_STRTO_FN(I32, strtoi32)
+CHECK_STRTO_FN(UI32, strtoui32)
+CHECK_STRTO_FN(I64, strtoi64)
+CHECK_STRTO_FN(UI64, strtoui64)
+
+static const CheckInt_t Ints[] =
+{
+  { "I8", IntFnI8, StrToFnI8, true, INT8_MIN, INT8_MAX },
+  { "UI8", IntFnUI8, StrToFnUI8, false, 0, UINT8_MAX },
+  { "I16", IntFnI16, StrToFnI16, true, INT16_MIN, INT16_MAX },
+  { "UI16", IntFnUI16, StrToFnUI16, false, 0, UINT16_MAX },
+  { "I32", IntFnI32, StrToFnI32, true, INT32_MIN, INT32_MAX },
+  { "UI32", IntFnUI32, StrToFnUI32, false, 0, UINT32_MAX },
+  { "I64", IntFnI64, StrToFnI64, true, INT64_MIN, INT64_MAX },
+  { "UI64", IntFnUI64, StrToFnUI64, false, 0, UINT64_MAX },
+  { "IMax", IntFnIMax, NULL, true, INTMAX_MIN, INTMAX_MAX },
+  { "UMax", IntFnUMax, NULL, false, 0, UINTMAX_MAX }
+};
+
+/* What 'StrNToX()' should do, following 'StrToX.h' to the letter, with
+ * 'strtoimax()' or 'strtoumax()' doing the actual conversion. */
+static int RefInt(const char *Str, size_t Len, int Base,
+                  const CheckInt_t *Type, uintmax_t *Val)
+{ /* RefInt() */
+  char Copy[CHECK_STR_SIZE], *End;
+  intmax_t SVal;
+  uintmax_t UVal;
+  int ErrNo;
+
+  if (Len == 0 || *Str == '\0' || isspace((unsigned char) *Str))
+    return EINVAL;
+  if (Base != 0 && (Base < 2 || Base > 36))
+    return EDOM;
+  if (!Type->Signed && *Str == '-')
+    return ERANGE;
+  if (memchr(Str, '\0', Len) != NULL)
+    return EINVAL;
+
+  memcpy(Copy, Str, Len);
+  Copy[Len] = '\0';
+  errno = 0;
+  if (Type->Signed)
+  { /* Signed. */
+    SVal = strtoimax(Copy, &End, Base);
+    ErrNo = errno;
+    if (End == Copy || *End != '\0')
+      return EINVAL;
+    if (ErrNo == ERANGE || SVal < Type->Min || SVal > (intmax_t) Type->Max)
+      return ERANGE;
+    *Val = (uintmax_t) SVal;
+  } /* Signed. */
+  else
+  { /* Unsigned. */
+    UVal = strtoumax(Copy, &End, Base);
+    ErrNo = errno;
+    if (End == Copy || *End != '\0')
+      return EINVAL;
+    if (ErrNo == ERANGE || UVal > Type->Max)
+      return ERANGE;
+    *Val = UVal;
+  } /* Unsigned. */
+
+  return 0;
+} /* RefInt() */
+
+/* What 'strtoX()' should do: what 'strtol()' or 'strtoul()' would for
+ * a type with the range of 'Type'. */
+static uintmax_t RefStrTo(const char *Str, char **End, int Base,
+                          const CheckInt_t *Type, int *ErrNo)
+{ /* RefStrTo() */
+  const char *Src;
+  intmax_t SVal;
+  uintmax_t UVal, Mag;
+  bool Neg;
+
+  errno = 0;
+  if (Type->Signed)
+  { /* Signed. */
+    SVal = strtoimax(Str, End, Base);
+    *ErrNo = errno;
+    if (SVal < Type->Min)
+    { /* Too small. */
+      *ErrNo = ERANGE;
+      SVal = Type->Min;
+    } /* Too small. */
+    else if (SVal > (intmax_t) Type->Max)
+    { /* Too big. */
+      *ErrNo = ERANGE;
+      SVal = (intmax_t) Type->Max;
+    } /* Too big. */
+    return (uintmax_t) SVal;
+  } /* Signed. */
+
+  UVal = strtoumax(Str, End, Base);
+  if ((*ErrNo = errno) == ERANGE)
+    return Type->Max;
+  for (Src = Str; isspace((unsigned char) *Src); ++Src)
+    ;
+  Neg = (*End != Str && *Src == '-');
+  Mag = (Neg ? -UVal : UVal);
+  if (Mag > Type->Max)
+  { /* Too big. */
+    *ErrNo = ERANGE;
+    return Type->Max;
+  } /* Too big. */
+  return (Neg ? -Mag & Type->Max : Mag);
+} /* RefStrTo() */
+
+static int RandBase(void)
+{ /* RandBase() */
+  static const int Bases[] = { 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 0, 0,
+                               16, 16, 16, 8, 2, 36, -1, 1, 37 };
+
+  return (Rand() % 20 == 0 ? (int) RandRange(2, 36) : RAND_PICK(Bases));
+} /* RandBase() */
+
+static uint64_t CheckStrToInt(uint64_t Count)
+{ /* CheckStrToInt() */
+  char Str[CHECK_STR_SIZE], *NCopy, *CCopy, *End, *WantEnd;
+  int Base, ErrNo, WantErrNo;
+  uintmax_t Val, WantVal;
+  const CheckInt_t *Type;
+  size_t Len, CLen, I;
+  uint64_t N;
+  bool Pad;
+
+  for (N = 0; N < Count; ++N)
+  { /* Each case. */
+    Base = RandBase();
+    Len = MakeInt(Str, Base);
+    if (Len > 1 && Rand() % 50 == 0)
+      Str[Rand() % Len] = '\0';
+    Pad = (Rand() & 1);
+    CLen = strnlen(Str, Len);
+    if ((NCopy = CopyField(Str, Len, Pad)) == NULL
+        || (CCopy = CopyField(Str, CLen + 1, false)) == NULL)
+    { /* Error. */
+      Fail("%s", StrError(errno));
+      free(NCopy);
+      break;
+    } /* Error. */
+    CCopy[CLen] = '\0';
+
+    for (I = 0; I < sizeof(Ints) / sizeof(Ints[0]); ++I)
+    { /* Each type. */
+      Type = &Ints[I];
+
+      WantVal = Val = 0;
+      ErrNo = Type->Fn(NCopy, Len, Base, &Val);
+      WantErrNo = RefInt(NCopy, Len, Base, Type, &WantVal);
+      if (ErrNo != WantErrNo || (ErrNo == 0 && Val != WantVal))
+        Fail("StrNTo%s(%s, %zu, %d): want %d %#jx, got %d %#jx.",
+             Type->Name, Show(NCopy, Len), Len, Base, WantErrNo, WantVal,
+             ErrNo, Val);
+
+      WantVal = Val = 0;
+      ErrNo = Type->Fn(CCopy, SIZE_MAX, Base, &Val);
+      WantErrNo = RefInt(CCopy, CLen, Base, Type, &WantVal);
+      if (ErrNo != WantErrNo || (ErrNo == 0 && Val != WantVal))
+        Fail("StrTo%s(%s, %d): want %d %#jx, got %d %#jx.", Type->Name,
+             Show(CCopy, CLen), Base, WantErrNo, WantVal, ErrNo, Val);
+
+      if (Type->StrTo == NULL || (Base != 0 && (Base < 2 || Base > 36)))
+        continue;
+      WantVal = RefStrTo(CCopy, &WantEnd, Base, Type, &WantErrNo);
+      errno = 0;
+      Val = Type->StrTo(CCopy, &End, Base);
+      ErrNo = errno;
+      if (Val != WantVal || End != WantEnd || ErrNo != WantErrNo)
+        Fail("strto%c%s(%s, %d): want %#jx, %td, %d, got %#jx, %td, %d.",
+             tolower(Type->Name[0]), &Type->Name[1], Show(CCopy, CLen),
+             Base, WantVal, WantEnd - CCopy, WantErrNo, Val, End - CCopy,
+             ErrNo);
+    } /* Each type. */
+
+    free(CCopy);
+    free(NCopy);
+  } /* Each case. */
+
+  return Count;
+} /* CheckStrToInt() */
+
+/* As for the integers, but the result is a 'long double', which holds
+ * any of the types exactly. */
+static int FltFnF(const char *Str, size_t Len, long double *Val)
+{ /* FltFnF() */
+  float NewVal = (float) CHECK_SENTINEL;
+  int ErrNo;
+
+  ErrNo = (Len == SIZE_MAX ? StrToF(Str, &NewVal)
+           : StrNToF(Str, Len, &NewVal));
+  *Val = NewVal;
+  return (ErrNo != 0 && NewVal != (float) CHECK_SENTINEL ? -1 : ErrNo);
+} /* FltFnF() */
+
+static int FltFnD(const char *Str, size_t Len, long double *Val)
+{ /* FltFnD() */
+  double NewVal = (double) CHECK_SENTINEL;
+  int ErrNo;
+
+  ErrNo = (Len == SIZE_MAX ? StrToD(Str, &NewVal)
+           : StrNToD(Str, Len, &NewVal));
+  *Val = NewVal;
+  return (ErrNo != 0 && NewVal != (double) CHECK_SENTINEL ? -1 : ErrNo);
+} /* FltFnD() */
+
+static int FltFnLD(const char *Str, size_t Len, long double *Val)
+{ /* FltFnLD() */
+  long double NewVal = (long double) CHECK_SENTINEL;
+  int ErrNo;
+
+  ErrNo = (Len == SIZE_MAX ? StrToLD(Str, &NewVal)
+           : StrNToLD(Str, Len, &NewVal));
+  *Val = NewVal;
+  return (ErrNo != 0 && NewVal != (long double) CHECK_SENTINEL ? -1 : ErrNo);
+} /* FltFnLD() */
+
+static const CheckFlt_t Flts[] =
+{
+  { "F", FltFnF, 'f' },
+  { "D", FltFnD, 'd' },
+  { "LD", FltFnLD, 'L' }
+};
+
+/* What 'StrNToX()' should do, with 'strtof()', 'strtod()', or
+ * 'strtold()' doing the actual conversion. */
+static int RefFlt(const char *Str, size_t Len, int Type, long double *Val)
+{ /* RefFlt() */
+  char Copy[CHECK_STR_SIZE], *End;
+  int ErrNo;
+
+  if (Len == 0 || *Str == '\0' || isspace((unsigned char) *Str)
+      || memchr(Str, '\0', Len) != NULL)
+    return EINVAL;
+
+  memcpy(Copy, Str, Len);
+  Copy[Len] = '\0';
+  errno = 0;
+  if (Type == 'f')
+    *Val = strtof(Copy, &End);
+  else if (Type == 'd')
+    *Val = strtod(Copy, &End);
+  else
+    *Val = strtold(Copy, &End);
+  ErrNo = errno;
+
+  return (*End != '\0' ? EINVAL : ErrNo);
+} /* RefFlt() */
+
+/* The same value, counting all NaNs of the same sign as the same. */
+static bool SameFlt(long double A, long double B)
+{ /* SameFlt() */
+  if (signbit(A) != signbit(B))
+    return false;
+  return (isnan(A) ? isnan(B) : A == B);
+} /* SameFlt() */
+
+static uint64_t CheckStrToFlt(uint64_t Count)
+{ /* CheckStrToFlt() */
+  char Str[CHECK_STR_SIZE], *NCopy, *CCopy;
+  long double Val, WantVal;
+  int ErrNo, WantErrNo;
+  const CheckFlt_t *Type;
+  size_t Len, CLen, I;
+  uint64_t N;
+
+  for (N = 0; N < Count; ++N)
+  { /* Each case. */
+    Len = MakeFlt(Str);
+    if (Len > 1 && Rand() % 50 == 0)
+      Str[Rand() % Len] = '\0';
+    CLen = strnlen(Str, Len);
+    if ((NCopy = CopyField(Str, Len, Rand() & 1)) == NULL
+        || (CCopy = CopyField(Str, CLen + 1, false)) == NULL)
+    { /* Error. */
+      Fail("%s", StrError(errno));
+      free(NCopy);
+      break;
+    } /* Error. */
+    CCopy[CLen] = '\0';
+
+    for (I = 0; I < sizeof(Flts) / sizeof(Flts[0]); ++I)
+    { /* Each type. */
+      Type = &Flts[I];
+
+      WantVal = Val = 0;
+      ErrNo = Type->Fn(NCopy, Len, &Val);
+      WantErrNo = RefFlt(NCopy, Len, Type->Type, &WantVal);
+      if (ErrNo != WantErrNo || (ErrNo == 0 && !SameFlt(Val, WantVal)))
+        Fail("StrNTo%s(%s, %zu): want %d %La, got %d %La.", Type->Name,
+             Show(NCopy, Len), Len, WantErrNo, WantVal, ErrNo, Val);
+
+      WantVal = Val = 0;
+      ErrNo = Type->Fn(CCopy, SIZE_MAX, &Val);
+      WantErrNo = RefFlt(CCopy, CLen, Type->Type, &WantVal);
+      if (ErrNo != WantErrNo || (ErrNo == 0 && !SameFlt(Val, WantVal)))
+        Fail("StrTo%s(%s): want %d %La, got %d %La.", Type->Name,
+             Show(CCopy, CLen), WantErrNo, WantVal, ErrNo, Val);
+    } /* Each type. */
+
+    free(CCopy);
+    free(NCopy);
+  } /* Each case. */
+
+  return Count;
+} /* CheckStrToFlt() */
+
+/* 'StrNToI64Delim()' or 'StrNToDDelim()', with 'Vals' as 8 bytes a
+ * value. */
+static int BatchDelim(bool Flt, const char *Buff, size_t Len, char Delim,
+                      int Base, char *Vals, uint64_t *Errs, size_t *NVals,
+                      const char **End)
+{ /* BatchDelim() */
+  if (Flt)
+    return StrNToDDelim(Buff, Len, Delim, (double *) (void *) Vals, Errs,
+                        NVals, End);
+  return StrNToI64Delim(Buff, Len, Delim, Base, (int64_t *) (void *) Vals,
+                        Errs, NVals, End);
+} /* BatchDelim() */
+
+static int BatchFields(bool Flt, const StrField_t *Fields, size_t NFields,
+                       int Base, char *Vals, uint64_t *Errs)
+{ /* BatchFields() */
+  if (Flt)
+    return StrNToDFields(Fields, NFields, (double *) (void *) Vals, Errs);
+  return StrNToI64Fields(Fields, NFields, Base, (int64_t *) (void *) Vals,
+                         Errs);
+} /* BatchFields() */
+
+static int BatchPar(bool Flt, const char *Buff, size_t Len, char Delim,
+                    int Base, unsigned NThreads, char **Vals,
+                    uint64_t **Errs, size_t *NVals)
+{ /* BatchPar() */
+  if (Flt)
+    return StrNToDDelimPar(Buff, Len, Delim, NThreads, (double **) Vals,
+                           Errs, NVals);
+  return StrNToI64DelimPar(Buff, Len, Delim, Base, NThreads,
+                           (int64_t **) Vals, Errs, NVals);
+} /* BatchPar() */
+
+/* Check the 'NVals' results in 'Vals' and 'Errs' of a batch conversion
+ * of 'Name' against the field by field ones.  'Full' says that the
+ * values for failed fields, and the unused bits of the last word of
+ * 'Errs', must be as they were before. */
+static void CheckBatchVals(const char *Name, const char *Vals,
+                           const uint64_t *Errs, size_t NVals,
+                           const char *WantVals, const int *WantErrNos,
+                           bool Full)
+{ /* CheckBatchVals() */
+  uint64_t Sentinel = CHECK_SENTINEL;
+  size_t I;
+
+  for (I = 0; I < NVals; ++I)
+  { /* Each value. */
+    if (StrToXFailed(Errs, I) != (WantErrNos[I] != 0))
+    { /* Wrong error bit. */
+      Fail("%s: field %zu: want error %d, got bit %d.", Name, I,
+           WantErrNos[I], StrToXFailed(Errs, I));
+      return;
+    } /* Wrong error bit. */
+    if (WantErrNos[I] == 0
+        ? memcmp(&Vals[8 * I], &WantVals[8 * I], 8) != 0
+        : Full && memcmp(&Vals[8 * I], &Sentinel, 8) != 0)
+    { /* Wrong value. */
+      Fail("%s: field %zu: wrong value.", Name, I);
+      return;
+    } /* Wrong value. */
+  } /* Each value. */
+
+  if (Full && NVals % 64 != 0 && Errs[NVals / 64] >> (NVals % 64) != 0)
+    Fail("%s: unused error bits set after %zu fields.", Name, NVals);
+} /* CheckBatchVals() */
+
+static uint64_t CheckBatch(uint64_t Count)
+{ /* CheckBatch() */
+  static const char Delims[] = "\n\n\n\n,,| e5-";
+  static const int Bases[] = { 10, 10, 10, 10, 0, 16, 2, 1, 37 };
+  char Field[CHECK_STR_SIZE], *Buff = NULL, *Copy, *Vals = NULL;
+  char *WantVals = NULL, *ParVals;
+  const char *End, *Next, *WantEnd;
+  size_t NFields, MaxFields = 0, MaxVals = 0, Len, Pos, NF, Cap, NVals, I;
+  uint64_t *Errs = NULL, *ParErrs, Sentinel = CHECK_SENTINEL, N;
+  int *WantErrNos = NULL, Base, ErrNo, WantErrNo, Want;
+  StrField_t *Fields = NULL;
+  unsigned NThreads;
+  char Delim, Name[64];
+  double DVal;
+  int64_t IVal;
+  bool Flt;
+
+  for (N = 0; N < Count; ++N)
+  { /* Each case. */
+    Flt = (Rand() & 1);
+    Delim = Delims[Rand() % (sizeof(Delims) - 1)];
+    Base = (Flt ? 10 : RAND_PICK(Bases));
+    if (N % 25000 == 0)
+      NFields = CHECK_BIG_COLUMN;
+    else
+      NFields = (Rand() % 50 == 0 ? RandRange(0, 1000) : RandRange(0, 20));
+
+    if (NFields > MaxFields)
+    { /* Need more room. */
+      MaxFields = NFields;
+      free(Buff);
+      if ((Buff = malloc(MaxFields * CHECK_STR_SIZE + 1)) == NULL)
+      { /* Error. */
+        Fail("%s", StrError(errno));
+        break;
+      } /* Error. */
+    } /* Need more room. */
+
+    /* The column, with or without a last 'Delim'. */
+    for (Len = 0, I = 0; I < NFields; ++I)
+    { /* Each field. */
+      Pos = (Flt ? MakeFlt(Field) : MakeInt(Field, Base));
+      memcpy(&Buff[Len], Field, Pos);
+      Len += Pos;
+      if (I + 1 < NFields || Rand() & 1)
+        Buff[Len++] = Delim;
+    } /* Each field. */
+    if ((Copy = CopyField(Buff, Len, false)) == NULL)
+    { /* Error. */
+      Fail("%s", StrError(errno));
+      break;
+    } /* Error. */
+
+    /* The fields, which aren't always those made (a field can have
+     * 'Delim' in it), and their values. */
+    for (NF = 0, Pos = 0; Pos < Len; ++NF)
+    { /* Count them. */
+      Next = memchr(&Copy[Pos], Delim, Len - Pos);
+      Pos = (Next != NULL ? (size_t) (Next - Copy) + 1 : Len);
+    } /* Count them. */
+    if (NF + 4 > MaxVals)
+    { /* Need more room. */
+      MaxVals = NF + 4;
+      free(Vals);
+      free(WantVals);
+      free(WantErrNos);
+      free(Errs);
+      free(Fields);
+      Vals = malloc(8 * MaxVals);
+      WantVals = malloc(8 * MaxVals);
+      WantErrNos = malloc(sizeof(int) * MaxVals);
+      Errs = malloc(sizeof(uint64_t) * (STRTOX_ERR_WORDS(MaxVals) + 1));
+      Fields = malloc(sizeof(StrField_t) * MaxVals);
+      if (Vals == NULL || WantVals == NULL || WantErrNos == NULL
+          || Errs == NULL || Fields == NULL)
+      { /* Error. */
+        Fail("%s", StrError(errno));
+        free(Copy);
+        break;
+      } /* Error. */
+    } /* Need more room. */
+    for (NF = 0, Pos = 0; Pos < Len; ++NF)
+    { /* Each field. */
+      Next = memchr(&Copy[Pos], Delim, Len - Pos);
+      Fields[NF].Ptr = &Copy[Pos];
+      Fields[NF].Len = (Next != NULL ? (size_t) (Next - &Copy[Pos])
+                        : Len - Pos);
+      Pos += Fields[NF].Len + (Next != NULL);
+      if (Flt)
+      { /* double. */
+        if ((WantErrNos[NF] = StrNToD(Fields[NF].Ptr, Fields[NF].Len,
+                                      &DVal)) == 0)
+          memcpy(&WantVals[8 * NF], &DVal, 8);
+      } /* double. */
+      else if ((WantErrNos[NF] = StrNToI64(Fields[NF].Ptr, Fields[NF].Len,
+                                           Base, &IVal)) == 0)
+        memcpy(&WantVals[8 * NF], &IVal, 8);
+    } /* Each field. */
+    WantErrNo = (Base != 0 && (Base < 2 || Base > 36) ? EDOM : 0);
+
+    /* All of it, or only room for some of it. */
+    Cap = (Rand() % 4 == 0 ? RandRange(0, NF) : NF + RandRange(0, 3));
+    for (I = 0; I < Cap + 1; ++I)
+      memcpy(&Vals[8 * I], &Sentinel, 8);
+    memset(Errs, 0xFF, sizeof(uint64_t) * (STRTOX_ERR_WORDS(Cap) + 1));
+    NVals = Cap;
+    End = NULL;
+    ErrNo = BatchDelim(Flt, Copy, Len, Delim, Base, Vals, Errs, &NVals, &End);
+    snprintf(Name, sizeof(Name), "StrNTo%sDelim(%zu fields, '%c', %d)",
+             (Flt ? "D" : "I64"), NF, (Delim == '\n' ? 'n' : Delim), Base);
+    Want = (WantErrNo != 0 ? WantErrNo : Cap < NF ? ENOBUFS : 0);
+    WantEnd = (Cap < NF ? Fields[Cap].Ptr : &Copy[Len]);
+    if (ErrNo != Want)
+      Fail("%s: want %d, got %d.", Name, Want, ErrNo);
+    else if (ErrNo != EDOM && (NVals != (Cap < NF ? Cap : NF)
+                               || End != WantEnd))
+      Fail("%s: want %zu values, end %td, got %zu, %td.", Name,
+           (Cap < NF ? Cap : NF), WantEnd - Copy, NVals, End - Copy);
+    else if (ErrNo != EDOM)
+    { /* Check the values. */
+      CheckBatchVals(Name, Vals, Errs, NVals, WantVals, WantErrNos, true);
+      if (memcmp(&Vals[8 * NVals], &Sentinel, 8) != 0)
+        Fail("%s: wrote past %zu values.", Name, NVals);
+    } /* Check the values. */
+
+    /* The same fields one by one. */
+    for (I = 0; I < NF; ++I)
+      memcpy(&Vals[8 * I], &Sentinel, 8);
+    memset(Errs, 0xFF, sizeof(uint64_t) * (STRTOX_ERR_WORDS(NF) + 1));
+    ErrNo = BatchFields(Flt, Fields, NF, Base, Vals, Errs);
+    snprintf(Name, sizeof(Name), "StrNTo%sFields(%zu fields, %d)",
+             (Flt ? "D" : "I64"), NF, Base);
+    if (ErrNo != WantErrNo)
+      Fail("%s: want %d, got %d.", Name, WantErrNo, ErrNo);
+    else if (ErrNo == 0)
+      CheckBatchVals(Name, Vals, Errs, NF, WantVals, WantErrNos, true);
+
+    /* And with threads, for a big column (and the odd small one). */
+    if (NFields == CHECK_BIG_COLUMN || Rand() % 10 == 0)
+    { /* Parallel. */
+      NThreads = (unsigned) RandRange(0, 8);
+      ParVals = NULL;
+      ParErrs = NULL;
+      NVals = SIZE_MAX;
+      ErrNo = BatchPar(Flt, Copy, Len, Delim, Base, NThreads, &ParVals,
+                       &ParErrs, &NVals);
+      snprintf(Name, sizeof(Name), "StrNTo%sDelimPar(%zu fields, %u, %d)",
+               (Flt ? "D" : "I64"), NF, NThreads, Base);
+      if (ErrNo != WantErrNo)
+        Fail("%s: want %d, got %d.", Name, WantErrNo, ErrNo);
+      else if (ErrNo == 0 && NVals != NF)
+        Fail("%s: want %zu values, got %zu.", Name, NF, NVals);
+      else if (ErrNo == 0 && NF == 0 && (ParVals != NULL || ParErrs != NULL))
+        Fail("%s: no fields but results allocated.", Name);
+      else if (ErrNo == 0 && NF > 0)
+        CheckBatchVals(Name, ParVals, ParErrs, NF, WantVals, WantErrNos,
+                       false);
+      free(ParErrs);
+      free(ParVals);
+    } /* Parallel. */
+
+    free(Copy);
+  } /* Each case. */
+
+  free(Fields);
+  free(Errs);
+  free(WantErrNos);
+  free(WantVals);
+  free(Vals);
+  free(Buff);
+
+  return N;
+} /* CheckBatch() */
+
+/* 'Val' in 'Base', the slow, obvious, way. */
+static size_t RefUMaxToStr(uintmax_t Val, int Base, char *Buff)
+{ /* RefUMaxToStr() */
+  static const char Digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+  char Rev[XTOSTR_BUFF_SIZE];
+  size_t Len = 0, I = 0;
+
+  do
+  { /* Each digit. */
+    Rev[I++] = Digits[Val % (unsigned) Base];
+    Val /= (unsigned) Base;
+  } while (Val != 0);
+  while (I > 0)
+    Buff[Len++] = Rev[--I];
+  Buff[Len] = '\0';
+
+  return Len;
+} /* RefUMaxToStr() */
+
+/* The number 'Neg' 0.'Digits' * 10^('Exp' + 1) (so 'Exp' is the
+ * exponent of the first digit), as '%g' would write it with a
+ * precision of 17 and no trailing zeros.  'Digits' has no leading or
+ * trailing zeros. */
+static void Layout(char *Buff, bool Neg, const char *Digits, int Exp)
+{ /* Layout() */
+  size_t NDigits = strlen(Digits), Pos = 0;
+  int I;
+
+  if (Neg)
+    Buff[Pos++] = '-';
+  if (Exp < -4 || Exp >= 17)
+  { /* Scientific. */
+    Buff[Pos++] = Digits[0];
+    if (NDigits > 1)
+      Pos += (size_t) sprintf(&Buff[Pos], ".%s", &Digits[1]);
+    sprintf(&Buff[Pos], "e%c%02d", (Exp < 0 ? '-' : '+'),
+            (Exp < 0 ? -Exp : Exp));
+  } /* Scientific. */
+  else if (Exp < 0)
+  { /* All after the point. */
+    Buff[Pos++] = '0';
+    Buff[Pos++] = '.';
+    for (I = -Exp - 1; I > 0; --I)
+      Buff[Pos++] = '0';
+    strcpy(&Buff[Pos], Digits);
+  } /* All after the point. */
+  else if (NDigits <= (size_t) Exp + 1)
+  { /* An integer. */
+    memcpy(&Buff[Pos], Digits, NDigits);
+    Pos += NDigits;
+    for (I = Exp + 1 - (int) NDigits; I > 0; --I)
+      Buff[Pos++] = '0';
+    Buff[Pos] = '\0';
+  } /* An integer. */
+  else
+  { /* Some either side of the point. */
+    memcpy(&Buff[Pos], Digits, (size_t) Exp + 1);
+    Pos += (size_t) Exp + 1;
+    Buff[Pos++] = '.';
+    strcpy(&Buff[Pos], &Digits[Exp + 1]);
+  } /* Some either side of the point. */
+} /* Layout() */
+
+/* Split a number written by 'DToStr()', '%e', or anything in between,
+ * into its sign, significant digits, and the exponent of the first of
+ * them, as for 'Layout()'.  Returns the number of digits, 0 for zero
+ * (or something that isn't a number). */
+static size_t SplitDigits(const char *Str, bool *Neg, char *Digits,
+                          int *Exp)
+{ /* SplitDigits() */
+  size_t NDigits = 0;
+  int Point = -1, Lead = 0, Pos;
+  bool Seen = false;
+
+  *Neg = (*Str == '-');
+  Str += *Neg;
+  for (Pos = 0; isdigit((unsigned char) *Str) || *Str == '.'; ++Str)
+  { /* Each character. */
+    if (*Str == '.')
+    { /* The point. */
+      Point = Pos;
+      continue;
+    } /* The point. */
+    if (!Seen && *Str == '0')
+      ++Lead;
+    else
+    { /* Significant. */
+      Seen = true;
+      Digits[NDigits++] = *Str;
+    } /* Significant. */
+    ++Pos;
+  } /* Each character. */
+  if (Point < 0)
+    Point = Pos;
+
+  while (NDigits > 0 && Digits[NDigits - 1] == '0')
+    --NDigits;
+  Digits[NDigits] = '\0';
+  *Exp = Point - Lead - 1 + (*Str == 'e' ? atoi(&Str[1]) : 0);
+
+  return NDigits;
+} /* SplitDigits() */
+
+/* Check 'Str', from 'DToStr()' or 'FToStr()' (as 'Type', 'd' or 'f'),
+ * for 'Val'. */
+static void CheckFltToStr(const char *Func, int Type, double Val,
+                          const char *Str)
+{ /* CheckFltToStr() */
+  char Buff[64], Want[64], Digs[32], WantDigs[32];
+  size_t NDigits, MinDigits;
+  double Back;
+  bool Neg;
+  int Exp;
+
+  if (isnan(Val) || isinf(Val) || Val == 0)
+  { /* Special. */
+    snprintf(Want, sizeof(Want), "%s%s", (signbit(Val) ? "-" : ""),
+             (isnan(Val) ? "nan" : isinf(Val) ? "inf" : "0"));
+    if (strcmp(Str, Want) != 0)
+      Fail("%s(%a): want \"%s\", got %s.", Func, Val, Want,
+           Show(Str, strlen(Str)));
+    return;
+  } /* Special. */
+
+  Back = (Type == 'f' ? strtof(Str, NULL) : strtod(Str, NULL));
+  if (memcmp(&Back, &Val, sizeof(Val)) != 0)
+  { /* Doesn't read back. */
+    Fail("%s(%a): got %s, which reads back as %a.", Func, Val,
+         Show(Str, strlen(Str)), Back);
+    return;
+  } /* Doesn't read back. */
+
+  /* The fewest digits '%e' needs to read back. */
+  for (MinDigits = 1; MinDigits < 17; ++MinDigits)
+  { /* Each precision. */
+    snprintf(Buff, sizeof(Buff), "%.*e", (int) MinDigits - 1, Val);
+    if ((Type == 'f' ? strtof(Buff, NULL) : strtod(Buff, NULL)) == Val)
+      break;
+  } /* Each precision. */
+  snprintf(Buff, sizeof(Buff), "%.*e", (int) MinDigits - 1, Val);
+  SplitDigits(Buff, &Neg, WantDigs, &Exp);
+  Layout(Want, Neg, WantDigs, Exp);
+
+  /* That, or, if there's a shorter one that '%e' doesn't find, that
+   * written the same way. */
+  if (strcmp(Str, Want) == 0)
+    return;
+  NDigits = SplitDigits(Str, &Neg, Digs, &Exp);
+  Layout(Buff, Neg, Digs, Exp);
+  if (NDigits >= MinDigits || strcmp(Buff, Str) != 0)
+    Fail("%s(%a): want \"%s\", got %s.", Func, Val, Want,
+         Show(Str, strlen(Str)));
+} /* CheckFltToStr() */
+
+static uint64_t CheckXToStr(uint64_t Count)
+{ /* CheckXToStr() */
+  char Buff[XTOSTR_BUFF_SIZE + 1], Want[XTOSTR_BUFF_SIZE + 1];
+  size_t Len, WantLen, Size;
+  int Base, ErrNo, WantErrNo;
+  uint64_t Bits, N;
+  double Val;
+  float FVal;
+
+  for (N = 0; N < Count; ++N)
+  { /* Each case. */
+    Bits = RandBits();
+    Base = (Rand() & 1 ? 10 : (int) RandRange(0, 37));
+    WantErrNo = (Base < 2 || Base > 36 ? EDOM : 0);
+    WantLen = (WantErrNo != 0 ? 0 : RefUMaxToStr(Bits, Base, Want));
+
+    /* Enough room, or just too little. */
+    Size = (WantErrNo == 0 && Rand() % 8 == 0 ? WantLen : sizeof(Buff));
+    WantErrNo = (WantErrNo != 0 ? WantErrNo : Size == WantLen ? ENOBUFS : 0);
+    Len = SIZE_MAX;
+    ErrNo = UMaxToStr(Bits, Base, Buff, Size, &Len);
+    if (ErrNo != WantErrNo
+        || (ErrNo == 0 ? Len != WantLen || strcmp(Buff, Want) != 0
+            : Len != SIZE_MAX || Buff[0] != '\0'))
+      Fail("UMaxToStr(%#" PRIx64 ", %d, %zu): want %d \"%s\", got %d %s.",
+           Bits, Base, Size, WantErrNo, (WantErrNo == 0 ? Want : ""), ErrNo,
+           Show(Buff, strlen(Buff)));
+
+    if (Base >= 2 && Base <= 36)
+    { /* Signed. */
+      if ((int64_t) Bits < 0)
+      { /* Negative. */
+        Want[0] = '-';
+        WantLen = RefUMaxToStr(-Bits, Base, &Want[1]) + 1;
+      } /* Negative. */
+      else
+        WantLen = RefUMaxToStr(Bits, Base, Want);
+      ErrNo = IMaxToStr((intmax_t) Bits, Base, Buff, sizeof(Buff), &Len);
+      if (ErrNo != 0 || Len != WantLen || strcmp(Buff, Want) != 0)
+        Fail("IMaxToStr(%" PRId64 ", %d): want \"%s\", got %d %s.",
+             (int64_t) Bits, Base, Want, ErrNo, Show(Buff, strlen(Buff)));
+    } /* Signed. */
+
+    Val = RandDouble();
+    if ((ErrNo = DToStr(Val, Buff, sizeof(Buff), &Len)) != 0
+        || Len != strlen(Buff))
+      Fail("DToStr(%a): failed, %d.", Val, ErrNo);
+    else
+      CheckFltToStr("DToStr", 'd', Val, Buff);
+
+    FVal = (Rand() & 1 ? (float) Val : (float) (Rand() >> 40) / 1024);
+    if ((ErrNo = FToStr(FVal, Buff, sizeof(Buff), &Len)) != 0
+        || Len != strlen(Buff))
+      Fail("FToStr(%a): failed, %d.", (double) FVal, ErrNo);
+    else
+      CheckFltToStr("FToStr", 'f', FVal, Buff);
+  } /* Each case. */
+
+  return Count;
+} /* CheckXToStr() */
+
+/* The keys, each ending with its index (except key 0, which is empty),
+ * some short, some too long for a short string, and some with a NUL in
+ * them. */
+static void MakeKeys(void)
+{ /* MakeKeys() */
+  size_t I;
+
+  KeyLens[0] = 0;
+  for (I = 1; I < CHECK_KEYS; ++I)
+  { /* Each key. */
+    switch (I % 3)
+    { /* switch */
+    case 0:
+      KeyLens[I] = (size_t) sprintf(Keys[I], "k%zu", I);
+      break;
+    case 1:
+      KeyLens[I] = (size_t) sprintf(Keys[I], "a key too long to be "
+                                    "short, %zu", I);
+      break;
+    default:
+      KeyLens[I] = (size_t) sprintf(Keys[I], "n.%zu", I);
+      Keys[I][1] = '\0';
+      break;
+    } /* switch */
+  } /* Each key. */
+} /* MakeKeys() */
+
+/* The index of a key, from its last digits. */
+static size_t KeyIndex(const char *Key, size_t Len)
+{ /* KeyIndex() */
+  size_t Pos = Len, Index = 0, Scale = 1;
+
+  while (Pos > 0 && isdigit((unsigned char) Key[Pos - 1]))
+  { /* Each digit. */
+    Index += (size_t) (Key[--Pos] - '0') * Scale;
+    Scale *= 10;
+  } /* Each digit. */
+
+  return Index;
+} /* KeyIndex() */
+
+static uint64_t CheckStrMap(uint64_t Count)
+{ /* CheckStrMap() */
+  static bool Present[CHECK_KEYS];
+  static uint64_t Vals[CHECK_KEYS];
+  const String_t *Key;
+  unsigned char *Val;
+  size_t ValSize, Pos, Index, Have = 0, I;
+  uint64_t N, Seen[STRTOX_ERR_WORDS(CHECK_KEYS)];
+  StrMap_t Map;
+  StrView_t View;
+  bool Added;
+  int Op;
+
+  ValSize = sizeof(uint64_t);
+  ConstructStrMap(&Map, ValSize, NULL);
+  memset(Present, 0, sizeof(Present));
+  for (N = 0; N < Count; ++N)
+  { /* Each case. */
+    if (N % 20000 == 19999)
+    { /* A new map, another way. */
+      DestroyStrMap(&Map);
+      ValSize = (Rand() & 1 ? sizeof(uint64_t) : 40);
+      ConstructStrMap(&Map, ValSize, (Rand() & 1 ? PoolAlloc() : NULL));
+      memset(Present, 0, sizeof(Present));
+      Have = 0;
+    } /* A new map, another way. */
+
+    Index = Rand() % CHECK_KEYS;
+    View = StrView(Keys[Index], KeyLens[Index]);
+    Op = (int) (Rand() % 1000);
+    if (Op < 400)
+    { /* Insert. */
+      if ((Val = StrMapInsert(&Map, View, &Added)) == NULL)
+        Fail("StrMapInsert(%s) failed.  %s.", Show(View.Ptr, View.Size),
+             StrError(errno));
+      else if (Added != !Present[Index])
+        Fail("StrMapInsert(%s): want Added %d, got %d.",
+             Show(View.Ptr, View.Size), !Present[Index], Added);
+      else if (Added)
+      { /* New. */
+        for (I = 0; I < ValSize && Val[I] == 0; ++I)
+          ;
+        if (I < ValSize)
+          Fail("StrMapInsert(%s): new value not zero.",
+               Show(View.Ptr, View.Size));
+        Present[Index] = true;
+        ++Have;
+        Vals[Index] = Rand();
+        memcpy(Val, &Vals[Index], sizeof(uint64_t));
+        memset(&Val[sizeof(uint64_t)], (int) Index, ValSize - sizeof(uint64_t));
+      } /* New. */
+      else if (memcmp(Val, &Vals[Index], sizeof(uint64_t)) != 0)
+        Fail("StrMapInsert(%s): wrong value.", Show(View.Ptr, View.Size));
+    } /* Insert. */
+    else if (Op < 750)
+    { /* Find. */
+      Val = StrMapFind(&Map, View);
+      if ((Val != NULL) != Present[Index])
+        Fail("StrMapFind(%s): want %s, got %s.", Show(View.Ptr, View.Size),
+             (Present[Index] ? "a value" : "NULL"),
+             (Val != NULL ? "a value" : "NULL"));
+      else if (Val != NULL
+               && (memcmp(Val, &Vals[Index], sizeof(uint64_t)) != 0
+                   || (ValSize > sizeof(uint64_t)
+                       && Val[ValSize - 1] != (unsigned char) Index)))
+        Fail("StrMapFind(%s): wrong value.", Show(View.Ptr, View.Size));
+    } /* Find. */
+    else if (Op < 995)
+    { /* Erase. */
+      if (StrMapErase(&Map, View) != Present[Index])
+        Fail("StrMapErase(%s): want %d.", Show(View.Ptr, View.Size),
+             Present[Index]);
+      if (Present[Index])
+        --Have;
+      Present[Index] = false;
+    } /* Erase. */
+    else if (Op < 999)
+    { /* Go through them all. */
+      memset(Seen, 0, sizeof(Seen));
+      for (Pos = 0, I = 0; StrMapNext(&Map, &Pos, &Key, (void **) &Val); ++I)
+      { /* Each key. */
+        Index = KeyIndex(Key->Ptr, Key->Size);
+        if (Index >= CHECK_KEYS || !Present[Index]
+            || Seen[Index / 64] & (UINT64_C(1) << (Index % 64))
+            || Key->Size != KeyLens[Index]
+            || memcmp(Key->Ptr, Keys[Index], Key->Size) != 0
+            || memcmp(Val, &Vals[Index], sizeof(uint64_t)) != 0)
+        { /* Wrong. */
+          Fail("StrMapNext(): unexpected key %s.",
+               Show(Key->Ptr, Key->Size));
+          break;
+        } /* Wrong. */
+        Seen[Index / 64] |= UINT64_C(1) << (Index % 64);
+      } /* Each key. */
+      if (I != Have)
+        Fail("StrMapNext(): want %zu keys, got %zu.", Have, I);
+    } /* Go through them all. */
+    else
+    { /* Clear. */
+      StrMapClear(&Map);
+      memset(Present, 0, sizeof(Present));
+      Have = 0;
+    } /* Clear. */
+
+    if (StrMapCount(&Map) != Have)
+    { /* Error. */
+      Fail("StrMapCount(): want %zu, got %zu.", Have, StrMapCount(&Map));
+      break;
+    } /* Error. */
+  } /* Each case. */
+  DestroyStrMap(&Map);
+
+  return N;
+} /* CheckStrMap() */
+
+/* Intern the keys, in a random order, as one of several threads doing
+ * so at once. */
+static void *InternThread(void *Arg)
+{ /* InternThread() */
+  CheckIntern_t *This = Arg;
+  const String_t *Str;
+  size_t Index, I;
+
+  for (I = 0; I < 4 * CHECK_KEYS; ++I)
+  { /* Each string. */
+    Index = RandNext(&This->Seed) % CHECK_KEYS;
+    Str = InternView(This->Intern, StrView(Keys[Index], KeyLens[Index]));
+    if (Str == NULL
+        || (This->Ptrs[Index] != NULL && Str != This->Ptrs[Index])
+        || Str->Size != KeyLens[Index]
+        || memcmp(Str->Ptr, Keys[Index], KeyLens[Index]) != 0)
+      ++This->Bad;
+    else
+      This->Ptrs[Index] = Str;
+  } /* Each string. */
+
+  return NULL;
+} /* InternThread() */
+
+static uint64_t CheckIntern(uint64_t Count)
+{ /* CheckIntern() */
+  static const String_t *Ptrs[CHECK_KEYS];
+  static CheckIntern_t Threads[CHECK_THREADS];
+  pthread_t Ids[CHECK_THREADS];
+  const String_t *Str, *First;
+  size_t Index, Have = 0, I;
+  Intern_t *Intern;
+  StrView_t View;
+  uint64_t N;
+  int T;
+
+  if ((Intern = NewIntern()) == NULL)
+  { /* Error. */
+    Fail("NewIntern() failed.  %s.", StrError(errno));
+    return 0;
+  } /* Error. */
+
+  memset(Ptrs, 0, sizeof(Ptrs));
+  for (N = 0; N < Count; ++N)
+  { /* Each case. */
+    if (N % 30000 == 29999)
+    { /* Start again. */
+      DeleteIntern(Intern);
+      if ((Intern = NewIntern()) == NULL)
+      { /* Error. */
+        Fail("NewIntern() failed.  %s.", StrError(errno));
+        return N;
+      } /* Error. */
+      memset(Ptrs, 0, sizeof(Ptrs));
+      Have = 0;
+    } /* Start again. */
+
+    Index = Rand() % CHECK_KEYS;
+    View = StrView(Keys[Index], KeyLens[Index]);
+    if (Rand() % 3 == 0)
+    { /* Find. */
+      if ((Str = InternFind(Intern, View)) != Ptrs[Index])
+        Fail("InternFind(%s): want %p, got %p.", Show(View.Ptr, View.Size),
+             (const void *) Ptrs[Index], (const void *) Str);
+    } /* Find. */
+    else if ((Str = InternView(Intern, View)) == NULL)
+      Fail("InternView(%s) failed.  %s.", Show(View.Ptr, View.Size),
+           StrError(errno));
+    else if (Ptrs[Index] == NULL)
+    { /* New. */
+      if (Str->Size != View.Size
+          || memcmp(Str->Ptr, View.Ptr, View.Size) != 0
+          || Str->Ptr[Str->Size] != '\0')
+        Fail("InternView(%s): got %s.", Show(View.Ptr, View.Size),
+             Show(Str->Ptr, Str->Size));
+      Ptrs[Index] = Str;
+      ++Have;
+    } /* New. */
+    else if (Str != Ptrs[Index])
+      Fail("InternView(%s): want %p, got %p.", Show(View.Ptr, View.Size),
+           (const void *) Ptrs[Index], (const void *) Str);
+
+    if (InternCount(Intern) != Have)
+    { /* Error. */
+      Fail("InternCount(): want %zu, got %zu.", Have, InternCount(Intern));
+      break;
+    } /* Error. */
+  } /* Each case. */
+  DeleteIntern(Intern);
+
+  /* Several threads at once, which must all get the same copies. */
+  if ((Intern = NewIntern()) == NULL)
+  { /* Error. */
+    Fail("NewIntern() failed.  %s.", StrError(errno));
+    return N;
+  } /* Error. */
+  for (T = 0; T < CHECK_THREADS; ++T)
+  { /* Start each thread. */
+    memset(&Threads[T], 0, sizeof(Threads[T]));
+    Threads[T].Intern = Intern;
+    Threads[T].Seed = Rand() | 1;
+    if ((errno = pthread_create(&Ids[T], NULL, InternThread,
+                                &Threads[T])) != 0)
+    { /* Error. */
+      Fail("pthread_create() failed.  %s.", StrError(errno));
+      break;
+    } /* Error. */
+  } /* Start each thread. */
+  while (T > 0)
+    pthread_join(Ids[--T], NULL);
+
+  for (Have = 0, I = 0; I < CHECK_KEYS; ++I)
+  { /* Each string. */
+    View = StrView(Keys[I], KeyLens[I]);
+    First = InternFind(Intern, View);
+    Have += (First != NULL);
+    for (T = 0; T < CHECK_THREADS; ++T)
+    { /* Each thread. */
+      if (Threads[T].Ptrs[I] != NULL && Threads[T].Ptrs[I] != First)
+      { /* Error. */
+        Fail("InternView(%s): thread %d got %p, not %p.",
+             Show(View.Ptr, View.Size), T, (const void *) Threads[T].Ptrs[I],
+             (const void *) First);
+        break;
+      } /* Error. */
+    } /* Each thread. */
+  } /* Each string. */
+  for (T = 0; T < CHECK_THREADS; ++T)
+  { /* Each thread. */
+    if (Threads[T].Bad != 0)
+      Fail("InternView(): thread %d got %" PRIu64 " wrong strings.", T,
+           Threads[T].Bad);
+  } /* Each thread. */
+  if (InternCount(Intern) != Have)
+    Fail("InternCount(): want %zu, got %zu after threads.", Have,
+         InternCount(Intern));
+  DeleteIntern(Intern);
+
+  return N;
+} /* CheckIntern() */
+
+/* Any size, but mostly pooled ones. */
+static size_t RandPoolSize(void)
+{ /* RandPoolSize() */
+  if (Rand() % 10 == 0)
+    return RandRange(POOL_MAX_SIZE + 1, 4 * POOL_MAX_SIZE);
+  return RandRange(1, POOL_MAX_SIZE);
+} /* RandPoolSize() */
+
+/* Is all of 'Block' still what it was filled with? */
+static bool BlockOk(const CheckBlock_t *Block, size_t Size)
+{ /* BlockOk() */
+  size_t I;
+
+  for (I = 0; I < Size && Block->Ptr[I] == Block->Fill; ++I)
+    ;
+  return (I == Size);
+} /* BlockOk() */
+
+/* Allocate, or check and free, blocks in another thread. */
+static void *PoolThread(void *Arg)
+{ /* PoolThread() */
+  CheckPool_t *This = Arg;
+  CheckBlock_t *Block;
+  size_t I;
+
+  for (I = 0; I < This->NBlocks; ++I)
+  { /* Each block. */
+    Block = &This->Blocks[I];
+    if (This->Alloc)
+    { /* Allocate. */
+      if ((Block->Ptr = PoolMalloc(Block->Size)) == NULL)
+        ++This->Bad;
+      else
+        memset(Block->Ptr, Block->Fill, Block->Size);
+    } /* Allocate. */
+    else
+    { /* Check and free. */
+      This->Bad += !BlockOk(Block, Block->Size);
+      PoolFree(Block->Ptr, Block->Size);
+      Block->Ptr = NULL;
+    } /* Check and free. */
+  } /* Each block. */
+
+  return NULL;
+} /* PoolThread() */
+
+/* Have another thread do 'Thread' to the blocks. */
+static void PoolOther(CheckPool_t *Thread)
+{ /* PoolOther() */
+  pthread_t Id;
+
+  if ((errno = pthread_create(&Id, NULL, PoolThread, Thread)) != 0)
+  { /* Error. */
+    Fail("pthread_create() failed.  %s.", StrError(errno));
+    Thread->Alloc = false;
+    PoolThread(Thread);
+    return;
+  } /* Error. */
+  pthread_join(Id, NULL);
+  if (Thread->Bad != 0)
+    Fail("Another thread got %" PRIu64 " bad blocks.", Thread->Bad);
+} /* PoolOther() */
+
+static uint64_t CheckPool(uint64_t Count)
+{ /* CheckPool() */
+  static CheckBlock_t Blocks[CHECK_BLOCKS], Others[CHECK_BLOCKS];
+  CheckBlock_t *Block;
+  CheckPool_t Thread;
+  unsigned char *Ptr;
+  size_t Size, NOthers, I;
+  uint64_t N;
+
+  memset(Blocks, 0, sizeof(Blocks));
+  for (N = 0; N < Count; ++N)
+  { /* Each case. */
+    if (N % 10000 == 5000)
+    { /* Hand over half of them to be freed by another thread. */
+      for (NOthers = 0, I = 0; I < CHECK_BLOCKS; I += 2)
+      { /* Each other block. */
+        if (Blocks[I].Ptr != NULL)
+        { /* In use. */
+          Others[NOthers++] = Blocks[I];
+          Blocks[I].Ptr = NULL;
+        } /* In use. */
+      } /* Each other block. */
+      Thread = (CheckPool_t) { Others, NOthers, false, 0 };
+      PoolOther(&Thread);
+
+      /* And have one allocate some for us to free. */
+      for (I = 0; I < CHECK_BLOCKS / 4; ++I)
+      { /* Each block. */
+        Others[I].Size = RandPoolSize();
+        Others[I].Fill = (unsigned char) Rand();
+      } /* Each block. */
+      Thread = (CheckPool_t) { Others, CHECK_BLOCKS / 4, true, 0 };
+      PoolOther(&Thread);
+      for (I = 0; I < CHECK_BLOCKS / 4; ++I)
+      { /* Each block. */
+        if (Others[I].Ptr == NULL)
+          continue;
+        if (!BlockOk(&Others[I], Others[I].Size))
+          Fail("A block from another thread changed.");
+        PoolFree(Others[I].Ptr, Others[I].Size);
+      } /* Each block. */
+    } /* Hand over half of them to be freed by another thread. */
+
+    Block = &Blocks[Rand() % CHECK_BLOCKS];
+    if (Block->Ptr == NULL)
+    { /* Allocate. */
+      Block->Size = RandPoolSize();
+      Block->Fill = (unsigned char) Rand();
+      if ((Block->Ptr = PoolMalloc(Block->Size)) == NULL)
+        Fail("PoolMalloc(%zu) failed.  %s.", Block->Size, StrError(errno));
+      else
+        memset(Block->Ptr, Block->Fill, Block->Size);
+      continue;
+    } /* Allocate. */
+
+    if (!BlockOk(Block, Block->Size))
+      Fail("A block of %zu changed.", Block->Size);
+    if (Rand() & 1)
+    { /* Free. */
+      PoolFree(Block->Ptr, Block->Size);
+      Block->Ptr = NULL;
+      continue;
+    } /* Free. */
+
+    Size = RandPoolSize();
+    if ((Ptr = PoolRealloc(Block->Ptr, Block->Size, Size)) == NULL)
+    { /* Error. */
+      Fail("PoolRealloc(%zu, %zu) failed.  %s.", Block->Size, Size,
+           StrError(errno));
+      continue;
+    } /* Error. */
+    Block->Ptr = Ptr;
+    if (!BlockOk(Block, (Size < Block->Size ? Size : Block->Size)))
+      Fail("PoolRealloc(%zu, %zu) lost the contents.", Block->Size, Size);
+    Block->Size = Size;
+    Block->Fill = (unsigned char) Rand();
+    memset(Block->Ptr, Block->Fill, Block->Size);
+  } /* Each case. */
+
+  for (I = 0; I < CHECK_BLOCKS; ++I)
+  { /* Each block. */
+    if (Blocks[I].Ptr != NULL)
+      PoolFree(Blocks[I].Ptr, Blocks[I].Size);
+  } /* Each block. */
+
+  return Count;
+} /* CheckPool() */
+
+static const Check_t Checks[] =
+{
+  { "Format", CheckFormat },
+  { "StrToInt", CheckStrToInt },
+  { "StrToFlt", CheckStrToFlt },
+  { "Batch", CheckBatch },
+  { "XToStr", CheckXToStr },
+  { "StrMap", CheckStrMap },
+  { "Intern", CheckIntern },
+  { "Pool", CheckPool }
+};
+
+static bool Wanted(const char *Name, char **Patterns, int NPatterns)
+{ /* Wanted() */
+  int I;
+
+  if (NPatterns == 0)
+    return true;
+  for (I = 0; I < NPatterns; ++I)
+  { /* Each pattern. */
+    if (strstr(Name, Patterns[I]) != NULL)
+      return true;
+  } /* Each pattern. */
+
+  return false;
+} /* Wanted() */
+
+static void Usage(const char *Prog)
+{ /* Usage() */
+  fprintf(stderr, "Usage: %s [-n Count] [-s Seed] [-l] [Pattern ...]\n",
+          Prog);
+} /* Usage() */
+
+/******************************************************************************
+ * Public methods.
+ *****************************************************************************/
+int main(int argc, char **argv)
+{ /* main() */
+  uint64_t Count = CHECK_COUNT, Seed = 1, Cases;
+  bool List = false, Failed = false;
+  size_t I;
+  int Opt;
+
+  while ((Opt = getopt(argc, argv, "n:s:l")) != -1)
+  { /* Each option. */
+    switch (Opt)
+    { /* switch */
+    case 'n':
+      if (StrToUI64(optarg, 0, &Count) != 0)
+      { /* Bad count. */
+        Usage(argv[0]);
+        return 2;
+      } /* Bad count. */
+      break;
+    case 's':
+      if (StrToUI64(optarg, 0, &Seed) != 0)
+      { /* Bad seed. */
+        Usage(argv[0]);
+        return 2;
+      } /* Bad seed. */
+      break;
+    case 'l':
+      List = true;
+      break;
+    default:
+      Usage(argv[0]);
+      return 2;
+    } /* switch */
+  } /* Each option. */
+  argv += optind;
+  argc -= optind;
+
+  MakeKeys();
+  for (I = 0; I < sizeof(Checks) / sizeof(Checks[0]); ++I)
+  { /* Each check. */
+    if (!Wanted(Checks[I].Name, argv, argc))
+      continue;
+    if (List)
+    { /* Just the name. */
+      printf("%s\n", Checks[I].Name);
+      continue;
+    } /* Just the name. */
+
+    /* Each check starts from 'Seed', so it gets the same inputs
+     * whichever others are run. */
+    RandState = Seed * UINT64_C(0x9E3779B97F4A7C15) + 1;
+    CheckName = Checks[I].Name;
+    Failures = 0;
+    Cases = Checks[I].Fn(Count);
+    printf("%-8s %10" PRIu64 " cases %10" PRIu64 " failed\n", CheckName,
+           Cases, Failures);
+    fflush(stdout);
+    Failed |= (Failures != 0);
+  } /* Each check. */
+
+  return (Failed ? 1 : 0);
+} /* main() */
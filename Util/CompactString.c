@@ -0,0 +1,266 @@
+/******************************************************************************
+ * Function definitions for our 'union CompactString' "class".  See
+ * CompactString.h.
+ *****************************************************************************/
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CompactString.h"
+#include "Diag.h"
+#include "Errors.h"
+
+/* The biggest buffer 'COMPACT_STRING_CAP()' can hold. */
+#define COMPACT_STRING_MAX_CAP (SIZE_MAX >> CHAR_BIT)
+
+_Static_assert(sizeof(CompactString_t) == 3 * sizeof(size_t),
+               "CompactString_t must be three words");
+
+/******************************************************************************
+ * These would be 'private' in C++.
+ *****************************************************************************/
+static inline char *Buff(CompactString_t *This)
+{ /* Buff() */
+  return (CompactStringIsLocal(This) ? This->Local : This->Heap.Ptr);
+} /* Buff() */
+
+/* Set the length to 'Size', which must fit, and write the '\0'. */
+static inline void SetSize(CompactString_t *This, size_t Size)
+{ /* SetSize() */
+  if (CompactStringIsLocal(This))
+  { /* Local. */
+    This->Local[Size] = '\0';
+    This->Local[COMPACT_STRING_LOCAL_MAX] = COMPACT_STRING_LOCAL_MAX - Size;
+  } /* Local. */
+  else
+  { /* Heap. */
+    This->Heap.Ptr[Size] = '\0';
+    This->Heap.Size = Size;
+  } /* Heap. */
+} /* SetSize() */
+
+/******************************************************************************
+ * Public methods.
+ *****************************************************************************/
+bool ConstructCompactStringCStr(CompactString_t *This, const char *Src)
+{ /* ConstructCompactStringCStr() */
+  int ErrNo;
+  bool _RetVal;
+
+  if (!ConstructCompactString(This))
+  { /* Error. */
+    ErrNo = errno;
+    EXIT(false);
+  } /* Error. */
+
+  if (!CompactStringSetCStr(This, Src))
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: CompactStringSetCStr() failed.  %s.\n",
+         __FILE__, __func__, __LINE__, StrError(ErrNo));
+    EXIT(false);
+  } /* Error. */
+  RETURN(true);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* ConstructCompactStringCStr() */
+
+void DestroyCompactString(CompactString_t *This)
+{ /* DestroyCompactString() */
+  if (This != NULL && !CompactStringIsLocal(This))
+  { /* Heap. */
+    free(This->Heap.Ptr);
+    ConstructCompactString(This);
+  } /* Heap. */
+} /* DestroyCompactString() */
+
+bool CompactStringReserve(CompactString_t *This, size_t MinSize)
+{ /* CompactStringReserve() */
+  int ErrNo;
+  bool _RetVal;
+  size_t CurSize, NewSize, Size;
+  char *NewBuff;
+
+  if ((CurSize = CompactStringCapacity(This)) >= MinSize)
+  { /* Nothing to do. */
+    RETURN(true);
+  } /* Nothing to do. */
+
+  if (MinSize > COMPACT_STRING_MAX_CAP)
+  { /* Error. */
+    ErrNo = ENOMEM;
+    Diag("%s %s %d: %zu bytes is too big.  %s.\n",
+         __FILE__, __func__, __LINE__, MinSize, StrError(ErrNo));
+    EXIT(false);
+  } /* Error. */
+
+  /* Grow by a factor of 2, as 'String_t' does. */
+  for (NewSize = CurSize; NewSize < MinSize; NewSize *= 2)
+    if (NewSize > COMPACT_STRING_MAX_CAP / 2)
+    { /* Just what's needed. */
+      NewSize = MinSize;
+      break;
+    } /* Just what's needed. */
+
+  Size = CompactStringSize(This);
+  if (CompactStringIsLocal(This))
+  { /* Move to the heap. */
+    if ((NewBuff = malloc(NewSize)) == NULL)
+    { /* Error. */
+      ErrNo = errno;
+      Diag("%s %s %d: malloc(%zu) failed.  %s.\n",
+           __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
+      EXIT(false);
+    } /* Error. */
+    memcpy(NewBuff, This->Local, Size + 1);
+  } /* Move to the heap. */
+  else if ((NewBuff = realloc(This->Heap.Ptr, NewSize)) == NULL)
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: realloc(%zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
+    EXIT(false);
+  } /* Error. */
+
+  This->Heap.Ptr = NewBuff;
+  This->Heap.Size = Size;
+  This->Heap.Cap = COMPACT_STRING_CAP(NewSize);
+  RETURN(true);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* CompactStringReserve() */
+
+bool CompactStringSet(CompactString_t *This, const char *Src, size_t Len)
+{ /* CompactStringSet() */
+  int ErrNo;
+  bool _RetVal;
+  const char *Old = Buff(This);
+  size_t Off = (uintptr_t) Src - (uintptr_t) Old;
+
+  if (Src == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'Src' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    ErrNo = EFAULT;
+    EXIT(false);
+  } /* Error. */
+
+  if (Len >= SIZE_MAX || !CompactStringReserve(This, Len + 1))
+  { /* Error. */
+    ErrNo = (Len >= SIZE_MAX ? ENOMEM : errno);
+    EXIT(false);
+  } /* Error. */
+
+  /* 'Src' may have been in the buffer that just moved. */
+  if (Off <= CompactStringSize(This))
+    Src = Buff(This) + Off;
+
+  memmove(Buff(This), Src, Len);
+  SetSize(This, Len);
+  RETURN(true);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* CompactStringSet() */
+
+bool CompactStringSetCStr(CompactString_t *This, const char *Src)
+{ /* CompactStringSetCStr() */
+  if (Src == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'Src' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    errno = EFAULT;
+    return false;
+  } /* Error. */
+
+  return CompactStringSet(This, Src, strlen(Src));
+} /* CompactStringSetCStr() */
+
+bool CompactStringSetStr(CompactString_t *This, const String_t *Src)
+{ /* CompactStringSetStr() */
+  if (Src == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'Src' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    errno = EFAULT;
+    return false;
+  } /* Error. */
+
+  return CompactStringSet(This, Src->Ptr, Src->Size);
+} /* CompactStringSetStr() */
+
+bool CompactStringAppend(CompactString_t *This, const char *Src, size_t Len)
+{ /* CompactStringAppend() */
+  int ErrNo;
+  bool _RetVal;
+  size_t Size = CompactStringSize(This);
+  const char *Old = Buff(This);
+  size_t Off = (uintptr_t) Src - (uintptr_t) Old;
+
+  if (Src == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'Src' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    ErrNo = EFAULT;
+    EXIT(false);
+  } /* Error. */
+
+  if (Len >= SIZE_MAX - Size || !CompactStringReserve(This, Size + Len + 1))
+  { /* Error. */
+    ErrNo = (Len >= SIZE_MAX - Size ? ENOMEM : errno);
+    EXIT(false);
+  } /* Error. */
+
+  /* 'Src' may have been in the buffer that just moved. */
+  if (Off <= Size)
+    Src = Buff(This) + Off;
+
+  memmove(Buff(This) + Size, Src, Len);
+  SetSize(This, Size + Len);
+  RETURN(true);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* CompactStringAppend() */
+
+bool CompactStringAppendCStr(CompactString_t *This, const char *Src)
+{ /* CompactStringAppendCStr() */
+  if (Src == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'Src' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    errno = EFAULT;
+    return false;
+  } /* Error. */
+
+  return CompactStringAppend(This, Src, strlen(Src));
+} /* CompactStringAppendCStr() */
+
+bool CompactStringAppendStr(CompactString_t *This, const String_t *Src)
+{ /* CompactStringAppendStr() */
+  if (Src == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'Src' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    errno = EFAULT;
+    return false;
+  } /* Error. */
+
+  return CompactStringAppend(This, Src->Ptr, Src->Size);
+} /* CompactStringAppendStr() */
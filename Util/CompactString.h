@@ -0,0 +1,166 @@
+#ifndef CompactString_h
+#define CompactString_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ * A compact string 'class' for the many short strings (identifiers,
+ * keys, field names, etc.) that are mostly copied around and compared.
+ * A 'CompactString_t' is just three words (24 bytes on a 64-bit
+ * machine, as opposed to 40 for a 'String_t'), and holds up to
+ * 'COMPACT_STRING_LOCAL_MAX' (23) characters without allocating
+ * anything (15 for a 'String_t').
+ *
+ * The trick (from 'folly::fbstring') is to keep the string's state in
+ * its last byte.  For a local string that's 'COMPACT_STRING_LOCAL_MAX'
+ * minus the length, so a full 23 character string has a 0 there,
+ * which doubles as the terminating '\0'.  Otherwise the contents are
+ * on the heap ('malloc()'ed, growing by a factor of 2, like
+ * 'String_t') and the string holds a pointer, the length, and the
+ * capacity, which is stored with 'COMPACT_STRING_HEAP' set in the last
+ * byte.
+ *
+ * As for 'String_t', the constructors and 'set' and 'append' functions
+ * return 'true' on success, or set 'errno' and return 'false' (leaving
+ * the string as it was).  A 'CompactString_t' can be copied with
+ * 'CompactStringSetCStr(&Dst, CompactStringGetCStr(&Src))' but not
+ * with '=', and must be destroyed with 'DestroyCompactString()'.
+ *****************************************************************************/
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <String.h>
+
+typedef union CompactString
+{ /* CompactString */
+  struct
+  {
+    char *Ptr;
+    size_t Size;                /* _Not_ including the '\0'. */
+    size_t Cap;                 /* See 'COMPACT_STRING_CAP()'. */
+  } Heap;
+  char Local[3 * sizeof(size_t)];
+} CompactString_t; /* CompactString */
+
+/* The most characters a string holds without allocating. */
+#define COMPACT_STRING_LOCAL_MAX (sizeof(CompactString_t) - 1)
+
+/* Set in the last byte of a string on the heap, never in a local one. */
+#define COMPACT_STRING_HEAP 0x80
+
+/* 'Heap.Cap' holds the buffer size (including the '\0') with
+ * 'COMPACT_STRING_HEAP' set in the last byte, whichever end of the
+ * word that is. */
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define COMPACT_STRING_CAP(Size) (((Size) << CHAR_BIT) | COMPACT_STRING_HEAP)
+#define COMPACT_STRING_GET_CAP(Cap) ((Cap) >> CHAR_BIT)
+#else
+#define COMPACT_STRING_CAP(Size) \
+  ((Size) | (size_t) COMPACT_STRING_HEAP << (sizeof(size_t) - 1) * CHAR_BIT)
+#define COMPACT_STRING_GET_CAP(Cap) \
+  ((Cap) & ~((size_t) COMPACT_STRING_HEAP << (sizeof(size_t) - 1) * CHAR_BIT))
+#endif
+
+  /* Constructors and destructor. */
+  static inline bool ConstructCompactString(CompactString_t *This);
+  extern bool ConstructCompactStringCStr(CompactString_t *This,
+                                         const char *Src);
+  extern void DestroyCompactString(CompactString_t *This);
+
+  /* Whether the contents are in the 'CompactString_t' itself. */
+  static inline bool CompactStringIsLocal(const CompactString_t *This);
+
+  /* The length (_not_ including the '\0'). */
+  static inline size_t CompactStringSize(const CompactString_t *This);
+
+  /* The size of the buffer (including the '\0'), as for
+   * 'StringCapacity()'. */
+  static inline size_t CompactStringCapacity(const CompactString_t *This);
+
+  /* The contents.  WARNING: The pointer may become invalid after any
+   * operation that changes the size of the string! */
+  static inline const char *CompactStringGetCStr(const CompactString_t *This);
+
+  /* Make the buffer at least 'MinSize' characters (including the
+   * '\0'). */
+  extern bool CompactStringReserve(CompactString_t *This, size_t MinSize);
+
+  /* Empty the string without resizing the buffer. */
+  static inline void CompactStringClear(CompactString_t *This);
+
+  /* Set the contents to 'Len' characters at 'Src', a 'const char *',
+   * or a 'String_t'.  'Src' may point into 'This'. */
+  extern bool CompactStringSet(CompactString_t *This, const char *Src,
+                               size_t Len);
+  extern bool CompactStringSetCStr(CompactString_t *This, const char *Src);
+  extern bool CompactStringSetStr(CompactString_t *This, const String_t *Src);
+
+  /* Append the same. */
+  extern bool CompactStringAppend(CompactString_t *This, const char *Src,
+                                  size_t Len);
+  extern bool CompactStringAppendCStr(CompactString_t *This, const char *Src);
+  extern bool CompactStringAppendStr(CompactString_t *This,
+                                     const String_t *Src);
+
+/******************************************************************************
+ * Inline method definitions.
+ *****************************************************************************/
+  static inline bool ConstructCompactString(CompactString_t *This)
+  { /* ConstructCompactString() */
+#ifndef NDEBUG
+    if (This == NULL)
+    { /* Error. */
+      Diag("%s %s %d: Internal error.  'This' is NULL.\n",
+           __FILE__, __func__, __LINE__);
+      errno = EFAULT;
+      return false;
+    } /* Error. */
+#endif
+
+    This->Local[0] = '\0';
+    This->Local[COMPACT_STRING_LOCAL_MAX] = COMPACT_STRING_LOCAL_MAX;
+    return true;
+  } /* ConstructCompactString() */
+
+  static inline bool CompactStringIsLocal(const CompactString_t *This)
+  { /* CompactStringIsLocal() */
+    return !(This->Local[COMPACT_STRING_LOCAL_MAX] & COMPACT_STRING_HEAP);
+  } /* CompactStringIsLocal() */
+
+  static inline size_t CompactStringSize(const CompactString_t *This)
+  { /* CompactStringSize() */
+    return (CompactStringIsLocal(This) ?
+            COMPACT_STRING_LOCAL_MAX - This->Local[COMPACT_STRING_LOCAL_MAX] :
+            This->Heap.Size);
+  } /* CompactStringSize() */
+
+  static inline size_t CompactStringCapacity(const CompactString_t *This)
+  { /* CompactStringCapacity() */
+    return (CompactStringIsLocal(This) ? sizeof(CompactString_t) :
+            COMPACT_STRING_GET_CAP(This->Heap.Cap));
+  } /* CompactStringCapacity() */
+
+  static inline const char *CompactStringGetCStr(const CompactString_t *This)
+  { /* CompactStringGetCStr() */
+    return (CompactStringIsLocal(This) ? This->Local : This->Heap.Ptr);
+  } /* CompactStringGetCStr() */
+
+  static inline void CompactStringClear(CompactString_t *This)
+  { /* CompactStringClear() */
+    if (CompactStringIsLocal(This))
+      ConstructCompactString(This);
+    else
+    { /* Heap. */
+      This->Heap.Ptr[0] = '\0';
+      This->Heap.Size = 0;
+    } /* Heap. */
+  } /* CompactStringClear() */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif
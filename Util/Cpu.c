@@ -0,0 +1,54 @@
+/******************************************************************************
+ * Run time CPU feature detection.  See 'Cpu.h'.
+ *****************************************************************************/
+#include <stdlib.h>
+
+#include "Cpu.h"
+
+/******************************************************************************
+ * Ask the CPU.  '__builtin_cpu_supports()' already checks that the OS
+ * saves the AVX state (XGETBV) so there is nothing more to do.
+ *****************************************************************************/
+static unsigned Probe(void)
+{ /* Probe() */
+  unsigned Features = 0;
+
+#ifdef CPU_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse2"))
+    Features |= CPU_SSE2;
+  if (__builtin_cpu_supports("sse4.1"))
+    Features |= CPU_SSE41;
+  if (__builtin_cpu_supports("avx2"))
+    Features |= CPU_AVX2;
+#endif
+
+  return Features;
+} /* Probe() */
+
+unsigned CpuFeatures(void)
+{ /* CpuFeatures() */
+  /* The high bit says "not computed yet".  Computing the answer is
+   * idempotent so if two threads race they just both store the same
+   * value. */
+  static unsigned Cached = ~0u;
+  unsigned Features;
+  const char *Mask;
+  char *End;
+
+  Features = __atomic_load_n(&Cached, __ATOMIC_RELAXED);
+  if (Features == ~0u)
+  { /* First time. */
+    Features = Probe();
+    if ((Mask = getenv("UTIL_CPU_MASK")) != NULL && *Mask != '\0')
+    { /* Override. */
+      unsigned long Bits = strtoul(Mask, &End, 0);
+
+      if (*End == '\0')
+        Features &= (unsigned) Bits;
+    } /* Override. */
+    __atomic_store_n(&Cached, Features, __ATOMIC_RELAXED);
+  } /* First time. */
+
+  return Features;
+} /* CpuFeatures() */
@@ -0,0 +1,33 @@
+#ifndef Cpu_h
+#define Cpu_h
+
+/******************************************************************************
+ * Private run time CPU feature detection.  This header is _not_
+ * installed.  The library is built for the baseline instruction set
+ * of the target; code that can use something better (e.g. AVX2)
+ * compiles those routines with a 'target' attribute and picks one at
+ * run time based on 'CpuFeatures()'.
+ *****************************************************************************/
+
+/* 'CpuFeatures()' bits.  Always 0 on anything but x86. */
+#define CPU_SSE2  0x01u
+#define CPU_SSE41 0x02u
+#define CPU_AVX2  0x04u
+
+/* True if we can compile x86 SIMD code with 'target' attributes. */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_X86 1
+#endif
+
+/******************************************************************************
+ * Return the set of 'CPU_*' features supported by both this CPU and
+ * the OS.  The result is computed once and cached.
+ *
+ * For testing and benchmarking, if the environment variable
+ * UTIL_CPU_MASK is set to a number (in any base accepted by
+ * 'strtoul(..., 0)') the features are ANDed with it, so e.g.
+ * UTIL_CPU_MASK=0 forces the portable code everywhere.
+ *****************************************************************************/
+extern unsigned CpuFeatures(void);
+
+#endif
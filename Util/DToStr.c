@@ -0,0 +1,33 @@
+#include <errno.h>
+
+#include "XToStr.h"
+#include "XToStrImpl.h"
+
+/******************************************************************************
+ * Convert 'Val' to the shortest string that 'StrToD()' converts back
+ * to exactly 'Val'.  See 'XToStr.h'.
+ *****************************************************************************/
+int DToStr(double Val, char *Buff, size_t Size, size_t *Len)
+{ /* DToStr(double, char *, size_t, size_t *) */
+  char Temp[XTOSTR_FLT_MAX];
+  size_t N;
+
+  /* NULL pointer checking. */
+  if (Buff == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Write straight into 'Buff' if it's big enough for anything. */
+  if (Size > XTOSTR_FLT_MAX)
+  { /* Big enough. */
+    N = XToStrD(Val, Buff);
+    Buff[N] = '\0';
+    if (Len != NULL)
+      *Len = N;
+    return 0;
+  } /* Big enough. */
+
+  N = XToStrD(Val, Temp);
+  return XToStrCopy(Temp, N, Buff, Size, Len);
+} /* DToStr(double, char *, size_t, size_t *) */
@@ -0,0 +1,366 @@
+/******************************************************************************
+ * Function definitions for the library's diagnostics.  See Diag.h.
+ *
+ * The default sink's ring is a bounded multi-producer queue (after
+ * Dmitry Vyukov's): each slot has a 'Turn' saying whether it's free for
+ * the producer whose position lands on it this time round, or holds a
+ * message for the consumer.  A producer claims a position with a
+ * compare and swap on 'Head', copies its message in, and then hands
+ * the slot over with a release store of 'Turn'.  If the slot it lands
+ * on still holds last time round's message the ring is full, and the
+ * message is dropped.
+ *
+ * There's only ever one consumer, whoever holds 'DrainLock': usually
+ * the writer thread, or 'DiagFlush()'.  The writer sleeps on a
+ * semaphore, and says so in 'Sleeping', so a producer only posts (the
+ * one system call) when there's someone to wake.
+ *
+ * The writer is started by the first diagnostic for the default sink
+ * (or by 'DiagStart()'), not when the library is loaded, so a program
+ * that never has anything to report stays single threaded.  Until it's
+ * running whoever reports a diagnostic writes it.  It's stopped when
+ * the library is unloaded, so that 'dlclose()' doesn't leave it behind
+ * with no code to run.  After a 'fork()' the child has no writer, so it
+ * writes its diagnostics itself, and the fork handlers see to it that
+ * it doesn't inherit 'DrainLock' locked, or the parent's messages.
+ *****************************************************************************/
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Diag.h"
+
+/* Number of messages the ring holds.  A power of 2. */
+#define DIAG_RING_SLOTS 1024
+#define DIAG_RING_MASK ((size_t) DIAG_RING_SLOTS - 1)
+
+/* How long the writer waits, once woken, before writing. */
+#define DIAG_LINGER_NS 1000000
+
+/* How much the writer 'write()'s at once. */
+#define DIAG_BATCH_SIZE (16 * DIAG_MAX_MSG)
+
+typedef struct DiagSlot
+{ /* DiagSlot */
+  /* Relative to the slot's index, so that all 0s is a free ring.  The
+   * slot is free for the position 'Pos' when this is 'Pos' rounded
+   * down to a multiple of 'DIAG_RING_SLOTS', and full when it's one
+   * more. */
+  size_t Turn;
+  size_t Len;
+  char Msg[DIAG_MAX_MSG];
+} DiagSlot_t; /* DiagSlot */
+
+static DiagSlot_t Ring[DIAG_RING_SLOTS];
+static size_t Head;                     /* Next position to claim. */
+static size_t Tail;                     /* Next to write.  'DrainLock'. */
+static uint64_t Dropped;                /* Since the writer last said. */
+static pthread_mutex_t DrainLock = PTHREAD_MUTEX_INITIALIZER;
+
+/* The writer thread, and how to wake (or stop) it.  'Started' is set
+ * by 'Start()', under 'StartOnce', and cleared by 'Stop()' and in a
+ * 'fork()'ed child. */
+static pthread_once_t StartOnce = PTHREAD_ONCE_INIT;
+static bool Started;
+static bool Stopping;
+static pthread_t WriterThread;
+static sem_t Wake;
+static int Sleeping;
+
+/* NULL for the default sink. */
+static const DiagSink_t *CurSink;
+
+/******************************************************************************
+ * These would be 'private' in C++.
+ *****************************************************************************/
+/* Write all of 'Buff' to standard error, or as much as it'll take. */
+static void WriteAll(const char *Buff, size_t Len)
+{ /* WriteAll() */
+  ssize_t N;
+
+  while (Len != 0)
+  { /* Until it's all written. */
+    if ((N = write(STDERR_FILENO, Buff, Len)) < 0)
+    { /* Error. */
+      if (errno == EINTR)
+        continue;
+      return;
+    } /* Error. */
+    Buff += N;
+    Len -= (size_t) N;
+  } /* Until it's all written. */
+} /* WriteAll() */
+
+/* Whether the slot at 'Tail' has a message in it.  'DrainLock' must
+ * be held. */
+static bool RingReady(void)
+{ /* RingReady() */
+  DiagSlot_t *Slot = &Ring[Tail & DIAG_RING_MASK];
+
+  return (__atomic_load_n(&Slot->Turn, __ATOMIC_ACQUIRE) ==
+          (Tail & ~DIAG_RING_MASK) + 1);
+} /* RingReady() */
+
+/* Write out, and free up, everything that's on the ring.  'DrainLock'
+ * must be held. */
+static void Drain(void)
+{ /* Drain() */
+  char Batch[DIAG_BATCH_SIZE];
+  size_t Used = 0;
+  DiagSlot_t *Slot;
+  uint64_t Lost;
+  int N;
+
+  while (RingReady())
+  { /* Each message. */
+    Slot = &Ring[Tail & DIAG_RING_MASK];
+    if (Used + Slot->Len > sizeof(Batch))
+    { /* Batch full. */
+      WriteAll(Batch, Used);
+      Used = 0;
+    } /* Batch full. */
+    memcpy(&Batch[Used], Slot->Msg, Slot->Len);
+    Used += Slot->Len;
+    __atomic_store_n(&Slot->Turn, (Tail & ~DIAG_RING_MASK) + DIAG_RING_SLOTS,
+                     __ATOMIC_RELEASE);
+    ++Tail;
+  } /* Each message. */
+
+  if ((Lost = __atomic_exchange_n(&Dropped, 0, __ATOMIC_RELAXED)) != 0)
+  { /* Say so. */
+    if (Used + DIAG_MAX_MSG > sizeof(Batch))
+    { /* Batch full. */
+      WriteAll(Batch, Used);
+      Used = 0;
+    } /* Batch full. */
+    N = snprintf(&Batch[Used], DIAG_MAX_MSG,
+                 "%s %s %d: %" PRIu64 " diagnostics dropped.\n",
+                 __FILE__, __func__, __LINE__, Lost);
+    if (N > 0)
+      Used += ((size_t) N < DIAG_MAX_MSG ? (size_t) N : DIAG_MAX_MSG - 1);
+  } /* Say so. */
+
+  WriteAll(Batch, Used);
+} /* Drain() */
+
+static void *Writer(void *Arg)
+{ /* Writer() */
+  static const struct timespec Linger = { 0, DIAG_LINGER_NS };
+  bool Ready;
+
+  (void) Arg;
+  for (;;)
+  { /* Until stopped. */
+    pthread_mutex_lock(&DrainLock);
+    Drain();
+    if (__atomic_load_n(&Stopping, __ATOMIC_RELAXED))
+    { /* Done. */
+      pthread_mutex_unlock(&DrainLock);
+      break;
+    } /* Done. */
+
+    /* Say we're going to sleep, then look again, so that a producer
+     * either sees 'Sleeping' or we see its message. */
+    __atomic_store_n(&Sleeping, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    Ready = RingReady();
+    pthread_mutex_unlock(&DrainLock);
+
+    if (!Ready)
+    { /* Sleep. */
+      while (sem_wait(&Wake) != 0 && errno == EINTR)
+        ;
+
+      /* Errors tend to come in bunches, so give the rest of the bunch
+       * a moment to turn up, rather than being woken for each one. */
+      if (!__atomic_load_n(&Stopping, __ATOMIC_RELAXED))
+        nanosleep(&Linger, NULL);
+    } /* Sleep. */
+    else
+    { /* Awake after all. */
+      /* If a producer already took 'Sleeping' its post just makes the
+       * next 'sem_wait()' return straight away. */
+      __atomic_store_n(&Sleeping, 0, __ATOMIC_RELAXED);
+    } /* Awake after all. */
+  } /* Until stopped. */
+
+  return NULL;
+} /* Writer() */
+
+/* Around a 'fork()', make sure the ring is left alone (the child
+ * can't inherit 'DrainLock' held by a thread it doesn't have). */
+static void ForkPrepare(void)
+{ /* ForkPrepare() */
+  pthread_mutex_lock(&DrainLock);
+} /* ForkPrepare() */
+
+static void ForkParent(void)
+{ /* ForkParent() */
+  pthread_mutex_unlock(&DrainLock);
+} /* ForkParent() */
+
+/* The child has no writer, so from now on it writes its diagnostics
+ * itself (it doesn't start one, as 'StartOnce' is done).  What's on the
+ * ring is the parent's to write, including any message another thread
+ * was half way through, so skip the lot. */
+static void ForkChild(void)
+{ /* ForkChild() */
+  size_t Pos = __atomic_load_n(&Head, __ATOMIC_RELAXED);
+
+  for (; Tail != Pos; ++Tail)
+    __atomic_store_n(&Ring[Tail & DIAG_RING_MASK].Turn,
+                     (Tail & ~DIAG_RING_MASK) + DIAG_RING_SLOTS,
+                     __ATOMIC_RELAXED);
+  __atomic_store_n(&Dropped, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&Sleeping, 0, __ATOMIC_RELAXED);
+  Started = false;
+  pthread_mutex_unlock(&DrainLock);
+} /* ForkChild() */
+
+/* Start the writer thread, with all signals blocked, so it never
+ * takes one meant for the program.  Run once, by the first diagnostic
+ * (or 'DiagStart()'), and never from a constructor: a thread started
+ * at load time makes every program that links with the library
+ * multi-threaded, which some things (e.g. 'unshare(CLONE_NEWUSER)')
+ * refuse to be.  If it can't be started diagnostics are written by
+ * whoever reports them. */
+static void Start(void)
+{ /* Start() */
+  sigset_t All, Old;
+  bool Ok;
+
+  if (pthread_atfork(ForkPrepare, ForkParent, ForkChild) != 0 ||
+      sem_init(&Wake, 0, 0) != 0)
+    return;
+
+  sigfillset(&All);
+  pthread_sigmask(SIG_SETMASK, &All, &Old);
+  Ok = (pthread_create(&WriterThread, NULL, Writer, NULL) == 0);
+  pthread_sigmask(SIG_SETMASK, &Old, NULL);
+
+  if (Ok)
+  { /* Running. */
+    __atomic_store_n(&Started, true, __ATOMIC_RELEASE);
+    atexit(DiagFlush);
+  } /* Running. */
+} /* Start() */
+
+/* Stop the writer, if there is one, when the library is unloaded (by
+ * 'dlclose()' or at exit), and write out whatever it left. */
+__attribute__((destructor))
+static void Stop(void)
+{ /* Stop() */
+  if (!__atomic_load_n(&Started, __ATOMIC_ACQUIRE))
+    return;
+
+  __atomic_store_n(&Started, false, __ATOMIC_RELEASE);
+  __atomic_store_n(&Stopping, true, __ATOMIC_RELAXED);
+  sem_post(&Wake);
+  pthread_join(WriterThread, NULL);
+  DiagFlush();
+} /* Stop() */
+
+/* The default sink: put 'Msg' on the ring, if there's room. */
+static void RingSink(const char *Msg, size_t Len)
+{ /* RingSink() */
+  size_t Pos, Lap, Turn;
+  DiagSlot_t *Slot;
+
+  pthread_once(&StartOnce, Start);
+  Pos = __atomic_load_n(&Head, __ATOMIC_RELAXED);
+  for (;;)
+  { /* Until we have a slot. */
+    Slot = &Ring[Pos & DIAG_RING_MASK];
+    Lap = Pos & ~DIAG_RING_MASK;
+    Turn = __atomic_load_n(&Slot->Turn, __ATOMIC_ACQUIRE);
+    if (Turn == Lap)
+    { /* Free. */
+      if (__atomic_compare_exchange_n(&Head, &Pos, Pos + 1, true,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        break;
+    } /* Free. */
+    else if ((ptrdiff_t) (Turn - Lap) < 0)
+    { /* Full. */
+      __atomic_add_fetch(&Dropped, 1, __ATOMIC_RELAXED);
+      return;
+    } /* Full. */
+    else
+      Pos = __atomic_load_n(&Head, __ATOMIC_RELAXED);
+  } /* Until we have a slot. */
+
+  memcpy(Slot->Msg, Msg, Len + 1);
+  Slot->Len = Len;
+  __atomic_store_n(&Slot->Turn, Lap + 1, __ATOMIC_RELEASE);
+
+  /* Wake the writer if it's asleep.  With no writer, write it out
+   * ourselves, the slow way, rather than lose it. */
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (!__atomic_load_n(&Started, __ATOMIC_ACQUIRE))
+    DiagFlush();
+  else if (__atomic_load_n(&Sleeping, __ATOMIC_RELAXED) &&
+           __atomic_exchange_n(&Sleeping, 0, __ATOMIC_RELAXED))
+    sem_post(&Wake);
+} /* RingSink() */
+
+/******************************************************************************
+ * Public methods.
+ *****************************************************************************/
+void Diag(const char *Fmt, ...)
+{ /* Diag() */
+  const DiagSink_t *Sink = __atomic_load_n(&CurSink, __ATOMIC_ACQUIRE);
+  char Msg[DIAG_MAX_MSG];
+  int SavedErrNo = errno, N;
+  va_list Args;
+  size_t Len;
+
+  va_start(Args, Fmt);
+  N = vsnprintf(Msg, sizeof(Msg), Fmt, Args);
+  va_end(Args);
+  if (N <= 0)
+    goto Return;
+
+  /* Cut short, but keep the newline. */
+  if ((Len = (size_t) N) >= sizeof(Msg))
+  { /* Too long. */
+    Len = sizeof(Msg) - 1;
+    Msg[Len - 1] = '\n';
+  } /* Too long. */
+
+  if (Sink == NULL)
+    RingSink(Msg, Len);
+  else
+    Sink->Hook(Msg, Len, Sink->Ctx);
+
+Return:
+  errno = SavedErrNo;
+} /* Diag() */
+
+void DiagStart(void)
+{ /* DiagStart() */
+  pthread_once(&StartOnce, Start);
+} /* DiagStart() */
+
+void DiagSetSink(const DiagSink_t *Sink)
+{ /* DiagSetSink() */
+  __atomic_store_n(&CurSink, Sink, __ATOMIC_RELEASE);
+} /* DiagSetSink() */
+
+void DiagFlush(void)
+{ /* DiagFlush() */
+  int SavedErrNo = errno;
+
+  pthread_mutex_lock(&DrainLock);
+  Drain();
+  pthread_mutex_unlock(&DrainLock);
+  errno = SavedErrNo;
+} /* DiagFlush() */
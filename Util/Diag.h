@@ -0,0 +1,76 @@
+#ifndef Diag_h
+#define Diag_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ * Where the library's diagnostics ("String.c MallocBuffExact 153:
+ * malloc(64) failed.  Cannot allocate memory.") go.
+ *
+ * 'Diag()' formats the message (with 'vsnprintf()', into a buffer on
+ * the stack) and hands it to the current sink.  The default sink
+ * copies it into a fixed size ring buffer and returns, without taking
+ * a lock, allocating, or making a system call (unless the writer
+ * thread is asleep and has to be woken, which is one 'sem_post()').
+ * A background thread, started by the first diagnostic (so a program
+ * that never gets one has no extra thread), takes messages off the
+ * ring and 'write()'s them to standard error in batches.  If the ring
+ * is full (something is reporting errors faster than they can be
+ * written) the message is dropped and counted, and the writer says how
+ * many it lost.  So reporting an error never blocks, which matters
+ * most when the error is running out of memory.
+ * (The exception is a 'fork()'ed child, which has no writer thread, so
+ * writes its diagnostics itself, as does a program the writer couldn't
+ * be started in.  The first diagnostic is often about running out of
+ * something, and so the one least likely to get a thread started; a
+ * program that cares can start it up front with 'DiagStart()'.)
+ *
+ * A program that wants the messages somewhere else (its own log, a
+ * test harness, ...) sets its own sink:
+ *
+ *   static void MySinkHook(const char *Msg, size_t Len, void *Ctx)
+ *   { ... }
+ *   static const DiagSink_t MySink = { MySinkHook, &MyLog };
+ *
+ *   DiagSetSink(&MySink);
+ *
+ * The hook is called on the thread reporting the error, and may be
+ * called by several threads at once.  'Msg' ends with a newline, and
+ * is also '\0' terminated.
+ *****************************************************************************/
+#include <stddef.h>
+
+/* The longest message, including the newline and the '\0'.  Longer
+ * ones are cut short. */
+#define DIAG_MAX_MSG 256
+
+typedef void DiagHook_t(const char *Msg, size_t Len, void *Ctx);
+
+typedef struct DiagSink
+{ /* DiagSink */
+  DiagHook_t *Hook;
+  void *Ctx;                    /* Passed to 'Hook'. */
+} DiagSink_t; /* DiagSink */
+
+  /* Report something, 'printf()' style.  Leaves 'errno' alone. */
+  extern void Diag(const char *Fmt, ...)
+    __attribute__((format(printf, 1, 2)));
+
+  /* Start the writer thread now, rather than with the first
+   * diagnostic.  Does nothing if it's already running. */
+  extern void DiagStart(void);
+
+  /* Send diagnostics to 'Sink' (which must stay put until it's
+   * replaced), or back to the default sink if 'Sink' is NULL. */
+  extern void DiagSetSink(const DiagSink_t *Sink);
+
+  /* Write out everything on the default sink's ring now.  This is done
+   * at 'exit()' anyway. */
+  extern void DiagFlush(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif
@@ -3,42 +3,61 @@
  *****************************************************************************/
 #include <errno.h>
 #include <locale.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <Errors.h>
+#include <String.h>
+
+/* Errors 0 to 'STRERROR_CACHE_SIZE' - 1 (which is all of them on
+ * Linux) have their messages cached. */
+#define STRERROR_CACHE_SIZE 256
+
+/* A thread's 'locale_t' and the messages it's looked up. */
+typedef struct StrErrorCache
+{ /* StrErrorCache */
+  locale_t Locale;              /* (locale_t) 0 until we have one. */
+  unsigned Gen;                 /* 'LocaleGen' when we got it. */
+  const char *Msgs[STRERROR_CACHE_SIZE];
+} StrErrorCache_t; /* StrErrorCache */
+
+/* Bumped by 'StrErrorLocaleChanged()'. */
+static unsigned LocaleGen;
+
+/* This thread's cache, or NULL if it doesn't have one (yet). */
+static __thread StrErrorCache_t *MyCache;
+
+/* To free the caches of threads that exit. */
+static pthread_once_t CacheOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t CacheKey;
+static bool HaveCacheKey;
+
+/* A thread's error context.  The frames are a ring: frame 'N' (counting
+ * from the last 'ErrorClear()') is in 'Frames[N % ERROR_CONTEXT_DEPTH]',
+ * so only the last 'ERROR_CONTEXT_DEPTH' are kept. */
+typedef struct ErrorStack
+{ /* ErrorStack */
+  size_t Count;                 /* Pushed since the last clear. */
+  ErrorFrame_t Frames[ERROR_CONTEXT_DEPTH];
+} ErrorStack_t; /* ErrorStack */
+
+/* This thread's stack.  Unlike the caches it isn't on the heap: a push
+ * is always on an error path, often running out of memory, and must
+ * not lose the frame to a failed allocation.  It's small enough that
+ * every thread can have one. */
+static __thread ErrorStack_t MyErrors;
 
 /******************************************************************************
- * Get error message corresponding to a system 'errno' value.
- * Basically, a thread-safe version off 'strerror()'.
- *
- * All the POSIX and GNU/Linux variants of 'strerror()' have one or
- * more signficant falings:
- *
- * strerror(): Not thread-safe.
- *
- * strerror_r(): Requires the user to supply a buffer to hold the
- *   error message but there is no way to determine the longest
- *   possible error message and, consequently, the size of buffer to
- *   pass to 'strerror_r()'.  Furthermore, there are two common
- *   versions of 'strerror_r()' floating around: The POSIX version and
- *   the GNU version which have different semantics and return values.
- *   Making sure we get the right one and/or determining which one(s)
- *   are available requires messing with various "feature macros", a
- *   skill which I have yet to master.
- *
- * strerror_l(): Like 'strerror()' but thread-safe.  Unfortunately,
- *   also requires a 'locale_t' object.
- *
- * So, we provide 'StrError()' but otherwise behaves just like
- * 'strerror()' ... with the following exception: 'StrError()' is
- * based on 'strerror_l()' which, as noted above, requires a
- * 'locale_t` object.  We obtain a 'locale_t' for the current locale
- * by calling 'newlocale()' which may fail.  In this case 'StrError()'
- * returns an error message indicating that the (real) error message
- * could not be obtaind and why.
+ * These would be 'private' in C++.
  *****************************************************************************/
-const char *StrError(int ErrNo)
-{ /* StrError() */
+/* Get a 'locale_t', look up the message, and free the 'locale_t'
+ * again. */
+static const char *StrErrorNewLocale(int ErrNo)
+{ /* StrErrorNewLocale() */
   static const char *LocEInvalMsg =
     "<No error message.  EINVAL getting locale.  Request for invalid locale data category, or invalid locale name.>";
   static const char *LocENoEntMsg =
@@ -96,4 +115,208 @@ Return:
     freelocale(Locale);
   errno = SavedErrNo;
   return _RetVal;
+} /* StrErrorNewLocale() */
+
+/* Called by 'pthread' when a thread with a cache exits. */
+static void FreeCache(void *Ptr)
+{ /* FreeCache() */
+  StrErrorCache_t *Cache = Ptr;
+
+  if (Cache->Locale != (locale_t) 0)
+    freelocale(Cache->Locale);
+  free(Cache);
+  MyCache = NULL;
+} /* FreeCache() */
+
+static void MakeCacheKey(void)
+{ /* MakeCacheKey() */
+  HaveCacheKey = (pthread_key_create(&CacheKey, FreeCache) == 0);
+} /* MakeCacheKey() */
+
+/* This thread's cache, with an up to date 'Locale', or NULL if we
+ * can't have one right now. */
+static StrErrorCache_t *GetCache(void)
+{ /* GetCache() */
+  StrErrorCache_t *Cache = MyCache;
+  unsigned Gen = __atomic_load_n(&LocaleGen, __ATOMIC_ACQUIRE);
+  locale_t Locale;
+
+  if (Cache != NULL && Cache->Gen == Gen && Cache->Locale != (locale_t) 0)
+    return Cache;
+
+  if (Cache == NULL)
+  { /* First time. */
+    pthread_once(&CacheOnce, MakeCacheKey);
+    if (!HaveCacheKey || (Cache = calloc(1, sizeof(*Cache))) == NULL)
+      return NULL;
+    pthread_setspecific(CacheKey, Cache);
+    MyCache = Cache;
+  } /* First time. */
+
+  /* If this fails we try again next time. */
+  Locale = newlocale(LC_MESSAGES_MASK, "", (locale_t) 0);
+  if (Locale == (locale_t) 0)
+    return NULL;
+
+  if (Cache->Locale != (locale_t) 0)
+    freelocale(Cache->Locale);
+  Cache->Locale = Locale;
+  Cache->Gen = Gen;
+  memset(Cache->Msgs, 0, sizeof(Cache->Msgs));
+  return Cache;
+} /* GetCache() */
+
+/* The C library makes up a message for an error it doesn't know
+ * ("Unknown error 1234", or a translation) in a buffer that the next
+ * one overwrites, so those can't be cached.  They end with the
+ * number. */
+static bool IsUnknown(const char *Msg, int ErrNo)
+{ /* IsUnknown() */
+  char Num[16];
+  int Len = snprintf(Num, sizeof(Num), " %d", ErrNo);
+  size_t MsgLen = strlen(Msg);
+
+  return (MsgLen >= (size_t) Len &&
+          memcmp(Msg + MsgLen - (size_t) Len, Num, (size_t) Len) == 0);
+} /* IsUnknown() */
+
+/******************************************************************************
+ * Get error message corresponding to a system 'errno' value.
+ * Basically, a thread-safe version off 'strerror()'.
+ *
+ * All the POSIX and GNU/Linux variants of 'strerror()' have one or
+ * more signficant falings:
+ *
+ * strerror(): Not thread-safe.
+ *
+ * strerror_r(): Requires the user to supply a buffer to hold the
+ *   error message but there is no way to determine the longest
+ *   possible error message and, consequently, the size of buffer to
+ *   pass to 'strerror_r()'.  Furthermore, there are two common
+ *   versions of 'strerror_r()' floating around: The POSIX version and
+ *   the GNU version which have different semantics and return values.
+ *   Making sure we get the right one and/or determining which one(s)
+ *   are available requires messing with various "feature macros", a
+ *   skill which I have yet to master.
+ *
+ * strerror_l(): Like 'strerror()' but thread-safe.  Unfortunately,
+ *   also requires a 'locale_t' object.
+ *
+ * So, we provide 'StrError()' but otherwise behaves just like
+ * 'strerror()' ... with the following exception: 'StrError()' is
+ * based on 'strerror_l()' which, as noted above, requires a
+ * 'locale_t` object.  We obtain a 'locale_t' for the current locale
+ * by calling 'newlocale()' which may fail.  In this case 'StrError()'
+ * returns an error message indicating that the (real) error message
+ * could not be obtaind and why.
+ *
+ * Getting a 'locale_t' (and, worse, freeing it again) every time is
+ * slow, so each thread keeps one, along with the messages it has
+ * already looked up, and only gets a new one when
+ * 'StrErrorLocaleChanged()' says to.  Otherwise 'StrError()' is a
+ * table lookup, with no locks, allocation, or system calls.
+ *****************************************************************************/
+const char *StrError(int ErrNo)
+{ /* StrError() */
+  static const char *NoMsgMsg = "<No error message.>";
+  StrErrorCache_t *Cache;
+  const char *Msg, *_RetVal;
+  int SavedErrNo = errno;
+
+  /* Without a cache do it the slow way, which says what went wrong. */
+  if ((Cache = GetCache()) == NULL)
+  { /* No cache. */
+    RETURN(StrErrorNewLocale(ErrNo));
+  } /* No cache. */
+
+  if ((unsigned) ErrNo < STRERROR_CACHE_SIZE &&
+      (Msg = Cache->Msgs[ErrNo]) != NULL)
+  { /* Cached. */
+    RETURN(Msg);
+  } /* Cached. */
+
+  if ((Msg = strerror_l(ErrNo, Cache->Locale)) == NULL)
+    Msg = NoMsgMsg;
+  else if ((unsigned) ErrNo < STRERROR_CACHE_SIZE && !IsUnknown(Msg, ErrNo))
+    Cache->Msgs[ErrNo] = Msg;
+  RETURN(Msg);
+
+Return:
+  errno = SavedErrNo;
+  return _RetVal;
 } /* StrError() */
+
+void StrErrorLocaleChanged(void)
+{ /* StrErrorLocaleChanged() */
+  __atomic_add_fetch(&LocaleGen, 1, __ATOMIC_RELEASE);
+} /* StrErrorLocaleChanged() */
+
+void ErrorPush(const char *File, int Line, const char *Func, int ErrNo,
+               const char *Fmt, ...)
+{ /* ErrorPush() */
+  ErrorFrame_t *Frame;
+  int SavedErrNo = errno;
+  va_list Args;
+
+  Frame = &MyErrors.Frames[MyErrors.Count++ % ERROR_CONTEXT_DEPTH];
+  Frame->File = File;
+  Frame->Func = Func;
+  Frame->Line = Line;
+  Frame->ErrNo = ErrNo;
+  Frame->Msg[0] = '\0';
+  if (Fmt != NULL)
+  { /* Message. */
+    va_start(Args, Fmt);
+    vsnprintf(Frame->Msg, sizeof(Frame->Msg), Fmt, Args);
+    va_end(Args);
+  } /* Message. */
+  errno = SavedErrNo;
+} /* ErrorPush() */
+
+size_t ErrorDepth(void)
+{ /* ErrorDepth() */
+  return (MyErrors.Count < ERROR_CONTEXT_DEPTH ? MyErrors.Count
+          : ERROR_CONTEXT_DEPTH);
+} /* ErrorDepth() */
+
+const ErrorFrame_t *ErrorGetFrame(size_t I)
+{ /* ErrorGetFrame() */
+  size_t Depth = ErrorDepth();
+
+  if (I >= Depth)
+    return NULL;
+  return &MyErrors.Frames[(MyErrors.Count - Depth + I) %
+                          ERROR_CONTEXT_DEPTH];
+} /* ErrorGetFrame() */
+
+bool ErrorFormat(String_t *Str)
+{ /* ErrorFormat() */
+  size_t Depth = ErrorDepth(), I;
+  const ErrorFrame_t *Frame;
+  bool HaveMsg;
+
+  if (Depth == ERROR_CONTEXT_DEPTH && MyErrors.Count > Depth &&
+      StringStreamf(Str, "(%zu earlier frames not kept.)\n",
+                    MyErrors.Count - Depth) < 0)
+    return false;
+
+  for (I = 0; I < Depth; ++I)
+  { /* Each frame. */
+    /* "<message>.  <error>.", or whichever there is. */
+    Frame = ErrorGetFrame(I);
+    HaveMsg = (Frame->Msg[0] != '\0');
+    if (StringStreamf(Str, "%s %s %d: %s%s%s%s\n",
+                      Frame->File, Frame->Func, Frame->Line, Frame->Msg,
+                      (HaveMsg && Frame->ErrNo != 0 ? ".  " : ""),
+                      (Frame->ErrNo != 0 ? StrError(Frame->ErrNo) : ""),
+                      (HaveMsg || Frame->ErrNo != 0 ? "." : "")) < 0)
+      return false;
+  } /* Each frame. */
+
+  return true;
+} /* ErrorFormat() */
+
+void ErrorClear(void)
+{ /* ErrorClear() */
+  MyErrors.Count = 0;
+} /* ErrorClear() */
@@ -6,6 +6,9 @@
  * few handy macros.  Ultimately, we'd like to have a full blown error
  * handling "class"es.
  *****************************************************************************/
+#include <stdbool.h>
+#include <stddef.h>
+
 /******************************************************************************
  * This macro is pretty self explanatory.  We save the value 'val' in
  * the variable 'var' (actually, 'var' can be any valid 'lhs'), then
@@ -28,6 +31,79 @@
 #define RETURN(val) RETVAL = (val); goto Return
 #define EXIT(val) RETVAL = (val); goto Exit
 
+/******************************************************************************
+ * Error context.  Each thread has a small, fixed size stack of frames
+ * saying where an error was seen (file, line, and function), what
+ * 'errno' was, and, optionally, a message.  As an error is passed back
+ * up the call chain each function that sees it can push a frame, so
+ * whoever finally deals with it can say not just what went wrong but
+ * how it got there:
+ *
+ *   if ((Buff = malloc(Size)) == NULL)
+ *   { // Error.
+ *     ErrNo = errno;
+ *     EXIT_PUSH(false, ErrNo, "malloc(%zu) failed", Size);
+ *   } // Error.
+ *   ...
+ *   if (!ReadConfig(Path))
+ *   { // Error.
+ *     ErrNo = errno;
+ *     EXIT_PUSH(false, ErrNo, "Can't read '%s'", Path);
+ *   } // Error.
+ *   ...
+ *   if (!Init())
+ *   { // Error.
+ *     ErrorFormat(&Msg);        // All of it, innermost first.
+ *     ErrorClear();
+ *     ...
+ *   } // Error.
+ *
+ * Nothing happens until there's an error (the push is an out of line
+ * call, which the compiler moves out of the way), and nothing is
+ * formatted (other than the frame's message) until someone asks.  A
+ * thread's stack is thread local storage, not the heap, so pushing
+ * never allocates and never loses a frame, even when the error is
+ * running out of memory; it's kept small (under 1K) so that every
+ * thread can afford one.  When the stack is full the oldest frames make
+ * way for new ones, so a handler that doesn't call 'ErrorClear()'
+ * just leaves old frames to be pushed off.  'Fmt' may be NULL.
+ *****************************************************************************/
+/* Frames kept, and the longest message (including the '\0'). */
+#define ERROR_CONTEXT_DEPTH 8
+#define ERROR_MSG_SIZE 64
+
+typedef struct ErrorFrame
+{ /* ErrorFrame */
+  const char *File;
+  const char *Func;
+  int Line;
+  int ErrNo;
+  char Msg[ERROR_MSG_SIZE];     /* "" if none. */
+} ErrorFrame_t; /* ErrorFrame */
+
+struct String;
+
+#define ERROR_PUSH(errnum, ...) \
+  ErrorPush(__FILE__, __LINE__, __func__, (errnum), __VA_ARGS__)
+#define EXIT_PUSH(val, errnum, ...) ERROR_PUSH(errnum, __VA_ARGS__); EXIT(val)
+
+extern void ErrorPush(const char *File, int Line, const char *Func,
+                      int ErrNo, const char *Fmt, ...)
+  __attribute__((cold, format(printf, 5, 6)));
+
+/* Number of frames on this thread's stack, and the 'I'th, oldest
+ * (innermost) first, or NULL if there isn't one. */
+extern size_t ErrorDepth(void);
+extern const ErrorFrame_t *ErrorGetFrame(size_t I);
+
+/* Append this thread's frames to 'Str' (a 'String_t', see String.h),
+ * innermost first, one line each, in the same form as the library's
+ * diagnostics.  Returns 'false' and sets 'errno' on error. */
+extern bool ErrorFormat(struct String *Str);
+
+/* Empty this thread's stack. */
+extern void ErrorClear(void);
+
 /******************************************************************************
  * Get error message corresponding to a system 'errno' value.
  * Basically, a thread-safe version off 'strerror()'.
@@ -60,4 +136,13 @@
  *****************************************************************************/
 extern const char *StrError(int ErrNo);
 
+/******************************************************************************
+ * Each thread's 'StrError()' keeps the 'locale_t' it got the first
+ * time, and the messages it has looked up since.  Call this after
+ * changing the locale (e.g. with 'setlocale()', or by changing
+ * 'LC_MESSAGES' etc. in the environment) so that they all get new
+ * ones.
+ *****************************************************************************/
+extern void StrErrorLocaleChanged(void);
+
 #endif
@@ -0,0 +1,33 @@
+#include <errno.h>
+
+#include "XToStr.h"
+#include "XToStrImpl.h"
+
+/******************************************************************************
+ * Convert 'Val' to the shortest string that 'StrToF()' converts back
+ * to exactly 'Val'.  See 'XToStr.h'.
+ *****************************************************************************/
+int FToStr(float Val, char *Buff, size_t Size, size_t *Len)
+{ /* FToStr(float, char *, size_t, size_t *) */
+  char Temp[XTOSTR_FLT_MAX];
+  size_t N;
+
+  /* NULL pointer checking. */
+  if (Buff == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Write straight into 'Buff' if it's big enough for anything. */
+  if (Size > XTOSTR_FLT_MAX)
+  { /* Big enough. */
+    N = XToStrF(Val, Buff);
+    Buff[N] = '\0';
+    if (Len != NULL)
+      *Len = N;
+    return 0;
+  } /* Big enough. */
+
+  N = XToStrF(Val, Temp);
+  return XToStrCopy(Temp, N, Buff, Size, Len);
+} /* FToStr(float, char *, size_t, size_t *) */
@@ -0,0 +1,35 @@
+#include <errno.h>
+#include <stdint.h>
+
+#include "XToStr.h"
+#include "XToStrImpl.h"
+
+/******************************************************************************
+ * Convert 'Val' to a string in base 'Base'.  See 'XToStr.h'.
+ *****************************************************************************/
+int IMaxToStr(intmax_t Val, int Base, char *Buff, size_t Size, size_t *Len)
+{ /* IMaxToStr(intmax_t, int, char *, size_t, size_t *) */
+  char Temp[XTOSTR_BUFF_SIZE], *End = &Temp[sizeof(Temp)], *Str;
+  uintmax_t Mag;
+
+  /* NULL pointer checking. */
+  if (Buff == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  if (Base < 2 || Base > 36)
+  { /* Invalid base. */
+    if (Size != 0)
+      Buff[0] = '\0';
+    return EDOM;
+  } /* Invalid base. */
+
+  /* Negating in 'uintmax_t' is fine for INTMAX_MIN too. */
+  Mag = (Val < 0 ? -(uintmax_t) Val : (uintmax_t) Val);
+  Str = XToStrUMax(Mag, (unsigned) Base, End);
+  if (Val < 0)
+    *--Str = '-';
+
+  return XToStrCopy(Str, (size_t) (End - Str), Buff, Size, Len);
+} /* IMaxToStr(intmax_t, int, char *, size_t, size_t *) */
@@ -0,0 +1,311 @@
+/******************************************************************************
+ * Function definitions for our 'struct Intern' "class".  See Intern.h.
+ *
+ * The pool is an open addressing (linear probing) hash table of
+ * pointers to the strings, which are never moved or freed, so a
+ * reader needs nothing more than an acquire load of each slot: a slot
+ * is either empty or points at a string that was complete before it
+ * was stored there.  Writers (holding 'Lock') only ever fill empty
+ * slots.
+ *
+ * When the table gets 3/4 full a writer builds one twice the size and
+ * then publishes it.  A reader still probing the old one may miss a
+ * string added since, but then it takes the lock and looks again.
+ * Old tables are kept (on the 'Retired' list) until the pool is
+ * destroyed, since we can't know when the last reader is done with
+ * them.  They add up to less than the current one.
+ *****************************************************************************/
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Diag.h"
+#include "Errors.h"
+#include "Intern.h"
+
+/* Size of the first table.  A power of 2. */
+#define INTERN_MIN_SLOTS 64
+
+struct InternTable
+{ /* InternTable */
+  InternTable_t *Retired;       /* Next older retired table. */
+  size_t Mask;                  /* Number of slots - 1. */
+  const StringKey_t *Slots[];
+}; /* InternTable */
+
+/******************************************************************************
+ * These would be 'private' in C++.
+ *****************************************************************************/
+static InternTable_t *NewTable(size_t NSlots)
+{ /* NewTable() */
+  int ErrNo;
+  InternTable_t *Table, *_RetVal;
+
+  if ((Table = calloc(1, sizeof(*Table) + NSlots * sizeof(Table->Slots[0])))
+      == NULL)
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: calloc(%zu slots) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, NSlots, StrError(ErrNo));
+    EXIT(NULL);
+  } /* Error. */
+
+  Table->Mask = NSlots - 1;
+  RETURN(Table);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* NewTable() */
+
+/* Look for 'View', which hashes to 'Hash', in 'Table'.  If it isn't
+ * there '*Slot' is set to the empty slot it would go in. */
+static const StringKey_t *Probe(const InternTable_t *Table, StrView_t View,
+                                uint64_t Hash, size_t *Slot)
+{ /* Probe() */
+  const StringKey_t *Str;
+  size_t I;
+
+  for (I = Hash & Table->Mask; ; I = (I + 1) & Table->Mask)
+  { /* Each slot. */
+    if ((Str = __atomic_load_n(&Table->Slots[I], __ATOMIC_ACQUIRE)) == NULL)
+    { /* Not there. */
+      *Slot = I;
+      return NULL;
+    } /* Not there. */
+
+    if (Str->Hash == Hash && StrViewEqual(StringView(&Str->Str), View))
+      return Str;
+  } /* Each slot. */
+} /* Probe() */
+
+/* Replace the table with one twice the size.  'Lock' must be held. */
+static bool Grow(Intern_t *This)
+{ /* Grow() */
+  InternTable_t *Old = This->Table, *New;
+  const StringKey_t *Str;
+  size_t I, J;
+
+  if ((New = NewTable(2 * (Old->Mask + 1))) == NULL)
+    return false;
+
+  /* Nobody else can see 'New' yet, and everything in 'Old' is
+   * different, so this is just a copy. */
+  for (I = 0; I <= Old->Mask; ++I)
+    if ((Str = Old->Slots[I]) != NULL)
+    { /* Move it. */
+      for (J = Str->Hash & New->Mask; New->Slots[J] != NULL;
+           J = (J + 1) & New->Mask)
+        ;
+      New->Slots[J] = Str;
+    } /* Move it. */
+
+  __atomic_store_n(&This->Table, New, __ATOMIC_RELEASE);
+  Old->Retired = This->Retired;
+  This->Retired = Old;
+  return true;
+} /* Grow() */
+
+/* A copy of 'View', and its hash, in the arena.  'Lock' must be
+ * held. */
+static StringKey_t *NewEntry(Intern_t *This, StrView_t View, uint64_t Hash)
+{ /* NewEntry() */
+  bool Local = (View.Size < STRING_MIN_BUFF_SIZE);
+  StringKey_t *Key;
+  String_t *Str;
+
+  if ((Key = ArenaMalloc(&This->Arena, sizeof(StringKey_t) +
+                         (Local ? 0 : View.Size + 1))) == NULL)
+    return NULL;
+
+  Str = &Key->Str;
+  ConstructStringAlloc(Str, ArenaAlloc(&This->Arena));
+  if (!Local)
+  { /* After the 'StringKey_t'. */
+    Str->Ptr = (char *) (Key + 1);
+    Str->Buff.Size = View.Size + 1;
+  } /* After the 'StringKey_t'. */
+
+  if (View.Size != 0)
+    memcpy(Str->Ptr, View.Ptr, View.Size);
+  Str->Ptr[View.Size] = '\0';
+  Str->Size = View.Size;
+  Key->Hash = Hash;
+  return Key;
+} /* NewEntry() */
+
+/******************************************************************************
+ * Public methods.
+ *****************************************************************************/
+bool ConstructIntern(Intern_t *This)
+{ /* ConstructIntern() */
+  int ErrNo;
+  bool _RetVal;
+
+  /* Error checking. */
+  if (This == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    ErrNo = EFAULT;
+    EXIT(false);
+  } /* Error. */
+
+  if ((This->Table = NewTable(INTERN_MIN_SLOTS)) == NULL)
+  { /* Error. */
+    ErrNo = errno;
+    EXIT(false);
+  } /* Error. */
+
+  This->Retired = NULL;
+  This->Count = 0;
+  ConstructArena(&This->Arena, 0, NULL);
+  pthread_mutex_init(&This->Lock, NULL);
+  RETURN(true);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* ConstructIntern() */
+
+Intern_t *NewIntern(void)
+{ /* NewIntern() */
+  int ErrNo;
+  Intern_t *This = NULL, *_RetVal;
+
+  if ((This = malloc(sizeof(Intern_t))) == NULL)
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: malloc(%zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, sizeof(Intern_t),
+         StrError(ErrNo));
+    EXIT(NULL);
+  } /* Error. */
+
+  if (!ConstructIntern(This))
+  { /* Error. */
+    ErrNo = errno;
+    EXIT(NULL);
+  } /* Error. */
+  RETURN(This);
+
+Exit:
+  free(This);
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* NewIntern() */
+
+void DestroyIntern(Intern_t *This)
+{ /* DestroyIntern() */
+  InternTable_t *Table;
+
+  if (This != NULL && This->Table != NULL)
+  { /* Exists. */
+    while ((Table = This->Retired) != NULL)
+    { /* Each retired table. */
+      This->Retired = Table->Retired;
+      free(Table);
+    } /* Each retired table. */
+    free(This->Table);
+    This->Table = NULL;
+    This->Count = 0;
+    DestroyArena(&This->Arena);
+    pthread_mutex_destroy(&This->Lock);
+  } /* Exists. */
+} /* DestroyIntern() */
+
+void DeleteIntern(Intern_t *This)
+{ /* DeleteIntern() */
+  if (This != NULL)
+  { /* Exists. */
+    DestroyIntern(This);
+    free(This);
+  } /* Exists. */
+} /* DeleteIntern() */
+
+const String_t *InternView(Intern_t *This, StrView_t View)
+{ /* InternView() */
+  int ErrNo;
+  const StringKey_t *Key;
+  const String_t *_RetVal;
+  StringKey_t *New;
+  InternTable_t *Table;
+  uint64_t Hash;
+  size_t Slot;
+
+  /* Error checking. */
+  if (This == NULL || (View.Ptr == NULL && View.Size != 0))
+  { /* Error. */
+    Diag("%s %s %d: '%s' is NULL.\n",
+         __FILE__, __func__, __LINE__,
+         (This == NULL ? "This" : "View.Ptr"));
+    errno = EFAULT;
+    return NULL;
+  } /* Error. */
+
+  /* The usual case: it's already there. */
+  Hash = StrViewHash(View);
+  Table = __atomic_load_n(&This->Table, __ATOMIC_ACQUIRE);
+  if ((Key = Probe(Table, View, Hash, &Slot)) != NULL)
+    return &Key->Str;
+
+  /* Add it, unless another thread just has. */
+  pthread_mutex_lock(&This->Lock);
+  if ((Key = Probe(This->Table, View, Hash, &Slot)) != NULL)
+  { /* Beaten to it. */
+    RETURN(&Key->Str);
+  } /* Beaten to it. */
+
+  if ((This->Count + 1) * 4 > (This->Table->Mask + 1) * 3)
+  { /* Too full. */
+    if (!Grow(This))
+    { /* Error. */
+      ErrNo = errno;
+      EXIT(NULL);
+    } /* Error. */
+    Probe(This->Table, View, Hash, &Slot);
+  } /* Too full. */
+
+  if ((New = NewEntry(This, View, Hash)) == NULL)
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: NewEntry(%zu characters) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, View.Size, StrError(ErrNo));
+    EXIT(NULL);
+  } /* Error. */
+
+  /* Only now that it's complete can readers see it. */
+  __atomic_store_n(&This->Table->Slots[Slot], New, __ATOMIC_RELEASE);
+  __atomic_store_n(&This->Count, This->Count + 1, __ATOMIC_RELAXED);
+  RETURN(&New->Str);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  pthread_mutex_unlock(&This->Lock);
+  return _RetVal;
+} /* InternView() */
+
+const String_t *InternFind(Intern_t *This, StrView_t View)
+{ /* InternFind() */
+  const StringKey_t *Key;
+  size_t Slot;
+
+  Key = Probe(__atomic_load_n(&This->Table, __ATOMIC_ACQUIRE), View,
+              StrViewHash(View), &Slot);
+  return (Key == NULL ? NULL : &Key->Str);
+} /* InternFind() */
+
+size_t InternCount(Intern_t *This)
+{ /* InternCount() */
+  return __atomic_load_n(&This->Count, __ATOMIC_RELAXED);
+} /* InternCount() */
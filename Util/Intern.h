@@ -0,0 +1,94 @@
+#ifndef Intern_h
+#define Intern_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ * A string intern pool.  Interning a value gives back the pool's one
+ * copy of it, a 'const String_t *' that stays put until the pool is
+ * destroyed, so however many times a value turns up it's only stored
+ * once, and two interned strings (from the same pool) are equal if and
+ * only if the pointers are.
+ *
+ * Looking up a value that's already there takes no lock (it's one
+ * hash and, almost always, one probe), so any number of threads can
+ * intern at once.  Adding a new value takes the pool's lock.  The
+ * strings themselves, and their hashes (as 'StringKey_t's), are in
+ * an arena (see 'Arena.h'), so there's no per-string
+ * 'malloc()' and nothing is freed until the pool is.
+ *
+ * For example:
+ *
+ *   Intern_t *Hosts = NewIntern();
+ *   const String_t *Host;
+ *
+ *   while (...)
+ *   { // For each record.
+ *     if ((Host = InternView(Hosts, Field)) == NULL)
+ *       ...                     // Out of memory.
+ *     if (Host == LastHost)     // Same value.
+ *       ...
+ *   } // For each record.
+ *   DeleteIntern(Hosts);        // Invalidates all of them.
+ *
+ * The interned strings must not be changed (or destroyed).
+ *****************************************************************************/
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <Arena.h>
+#include <String.h>
+#include <StrView.h>
+
+typedef struct InternTable InternTable_t;
+
+typedef struct Intern
+{ /* Intern */
+  InternTable_t *Table;         /* Current table.  Read without 'Lock'. */
+  InternTable_t *Retired;       /* Outgrown tables, still being read. */
+  size_t Count;                 /* Strings in the pool. */
+  Arena_t Arena;                /* The strings. */
+  pthread_mutex_t Lock;         /* For adding strings. */
+} Intern_t; /* Intern */
+
+  /* Constructors and destructors, as for 'String_t'. */
+  extern bool ConstructIntern(Intern_t *This);
+  extern Intern_t *NewIntern(void);
+  extern void DestroyIntern(Intern_t *This);
+  extern void DeleteIntern(Intern_t *This);
+
+  /* The pool's copy of a value, added if it isn't there yet.  Returns
+   * NULL and sets 'errno' on error. */
+  extern const String_t *InternView(Intern_t *This, StrView_t View);
+  static inline const String_t *InternCStr(Intern_t *This, const char *CStr);
+  static inline const String_t *InternStr(Intern_t *This,
+                                          const String_t *Str);
+
+  /* The pool's copy of a value if it has one, NULL if it doesn't.
+   * Never takes the lock. */
+  extern const String_t *InternFind(Intern_t *This, StrView_t View);
+
+  /* The number of different values in the pool. */
+  extern size_t InternCount(Intern_t *This);
+
+/******************************************************************************
+ * Inline method definitions.
+ *****************************************************************************/
+  static inline const String_t *InternCStr(Intern_t *This, const char *CStr)
+  { /* InternCStr() */
+    return InternView(This, StrViewCStr(CStr));
+  } /* InternCStr() */
+
+  static inline const String_t *InternStr(Intern_t *This,
+                                          const String_t *Str)
+  { /* InternStr() */
+    return InternView(This, StringView(Str));
+  } /* InternStr() */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif
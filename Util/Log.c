@@ -0,0 +1,870 @@
+/******************************************************************************
+ * Function definitions for the asynchronous logger.  See Log.h.
+ *
+ * Each thread that logs gets a 'LogBuff_t': a single producer, single
+ * consumer byte ring of records, each a 'LogRec_t' header followed by
+ * either the formatted message or the encoded arguments for a compiled
+ * format.  The thread builds the message or arguments in its
+ * 'Scratch' string, reserves room on the ring (a record that won't fit
+ * before the end of the ring goes at the start, after a 'LOG_REC_SKIP'
+ * record), copies it in, and publishes it by advancing 'Head'.  The
+ * buffers are on a list that threads push themselves onto, without a
+ * lock.
+ *
+ * The consumer is whoever holds 'DrainLock': the writer thread or
+ * 'LogFlush()'.  It goes down the list turning each thread's records
+ * into an 'iovec' for the prefix (time, level, and place, built in
+ * 'Out'), one for the message (straight off the ring, or, for encoded
+ * arguments, formatted into 'Out'), and maybe one for a newline, and
+ * writes them out a batch at a time before advancing that thread's
+ * 'Tail'.  The consumer is also the only one who takes buffers off the
+ * list, once their threads have exited and they're empty.
+ *
+ * Waking the writer works as in Diag.c, except that a thread whose
+ * ring gets half full wakes it even if it's only lingering.  'fork()'
+ * is handled as in Diag.c too: the child drops what the parent has yet
+ * to write, and writes its own records itself.
+ *****************************************************************************/
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Diag.h"
+#include "Errors.h"
+#include "Log.h"
+#include "StringImpl.h"
+
+/* Size of each thread's ring.  A power of 2. */
+#define LOG_RING_SIZE ((size_t) 64 * 1024)
+#define LOG_RING_MASK (LOG_RING_SIZE - 1)
+
+/* The biggest record.  Longer messages are cut short. */
+#define LOG_MAX_RECORD (LOG_RING_SIZE / 4)
+
+/* Records per 'writev()'.  Each takes up to three 'iovec's. */
+#define LOG_BATCH 256
+
+/* How long the writer waits, once woken, before writing. */
+#define LOG_LINGER_NS 1000000
+
+/* Kinds of record. */
+#define LOG_REC_TEXT 0          /* A formatted message. */
+#define LOG_REC_ARGS 1          /* 'Fmt' and its encoded arguments. */
+#define LOG_REC_SKIP 2          /* Nothing, up to the end of the ring. */
+
+typedef struct LogRec
+{ /* LogRec */
+  uint32_t Size;                /* All of it, a multiple of 8. */
+  uint8_t Kind;                 /* LOG_REC_xxx.  Size and Kind fit in */
+  uint8_t Level;                /* the smallest 'LOG_REC_SKIP'. */
+  uint32_t Len;                 /* Of the message or arguments. */
+  int Line;
+  const char *File;
+  const StringFmt_t *Fmt;       /* For 'LOG_REC_ARGS'. */
+  struct timespec Time;
+} LogRec_t; /* LogRec */
+
+typedef struct LogBuff LogBuff_t;
+struct LogBuff
+{ /* LogBuff */
+  size_t Head;                  /* Written by the thread. */
+  uint64_t Dropped;             /* Since the consumer last said. */
+  String_t Scratch;             /* For building a record. */
+  LogBuff_t *Next;              /* On 'Buffs'. */
+  bool Dead;                    /* The thread has exited. */
+  size_t Tail __attribute__((aligned(64))); /* Written by the consumer. */
+  char Ring[] __attribute__((aligned(64)));
+}; /* LogBuff */
+
+static const char *LevelNames[] =
+  { "TRACE", "DEBUG", "INFO ", "WARN ", "ERROR", "FATAL" };
+
+static int MinLevel = LOG_LEVEL_TRACE;
+static int OutFd = STDERR_FILENO;
+
+/* This thread's buffer, and everyone's. */
+static __thread LogBuff_t *MyBuff;
+static LogBuff_t *Buffs;
+static pthread_key_t BuffKey;
+static uint64_t Lost;                   /* Threads with no buffer. */
+
+/* The consumer's stuff. */
+static pthread_mutex_t DrainLock = PTHREAD_MUTEX_INITIALIZER;
+static String_t Out;
+static bool HaveOut;
+static time_t OutSec = -1;              /* The second in 'OutTime'. */
+static char OutTime[32];
+static size_t OutTimeLen;
+
+/* The writer thread, and how to wake it. */
+static pthread_once_t StartOnce = PTHREAD_ONCE_INIT;
+static bool Started;
+static bool HaveBuffKey;
+static sem_t Wake;
+static int Sleeping;
+
+/******************************************************************************
+ * These would be 'private' in C++.
+ *****************************************************************************/
+/* Called by 'pthread' when a thread with a buffer exits.  The
+ * consumer frees the buffer once it's empty. */
+static void FreeBuff(void *Ptr)
+{ /* FreeBuff() */
+  LogBuff_t *Buff = Ptr;
+
+  DestroyString(&Buff->Scratch);
+  MyBuff = NULL;
+  __atomic_store_n(&Buff->Dead, true, __ATOMIC_RELEASE);
+} /* FreeBuff() */
+
+/* Write all of 'Iov', or as much as 'OutFd' will take. */
+static void WriteAll(struct iovec *Iov, int NIov)
+{ /* WriteAll() */
+  int Fd = __atomic_load_n(&OutFd, __ATOMIC_RELAXED);
+  ssize_t N;
+
+  while (NIov > 0)
+  { /* Until it's all written. */
+    if ((N = writev(Fd, Iov, NIov)) < 0)
+    { /* Error. */
+      if (errno == EINTR)
+        continue;
+      Diag("%s %s %d: writev(%d) failed.  %s.\n",
+           __FILE__, __func__, __LINE__, Fd, StrError(errno));
+      return;
+    } /* Error. */
+
+    for (; NIov > 0 && (size_t) N >= Iov->iov_len; ++Iov, --NIov)
+      N -= (ssize_t) Iov->iov_len;
+    if (NIov > 0)
+    { /* Part of one. */
+      Iov->iov_base = (char *) Iov->iov_base + N;
+      Iov->iov_len -= (size_t) N;
+    } /* Part of one. */
+  } /* Until it's all written. */
+} /* WriteAll() */
+
+/* Put the 'Len' digits of 'Val' at 'End' - 'Len'. */
+static inline void Digits(char *End, unsigned long Val, int Len)
+{ /* Digits() */
+  while (Len-- > 0)
+  { /* Each digit. */
+    *--End = (char) ('0' + Val % 10);
+    Val /= 10;
+  } /* Each digit. */
+} /* Digits() */
+
+/* Append the start of a line to 'Out'.  This is most of the writer's
+ * work, so it's done by hand: the date and time only change once a
+ * second. */
+static bool Prefix(const struct timespec *Time, int Level, const char *File,
+                   int Line)
+{ /* Prefix() */
+  char Buff[64], *Ptr;
+  unsigned long Num;
+  struct tm Tm;
+  int Len;
+
+  if (Time->tv_sec != OutSec)
+  { /* New second. */
+    if (localtime_r(&Time->tv_sec, &Tm) == NULL ||
+        (OutTimeLen = strftime(OutTime, sizeof(OutTime), "%Y-%m-%d %H:%M:%S",
+                               &Tm)) == 0)
+      OutTimeLen = 0;
+    OutSec = Time->tv_sec;
+  } /* New second. */
+
+  /* "<date> <time>.<microseconds> <level> " */
+  Ptr = Buff;
+  memcpy(Ptr, OutTime, OutTimeLen);
+  Ptr += OutTimeLen;
+  *Ptr++ = '.';
+  Digits(Ptr += 6, (unsigned long) Time->tv_nsec / 1000, 6);
+  *Ptr++ = ' ';
+  memcpy(Ptr, LevelNames[Level], 5);
+  Ptr += 5;
+  *Ptr++ = ' ';
+  if (!StringAppendView(&Out, StrView(Buff, (size_t) (Ptr - Buff))) ||
+      !StringAppendCStr(&Out, File))
+    return false;
+
+  /* ":<line>: " */
+  for (Len = 1, Num = (unsigned long) (Line < 0 ? 0 : Line); Num >= 10;
+       Num /= 10)
+    ++Len;
+  Ptr = Buff;
+  *Ptr++ = ':';
+  Digits(Ptr += Len, (unsigned long) (Line < 0 ? 0 : Line), Len);
+  *Ptr++ = ':';
+  *Ptr++ = ' ';
+  return StringAppendView(&Out, StrView(Buff, (size_t) (Ptr - Buff)));
+} /* Prefix() */
+
+/* Take 'Size' bytes from '*Data'. */
+static inline void Get(const char **Data, void *Val, size_t Size)
+{ /* Get() */
+  memcpy(Val, *Data, Size);
+  *Data += Size;
+} /* Get() */
+
+/* Append one argument, the one after 'Start', to 'This' as
+ * 'StringFormatArg()' would. */
+static bool FormatOne(String_t *This, const StringSpec_t *Spec, size_t Start,
+                      ...)
+{ /* FormatOne() */
+  va_list Ap;
+  bool Ok;
+
+  va_start(Ap, Start);
+  Ok = StringFormatArg(This, Spec, Start, &Ap);
+  va_end(Ap);
+  return Ok;
+} /* FormatOne() */
+
+/* Put the arguments for 'Fmt' in 'Data', for 'Decode()'.  Each
+ * argument is stored as the type it's passed to 'FormatOne()' as.
+ * Strings are copied, preceded by their length ('SIZE_MAX' for NULL)
+ * and followed by a '\0'.  Returns 'false' if 'Fmt' can't be deferred
+ * (or we run out of memory). */
+static bool Encode(String_t *Data, const StringFmt_t *Fmt, va_list Ap)
+{ /* Encode() */
+  const StringPiece_t *Piece, *End = &Fmt->Pieces[Fmt->NPieces];
+  const StringSpec_t *Spec;
+  const char *Str;
+  long double LDbl;
+  uintmax_t UMax;
+  intmax_t IMax;
+  double Dbl;
+  size_t Len;
+  void *Ptr;
+  int Int, Prec;
+  bool Ok = true;
+
+  if (Fmt->Fallback)
+    return false;
+
+#define PUT(Val) (Ok = Ok && StringAppendView(Data, StrView((const char *) \
+                                                           &(Val),          \
+                                                           sizeof(Val))))
+
+  for (Piece = Fmt->Pieces; Ok && Piece != End; ++Piece)
+  { /* For each piece. */
+    if ((Spec = &Piece->Spec)->Conv == '\0')
+      continue;
+
+    if (Spec->Width == STRING_FMT_ARG)
+    { /* Width. */
+      Int = va_arg(Ap, int);
+      PUT(Int);
+    } /* Width. */
+
+    Prec = Spec->Prec;
+    if (Prec == STRING_FMT_ARG)
+    { /* Precision. */
+      Prec = va_arg(Ap, int);
+      PUT(Prec);
+    } /* Precision. */
+
+    switch (Spec->Conv)
+    { /* Conversion. */
+    case 'd': case 'i':
+      switch (Spec->Len)
+      { /* Get the argument. */
+      case STRING_LEN_HH: IMax = (signed char) va_arg(Ap, int); break;
+      case STRING_LEN_H: IMax = (short) va_arg(Ap, int); break;
+      case STRING_LEN_L: IMax = va_arg(Ap, long); break;
+      case STRING_LEN_LL: IMax = va_arg(Ap, long long); break;
+      case STRING_LEN_J: IMax = va_arg(Ap, intmax_t); break;
+      case STRING_LEN_Z: IMax = (intmax_t) va_arg(Ap, size_t); break;
+      case STRING_LEN_T: IMax = va_arg(Ap, ptrdiff_t); break;
+      default: IMax = va_arg(Ap, int); break;
+      } /* Get the argument. */
+      PUT(IMax);
+      break;
+
+    case 'o': case 'u': case 'x': case 'X':
+      switch (Spec->Len)
+      { /* Get the argument. */
+      case STRING_LEN_HH: UMax = (unsigned char) va_arg(Ap, unsigned); break;
+      case STRING_LEN_H: UMax = (unsigned short) va_arg(Ap, unsigned); break;
+      case STRING_LEN_L: UMax = va_arg(Ap, unsigned long); break;
+      case STRING_LEN_LL: UMax = va_arg(Ap, unsigned long long); break;
+      case STRING_LEN_J: UMax = va_arg(Ap, uintmax_t); break;
+      case STRING_LEN_Z: UMax = va_arg(Ap, size_t); break;
+      case STRING_LEN_T: UMax = (uintmax_t) va_arg(Ap, ptrdiff_t); break;
+      default: UMax = va_arg(Ap, unsigned); break;
+      } /* Get the argument. */
+      PUT(UMax);
+      break;
+
+    case 'p':
+      Ptr = va_arg(Ap, void *);
+      PUT(Ptr);
+      break;
+
+    case 'c':
+      Int = va_arg(Ap, int);
+      PUT(Int);
+      break;
+
+    case 's':
+      /* Only as much as the precision will show. */
+      if ((Str = va_arg(Ap, const char *)) == NULL)
+        Len = SIZE_MAX;
+      else
+        Len = (Prec < 0 ? strlen(Str) : strnlen(Str, (size_t) Prec));
+      PUT(Len);
+      if (Str != NULL && Ok)
+        Ok = (StringAppendView(Data, StrView(Str, Len)) &&
+              StringAppendView(Data, StrView("", 1)));
+      break;
+
+    case 'n':
+      return false;
+
+    default:
+      if (Spec->Len == STRING_LEN_LD)
+      { /* long double. */
+        LDbl = va_arg(Ap, long double);
+        PUT(LDbl);
+      } /* long double. */
+      else
+      { /* double. */
+        Dbl = va_arg(Ap, double);
+        PUT(Dbl);
+      } /* double. */
+      break;
+    } /* Conversion. */
+  } /* For each piece. */
+
+#undef PUT
+
+  return Ok;
+} /* Encode() */
+
+/* Append 'Fmt' formatted with the arguments 'Encode()' put in 'Data'
+ * to 'Out'.  The result is the same as 'StringStreamFmt()'s. */
+static bool Decode(const StringFmt_t *Fmt, const char *Data)
+{ /* Decode() */
+  const StringPiece_t *Piece, *End = &Fmt->Pieces[Fmt->NPieces];
+  size_t Start = Out.Size, Len;
+  StringSpec_t Spec;
+  long double LDbl;
+  uintmax_t UMax;
+  intmax_t IMax;
+  double Dbl;
+  void *Ptr;
+  int Int;
+  bool Ok = true;
+
+  for (Piece = Fmt->Pieces; Ok && Piece != End; ++Piece)
+  { /* For each piece. */
+    if (Piece->Len != 0 &&
+        !(Ok = StringAppendView(&Out, StrView(Piece->Lit, Piece->Len))))
+      break;
+    if ((Spec = Piece->Spec).Conv == '\0')
+      continue;
+
+    /* Width and precision become part of the specification. */
+    if (Spec.Width == STRING_FMT_ARG)
+    { /* Width. */
+      Get(&Data, &Int, sizeof(Int));
+      if (Int < 0)
+      { /* Negative means '-'. */
+        Spec.Flags |= STRING_FMT_MINUS;
+        Int = (Int == INT_MIN ? INT_MAX : -Int);
+      } /* Negative means '-'. */
+      Spec.Width = Int;
+    } /* Width. */
+
+    if (Spec.Prec == STRING_FMT_ARG)
+    { /* Precision. */
+      Get(&Data, &Int, sizeof(Int));
+      Spec.Prec = (Int < 0 ? -1 : Int);
+    } /* Precision. */
+
+    switch (Spec.Conv)
+    { /* Conversion. */
+    case 'd': case 'i':
+      Get(&Data, &IMax, sizeof(IMax));
+      Spec.Len = STRING_LEN_J;
+      Ok = FormatOne(&Out, &Spec, Start, IMax);
+      break;
+
+    case 'o': case 'u': case 'x': case 'X':
+      Get(&Data, &UMax, sizeof(UMax));
+      Spec.Len = STRING_LEN_J;
+      Ok = FormatOne(&Out, &Spec, Start, UMax);
+      break;
+
+    case 'p':
+      Get(&Data, &Ptr, sizeof(Ptr));
+      Ok = FormatOne(&Out, &Spec, Start, Ptr);
+      break;
+
+    case 'c':
+      Get(&Data, &Int, sizeof(Int));
+      Ok = FormatOne(&Out, &Spec, Start, Int);
+      break;
+
+    case 's':
+      Get(&Data, &Len, sizeof(Len));
+      if (Len == SIZE_MAX)
+        Ok = FormatOne(&Out, &Spec, Start, (const char *) NULL);
+      else
+      { /* The copy. */
+        Ok = FormatOne(&Out, &Spec, Start, Data);
+        Data += Len + 1;
+      } /* The copy. */
+      break;
+
+    default:
+      if (Spec.Len == STRING_LEN_LD)
+      { /* long double. */
+        Get(&Data, &LDbl, sizeof(LDbl));
+        Ok = FormatOne(&Out, &Spec, Start, LDbl);
+      } /* long double. */
+      else
+      { /* double. */
+        Get(&Data, &Dbl, sizeof(Dbl));
+        Ok = FormatOne(&Out, &Spec, Start, Dbl);
+      } /* double. */
+      break;
+    } /* Conversion. */
+  } /* For each piece. */
+
+  return Ok;
+} /* Decode() */
+
+/* Write out everything on 'Buff'.  'DrainLock' must be held. */
+static void DrainBuff(LogBuff_t *Buff)
+{ /* DrainBuff() */
+  /* While 'Out' is being built it may move, so its parts of the
+   * batch are offsets (with 'Ptr' NULL) until it's written. */
+  struct { const char *Ptr; size_t Off, Len; } Parts[3 * LOG_BATCH + 1];
+  struct iovec Iov[3 * LOG_BATCH + 1];
+  size_t Head = __atomic_load_n(&Buff->Head, __ATOMIC_ACQUIRE);
+  size_t Tail = Buff->Tail, Off;
+  struct timespec Now;
+  const LogRec_t *Rec;
+  const char *Msg;
+  uint64_t Dropped;
+  int NParts, I;
+
+#define ADD_OUT(From) (Parts[NParts].Ptr = NULL, Parts[NParts].Off = (From), \
+                       Parts[NParts++].Len = Out.Size - (From))
+
+  while (Tail != Head)
+  { /* A batch at a time. */
+    StringClear(&Out);
+    NParts = 0;
+    while (Tail != Head && NParts + 3 <= 3 * LOG_BATCH)
+    { /* Each record. */
+      Rec = (const LogRec_t *) &Buff->Ring[Tail & LOG_RING_MASK];
+      Tail += Rec->Size;
+      if (Rec->Kind == LOG_REC_SKIP)
+        continue;
+
+      Off = Out.Size;
+      if (!Prefix(&Rec->Time, Rec->Level, Rec->File, Rec->Line))
+      { /* Error. */
+        Out.Size = Off;
+        continue;
+      } /* Error. */
+
+      if (Rec->Kind == LOG_REC_TEXT)
+      { /* Straight off the ring. */
+        ADD_OUT(Off);
+        Msg = (const char *) (Rec + 1);
+        Parts[NParts].Ptr = Msg;
+        Parts[NParts++].Len = Rec->Len;
+        if (Rec->Len == 0 || Msg[Rec->Len - 1] != '\n')
+        { /* Add a newline. */
+          Parts[NParts].Ptr = "\n";
+          Parts[NParts++].Len = 1;
+        } /* Add a newline. */
+      } /* Straight off the ring. */
+      else if (Decode(Rec->Fmt, (const char *) (Rec + 1)))
+      { /* Formatted. */
+        if (Out.Size == Off || Out.Ptr[Out.Size - 1] != '\n')
+          StringAppendView(&Out, StrView("\n", 1));
+        ADD_OUT(Off);
+      } /* Formatted. */
+      else
+        Out.Size = Off;
+    } /* Each record. */
+
+    if ((Dropped = __atomic_exchange_n(&Buff->Dropped, 0, __ATOMIC_RELAXED))
+        != 0)
+    { /* Say so. */
+      clock_gettime(CLOCK_REALTIME, &Now);
+      Off = Out.Size;
+      if (Prefix(&Now, LOG_LEVEL_WARN, __FILE__, __LINE__) &&
+          StringStreamf(&Out, "%llu records dropped.\n",
+                        (unsigned long long) Dropped) >= 0)
+        ADD_OUT(Off);
+    } /* Say so. */
+
+    for (I = 0; I < NParts; ++I)
+    { /* Now 'Out' stays put. */
+      Iov[I].iov_base = (void *) (Parts[I].Ptr != NULL ? Parts[I].Ptr
+                                  : &Out.Ptr[Parts[I].Off]);
+      Iov[I].iov_len = Parts[I].Len;
+    } /* Now 'Out' stays put. */
+    WriteAll(Iov, NParts);
+
+    /* Only now can the thread have the space back. */
+    __atomic_store_n(&Buff->Tail, Tail, __ATOMIC_RELEASE);
+  } /* A batch at a time. */
+
+#undef ADD_OUT
+} /* DrainBuff() */
+
+/* Write out every thread's records, and free the buffers of threads
+ * that have exited.  'DrainLock' must be held. */
+static void Drain(void)
+{ /* Drain() */
+  LogBuff_t *Buff, *Next, *Pred = NULL, *First;
+  uint64_t NLost;
+
+  if (!HaveOut)
+    HaveOut = ConstructString(&Out);
+
+  for (Buff = __atomic_load_n(&Buffs, __ATOMIC_ACQUIRE); Buff != NULL;
+       Buff = Next)
+  { /* Each buffer. */
+    Next = Buff->Next;
+    DrainBuff(Buff);
+    if (!__atomic_load_n(&Buff->Dead, __ATOMIC_ACQUIRE) ||
+        __atomic_load_n(&Buff->Head, __ATOMIC_ACQUIRE) != Buff->Tail)
+    { /* Keep it. */
+      Pred = Buff;
+      continue;
+    } /* Keep it. */
+
+    /* Threads only ever push themselves on the front, so if it's not
+     * the first one we're the only one changing its predecessor. */
+    First = Buff;
+    if (Pred == NULL &&
+        !__atomic_compare_exchange_n(&Buffs, &First, Next, false,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+      for (Pred = First; Pred->Next != Buff; Pred = Pred->Next)
+        ;
+    if (Pred != NULL)
+      Pred->Next = Next;
+    free(Buff);
+  } /* Each buffer. */
+
+  if ((NLost = __atomic_exchange_n(&Lost, 0, __ATOMIC_RELAXED)) != 0)
+    Diag("%s %s %d: %llu log records lost.  No buffer.\n",
+         __FILE__, __func__, __LINE__, (unsigned long long) NLost);
+} /* Drain() */
+
+/* Whether any thread has records waiting.  'DrainLock' must be
+ * held. */
+static bool AnyReady(void)
+{ /* AnyReady() */
+  LogBuff_t *Buff;
+
+  for (Buff = __atomic_load_n(&Buffs, __ATOMIC_ACQUIRE); Buff != NULL;
+       Buff = Buff->Next)
+    if (__atomic_load_n(&Buff->Head, __ATOMIC_ACQUIRE) != Buff->Tail)
+      return true;
+  return false;
+} /* AnyReady() */
+
+static void *Writer(void *Arg)
+{ /* Writer() */
+  struct timespec Until;
+  bool Ready;
+
+  (void) Arg;
+  for (;;)
+  { /* Forever. */
+    pthread_mutex_lock(&DrainLock);
+    Drain();
+    __atomic_store_n(&Sleeping, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    Ready = AnyReady();
+    pthread_mutex_unlock(&DrainLock);
+
+    if (!Ready)
+    { /* Sleep. */
+      while (sem_wait(&Wake) != 0 && errno == EINTR)
+        ;
+
+      /* Give the rest of a bunch of records a moment to turn up,
+       * unless a thread's ring is filling up and it wakes us again.
+       * Posts from while we were busy don't count. */
+      while (sem_trywait(&Wake) == 0)
+        ;
+      clock_gettime(CLOCK_REALTIME, &Until);
+      if ((Until.tv_nsec += LOG_LINGER_NS) >= 1000000000)
+      { /* Carry. */
+        Until.tv_nsec -= 1000000000;
+        ++Until.tv_sec;
+      } /* Carry. */
+      while (sem_timedwait(&Wake, &Until) != 0 && errno == EINTR)
+        ;
+    } /* Sleep. */
+    else
+      __atomic_store_n(&Sleeping, 0, __ATOMIC_RELAXED);
+  } /* Forever. */
+
+  return NULL;
+} /* Writer() */
+
+/* Around 'fork()', so the child doesn't inherit 'DrainLock' held by a
+ * thread it doesn't have. */
+static void ForkPrepare(void)
+{ /* ForkPrepare() */
+  pthread_mutex_lock(&DrainLock);
+} /* ForkPrepare() */
+
+static void ForkParent(void)
+{ /* ForkParent() */
+  pthread_mutex_unlock(&DrainLock);
+} /* ForkParent() */
+
+/* The child has no writer, so from now on each thread writes its own
+ * records, as before 'Start()'.  What's on the rings is the parent's to
+ * write, so skip it all.  The other threads aren't in the child, so
+ * their buffers are dead; the consumer frees them as usual, but not
+ * their 'Scratch', which might have been half way through changing. */
+static void ForkChild(void)
+{ /* ForkChild() */
+  LogBuff_t *Buff;
+
+  for (Buff = Buffs; Buff != NULL; Buff = Buff->Next)
+  { /* Each buffer. */
+    Buff->Tail = Buff->Head;
+    Buff->Dropped = 0;
+    if (Buff != MyBuff)
+      Buff->Dead = true;
+  } /* Each buffer. */
+  Lost = 0;
+  Sleeping = 0;
+  Started = false;
+  pthread_mutex_unlock(&DrainLock);
+} /* ForkChild() */
+
+/* Set up the thread buffer key and start the writer thread, with all
+ * signals blocked. */
+static void Start(void)
+{ /* Start() */
+  sigset_t All, Old;
+  pthread_attr_t Attr;
+  pthread_t Thread;
+
+  if (!(HaveBuffKey = (pthread_key_create(&BuffKey, FreeBuff) == 0)) ||
+      pthread_atfork(ForkPrepare, ForkParent, ForkChild) != 0 ||
+      sem_init(&Wake, 0, 0) != 0)
+    return;
+
+  sigfillset(&All);
+  pthread_sigmask(SIG_SETMASK, &All, &Old);
+  pthread_attr_init(&Attr);
+  pthread_attr_setdetachstate(&Attr, PTHREAD_CREATE_DETACHED);
+  Started = (pthread_create(&Thread, &Attr, Writer, NULL) == 0);
+  pthread_attr_destroy(&Attr);
+  pthread_sigmask(SIG_SETMASK, &Old, NULL);
+  atexit(LogFlush);
+} /* Start() */
+
+/* This thread's buffer, or NULL if it can't have one. */
+static LogBuff_t *GetBuff(void)
+{ /* GetBuff() */
+  LogBuff_t *Buff = MyBuff;
+
+  if (Buff != NULL)
+    return Buff;
+
+  pthread_once(&StartOnce, Start);
+  if (!HaveBuffKey ||
+      (Buff = aligned_alloc(64, sizeof(*Buff) + LOG_RING_SIZE)) == NULL)
+  { /* Error. */
+    __atomic_add_fetch(&Lost, 1, __ATOMIC_RELAXED);
+    return NULL;
+  } /* Error. */
+
+  Buff->Head = Buff->Tail = 0;
+  Buff->Dropped = 0;
+  Buff->Dead = false;
+  ConstructString(&Buff->Scratch);
+  pthread_setspecific(BuffKey, Buff);
+
+  Buff->Next = __atomic_load_n(&Buffs, __ATOMIC_RELAXED);
+  while (!__atomic_compare_exchange_n(&Buffs, &Buff->Next, Buff, true,
+                                      __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+    ;
+  MyBuff = Buff;
+  return Buff;
+} /* GetBuff() */
+
+/* Put what's in 'Buff->Scratch' on the ring, as a record of 'Kind',
+ * and wake the writer if need be. */
+static void Submit(LogBuff_t *Buff, int Kind, int Level, const char *File,
+                   int Line, const StringFmt_t *Fmt)
+{ /* Submit() */
+  size_t Head = __atomic_load_n(&Buff->Head, __ATOMIC_RELAXED);
+  size_t Off = Head & LOG_RING_MASK, Len = Buff->Scratch.Size, Size, Pad = 0;
+  size_t Used;
+  LogRec_t *Rec;
+
+  if (sizeof(LogRec_t) + Len > LOG_MAX_RECORD)
+  { /* Too big. */
+    if (Kind != LOG_REC_TEXT)
+    { /* Can't cut arguments short. */
+      __atomic_add_fetch(&Buff->Dropped, 1, __ATOMIC_RELAXED);
+      return;
+    } /* Can't cut arguments short. */
+    Len = LOG_MAX_RECORD - sizeof(LogRec_t);
+  } /* Too big. */
+
+  Size = (sizeof(LogRec_t) + Len + 7) & ~(size_t) 7;
+  if (Off + Size > LOG_RING_SIZE)
+    Pad = LOG_RING_SIZE - Off;
+  Used = Head - __atomic_load_n(&Buff->Tail, __ATOMIC_ACQUIRE);
+  if (LOG_RING_SIZE - Used < Pad + Size)
+  { /* Full. */
+    __atomic_add_fetch(&Buff->Dropped, 1, __ATOMIC_RELAXED);
+    return;
+  } /* Full. */
+
+  if (Pad != 0)
+  { /* Skip to the start. */
+    Rec = (LogRec_t *) &Buff->Ring[Off];
+    Rec->Size = (uint32_t) Pad;
+    Rec->Kind = LOG_REC_SKIP;
+    Off = 0;
+  } /* Skip to the start. */
+
+  Rec = (LogRec_t *) &Buff->Ring[Off];
+  Rec->Size = (uint32_t) Size;
+  Rec->Kind = (uint8_t) Kind;
+  Rec->Level = (uint8_t) Level;
+  Rec->Len = (uint32_t) Len;
+  Rec->Line = Line;
+  Rec->File = File;
+  Rec->Fmt = Fmt;
+  clock_gettime(CLOCK_REALTIME, &Rec->Time);
+  memcpy(Rec + 1, Buff->Scratch.Ptr, Len);
+  __atomic_store_n(&Buff->Head, Head + Pad + Size, __ATOMIC_RELEASE);
+
+  /* Wake the writer if it's asleep, or if the ring is over half full,
+   * in case it's lingering.  (Posting when nobody's waiting is cheap.) */
+  Used += Pad + Size;
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (!Started)
+    LogFlush();
+  else if (Used > LOG_RING_SIZE / 2 ||
+           (__atomic_load_n(&Sleeping, __ATOMIC_RELAXED) &&
+            __atomic_exchange_n(&Sleeping, 0, __ATOMIC_RELAXED)))
+    sem_post(&Wake);
+} /* Submit() */
+
+/******************************************************************************
+ * Public methods.
+ *****************************************************************************/
+void LogPrintf(int Level, const char *File, int Line, const char *Fmt, ...)
+{ /* LogPrintf() */
+  int SavedErrNo = errno;
+  LogBuff_t *Buff;
+  va_list Args;
+  bool Ok;
+
+  if (Level < __atomic_load_n(&MinLevel, __ATOMIC_RELAXED) ||
+      (unsigned) Level >= LOG_LEVEL_OFF || (Buff = GetBuff()) == NULL)
+    goto Return;
+
+  StringClear(&Buff->Scratch);
+  va_start(Args, Fmt);
+  Ok = StringVFormat(&Buff->Scratch, Fmt, Args);
+  va_end(Args);
+  if (Ok)
+    Submit(Buff, LOG_REC_TEXT, Level, File, Line, NULL);
+
+Return:
+  errno = SavedErrNo;
+} /* LogPrintf() */
+
+void LogDeferred(int Level, const char *File, int Line, StringFmt_t **Site,
+                 const char *Fmt, ...)
+{ /* LogDeferred() */
+  int SavedErrNo = errno;
+  StringFmt_t *Compiled, *Mine;
+  va_list Args, Copy;
+  LogBuff_t *Buff;
+  bool Ok;
+
+  if (Level < __atomic_load_n(&MinLevel, __ATOMIC_RELAXED) ||
+      (unsigned) Level >= LOG_LEVEL_OFF || (Buff = GetBuff()) == NULL)
+    goto Return;
+
+  /* The first time here, compile the format.  If two threads do it at
+   * once, one of them wins. */
+  if ((Compiled = __atomic_load_n(Site, __ATOMIC_ACQUIRE)) == NULL &&
+      (Mine = NewStringFmt(Fmt)) != NULL)
+  { /* First time. */
+    if (__atomic_compare_exchange_n(Site, &Compiled, Mine, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+      Compiled = Mine;
+    else
+      DeleteStringFmt(Mine);
+  } /* First time. */
+
+  StringClear(&Buff->Scratch);
+  va_start(Args, Fmt);
+  va_copy(Copy, Args);
+  if (Compiled != NULL && Encode(&Buff->Scratch, Compiled, Copy))
+  { /* Deferred. */
+    va_end(Copy);
+    va_end(Args);
+    Submit(Buff, LOG_REC_ARGS, Level, File, Line, Compiled);
+    goto Return;
+  } /* Deferred. */
+  va_end(Copy);
+
+  /* Do it now instead. */
+  StringClear(&Buff->Scratch);
+  Ok = (Compiled != NULL ? StringVFormatFmt(&Buff->Scratch, Compiled, Args)
+        : StringVFormat(&Buff->Scratch, Fmt, Args));
+  va_end(Args);
+  if (Ok)
+    Submit(Buff, LOG_REC_TEXT, Level, File, Line, NULL);
+
+Return:
+  errno = SavedErrNo;
+} /* LogDeferred() */
+
+void LogSetLevel(int Level)
+{ /* LogSetLevel() */
+  __atomic_store_n(&MinLevel, Level, __ATOMIC_RELAXED);
+} /* LogSetLevel() */
+
+void LogSetFd(int Fd)
+{ /* LogSetFd() */
+  __atomic_store_n(&OutFd, Fd, __ATOMIC_RELAXED);
+} /* LogSetFd() */
+
+void LogFlush(void)
+{ /* LogFlush() */
+  int SavedErrNo = errno;
+
+  pthread_mutex_lock(&DrainLock);
+  Drain();
+  pthread_mutex_unlock(&DrainLock);
+  errno = SavedErrNo;
+} /* LogFlush() */
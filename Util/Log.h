@@ -0,0 +1,114 @@
+#ifndef Log_h
+#define Log_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ * An asynchronous logger.  Logging a line costs the calling thread
+ * formatting it into a 'String_t' (or not even that, see below) and
+ * copying it onto a ring buffer of its own.  There are no locks, no
+ * stdio, and usually no system calls.  A background thread takes the
+ * records off every thread's ring, adds a time stamp, the level, and
+ * where they came from, and writes them out with 'writev()', as many
+ * at a time as there are.
+ *
+ *   LOG(LOG_LEVEL_INFO, "Listening on port %d", Port);
+ *   LOG_DEFERRED(LOG_LEVEL_DEBUG, "%s: %zu bytes in %.3f ms",
+ *                Host, Len, Ms);
+ *
+ * comes out as
+ *
+ *   2026-10-18 09:15:02.123456 INFO  Server.c:87: Listening on port 80
+ *   2026-10-18 09:15:02.123601 DEBUG Server.c:112: db1: 512 bytes in ...
+ *
+ * A newline is added if the message doesn't end with one.
+ *
+ * 'LOG()' formats the message on the calling thread (with the same
+ * engine as 'StringPrintf()').  'LOG_DEFERRED()' only copies the
+ * arguments (and the characters of any '%s' ones) into the record, and
+ * the writer thread does the formatting.  The format is compiled (see
+ * 'NewStringFmt()') the first time that 'LOG_DEFERRED()' is reached and
+ * kept for the life of the program, so it must be a string literal.
+ * Formats that 'StringFmt_t' leaves to 'vsnprintf()', or with '%n',
+ * are formatted on the calling thread as for 'LOG()'.
+ *
+ * Levels below 'LOG_MIN_LEVEL' are compiled out completely (arguments
+ * and all).  It defaults to 'LOG_LEVEL_DEBUG', or 'LOG_LEVEL_INFO' with
+ * 'NDEBUG', and can be defined before including this file.
+ * 'LogSetLevel()' filters further at run time.
+ *
+ * Each thread's records come out in the order they were logged.
+ * Records from different threads are only roughly in time order, by
+ * as much as one trip round the writer's loop.  If a thread's ring is
+ * full (it's logging faster than the output can take it) records are
+ * dropped and counted, rather than making the thread wait, and the
+ * writer says how many.
+ *
+ * After 'fork()' the child has no writer thread, so 'LOG()' and
+ * 'LOG_DEFERRED()' write each record before they return.  Records
+ * logged before the 'fork()' are written by the parent only.
+ *****************************************************************************/
+#include <stdbool.h>
+
+#include <String.h>
+
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO 2
+#define LOG_LEVEL_WARN 3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_FATAL 5
+#define LOG_LEVEL_OFF 6
+
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL LOG_LEVEL_INFO
+#else
+#define LOG_MIN_LEVEL LOG_LEVEL_DEBUG
+#endif
+#endif
+
+#define LOG(Level, ...)                                                 \
+  do                                                                    \
+  {                                                                     \
+    if ((Level) >= LOG_MIN_LEVEL)                                       \
+      LogPrintf((Level), __FILE__, __LINE__, __VA_ARGS__);              \
+  } while (0)
+
+#define LOG_DEFERRED(Level, ...)                                        \
+  do                                                                    \
+  {                                                                     \
+    static StringFmt_t *_LogFmt;                                        \
+                                                                        \
+    if ((Level) >= LOG_MIN_LEVEL)                                       \
+      LogDeferred((Level), __FILE__, __LINE__, &_LogFmt, __VA_ARGS__);  \
+  } while (0)
+
+  /* What 'LOG()' and 'LOG_DEFERRED()' call.  'File' must be a string
+   * literal (or otherwise outlive the logger).  'Site' is where the
+   * compiled 'Fmt' is kept. */
+  extern void LogPrintf(int Level, const char *File, int Line,
+                        const char *Fmt, ...)
+    __attribute__((format(printf, 4, 5)));
+  extern void LogDeferred(int Level, const char *File, int Line,
+                          StringFmt_t **Site, const char *Fmt, ...)
+    __attribute__((format(printf, 5, 6)));
+
+  /* Only log 'Level' and above (on top of 'LOG_MIN_LEVEL').  The
+   * default is everything. */
+  extern void LogSetLevel(int Level);
+
+  /* Write to 'Fd' (which the logger doesn't close) rather than standard
+   * error. */
+  extern void LogSetFd(int Fd);
+
+  /* Write out everything logged so far (by any thread) before
+   * returning.  This is done at 'exit()' anyway. */
+  extern void LogFlush(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif
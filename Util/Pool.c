@@ -0,0 +1,311 @@
+/******************************************************************************
+ * Function definitions for the thread-local small block pool.  See
+ * Pool.h.
+ *
+ * Each thread has a heap, with a free list for each size class.
+ * Blocks are carved out of slabs, 'SLAB_SIZE' bytes aligned to
+ * 'SLAB_SIZE', each holding blocks of one size class for one heap.  So
+ * the slab header, found by masking a block's address, says which heap
+ * and size class a block belongs to.
+ *
+ * Only the owning thread touches a heap's free lists.  Other threads
+ * push the blocks they free onto the heap's 'Remote' list (a lock-free
+ * stack).  The owner takes the whole list at once, with an exchange,
+ * so there's no ABA problem.
+ *
+ * When a thread exits its heap goes on the 'Abandoned' list for the
+ * next new thread to take over.  Heaps (and so slabs) are never freed,
+ * since blocks from them may still be in use anywhere.
+ *****************************************************************************/
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Diag.h"
+#include "Errors.h"
+#include "Pool.h"
+
+#define POOL_MIN_SHIFT 5        /* log2(POOL_MIN_SIZE). */
+#define POOL_CLASSES 5          /* 32, 64, 128, 256, 512. */
+
+#define SLAB_SIZE ((size_t) 64 * 1024)
+#define SLAB_HEAD_SIZE 64       /* Keep the blocks off its cache line. */
+
+/* A free block. */
+typedef struct PoolBlock
+{ /* PoolBlock */
+  struct PoolBlock *Next;
+} PoolBlock_t; /* PoolBlock */
+
+typedef struct PoolHeap PoolHeap_t;
+
+typedef struct PoolSlab
+{ /* PoolSlab */
+  PoolHeap_t *Heap;             /* Owner. */
+  unsigned Class;               /* Of all its blocks. */
+} PoolSlab_t; /* PoolSlab */
+
+struct PoolHeap
+{ /* PoolHeap */
+  PoolBlock_t *Free[POOL_CLASSES];
+  char *Next[POOL_CLASSES];     /* Unused part of the newest slab. */
+  char *End[POOL_CLASSES];
+  PoolHeap_t *Abandoned;        /* Next on the 'Abandoned' list. */
+
+  /* Written by other threads, so on its own cache line. */
+  _Alignas(64) PoolBlock_t *Remote;
+}; /* PoolHeap */
+
+/* This thread's heap, or NULL if it doesn't have one (yet). */
+static __thread PoolHeap_t *MyHeap;
+
+/* To find out when threads exit. */
+static pthread_once_t HeapOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t HeapKey;
+
+/* Heaps of threads that have exited. */
+static pthread_mutex_t AbandonedLock = PTHREAD_MUTEX_INITIALIZER;
+static PoolHeap_t *Abandoned;
+
+/******************************************************************************
+ * These would be 'private' in C++.
+ *****************************************************************************/
+/* The size class of 'Size', which must be '<= POOL_MAX_SIZE'. */
+static inline unsigned SizeClass(size_t Size)
+{ /* SizeClass() */
+  if (Size <= POOL_MIN_SIZE)
+    return 0;
+  return (sizeof(unsigned long long) * CHAR_BIT -
+          __builtin_clzll(Size - 1) - POOL_MIN_SHIFT);
+} /* SizeClass() */
+
+static inline PoolSlab_t *SlabOf(void *Ptr)
+{ /* SlabOf() */
+  return (PoolSlab_t *) ((uintptr_t) Ptr & ~(uintptr_t) (SLAB_SIZE - 1));
+} /* SlabOf() */
+
+/* Called by 'pthread' when a thread with a heap exits. */
+static void AbandonHeap(void *Heap)
+{ /* AbandonHeap() */
+  pthread_mutex_lock(&AbandonedLock);
+  ((PoolHeap_t *) Heap)->Abandoned = Abandoned;
+  Abandoned = Heap;
+  pthread_mutex_unlock(&AbandonedLock);
+  MyHeap = NULL;
+} /* AbandonHeap() */
+
+static void MakeHeapKey(void)
+{ /* MakeHeapKey() */
+  if (pthread_key_create(&HeapKey, AbandonHeap) != 0)
+    Diag("%s %s %d: pthread_key_create() failed.  "
+         "Pools of exiting threads will leak.\n",
+         __FILE__, __func__, __LINE__);
+} /* MakeHeapKey() */
+
+/* Give this thread a heap, an abandoned one if there is one. */
+static PoolHeap_t *NewHeap(void)
+{ /* NewHeap() */
+  int ErrNo;
+  PoolHeap_t *Heap, *_RetVal;
+
+  pthread_once(&HeapOnce, MakeHeapKey);
+
+  pthread_mutex_lock(&AbandonedLock);
+  if ((Heap = Abandoned) != NULL)
+    Abandoned = Heap->Abandoned;
+  pthread_mutex_unlock(&AbandonedLock);
+
+  if (Heap == NULL)
+  { /* Make one. */
+    if ((Heap = aligned_alloc(_Alignof(PoolHeap_t),
+                              sizeof(PoolHeap_t))) == NULL)
+    { /* Error. */
+      ErrNo = errno;
+      Diag("%s %s %d: aligned_alloc(%zu) failed.  %s.\n",
+           __FILE__, __func__, __LINE__, sizeof(PoolHeap_t),
+           StrError(ErrNo));
+      EXIT(NULL);
+    } /* Error. */
+    memset(Heap, 0, sizeof(*Heap));
+  } /* Make one. */
+
+  Heap->Abandoned = NULL;
+  pthread_setspecific(HeapKey, Heap);
+  MyHeap = Heap;
+  RETURN(Heap);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* NewHeap() */
+
+/* Move the blocks other threads have freed onto our free lists. */
+static void TakeRemote(PoolHeap_t *Heap)
+{ /* TakeRemote() */
+  PoolBlock_t *Block, *Next;
+
+  if (__atomic_load_n(&Heap->Remote, __ATOMIC_RELAXED) == NULL)
+    return;
+
+  Block = __atomic_exchange_n(&Heap->Remote, NULL, __ATOMIC_ACQUIRE);
+  for (; Block != NULL; Block = Next)
+  { /* Each block. */
+    unsigned Class = SlabOf(Block)->Class;
+
+    Next = Block->Next;
+    Block->Next = Heap->Free[Class];
+    Heap->Free[Class] = Block;
+  } /* Each block. */
+} /* TakeRemote() */
+
+/******************************************************************************
+ * The slow path of 'PoolMalloc()': class 'Class''s free list is empty.
+ * Take back the blocks other threads have freed, or carve a new one
+ * out of the newest slab, or get a new slab.
+ *****************************************************************************/
+static void *Refill(PoolHeap_t *Heap, unsigned Class)
+{ /* Refill() */
+  int ErrNo;
+  size_t Size = POOL_MIN_SIZE << Class;
+  PoolBlock_t *Block;
+  PoolSlab_t *Slab;
+  void *_RetVal;
+
+  TakeRemote(Heap);
+  if ((Block = Heap->Free[Class]) != NULL)
+  { /* Got one back. */
+    Heap->Free[Class] = Block->Next;
+    RETURN(Block);
+  } /* Got one back. */
+
+  if ((size_t) (Heap->End[Class] - Heap->Next[Class]) < Size)
+  { /* New slab. */
+    if ((Slab = aligned_alloc(SLAB_SIZE, SLAB_SIZE)) == NULL)
+    { /* Error. */
+      ErrNo = errno;
+      Diag("%s %s %d: aligned_alloc(%zu) failed.  %s.\n",
+           __FILE__, __func__, __LINE__, SLAB_SIZE, StrError(ErrNo));
+      EXIT(NULL);
+    } /* Error. */
+    Slab->Heap = Heap;
+    Slab->Class = Class;
+    Heap->Next[Class] = (char *) Slab + SLAB_HEAD_SIZE;
+    Heap->End[Class] = (char *) Slab + SLAB_SIZE;
+  } /* New slab. */
+
+  Heap->Next[Class] += Size;
+  RETURN(Heap->Next[Class] - Size);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* Refill() */
+
+/* The 'Alloc_t' methods. */
+static void *AllocPoolMalloc(void *Ctx, size_t Size)
+{ /* AllocPoolMalloc() */
+  return PoolMalloc(Size);
+} /* AllocPoolMalloc() */
+
+static void *AllocPoolRealloc(void *Ctx, void *Ptr, size_t OldSize,
+                              size_t NewSize)
+{ /* AllocPoolRealloc() */
+  return PoolRealloc(Ptr, OldSize, NewSize);
+} /* AllocPoolRealloc() */
+
+static void AllocPoolFree(void *Ctx, void *Ptr, size_t Size)
+{ /* AllocPoolFree() */
+  PoolFree(Ptr, Size);
+} /* AllocPoolFree() */
+
+/******************************************************************************
+ * Public methods.
+ *****************************************************************************/
+const Alloc_t PoolAllocator =
+{
+  AllocPoolMalloc, AllocPoolRealloc, AllocPoolFree, NULL
+};
+
+void *PoolMalloc(size_t Size)
+{ /* PoolMalloc() */
+  PoolHeap_t *Heap = MyHeap;
+  PoolBlock_t *Block;
+  unsigned Class;
+
+  if (Size > POOL_MAX_SIZE)
+    return malloc(Size);
+
+  if (Heap == NULL && (Heap = NewHeap()) == NULL)
+    return NULL;
+
+  Class = SizeClass(Size);
+  if ((Block = Heap->Free[Class]) == NULL)
+    return Refill(Heap, Class);
+
+  Heap->Free[Class] = Block->Next;
+  return Block;
+} /* PoolMalloc() */
+
+void *PoolRealloc(void *Ptr, size_t OldSize, size_t NewSize)
+{ /* PoolRealloc() */
+  void *New;
+
+  if (Ptr == NULL)
+    return PoolMalloc(NewSize);
+
+  if (OldSize > POOL_MAX_SIZE && NewSize > POOL_MAX_SIZE)
+    return realloc(Ptr, NewSize);
+
+  /* Still fits the same size class. */
+  if (OldSize <= POOL_MAX_SIZE && NewSize <= POOL_MAX_SIZE &&
+      SizeClass(OldSize) == SizeClass(NewSize))
+    return Ptr;
+
+  if ((New = PoolMalloc(NewSize)) != NULL)
+  { /* Move it. */
+    memcpy(New, Ptr, (OldSize < NewSize ? OldSize : NewSize));
+    PoolFree(Ptr, OldSize);
+  } /* Move it. */
+
+  return New;
+} /* PoolRealloc() */
+
+void PoolFree(void *Ptr, size_t Size)
+{ /* PoolFree() */
+  PoolBlock_t *Block = Ptr;
+  PoolSlab_t *Slab;
+  PoolHeap_t *Heap;
+
+  if (Block == NULL)
+    return;
+
+  if (Size > POOL_MAX_SIZE)
+  { /* Not ours. */
+    free(Block);
+    return;
+  } /* Not ours. */
+
+  Slab = SlabOf(Block);
+  if ((Heap = Slab->Heap) == MyHeap)
+  { /* Local. */
+    Block->Next = Heap->Free[Slab->Class];
+    Heap->Free[Slab->Class] = Block;
+  } /* Local. */
+  else
+  { /* Remote. */
+    Block->Next = __atomic_load_n(&Heap->Remote, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&Heap->Remote, &Block->Next,
+                                        Block, true, __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED))
+      ;
+  } /* Remote. */
+} /* PoolFree() */
@@ -0,0 +1,59 @@
+#ifndef Pool_h
+#define Pool_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ * A thread-local pool for small blocks, meant for the heap buffers of
+ * 'String_t's that are built and destroyed over and over, e.g.:
+ *
+ *   ConstructStringAlloc(&Str, PoolAlloc());
+ *
+ * Sizes up to 'POOL_MAX_SIZE' are rounded up to a power of two (at
+ * least 'POOL_MIN_SIZE'), the same sizes 'String_t' buffers grow by,
+ * and each size has a free list per thread.  So allocating and
+ * freeing is a few instructions with no locks and no atomics.
+ * Anything bigger goes straight to 'malloc()'.
+ *
+ * A block may be freed by any thread.  If it isn't the one that
+ * allocated it, it's pushed (lock free) onto the owner's remote free
+ * queue, which the owner takes back the next time it runs out of
+ * blocks.  When a thread exits its pool is kept, with everything in
+ * it, for the next new thread to take over.
+ *
+ * Pooled memory is never given back to the system.
+ *****************************************************************************/
+#include <stddef.h>
+
+#include <Alloc.h>
+
+/* The smallest and biggest sizes that are pooled. */
+#define POOL_MIN_SIZE ((size_t) 32)
+#define POOL_MAX_SIZE ((size_t) 512)
+
+  /* Like 'malloc()', 'realloc()', and 'free()' except, as for
+   * 'Alloc_t', 'PoolRealloc()' and 'PoolFree()' must be given the size
+   * the block was allocated (or last resized) with.  Return NULL and
+   * set 'errno' on error. */
+  extern void *PoolMalloc(size_t Size);
+  extern void *PoolRealloc(void *Ptr, size_t OldSize, size_t NewSize);
+  extern void PoolFree(void *Ptr, size_t Size);
+
+  /* The pool as an 'Alloc_t'. */
+  extern const Alloc_t PoolAllocator;
+  static inline const Alloc_t *PoolAlloc(void);
+
+/******************************************************************************
+ * Inline method definitions.
+ *****************************************************************************/
+  static inline const Alloc_t *PoolAlloc(void)
+  { /* PoolAlloc() */
+    return &PoolAllocator;
+  } /* PoolAlloc() */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif
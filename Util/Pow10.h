@@ -0,0 +1,20 @@
+#ifndef Pow10_h
+#define Pow10_h
+
+/******************************************************************************
+ * The powers of 10 that fit in a 'uint64_t', 10^0 to 10^19, for the
+ * conversions in StrToXDec.c, StrToXFlt.c, XToStrFlt.c, and
+ * StringFmt.c.  This header is _not_ installed.
+ *****************************************************************************/
+#include <stdint.h>
+
+static const uint64_t Pow10[] =
+{
+  1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u,
+  100000000u, 1000000000u, 10000000000u, 100000000000u,
+  1000000000000u, 10000000000000u, 100000000000000u,
+  1000000000000000u, 10000000000000000u, 100000000000000000u,
+  1000000000000000000u, 10000000000000000000u
+};
+
+#endif
@@ -0,0 +1,387 @@
+/******************************************************************************
+ * Function definitions for our 'struct StrMap' "class".  See StrMap.h.
+ *
+ * The control bytes are 'CTRL_EMPTY', 'CTRL_DELETED', or, for a full
+ * slot, the low 7 bits of its key's hash ("H2").  The rest of the hash
+ * ("H1") picks the slot where the search starts.  The search goes
+ * through groups of 'GROUP' control bytes at a time, starting at any
+ * slot (not just multiples of 'GROUP'), so the first 'GROUP' control
+ * bytes are repeated after the last to save wrapping.  Each step is
+ * one 'GROUP' further than the one before ("triangular" probing),
+ * which, since 'Cap' is a power of 2, gets to every group eventually.
+ * A search stops at a group with an empty slot, so there must always
+ * be one: the table grows when it's 7/8 full (counting deleted slots,
+ * which only a resize clears).
+ *
+ * The slots and control bytes are one allocation, slots first.
+ *****************************************************************************/
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Diag.h"
+#include "Errors.h"
+#include "StrMap.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define GROUP 16
+#define MIN_CAP GROUP
+
+#define CTRL_EMPTY ((int8_t) -128)
+#define CTRL_DELETED ((int8_t) -2)
+
+/* Where the value starts in a slot, and how slots are aligned. */
+#define SLOT_ALIGN _Alignof(max_align_t)
+#define VAL_OFFSET ((sizeof(StringKey_t) + SLOT_ALIGN - 1) & ~(SLOT_ALIGN - 1))
+
+/******************************************************************************
+ * These would be 'private' in C++.
+ *****************************************************************************/
+/* Bit 'I' is set for each 'Group[I]' equal to 'Byte'. */
+static inline unsigned MatchByte(const int8_t *Group, int8_t Byte)
+{ /* MatchByte() */
+#ifdef __SSE2__
+  __m128i Ctrl = _mm_loadu_si128((const __m128i *) Group);
+
+  return (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(Ctrl,
+                                                     _mm_set1_epi8(Byte)));
+#else
+  unsigned Mask = 0, I;
+
+  for (I = 0; I < GROUP; ++I)
+    Mask |= (unsigned) (Group[I] == Byte) << I;
+  return Mask;
+#endif
+} /* MatchByte() */
+
+/* The same for each empty or deleted slot, i.e. sign bit set. */
+static inline unsigned MatchFree(const int8_t *Group)
+{ /* MatchFree() */
+#ifdef __SSE2__
+  return (unsigned) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)
+                                                      Group));
+#else
+  unsigned Mask = 0, I;
+
+  for (I = 0; I < GROUP; ++I)
+    Mask |= (unsigned) (Group[I] < 0) << I;
+  return Mask;
+#endif
+} /* MatchFree() */
+
+static inline StringKey_t *KeyAt(const StrMap_t *This, size_t Slot)
+{ /* KeyAt() */
+  return (StringKey_t *) (This->Slots + Slot * This->SlotSize);
+} /* KeyAt() */
+
+static inline void *ValAt(const StrMap_t *This, size_t Slot)
+{ /* ValAt() */
+  return This->Slots + Slot * This->SlotSize + VAL_OFFSET;
+} /* ValAt() */
+
+static inline void SetCtrl(StrMap_t *This, size_t Slot, int8_t Ctrl)
+{ /* SetCtrl() */
+  This->Ctrl[Slot] = Ctrl;
+  if (Slot < GROUP)
+    This->Ctrl[This->Cap + Slot] = Ctrl;
+} /* SetCtrl() */
+
+/* Keys we can have in 'Cap' slots. */
+static inline size_t MaxCount(size_t Cap)
+{ /* MaxCount() */
+  return Cap - Cap / 8;
+} /* MaxCount() */
+
+static inline size_t BlockSize(const StrMap_t *This, size_t Cap)
+{ /* BlockSize() */
+  return Cap * This->SlotSize + Cap + GROUP;
+} /* BlockSize() */
+
+/* The slot holding 'Key', which hashes to 'Hash', or 'STRVIEW_NPOS'. */
+static size_t FindSlot(const StrMap_t *This, StrView_t Key, uint64_t Hash)
+{ /* FindSlot() */
+  size_t Mask = This->Cap - 1, Pos = (Hash >> 7) & Mask, Step = 0, Slot;
+  const int8_t *Group;
+  const StringKey_t *Str;
+  unsigned Match;
+
+  for (;;)
+  { /* Each group. */
+    Group = This->Ctrl + Pos;
+    for (Match = MatchByte(Group, Hash & 0x7F); Match != 0;
+         Match &= Match - 1)
+    { /* Each candidate. */
+      Slot = (Pos + (unsigned) __builtin_ctz(Match)) & Mask;
+      Str = KeyAt(This, Slot);
+      if (Str->Hash == Hash && StrViewEqual(StringView(&Str->Str), Key))
+        return Slot;
+    } /* Each candidate. */
+
+    if (MatchByte(Group, CTRL_EMPTY) != 0)
+      return STRVIEW_NPOS;
+    Step += GROUP;
+    Pos = (Pos + Step) & Mask;
+  } /* Each group. */
+} /* FindSlot() */
+
+/* The first empty or deleted slot for a key that hashes to 'Hash'. */
+static size_t FindFree(const StrMap_t *This, uint64_t Hash)
+{ /* FindFree() */
+  size_t Mask = This->Cap - 1, Pos = (Hash >> 7) & Mask, Step = 0;
+  unsigned Match;
+
+  while ((Match = MatchFree(This->Ctrl + Pos)) == 0)
+  { /* Full group. */
+    Step += GROUP;
+    Pos = (Pos + Step) & Mask;
+  } /* Full group. */
+
+  return (Pos + (unsigned) __builtin_ctz(Match)) & Mask;
+} /* FindFree() */
+
+/* Move everything to a new table of 'NewCap' slots, leaving out the
+ * deleted slots. */
+static bool Resize(StrMap_t *This, size_t NewCap)
+{ /* Resize() */
+  int ErrNo;
+  bool _RetVal;
+  StrMap_t New = *This;
+  StringKey_t *Key;
+  size_t Slot, NewSlot;
+
+  if (NewCap > (SIZE_MAX - GROUP) / (This->SlotSize + 1))
+  { /* Error. */
+    ErrNo = ENOMEM;
+    Diag("%s %s %d: %zu slots is too many.  %s.\n",
+         __FILE__, __func__, __LINE__, NewCap, StrError(ErrNo));
+    EXIT(false);
+  } /* Error. */
+
+  if ((New.Slots = AllocMalloc(This->Alloc, BlockSize(This, NewCap)))
+      == NULL)
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: Allocating %zu slots failed.  %s.\n",
+         __FILE__, __func__, __LINE__, NewCap, StrError(ErrNo));
+    EXIT(false);
+  } /* Error. */
+  New.Ctrl = (int8_t *) (New.Slots + NewCap * This->SlotSize);
+  New.Cap = NewCap;
+  memset(New.Ctrl, CTRL_EMPTY, NewCap + GROUP);
+
+  /* The hashes are kept with the keys, and there's nothing to compare
+   * since the keys are all different. */
+  for (Slot = 0; Slot < This->Cap; ++Slot)
+    if (This->Ctrl[Slot] >= 0)
+    { /* Move it. */
+      Key = KeyAt(This, Slot);
+      NewSlot = FindFree(&New, Key->Hash);
+      memcpy(KeyAt(&New, NewSlot), Key, This->SlotSize);
+      SetCtrl(&New, NewSlot, This->Ctrl[Slot]);
+
+      /* A short key points at its own buffer, which just moved. */
+      if (Key->Str.Ptr == Key->Str.Buff.Data)
+        KeyAt(&New, NewSlot)->Str.Ptr = KeyAt(&New, NewSlot)->Str.Buff.Data;
+    } /* Move it. */
+
+  if (This->Slots != NULL)
+    AllocFree(This->Alloc, This->Slots, BlockSize(This, This->Cap));
+  New.Growth = MaxCount(NewCap) - This->Count;
+  *This = New;
+  RETURN(true);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* Resize() */
+
+/******************************************************************************
+ * Public methods.
+ *****************************************************************************/
+bool ConstructStrMap(StrMap_t *This, size_t ValSize, const Alloc_t *Alloc)
+{ /* ConstructStrMap() */
+  /* Error checking. */
+  if (This == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    errno = EFAULT;
+    return false;
+  } /* Error. */
+
+  This->Slots = NULL;
+  This->Ctrl = NULL;
+  This->Cap = This->Count = This->Growth = 0;
+  This->ValSize = ValSize;
+  This->SlotSize = (VAL_OFFSET + ValSize + SLOT_ALIGN - 1) & ~(SLOT_ALIGN - 1);
+  This->Alloc = Alloc;
+  return true;
+} /* ConstructStrMap() */
+
+StrMap_t *NewStrMap(size_t ValSize, const Alloc_t *Alloc)
+{ /* NewStrMap() */
+  int ErrNo;
+  StrMap_t *This, *_RetVal;
+
+  if ((This = AllocMalloc(Alloc, sizeof(StrMap_t))) == NULL)
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: malloc(%zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, sizeof(StrMap_t),
+         StrError(ErrNo));
+    EXIT(NULL);
+  } /* Error. */
+
+  /* We know this never fails if '(This != NULL)'. */
+  ConstructStrMap(This, ValSize, Alloc);
+  RETURN(This);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* NewStrMap() */
+
+void DestroyStrMap(StrMap_t *This)
+{ /* DestroyStrMap() */
+  if (This != NULL && This->Slots != NULL)
+  { /* Exists. */
+    StrMapClear(This);
+    AllocFree(This->Alloc, This->Slots, BlockSize(This, This->Cap));
+    This->Slots = NULL;
+    This->Ctrl = NULL;
+    This->Cap = This->Growth = 0;
+  } /* Exists. */
+} /* DestroyStrMap() */
+
+void DeleteStrMap(StrMap_t *This)
+{ /* DeleteStrMap() */
+  if (This != NULL)
+  { /* Exists. */
+    DestroyStrMap(This);
+    AllocFree(This->Alloc, This, sizeof(*This));
+  } /* Exists. */
+} /* DeleteStrMap() */
+
+void *StrMapFind(const StrMap_t *This, StrView_t Key)
+{ /* StrMapFind() */
+  size_t Slot;
+
+  if (This->Count == 0 ||
+      (Slot = FindSlot(This, Key, StrViewHash(Key))) == STRVIEW_NPOS)
+    return NULL;
+  return ValAt(This, Slot);
+} /* StrMapFind() */
+
+void *StrMapInsert(StrMap_t *This, StrView_t Key, bool *Added)
+{ /* StrMapInsert() */
+  int ErrNo;
+  void *_RetVal;
+  uint64_t Hash;
+  size_t Slot;
+  StringKey_t *Str;
+
+  /* Error checking. */
+  if (This == NULL || (Key.Ptr == NULL && Key.Size != 0))
+  { /* Error. */
+    Diag("%s %s %d: '%s' is NULL.\n",
+         __FILE__, __func__, __LINE__,
+         (This == NULL ? "This" : "Key.Ptr"));
+    ErrNo = EFAULT;
+    EXIT(NULL);
+  } /* Error. */
+
+  Hash = StrViewHash(Key);
+  if (This->Cap != 0 && (Slot = FindSlot(This, Key, Hash)) != STRVIEW_NPOS)
+  { /* Already there. */
+    if (Added != NULL)
+      *Added = false;
+    RETURN(ValAt(This, Slot));
+  } /* Already there. */
+
+  /* Out of empty slots.  If it's mostly deleted ones just clean up,
+   * otherwise double the size. */
+  if (This->Growth == 0 &&
+      !Resize(This, (This->Cap == 0 ? MIN_CAP :
+                     This->Count < MaxCount(This->Cap) / 2 ?
+                     This->Cap : 2 * This->Cap)))
+  { /* Error. */
+    ErrNo = errno;
+    EXIT(NULL);
+  } /* Error. */
+
+  Slot = FindFree(This, Hash);
+  Str = KeyAt(This, Slot);
+  ConstructStringAlloc(&Str->Str, This->Alloc);
+  if (!StringSetView(&Str->Str, Key))
+  { /* Error. */
+    ErrNo = errno;
+    EXIT(NULL);
+  } /* Error. */
+  Str->Hash = Hash;
+  memset(ValAt(This, Slot), 0, This->ValSize);
+
+  if (This->Ctrl[Slot] == CTRL_EMPTY)
+    This->Growth--;
+  SetCtrl(This, Slot, (int8_t) (Hash & 0x7F));
+  This->Count++;
+  if (Added != NULL)
+    *Added = true;
+  RETURN(ValAt(This, Slot));
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* StrMapInsert() */
+
+bool StrMapErase(StrMap_t *This, StrView_t Key)
+{ /* StrMapErase() */
+  size_t Slot;
+
+  if (This->Count == 0 ||
+      (Slot = FindSlot(This, Key, StrViewHash(Key))) == STRVIEW_NPOS)
+    return false;
+
+  DestroyString(&KeyAt(This, Slot)->Str);
+  SetCtrl(This, Slot, CTRL_DELETED);
+  This->Count--;
+  return true;
+} /* StrMapErase() */
+
+void StrMapClear(StrMap_t *This)
+{ /* StrMapClear() */
+  size_t Slot;
+
+  for (Slot = 0; Slot < This->Cap; ++Slot)
+    if (This->Ctrl[Slot] >= 0)
+      DestroyString(&KeyAt(This, Slot)->Str);
+
+  if (This->Ctrl != NULL)
+    memset(This->Ctrl, CTRL_EMPTY, This->Cap + GROUP);
+  This->Count = 0;
+  This->Growth = MaxCount(This->Cap);
+} /* StrMapClear() */
+
+bool StrMapNext(const StrMap_t *This, size_t *Pos, const String_t **Key,
+                void **Val)
+{ /* StrMapNext() */
+  for (; *Pos < This->Cap; ++*Pos)
+    if (This->Ctrl[*Pos] >= 0)
+    { /* Full. */
+      *Key = &KeyAt(This, *Pos)->Str;
+      *Val = ValAt(This, *Pos);
+      ++*Pos;
+      return true;
+    } /* Full. */
+
+  return false;
+} /* StrMapNext() */
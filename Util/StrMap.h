@@ -0,0 +1,127 @@
+#ifndef StrMap_h
+#define StrMap_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ * A hash map from strings to values, laid out as a "Swiss table"
+ * (after Abseil's 'flat_hash_map'): an open addressing table with, as
+ * well as the slots, one control byte per slot saying whether it's
+ * empty, deleted, or full, and for a full slot 7 bits of the key's
+ * hash.  A lookup checks a group of 16 control bytes at once (with one
+ * SSE2 compare where there is SSE2), so it only looks at the keys whose
+ * hash bits match, which is nearly always just the one it wants, and
+ * usually stops at the first group.
+ *
+ * Each slot holds the key, as a 'String_t' (so keys of up to 15
+ * characters are stored in the slot itself, and only longer ones are
+ * allocated), and 'ValSize' bytes of value, aligned as for 'malloc()'.
+ * A value is usually a struct that's updated in place, or a pointer
+ * ('StrMapGet()' and 'StrMapPut()' are for when 'ValSize' is
+ * 'sizeof(void *)').  Keys are looked up by 'StrView_t', so no
+ * temporary 'String_t' is ever needed, and the key's hash is kept
+ * with it (as a 'StringKey_t') so growing the table never rehashes a
+ * string.
+ *
+ * The table, and long keys, come from 'Alloc' (NULL for 'malloc()',
+ * see 'Alloc.h').  Pointers to values and keys are only good until the
+ * map next changes size, i.e. the next 'StrMapInsert()' that adds a
+ * key.  A map is _not_ thread safe.
+ *
+ * For example:
+ *
+ *   StrMap_t Counts;
+ *   uint64_t *Count;
+ *
+ *   ConstructStrMap(&Counts, sizeof(uint64_t), NULL);
+ *   while (...)
+ *     if ((Count = StrMapInsert(&Counts, Key, NULL)) != NULL)
+ *       ++*Count;               // New ones start at 0.
+ *   DestroyStrMap(&Counts);
+ *****************************************************************************/
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <Alloc.h>
+#include <String.h>
+#include <StrView.h>
+
+typedef struct StrMap
+{ /* StrMap */
+  char *Slots;                  /* 'Cap' slots, or NULL. */
+  int8_t *Ctrl;                 /* 'Cap' + 16 control bytes. */
+  size_t Cap;                   /* Number of slots, 0 or a power of 2. */
+  size_t Count;                 /* Keys in the map. */
+  size_t Growth;                /* Keys we can add before growing. */
+  size_t ValSize;
+  size_t SlotSize;              /* Key plus value, rounded up. */
+  const Alloc_t *Alloc;
+} StrMap_t; /* StrMap */
+
+  /* Constructors and destructors, as for 'String_t'.  The constructors
+   * don't allocate anything, so they only fail if 'This' is NULL. */
+  extern bool ConstructStrMap(StrMap_t *This, size_t ValSize,
+                              const Alloc_t *Alloc);
+  extern StrMap_t *NewStrMap(size_t ValSize, const Alloc_t *Alloc);
+  extern void DestroyStrMap(StrMap_t *This);
+  extern void DeleteStrMap(StrMap_t *This);
+
+  /* The value for 'Key', or NULL if there isn't one. */
+  extern void *StrMapFind(const StrMap_t *This, StrView_t Key);
+
+  /* The value for 'Key', adding it (with a value of all 0 bytes) if it
+   * isn't there.  If 'Added' isn't NULL '*Added' says which.  Returns
+   * NULL and sets 'errno' on error. */
+  extern void *StrMapInsert(StrMap_t *This, StrView_t Key, bool *Added);
+
+  /* Remove 'Key'.  Returns 'false' if it wasn't there. */
+  extern bool StrMapErase(StrMap_t *This, StrView_t Key);
+
+  /* Remove every key, but keep the table. */
+  extern void StrMapClear(StrMap_t *This);
+
+  static inline size_t StrMapCount(const StrMap_t *This);
+
+  /* Go through the keys and values, in no particular order.  Start
+   * with '*Pos' 0.  Returns 'false' when there are no more. */
+  extern bool StrMapNext(const StrMap_t *This, size_t *Pos,
+                         const String_t **Key, void **Val);
+
+  /* For a map of pointers: the value for 'Key', or NULL, and set the
+   * value for 'Key' (adding it if need be).  'StrMapPut()' returns
+   * 'false' and sets 'errno' on error. */
+  static inline void *StrMapGet(const StrMap_t *This, StrView_t Key);
+  static inline bool StrMapPut(StrMap_t *This, StrView_t Key, void *Val);
+
+/******************************************************************************
+ * Inline method definitions.
+ *****************************************************************************/
+  static inline size_t StrMapCount(const StrMap_t *This)
+  { /* StrMapCount() */
+    return This->Count;
+  } /* StrMapCount() */
+
+  static inline void *StrMapGet(const StrMap_t *This, StrView_t Key)
+  { /* StrMapGet() */
+    void **Val = StrMapFind(This, Key);
+
+    return (Val == NULL ? NULL : *Val);
+  } /* StrMapGet() */
+
+  static inline bool StrMapPut(StrMap_t *This, StrView_t Key, void *Val)
+  { /* StrMapPut() */
+    void **Slot = StrMapInsert(This, Key, NULL);
+
+    if (Slot == NULL)
+      return false;
+    *Slot = Val;
+    return true;
+  } /* StrMapPut() */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif
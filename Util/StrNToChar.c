@@ -0,0 +1,30 @@
+#include <errno.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToChar() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToChar() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToChar(const char *Str, size_t Len, char *Val)
+{ /* StrNToChar(const char *, size_t, char *) */
+  unsigned char NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXChar(Str, Len, &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (char) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToChar(const char *, size_t, char *) */
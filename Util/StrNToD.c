@@ -0,0 +1,55 @@
+#include <errno.h>
+#include <string.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToD() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToD() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.  Most numbers
+ * are converted in place by 'StrToXFastD()'.  Anything else needs the C
+ * library, which needs a C string, so we convert a NUL terminated copy
+ * of the field, which lives on the stack unless the field is
+ * unreasonably long.
+ *****************************************************************************/
+int StrNToD(const char *Str, size_t Len, double *Val)
+{ /* StrNToD(const char *, size_t, double *) */
+  char Buff[STRNTOX_BUFF_SIZE], *Copy;
+  int SavedErrNo, ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* The common case needs no copy. */
+  if (StrToXFastD(Str, Len, Val))
+  { /* Done. */
+    return 0;
+  } /* Done. */
+
+  /* An embedded NUL would end the copy early and make a malformed
+   * field look valid. */
+  if (Len == 0 || memchr(Str, '\0', Len) != NULL)
+  { /* Error. */
+    return EINVAL;
+  } /* Error. */
+
+  /* Get a C string.  If 'malloc()' fails we must leave 'errno'
+   * unchanged. */
+  SavedErrNo = errno;
+  if ((Copy = StrNToXCopy(Str, Len, Buff, sizeof(Buff))) == NULL)
+  { /* Error. */
+    ErrNo = (errno != 0 ? errno : ENOMEM);
+    errno = SavedErrNo;
+    return ErrNo;
+  } /* Error. */
+
+  /* Do the conversion. */
+  ErrNo = StrToD(Copy, Val);
+  StrNToXFreeCopy(Copy, Buff);
+  return ErrNo;
+} /* StrNToD(const char *, size_t, double *) */
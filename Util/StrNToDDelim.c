@@ -0,0 +1,74 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Convert the 'Delim' separated fields in the 'Len' characters
+ * starting at 'Buff' to 'double', exactly as if by calling 'StrNToD()'
+ * on each one.  See 'StrToX.h'.
+ *****************************************************************************/
+int StrNToDDelim(const char *Buff, size_t Len, char Delim, double *Vals,
+                 uint64_t *Errs, size_t *NVals, const char **End)
+{ /* StrNToDDelim() */
+  const char *Next;
+  uint64_t Bits = 0;
+  size_t Pos = 0, FieldLen, Used, MaxVals, I;
+  double NewVal;
+  bool Fast, Ok;
+
+  /* NULL pointer checking. */
+  if (Buff == NULL || Vals == NULL || NVals == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* As for 'StrNToI64Delim()', if 'Delim' can't be part of a decimal
+   * number we parse first and only look for the end of the field if
+   * that fails. */
+  Fast = (strchr("0123456789.eE+-", Delim) == NULL);
+  MaxVals = *NVals;
+  for (I = 0; Pos < Len && I < MaxVals; ++I)
+  { /* For each field. */
+    if (Fast
+        && (Used = StrToXFastDPrefix(&Buff[Pos], Len - Pos, &NewVal)) != 0
+        && (Used == Len - Pos || Buff[Pos + Used] == Delim))
+    { /* The whole field is a number. */
+      FieldLen = Used;
+      Vals[I] = NewVal;
+      Ok = true;
+    } /* The whole field is a number. */
+    else
+    { /* Find the end of the field. */
+      Next = StrToXFindDelim(&Buff[Pos], &Buff[Len], Delim);
+      FieldLen = (Next != NULL ? (size_t) (Next - &Buff[Pos]) : Len - Pos);
+      Ok = (StrNToD(&Buff[Pos], FieldLen, &Vals[I]) == 0);
+    } /* Find the end of the field. */
+
+    if (!Ok)
+    { /* Error. */
+      Bits |= (uint64_t) 1 << (I % 64);
+    } /* Error. */
+
+    if (I % 64 == 63)
+    { /* Word done. */
+      if (Errs != NULL)
+        Errs[I / 64] = Bits;
+      Bits = 0;
+    } /* Word done. */
+
+    /* Skip the delimiter, if there is one. */
+    Pos += FieldLen + (Pos + FieldLen < Len);
+  } /* For each field. */
+
+  if (I % 64 != 0 && Errs != NULL)
+    Errs[I / 64] = Bits;
+
+  *NVals = I;
+  if (End != NULL)
+    *End = &Buff[Pos];
+
+  return (Pos < Len ? ENOBUFS : 0);
+} /* StrNToDDelim() */
@@ -0,0 +1,42 @@
+#include <errno.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * 'StrNToDDelim()' with the interface 'StrToXDelimPar()' wants.
+ *****************************************************************************/
+static int Convert(const char *Buff, size_t Len, char Delim, int Base,
+                   void *Vals, uint64_t *Errs, size_t *NVals)
+{ /* Convert() */
+  return StrNToDDelim(Buff, Len, Delim, Vals, Errs, NVals, NULL);
+} /* Convert() */
+
+/******************************************************************************
+ * Convert all the 'Delim' separated fields in the 'Len' characters
+ * starting at 'Buff' to a malloc()ed array of 'double', using up to
+ * 'NThreads' threads.  See 'StrToX.h'.
+ *****************************************************************************/
+int StrNToDDelimPar(const char *Buff, size_t Len, char Delim,
+                    unsigned NThreads, double **Vals, uint64_t **Errs,
+                    size_t *NVals)
+{ /* StrNToDDelimPar() */
+  void *NewVals;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Buff == NULL || Vals == NULL || NVals == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  if ((ErrNo = StrToXDelimPar(Buff, Len, Delim, 10, NThreads,
+                               sizeof(**Vals), Convert, &NewVals, Errs,
+                               NVals)) == 0)
+  { /* No error, so return the values. */
+    *Vals = NewVals;
+  } /* No error, so return the values. */
+
+  return ErrNo;
+} /* StrNToDDelimPar() */
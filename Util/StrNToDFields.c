@@ -0,0 +1,45 @@
+#include <errno.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Convert a column of (pointer, length) fields to 'double', exactly as
+ * if by calling 'StrNToD()' on each one.  See 'StrToX.h'.
+ *****************************************************************************/
+int StrNToDFields(const StrField_t *Fields, size_t NFields, double *Vals,
+                  uint64_t *Errs)
+{ /* StrNToDFields() */
+  uint64_t Bits = 0;
+  size_t I;
+
+  /* NULL pointer checking. */
+  if (Fields == NULL || Vals == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  for (I = 0; I < NFields; ++I)
+  { /* For each field. */
+    /* 'StrNToD()' would try 'StrToXFastD()' first anyway.  Doing it
+     * here saves a call per field in the usual case. */
+    if (Fields[I].Ptr == NULL
+        || (!StrToXFastD(Fields[I].Ptr, Fields[I].Len, &Vals[I])
+            && StrNToD(Fields[I].Ptr, Fields[I].Len, &Vals[I]) != 0))
+    { /* Error. */
+      Bits |= (uint64_t) 1 << (I % 64);
+    } /* Error. */
+
+    if (I % 64 == 63)
+    { /* Word done. */
+      if (Errs != NULL)
+        Errs[I / 64] = Bits;
+      Bits = 0;
+    } /* Word done. */
+  } /* For each field. */
+
+  if (NFields % 64 != 0 && Errs != NULL)
+    Errs[NFields / 64] = Bits;
+
+  return 0;
+} /* StrNToDFields() */
@@ -0,0 +1,33 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToI() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToI() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToI(const char *Str, size_t Len, int Base, int *Val)
+{ /* StrNToI(const char *, size_t, int, int *) */
+  intmax_t NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXSigned(Str, Len, Base, INT_MIN, INT_MAX,
+                             &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (int) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToI(const char *, size_t, int, int *) */
@@ -0,0 +1,33 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToI16() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToI16() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToI16(const char *Str, size_t Len, int Base, int16_t *Val)
+{ /* StrNToI16(const char *, size_t, int, int16_t *) */
+  intmax_t NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXSigned(Str, Len, Base, INT16_MIN, INT16_MAX,
+                             &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (int16_t) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToI16(const char *, size_t, int, int16_t *) */
@@ -0,0 +1,33 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToI64() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToI64() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToI64(const char *Str, size_t Len, int Base, int64_t *Val)
+{ /* StrNToI64(const char *, size_t, int, int64_t *) */
+  intmax_t NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXSigned(Str, Len, Base, INT64_MIN, INT64_MAX,
+                             &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (int64_t) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToI64(const char *, size_t, int, int64_t *) */
@@ -0,0 +1,110 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Convert up to 'MaxVals' fields and return the number of characters
+ * used, including the delimiter after the last field, if any.  The
+ * number of fields converted is returned in '*NVals'.  Split out so
+ * that the common case of (Base == 10) can be inlined with a constant
+ * 'Base'.
+ *
+ * If 'Delim' can't be part of a number (i.e. isn't a sign or a digit
+ * in any base) we just parse the number and check that it is followed
+ * by 'Delim' (or the end of the buffer), so a valid field is only
+ * looked at once.  Only if it isn't do we have to look for the end of
+ * the field.
+ *****************************************************************************/
+static inline size_t Convert(const char *Buff, size_t Len, char Delim,
+                             int Base, int64_t *Vals, uint64_t *Errs,
+                             size_t MaxVals, size_t *NVals)
+{ /* Convert() */
+  const char *Next;
+  uint64_t Bits = 0;
+  uintmax_t Mag;
+  intmax_t NewVal;
+  size_t Pos = 0, FieldLen, Used, I;
+  bool Fast, Neg, Range, Ok;
+
+  Fast = (StrToXDigit(Delim) == 36 && Delim != '+' && Delim != '-');
+  for (I = 0; Pos < Len && I < MaxVals; ++I)
+  { /* For each field. */
+    if (Fast
+        && (Used = StrToXParseInt(&Buff[Pos], Len - Pos, Base, INT64_MAX,
+                                  (uintmax_t) INT64_MAX + 1,
+                                  &Mag, &Neg, &Range)) != 0
+        && (Used == Len - Pos || Buff[Pos + Used] == Delim))
+    { /* The whole field is a number. */
+      FieldLen = Used;
+      if ((Ok = !Range))
+        Vals[I] = (Neg && Mag != 0 ? -(int64_t) (Mag - 1) - 1 : (int64_t) Mag);
+    } /* The whole field is a number. */
+    else
+    { /* Find the end of the field. */
+      Next = StrToXFindDelim(&Buff[Pos], &Buff[Len], Delim);
+      FieldLen = (Next != NULL ? (size_t) (Next - &Buff[Pos]) : Len - Pos);
+      /* If we already tried parsing it, it's bad. */
+      if ((Ok = (!Fast
+                 && StrNToXSigned(&Buff[Pos], FieldLen, Base, INT64_MIN,
+                                  INT64_MAX, &NewVal) == 0)))
+        Vals[I] = (int64_t) NewVal;
+    } /* Find the end of the field. */
+
+    if (!Ok)
+    { /* Error. */
+      Bits |= (uint64_t) 1 << (I % 64);
+    } /* Error. */
+
+    if (I % 64 == 63)
+    { /* Word done. */
+      if (Errs != NULL)
+        Errs[I / 64] = Bits;
+      Bits = 0;
+    } /* Word done. */
+
+    /* Skip the delimiter, if there is one. */
+    Pos += FieldLen + (Pos + FieldLen < Len);
+  } /* For each field. */
+
+  if (I % 64 != 0 && Errs != NULL)
+    Errs[I / 64] = Bits;
+
+  *NVals = I;
+  return Pos;
+} /* Convert() */
+
+/******************************************************************************
+ * Convert the 'Delim' separated fields in the 'Len' characters
+ * starting at 'Buff' to 'int64_t', exactly as if by calling
+ * 'StrNToI64()' on each one.  See 'StrToX.h'.
+ *****************************************************************************/
+int StrNToI64Delim(const char *Buff, size_t Len, char Delim, int Base,
+                   int64_t *Vals, uint64_t *Errs, size_t *NVals,
+                   const char **End)
+{ /* StrNToI64Delim() */
+  size_t Used;
+
+  /* NULL pointer checking. */
+  if (Buff == NULL || Vals == NULL || NVals == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  if (Base != 0 && (Base < 2 || Base > 36))
+  { /* Invalid base. */
+    return EDOM;
+  } /* Invalid base. */
+
+  if (Base == 10)
+    Used = Convert(Buff, Len, Delim, 10, Vals, Errs, *NVals, NVals);
+  else
+    Used = Convert(Buff, Len, Delim, Base, Vals, Errs, *NVals, NVals);
+
+  if (End != NULL)
+    *End = &Buff[Used];
+
+  return (Used < Len ? ENOBUFS : 0);
+} /* StrNToI64Delim() */
@@ -0,0 +1,47 @@
+#include <errno.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * 'StrNToI64Delim()' with the interface 'StrToXDelimPar()' wants.
+ *****************************************************************************/
+static int Convert(const char *Buff, size_t Len, char Delim, int Base,
+                   void *Vals, uint64_t *Errs, size_t *NVals)
+{ /* Convert() */
+  return StrNToI64Delim(Buff, Len, Delim, Base, Vals, Errs, NVals, NULL);
+} /* Convert() */
+
+/******************************************************************************
+ * Convert all the 'Delim' separated fields in the 'Len' characters
+ * starting at 'Buff' to a malloc()ed array of 'int64_t', using up to
+ * 'NThreads' threads.  See 'StrToX.h'.
+ *****************************************************************************/
+int StrNToI64DelimPar(const char *Buff, size_t Len, char Delim, int Base,
+                      unsigned NThreads, int64_t **Vals, uint64_t **Errs,
+                      size_t *NVals)
+{ /* StrNToI64DelimPar() */
+  void *NewVals;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Buff == NULL || Vals == NULL || NVals == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  if (Base != 0 && (Base < 2 || Base > 36))
+  { /* Invalid base. */
+    return EDOM;
+  } /* Invalid base. */
+
+  if ((ErrNo = StrToXDelimPar(Buff, Len, Delim, Base, NThreads,
+                               sizeof(**Vals), Convert, &NewVals, Errs,
+                               NVals)) == 0)
+  { /* No error, so return the values. */
+    *Vals = NewVals;
+  } /* No error, so return the values. */
+
+  return ErrNo;
+} /* StrNToI64DelimPar() */
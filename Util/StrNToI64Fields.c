@@ -0,0 +1,67 @@
+#include <errno.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Convert each field in turn.  Split out so that the common case of
+ * (Base == 10) can be inlined with a constant 'Base'.
+ *****************************************************************************/
+static inline void Convert(const StrField_t *Fields, size_t NFields, int Base,
+                           int64_t *Vals, uint64_t *Errs)
+{ /* Convert() */
+  uint64_t Bits = 0;
+  intmax_t NewVal;
+  size_t I;
+
+  for (I = 0; I < NFields; ++I)
+  { /* For each field. */
+    if (Fields[I].Ptr != NULL
+        && StrNToXSigned(Fields[I].Ptr, Fields[I].Len, Base,
+                         INT64_MIN, INT64_MAX, &NewVal) == 0)
+    { /* No error, so return converted value. */
+      Vals[I] = (int64_t) NewVal;
+    } /* No error, so return converted value. */
+    else
+    { /* Error. */
+      Bits |= (uint64_t) 1 << (I % 64);
+    } /* Error. */
+
+    if (I % 64 == 63)
+    { /* Word done. */
+      if (Errs != NULL)
+        Errs[I / 64] = Bits;
+      Bits = 0;
+    } /* Word done. */
+  } /* For each field. */
+
+  if (NFields % 64 != 0 && Errs != NULL)
+    Errs[NFields / 64] = Bits;
+} /* Convert() */
+
+/******************************************************************************
+ * Convert a column of (pointer, length) fields to 'int64_t', exactly
+ * as if by calling 'StrNToI64()' on each one.  See 'StrToX.h'.
+ *****************************************************************************/
+int StrNToI64Fields(const StrField_t *Fields, size_t NFields, int Base,
+                    int64_t *Vals, uint64_t *Errs)
+{ /* StrNToI64Fields() */
+  /* NULL pointer checking. */
+  if (Fields == NULL || Vals == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  if (Base != 0 && (Base < 2 || Base > 36))
+  { /* Invalid base. */
+    return EDOM;
+  } /* Invalid base. */
+
+  if (Base == 10)
+    Convert(Fields, NFields, 10, Vals, Errs);
+  else
+    Convert(Fields, NFields, Base, Vals, Errs);
+
+  return 0;
+} /* StrNToI64Fields() */
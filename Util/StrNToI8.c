@@ -0,0 +1,33 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToI8() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToI8() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToI8(const char *Str, size_t Len, int Base, int8_t *Val)
+{ /* StrNToI8(const char *, size_t, int, int8_t *) */
+  intmax_t NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXSigned(Str, Len, Base, INT8_MIN, INT8_MAX,
+                             &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (int8_t) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToI8(const char *, size_t, int, int8_t *) */
@@ -0,0 +1,33 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToL() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToL() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToL(const char *Str, size_t Len, int Base, long *Val)
+{ /* StrNToL(const char *, size_t, int, long *) */
+  intmax_t NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXSigned(Str, Len, Base, LONG_MIN, LONG_MAX,
+                             &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (long) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToL(const char *, size_t, int, long *) */
@@ -0,0 +1,33 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToLL() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToLL() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToLL(const char *Str, size_t Len, int Base, long long *Val)
+{ /* StrNToLL(const char *, size_t, int, long long *) */
+  intmax_t NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXSigned(Str, Len, Base, LLONG_MIN, LLONG_MAX,
+                             &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (long long) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToLL(const char *, size_t, int, long long *) */
@@ -0,0 +1,33 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToS() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToS() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToS(const char *Str, size_t Len, int Base, short *Val)
+{ /* StrNToS(const char *, size_t, int, short *) */
+  intmax_t NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXSigned(Str, Len, Base, SHRT_MIN, SHRT_MAX,
+                             &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (short) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToS(const char *, size_t, int, short *) */
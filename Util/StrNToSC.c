@@ -0,0 +1,33 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToSC() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToSC() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToSC(const char *Str, size_t Len, int Base, signed char *Val)
+{ /* StrNToSC(const char *, size_t, int, signed char *) */
+  intmax_t NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXSigned(Str, Len, Base, SCHAR_MIN, SCHAR_MAX,
+                             &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (signed char) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToSC(const char *, size_t, int, signed char *) */
@@ -0,0 +1,30 @@
+#include <errno.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToSChar() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToSChar() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToSChar(const char *Str, size_t Len, signed char *Val)
+{ /* StrNToSChar(const char *, size_t, signed char *) */
+  unsigned char NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXChar(Str, Len, &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (signed char) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToSChar(const char *, size_t, signed char *) */
@@ -0,0 +1,30 @@
+#include <errno.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToUChar() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToUChar() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToUChar(const char *Str, size_t Len, unsigned char *Val)
+{ /* StrNToUChar(const char *, size_t, unsigned char *) */
+  unsigned char NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXChar(Str, Len, &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (unsigned char) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToUChar(const char *, size_t, unsigned char *) */
@@ -0,0 +1,32 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToUI() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToUI() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToUI(const char *Str, size_t Len, int Base, unsigned int *Val)
+{ /* StrNToUI(const char *, size_t, int, unsigned int *) */
+  uintmax_t NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXUnsigned(Str, Len, Base, UINT_MAX, &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (unsigned int) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToUI(const char *, size_t, int, unsigned int *) */
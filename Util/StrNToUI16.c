@@ -0,0 +1,32 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToUI16() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToUI16() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToUI16(const char *Str, size_t Len, int Base, uint16_t *Val)
+{ /* StrNToUI16(const char *, size_t, int, uint16_t *) */
+  uintmax_t NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXUnsigned(Str, Len, Base, UINT16_MAX, &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (uint16_t) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToUI16(const char *, size_t, int, uint16_t *) */
@@ -0,0 +1,32 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToUI32() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToUI32() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToUI32(const char *Str, size_t Len, int Base, uint32_t *Val)
+{ /* StrNToUI32(const char *, size_t, int, uint32_t *) */
+  uintmax_t NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXUnsigned(Str, Len, Base, UINT32_MAX, &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (uint32_t) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToUI32(const char *, size_t, int, uint32_t *) */
@@ -0,0 +1,32 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/******************************************************************************
+ * Equivalent to StrToUL() but converts exactly the 'Len' characters
+ * starting at 'Str', which need not be NUL terminated.  Error
+ * semantics are those of StrToUL() with "all of 'Str'" meaning all
+ * 'Len' characters, so (Len == 0) is an EINVAL error.
+ *****************************************************************************/
+int StrNToUL(const char *Str, size_t Len, int Base, unsigned long *Val)
+{ /* StrNToUL(const char *, size_t, int, unsigned long *) */
+  uintmax_t NewVal;
+  int ErrNo;
+
+  /* NULL pointer checking. */
+  if (Str == NULL || Val == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  /* Do the conversion. */
+  if ((ErrNo = StrNToXUnsigned(Str, Len, Base, ULONG_MAX, &NewVal)) == 0)
+  { /* No error, so return converted value. */
+    *Val = (unsigned long) NewVal;
+  } /* No error, so return converted value. */
+
+  return ErrNo;
+} /* StrNToUL(const char *, size_t, int, unsigned long *) */
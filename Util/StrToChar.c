@@ -1,7 +1,9 @@
 #include <errno.h>
 #include <limits.h>
+#include <stdint.h>
 
 #include "StrToX.h"
+#include "StrToXImpl.h"
 
 /******************************************************************************
  * Equivalent to 'strtoc()' but with simplified error reporting.
@@ -14,43 +16,20 @@
  *****************************************************************************/
 int StrToChar(const char *Str, char *Val)
 { /* StrToChar(char *, char *) */
-  char NewVal;
-  char *End = NULL;
-  int SavedErrNo, ErrNo;
+  unsigned char NewVal;
+  int ErrNo;
 
-  /* NULL checking. */
+  /* NULL pointer checking. */
   if (Str == NULL || Val == NULL)
   { /* Error. */
     return EFAULT;
   } /* Error. */
 
-  /* Check that 'Str' is not empty. */
-  if (*Str == '\0')
-  { /* Error. */
-    return EINVAL;
-  } /* Error. */
-
-  /* strtoc() returns error status in 'errno' but we must leave it
-   * unchanged. */
-  SavedErrNo = errno;
-
   /* Do the conversion. */
-  errno = 0;
-  NewVal = strtochar(Str, &End);
-  ErrNo = errno;
-
-  /* Check for errors. */
-  if (End == Str || *End != '\0')
-  { /* Error. */
-    ErrNo = EINVAL;
-  } /* Error. */
-
-  else if (ErrNo == 0)
+  if ((ErrNo = StrNToXChar(Str, SIZE_MAX, &NewVal)) == 0)
   { /* No error, so return converted value. */
-    *Val = NewVal;
+    *Val = (char) NewVal;
   } /* No error, so return converted value. */
 
-  /* Restore global 'errno' and return 'ErrNo'. */
-  errno = SavedErrNo;
   return ErrNo;
 } /* StrToChar(char *, char *) */
@@ -1,8 +1,10 @@
 #include <errno.h>
 #include <limits.h>
 #include <ctype.h>
+#include <locale.h>
 
 #include "StrToX.h"
+#include "StrToXImpl.h"
 
 /******************************************************************************
  * Equivalent to strtod() but with simplified error reporting.
@@ -12,12 +14,19 @@
  * for a malformed 'Str'.  If the function returns non-zero then
  * '*Val' is unchanged.  In all cases neither 'Str' nor 'Val' may be
  * NULL.
+ *
+ * Numbers are always read as in the "C" locale (i.e. the decimal
+ * point is '.') whatever the current locale.  Plain decimal numbers
+ * whose value is neither subnormal nor out of range, which is to say
+ * nearly all of them, are converted by the much faster (but equally
+ * exact) 'StrToXFastD()'.  Everything else goes to strtod().
  *****************************************************************************/
 int StrToD(const char *Str, double *Val)
 { /* StrToD(const char *, double *) */
   char *End;
   double NewVal;
   int SavedErrNo, ErrNo;
+  locale_t CLocale, OldLocale;
 
   /* Error checking. */
   if (Str == NULL || Val == NULL)
@@ -25,19 +34,35 @@ int StrToD(const char *Str, double *Val)
     return EFAULT;
   } /* Error. */
 
-  if (*Str == '\0' || isspace(*Str))
+  if (*Str == '\0' || isspace((unsigned char) *Str))
   { /* Error. */
     return EINVAL;
   } /* Error. */
 
+  /* The common case. */
+  if (StrToXFastD(Str, SIZE_MAX, Val))
+  { /* Done. */
+    return 0;
+  } /* Done. */
+
   /* strtod() returns error status in 'errno' but we must leave it
    * unchanged. */
   SavedErrNo = errno;
 
-  /* Do the conversion. */
+  /* Do the conversion in the "C" locale.  'uselocale()' only affects
+   * this thread. */
+  if ((CLocale = StrToXCLocale()) == (locale_t) 0
+      || (OldLocale = uselocale(CLocale)) == (locale_t) 0)
+  { /* Error. */
+    ErrNo = errno;
+    errno = SavedErrNo;
+    return ErrNo;
+  } /* Error. */
+
   errno = 0;
   NewVal = strtod(Str, &End);
   ErrNo = errno;
+  uselocale(OldLocale);
 
   /****************************************************************************
    * We already know that 'Str' is not NULL, is not empty, and does
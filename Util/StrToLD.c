@@ -1,8 +1,10 @@
 #include <errno.h>
 #include <limits.h>
 #include <ctype.h>
+#include <locale.h>
 
 #include "StrToX.h"
+#include "StrToXImpl.h"
 
 /******************************************************************************
  * Equivalent to strtold() but with simplified error reporting.
@@ -12,12 +14,17 @@
  * for a malformed 'Str'.  If the function returns non-zero then
  * '*Val' is unchanged.  In all cases neither 'Str' nor 'Val' may be
  * NULL.
+ *
+ * Numbers are always read as in the "C" locale (i.e. the decimal
+ * point is '.') whatever the current locale, just like 'StrToF()' and
+ * 'StrToD()'.
  *****************************************************************************/
 int StrToLD(const char *Str, long double *Val)
 { /* StrToLD(const char *, long double *) */
   char *End;
   long double NewVal;
   int SavedErrNo, ErrNo;
+  locale_t CLocale, OldLocale;
 
   /* Error checking. */
   if (Str == NULL || Val == NULL)
@@ -25,7 +32,7 @@ int StrToLD(const char *Str, long double *Val)
     return EFAULT;
   } /* Error. */
 
-  if (*Str == '\0' || isspace(*Str))
+  if (*Str == '\0' || isspace((unsigned char) *Str))
   { /* Error. */
     return EINVAL;
   } /* Error. */
@@ -34,10 +41,20 @@ int StrToLD(const char *Str, long double *Val)
    * unchanged. */
   SavedErrNo = errno;
 
-  /* Do the conversion. */
+  /* Do the conversion in the "C" locale.  'uselocale()' only affects
+   * this thread. */
+  if ((CLocale = StrToXCLocale()) == (locale_t) 0
+      || (OldLocale = uselocale(CLocale)) == (locale_t) 0)
+  { /* Error. */
+    ErrNo = errno;
+    errno = SavedErrNo;
+    return ErrNo;
+  } /* Error. */
+
   errno = 0;
   NewVal = strtold(Str, &End);
   ErrNo = errno;
+  uselocale(OldLocale);
 
   /****************************************************************************
    * We already know that 'Str' is not NULL, is not empty, and does
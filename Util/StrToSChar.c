@@ -1,7 +1,9 @@
 #include <errno.h>
 #include <limits.h>
+#include <stdint.h>
 
 #include "StrToX.h"
+#include "StrToXImpl.h"
 
 /******************************************************************************
  * Equivalent to 'strtosc()' but with simplified error reporting.
@@ -14,9 +16,8 @@
  *****************************************************************************/
 int StrToSChar(const char *Str, signed char *Val)
 { /* StrToSChar(char *, char *) */
-  signed char NewVal;
-  char *End;
-  int SavedErrNo, ErrNo;
+  unsigned char NewVal;
+  int ErrNo;
 
   /* NULL pointer checking. */
   if (Str == NULL || Val == NULL)
@@ -24,33 +25,11 @@ int StrToSChar(const char *Str, signed char *Val)
     return EFAULT;
   } /* Error. */
 
-  /* Check that 'Str' is not empty. */
-  if (*Str == '\0')
-  { /* Error. */
-    return EINVAL;
-  } /* Error. */
-
-  /* strtoc() returns error status in 'errno' but we must leave it
-   * unchanged. */
-  SavedErrNo = errno;
-
   /* Do the conversion. */
-  errno = 0;
-  NewVal = strtoschar(Str, &End);
-  ErrNo = errno;
-
-  /* Check for errors. */
-  if (End == Str || *End != '\0')
-  { /* Error. */
-    ErrNo = EINVAL;
-  } /* Error. */
-
-  else if (ErrNo == 0)
+  if ((ErrNo = StrNToXChar(Str, SIZE_MAX, &NewVal)) == 0)
   { /* No error, so return converted value. */
-    *Val = NewVal;
+    *Val = (signed char) NewVal;
   } /* No error, so return converted value. */
 
-  /* Restore global 'errno' and return 'ErrNo'. */
-  errno = SavedErrNo;
   return ErrNo;
 } /* StrToSChar(char *, signed char *) */
@@ -1,7 +1,9 @@
 #include <errno.h>
 #include <limits.h>
+#include <stdint.h>
 
 #include "StrToX.h"
+#include "StrToXImpl.h"
 
 /******************************************************************************
  * Equivalent to strtouc() but with simplified error reporting.
@@ -15,42 +17,19 @@
 int StrToUChar(const char *Str, unsigned char *Val)
 { /* StrToUChar(char *, char *) */
   unsigned char NewVal;
-  char *End;
-  int SavedErrNo, ErrNo;
+  int ErrNo;
 
-  /* Error checking. */
+  /* NULL pointer checking. */
   if (Str == NULL || Val == NULL)
   { /* Error. */
     return EFAULT;
   } /* Error. */
 
-  /* Check that 'Str' is not empty. */
-  if (*Str == '\0')
-  { /* Error. */
-    return EINVAL;
-  } /* Error. */
-
-  /* strtoc() returns error status in 'errno' but we must leave it
-   * unchanged. */
-  SavedErrNo = errno;
-
   /* Do the conversion. */
-  errno = 0;
-  NewVal = strtouchar(Str, &End);
-  ErrNo = errno;
-
-  /* Check for errors. */
-  if (End == Str || *End != '\0')
-  { /* Error. */
-    ErrNo = EINVAL;
-  } /* Error. */
-
-  else if (ErrNo == 0)
+  if ((ErrNo = StrNToXChar(Str, SIZE_MAX, &NewVal)) == 0)
   { /* No error, so return converted value. */
-    *Val = NewVal;
+    *Val = (unsigned char) NewVal;
   } /* No error, so return converted value. */
 
-  /* Restore global 'errno' and return 'ErrNo'. */
-  errno = SavedErrNo;
   return ErrNo;
 } /* StrToUChar(char *, unsigned char *) */
@@ -21,15 +21,18 @@ extern "C" {
 /******************************************************************************
  * Functions equivalent to strtol(), etc., for other basic types.
  *
- * WARNING: All the 'strtoX()' functions except 'strtochar()',
- * 'strtoschar()', and 'strtouchar()' (which we wrote from scratch)
- * are in turn based on 'strtol()', 'strtoul()', 'strtoll()', and
- * 'strtoull()'.  These underlying functions have error semantics
- * which are at best awkward, and at worst undefined.  Read both the
- * Linux man pages, and the Open Group's "The Single Unix
- * Specification" / POSIX.1-2008 spec carefully(!) as the
- * corresponding functions declared here ('strtos()', etc.) have
- * exactly analogous error semantics.
+ * WARNING: All the numeric 'strtoX()' functions have exactly the
+ * semantics of 'strtol()', 'strtoul()', 'strtoll()', and 'strtoull()'
+ * for the corresponding types.  These semantics are at best awkward,
+ * and at worst undefined.  Read both the Linux man pages, and the
+ * Open Group's "The Single Unix Specification" / POSIX.1-2008 spec
+ * carefully(!).  (For what it's worth, where the spec says the
+ * behavior is undefined, i.e. for an invalid 'Base', we do what glibc
+ * does: return 0 and set 'errno' to EINVAL.)  However, none of them
+ * actually call the standard functions.  They all share a single
+ * digit-by-digit conversion engine that checks for overflow against
+ * the limits of the target type as it goes, and that only touches
+ * 'errno' if there is an error to report.
  *****************************************************************************/
   /* These interpret C escape sequences in 'Str'.  NOTE: These
    * functions do _not_ understand the '\unnnn' and '\Unnnn' escape
@@ -103,12 +106,14 @@ extern "C" {
  *   2.4) For functions that take a 'Base' argument, if '(Base != 0 &&
  *        (Base < 2 || Base > 36))', then EDOM is returned.
  *
- *   2.5) Should the underlying 'strtoX()' function sets 'errno' to any
- *        value other than 0, EINVAL, or ERANGE, that value is
- *        returned and '*Val' is unchanged.
+ *   2.5) For 'StrToF()', 'StrToD()', and 'StrToLD()' only, should the
+ *        underlying 'strtoX()' function set 'errno' to any value
+ *        other than 0, EINVAL, or ERANGE, that value is returned and
+ *        '*Val' is unchanged.
  *
- * 3) On return, the global 'errno' is unchanged (although it may be
- *    temporarily modified internally to the functiuon).
+ * 3) On return, the global 'errno' is unchanged.  (The integer and
+ *    character conversions never touch it at all.  The floating point
+ *    ones may modify it temporarily.)
  *
  * So, the caller simply needs to do (for exmple):
  *
@@ -149,6 +154,10 @@ extern "C" {
   extern int StrToLL(const char *Str, int Base, long long *Val);
   extern int StrToULL(const char *Str, int Base, unsigned long long *Val);
 
+  /* These always use the "C" locale, i.e. the decimal point is '.'.
+   * 'StrToF()' and 'StrToD()' convert ordinary decimal numbers
+   * themselves, exactly but much faster than 'strtof()' and
+   * 'strtod()', and only use those for anything else. */
   extern int StrToF(const char *Str, float *Val);
   extern int StrToD(const char *Str, double *Val);
   extern int StrToLD(const char *Str, long double *Val);
@@ -185,6 +194,229 @@ extern "C" {
   extern int StrToIF64(const char *Str, int Base, int_fast64_t *Val);
   extern int StrToUIF64(const char *Str, int Base, uint_fast64_t *Val);
 
+/******************************************************************************
+ * The StrNToX() functions are exactly like the StrToX() functions
+ * except that they convert the 'Len' characters starting at 'Str'
+ * rather than a NUL terminated C string.  So they can be used to
+ * convert fields "in place" (e.g. in a buffer read from a file or a
+ * socket, or an 'mmap()'ed file) without first copying each one
+ * somewhere just to terminate it.  The error semantics are the same
+ * as above, with "all of 'Str'" meaning all 'Len' characters.  In
+ * particular:
+ *
+ * 1) The characters 'Str[0]' to 'Str[Len-1]' must be exactly one
+ *    valid subject sequence.  If not, or if (Len == 0), then EINVAL
+ *    is returned.  Nothing at or beyond 'Str[Len]' is ever examined,
+ *    so the field may be followed by anything (a delimiter, the next
+ *    field, the end of a mapping, ...).
+ *
+ * 2) If 'Str' is NULL, EFAULT is returned even if (Len == 0).
+ *
+ * For example:
+ *
+ *   const char *Line = "42,1.5,foo";
+ *   int32_t I;
+ *   double D;
+ *
+ *   ErrNo = StrNToI32(Line, 2, 10, &I);       // I == 42
+ *   ErrNo = StrNToD(&Line[3], 3, &D);         // D == 1.5
+ *****************************************************************************/
+  extern int StrNToChar(const char *Str, size_t Len, char *Val);
+  extern int StrNToSChar(const char *Str, size_t Len, signed char *Val);
+  extern int StrNToUChar(const char *Str, size_t Len, unsigned char *Val);
+
+  static inline int StrNToC(const char *Str, size_t Len, int Base, char *Val);
+  extern int StrNToSC(const char *Str, size_t Len, int Base, signed char *Val);
+  extern int StrNToUC(const char *Str, size_t Len, int Base,
+                      unsigned char *Val);
+  extern int StrNToS(const char *Str, size_t Len, int Base, short *Val);
+  extern int StrNToUS(const char *Str, size_t Len, int Base,
+                      unsigned short *Val);
+  extern int StrNToI(const char *Str, size_t Len, int Base, int *Val);
+  extern int StrNToUI(const char *Str, size_t Len, int Base,
+                      unsigned int *Val);
+  extern int StrNToL(const char *Str, size_t Len, int Base, long *Val);
+  extern int StrNToUL(const char *Str, size_t Len, int Base,
+                      unsigned long *Val);
+  extern int StrNToLL(const char *Str, size_t Len, int Base, long long *Val);
+  extern int StrNToULL(const char *Str, size_t Len, int Base,
+                       unsigned long long *Val);
+
+  extern int StrNToF(const char *Str, size_t Len, float *Val);
+  extern int StrNToD(const char *Str, size_t Len, double *Val);
+  extern int StrNToLD(const char *Str, size_t Len, long double *Val);
+
+  extern int StrNToI8(const char *Str, size_t Len, int Base, int8_t *Val);
+  extern int StrNToUI8(const char *Str, size_t Len, int Base, uint8_t *Val);
+  extern int StrNToI16(const char *Str, size_t Len, int Base, int16_t *Val);
+  extern int StrNToUI16(const char *Str, size_t Len, int Base, uint16_t *Val);
+  extern int StrNToI32(const char *Str, size_t Len, int Base, int32_t *Val);
+  extern int StrNToUI32(const char *Str, size_t Len, int Base, uint32_t *Val);
+  extern int StrNToI64(const char *Str, size_t Len, int Base, int64_t *Val);
+  extern int StrNToUI64(const char *Str, size_t Len, int Base, uint64_t *Val);
+  extern int StrNToIMax(const char *Str, size_t Len, int Base, intmax_t *Val);
+  extern int StrNToUMax(const char *Str, size_t Len, int Base,
+                        uintmax_t *Val);
+
+  extern int StrNToIL8(const char *Str, size_t Len, int Base,
+                       int_least8_t *Val);
+  extern int StrNToUIL8(const char *Str, size_t Len, int Base,
+                        uint_least8_t *Val);
+  extern int StrNToIL16(const char *Str, size_t Len, int Base,
+                        int_least16_t *Val);
+  extern int StrNToUIL16(const char *Str, size_t Len, int Base,
+                         uint_least16_t *Val);
+  extern int StrNToIL32(const char *Str, size_t Len, int Base,
+                        int_least32_t *Val);
+  extern int StrNToUIL32(const char *Str, size_t Len, int Base,
+                         uint_least32_t *Val);
+  extern int StrNToIL64(const char *Str, size_t Len, int Base,
+                        int_least64_t *Val);
+  extern int StrNToUIL64(const char *Str, size_t Len, int Base,
+                         uint_least64_t *Val);
+
+  extern int StrNToIF8(const char *Str, size_t Len, int Base,
+                       int_fast8_t *Val);
+  extern int StrNToUIF8(const char *Str, size_t Len, int Base,
+                        uint_fast8_t *Val);
+  extern int StrNToIF16(const char *Str, size_t Len, int Base,
+                        int_fast16_t *Val);
+  extern int StrNToUIF16(const char *Str, size_t Len, int Base,
+                         uint_fast16_t *Val);
+  extern int StrNToIF32(const char *Str, size_t Len, int Base,
+                        int_fast32_t *Val);
+  extern int StrNToUIF32(const char *Str, size_t Len, int Base,
+                         uint_fast32_t *Val);
+  extern int StrNToIF64(const char *Str, size_t Len, int Base,
+                        int_fast64_t *Val);
+  extern int StrNToUIF64(const char *Str, size_t Len, int Base,
+                         uint_fast64_t *Val);
+
+/******************************************************************************
+ * Batch conversions.  These convert a whole column of fields in one
+ * call with exactly the results of calling 'StrNToI64()' or 'StrNToD()'
+ * on each field in turn, but the argument checking is done once per
+ * call rather than once per field and there is no per field call and
+ * 'errno' overhead.
+ *
+ * A column is either an array of 'NFields' (pointer, length) pairs,
+ * or a buffer of 'Len' characters in which the fields are separated by
+ * 'Delim'.  In a buffer, a 'Delim' at the very end does not start
+ * another (empty) field, so a file of newline terminated lines can be
+ * converted as is.  Nothing else (white space, a '\r' before a '\n')
+ * is stripped.
+ *
+ * Field 'I' is converted into 'Vals[I]'.  If the conversion fails, bit
+ * (I % 64) of 'Errs[I / 64]' is set and 'Vals[I]' is unchanged,
+ * otherwise the bit is cleared.  'Errs' must have room for
+ * 'STRTOX_ERR_WORDS(N)' words for 'N' fields, and the unused bits of
+ * the last word are cleared.  'StrToXFailed(Errs, I)' tests the bit
+ * for field 'I'.  'Errs' may be NULL if you don't care which fields
+ * failed.  To find out why a field failed convert it again with the
+ * corresponding 'StrNToX()' function.
+ *
+ * For the 'Delim' versions '*NVals' is the size of 'Vals' (and 'Errs'
+ * in bits) on entry, and the number of fields converted on return.  If
+ * 'End' is not NULL '*End' is set to the first character not
+ * converted, i.e. '&Buff[Len]' if all of them were.
+ *
+ * The functions return 0 if the arguments are OK, even if some fields
+ * couldn't be converted.  Otherwise they return:
+ *
+ *   EFAULT if 'Fields', 'Buff', 'Vals', or 'NVals' is NULL.  (A NULL
+ *     'Ptr' in a field just makes that field fail.)
+ *
+ *   EDOM if '(Base != 0 && (Base < 2 || Base > 36))'.
+ *
+ *   ENOBUFS if there are more than '*NVals' fields in 'Buff'.  The
+ *     first '*NVals' are still converted so the caller can carry on
+ *     from '*End'.
+ *
+ * For example:
+ *
+ *   const char *Col = "42\n-7\nfoo\n";
+ *   int64_t Vals[3];
+ *   uint64_t Errs[STRTOX_ERR_WORDS(3)];
+ *   size_t NVals = 3;
+ *
+ *   ErrNo = StrNToI64Delim(Col, strlen(Col), '\n', 10, Vals, Errs,
+ *                          &NVals, NULL);
+ *   // ErrNo == 0, NVals == 3, Vals[0] == 42, Vals[1] == -7,
+ *   // StrToXFailed(Errs, 2) != 0.
+ *****************************************************************************/
+  typedef struct StrField
+  {
+    const char *Ptr;
+    size_t Len;
+  } StrField_t;
+
+#define STRTOX_ERR_WORDS(N) (((N) + 63) / 64)
+
+  static inline int StrToXFailed(const uint64_t *Errs, size_t I);
+
+  extern int StrNToI64Fields(const StrField_t *Fields, size_t NFields,
+                             int Base, int64_t *Vals, uint64_t *Errs);
+  extern int StrNToDFields(const StrField_t *Fields, size_t NFields,
+                           double *Vals, uint64_t *Errs);
+
+  extern int StrNToI64Delim(const char *Buff, size_t Len, char Delim,
+                            int Base, int64_t *Vals, uint64_t *Errs,
+                            size_t *NVals, const char **End);
+  extern int StrNToDDelim(const char *Buff, size_t Len, char Delim,
+                          double *Vals, uint64_t *Errs, size_t *NVals,
+                          const char **End);
+
+/******************************************************************************
+ * Parallel batch conversions.  These are the 'Delim' versions above
+ * for big buffers (e.g. a whole mmap()ed file): 'Buff' is split at
+ * 'Delim's into one part per thread, the parts are converted at the
+ * same time, and the results come back in one array in the original
+ * order, exactly as if 'StrNToI64Delim()' or 'StrNToDDelim()' had
+ * converted the whole buffer.
+ *
+ * Up to 'NThreads' threads are used (counting the calling thread),
+ * or one per online CPU if 'NThreads' is 0.  Fewer are used for a
+ * small buffer, where starting a thread would cost more than it
+ * saves, so small buffers are converted in the calling thread.
+ *
+ * Since the number of fields isn't known in advance the results are
+ * returned in a malloc()ed array, '*Vals', of '*NVals' values, and if
+ * 'Errs' isn't NULL a malloc()ed error bitmap '*Errs' (as above).
+ * Free them with free().  If there are no fields both are NULL.  The
+ * first '*NVals' bits of '*Errs' are all that are valid.
+ *
+ * The functions return 0 if the arguments are OK, even if some fields
+ * couldn't be converted.  Otherwise nothing is allocated and they
+ * return:
+ *
+ *   EFAULT if 'Buff', 'Vals', or 'NVals' is NULL.
+ *
+ *   EDOM if '(Base != 0 && (Base < 2 || Base > 36))'.
+ *
+ *   ENOMEM if the results can't be allocated.
+ *
+ * For example, with 'Buff' and 'Len' a mmap()ed file of one number per
+ * line:
+ *
+ *   double *Vals;
+ *   uint64_t *Errs;
+ *   size_t NVals;
+ *
+ *   if ((ErrNo = StrNToDDelimPar(Buff, Len, '\n', 0, &Vals, &Errs,
+ *                                &NVals)) == 0)
+ *   {
+ *     // Use Vals[0] ... Vals[NVals - 1].
+ *     free(Errs);
+ *     free(Vals);
+ *   }
+ *****************************************************************************/
+  extern int StrNToI64DelimPar(const char *Buff, size_t Len, char Delim,
+                               int Base, unsigned NThreads, int64_t **Vals,
+                               uint64_t **Errs, size_t *NVals);
+  extern int StrNToDDelimPar(const char *Buff, size_t Len, char Delim,
+                             unsigned NThreads, double **Vals,
+                             uint64_t **Errs, size_t *NVals);
+
 /******************************************************************************
  * Inline method definitions.
  *****************************************************************************/
@@ -210,6 +442,22 @@ extern "C" {
 #endif
   } /*StrToC() */
 
+  static inline int StrNToC(const char *Str, size_t Len, int Base, char *Val)
+  { /* StrNToC() */
+#if CHAR_MIN == SCHAR_MIN && CHAR_MAX == SCHAR_MAX
+    return StrNToSC(Str, Len, Base, (signed char *) Val);
+#elif CHAR_MIN == UCHAR_MIN && CHAR_MAX == UCHAR_MAX
+    return StrNToUC(Str, Len, Base, (unsigned char *) Val);
+#else
+#error "Can not implement StrNToC()."
+#endif
+  } /* StrNToC() */
+
+  static inline int StrToXFailed(const uint64_t *Errs, size_t I)
+  { /* StrToXFailed() */
+    return (int) ((Errs[I / 64] >> (I % 64)) & 1);
+  } /* StrToXFailed() */
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
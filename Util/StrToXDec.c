@@ -0,0 +1,257 @@
+/******************************************************************************
+ * Fast conversion of runs of decimal digits for the 'StrToX()'
+ * family.  See 'StrToXDecScan' in 'StrToXImpl.h' for the interface.
+ *
+ * There are three versions:
+ *
+ * SWAR: Portable C working on 8 digits at a time in a 64-bit word
+ *   ("SIMD within a register").  Used on little endian machines
+ *   without anything better.  Big endian machines get a plain loop.
+ *
+ * SSE4.1: Validates 16 characters with one compare and converts them
+ *   with three multiply-adds.
+ *
+ * AVX2: The same code as SSE4.1, but VEX encoded.
+ *
+ * The version is picked once, when the library is loaded, by
+ * 'CpuFeatures()'.  All of them give exactly the same results.
+ *
+ * None of them read past the end of the string (i.e. past 'Len' or
+ * the terminating '\0').  A NUL terminated string is measured first,
+ * but only as far as the most digits we'd use, and when there are
+ * fewer characters left than a load takes they're copied into a
+ * buffer padded with '\0's (which aren't digits) and loaded from
+ * there.
+ *****************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Cpu.h"
+#include "Pow10.h"
+#include "StrToXImpl.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+/******************************************************************************
+ * The number of characters of 'Str' that we may look at.  A 'Len'
+ * greater than PTRDIFF_MAX can't be the size of a real object so it
+ * means a NUL terminated string of unknown length, and we only need
+ * to know how much of it there is up to 'STRTOX_DEC_DIGITS'.
+ *****************************************************************************/
+static inline size_t Limit(const char *Str, size_t Len)
+{ /* Limit() */
+  return (Len > PTRDIFF_MAX ? strnlen(Str, STRTOX_DEC_DIGITS) : Len);
+} /* Limit() */
+
+/******************************************************************************
+ * Somewhere to load 'Size' (at most 16) characters from: 'Str' itself
+ * if it has that many of its 'Len' left, otherwise a copy of what it
+ * does have in 'Buff', padded with '\0's.
+ *****************************************************************************/
+static inline const char *Padded(const char *Str, size_t Len, size_t Size,
+                                 char *Buff)
+{ /* Padded() */
+  if (Len >= Size)
+    return Str;
+  memset(Buff, 0, Size);
+  memcpy(Buff, Str, Len);
+  return Buff;
+} /* Padded() */
+
+/******************************************************************************
+ * Convert up to 'STRTOX_DEC_DIGITS' digits one at a time, starting
+ * with 'Acc' and 'Pos' digits already done.
+ *****************************************************************************/
+static inline size_t ScanTail(const char *Str, size_t Len, size_t Pos,
+                              uint64_t Acc, uint64_t *Val)
+{ /* ScanTail() */
+  unsigned Digit;
+
+  for (; Pos < STRTOX_DEC_DIGITS && Pos < Len
+         && (Digit = (unsigned char) Str[Pos] - '0') <= 9; ++Pos)
+  { /* For each digit. */
+    Acc = Acc * 10 + Digit;
+  } /* For each digit. */
+
+  *Val = Acc;
+  return Pos;
+} /* ScanTail() */
+
+/******************************************************************************
+ * The SWAR version.  'Word' holds 8 characters, the first in the low
+ * byte.  XORing with '0' maps the digits to 0-9 and everything else to
+ * something with either the high nibble set or a value of 10-15, and
+ * adding 0x76 to any of those sets bit 7.  Carries out of a byte can
+ * only corrupt the bytes _after_ the first non-digit, which we don't
+ * care about.
+ *
+ * To convert the first 'N' digits we shift them to the top of the word
+ * (so the missing digits become leading zeros) and then combine pairs,
+ * quads and octets of digits with the usual multiplications.
+ *****************************************************************************/
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+static inline unsigned SwarCount(uint64_t Word)
+{ /* SwarCount() */
+  uint64_t NonDigit;
+
+  NonDigit = ((Word + 0x7676767676767676u) | Word) & 0x8080808080808080u;
+  return (NonDigit == 0 ? 8 : (unsigned) __builtin_ctzll(NonDigit) / 8);
+} /* SwarCount() */
+
+static inline uint64_t SwarValue(uint64_t Word, unsigned N)
+{ /* SwarValue() */
+  Word <<= 8 * (8 - N);
+  Word = Word * 10 + (Word >> 8);
+  return (((Word & 0x000000FF000000FFu) * (100 + (1000000ull << 32)))
+          + (((Word >> 16) & 0x000000FF000000FFu)
+             * (1 + (10000ull << 32)))) >> 32;
+} /* SwarValue() */
+
+static size_t ScanSwar(const char *Str, size_t Len, uint64_t *Val)
+{ /* ScanSwar() */
+  uint64_t Word, Acc = 0;
+  size_t Pos = 0;
+  unsigned N;
+  char Buff[8];
+
+  /* Two words is 16 digits, ScanTail() does the last 3.  The padding
+   * stops 'SwarCount()' at the end. */
+  Len = Limit(Str, Len);
+  while (Pos < 16 && Pos < Len)
+  { /* For each word. */
+    memcpy(&Word, Padded(&Str[Pos], Len - Pos, 8, Buff), 8);
+    Word ^= 0x3030303030303030u;
+    if ((N = SwarCount(Word)) == 0)
+      break;
+
+    Acc = Acc * Pow10[N] + SwarValue(Word, N);
+    Pos += N;
+    if (N < 8)
+    { /* Done. */
+      *Val = Acc;
+      return Pos;
+    } /* Done. */
+  } /* For each word. */
+
+  return ScanTail(Str, Len, Pos, Acc, Val);
+} /* ScanSwar() */
+#else
+static size_t ScanSwar(const char *Str, size_t Len, uint64_t *Val)
+{ /* ScanSwar() */
+  return ScanTail(Str, Len, 0, 0, Val);
+} /* ScanSwar() */
+#endif
+
+/* Until 'ScanInit()' runs (e.g. if another library's constructor calls
+ * us first) the portable version is used. */
+size_t (*StrToXDecScan)(const char *Str, size_t Len, uint64_t *Val) = ScanSwar;
+
+#ifdef CPU_X86
+/******************************************************************************
+ * Shuffle masks to move the first 'N' bytes of a vector to the end
+ * and zero the rest: '&ShiftRight[N]' is 16 - N 0x80s (which
+ * '_mm_shuffle_epi8()' turns into 0) followed by 0, 1, ... N - 1.
+ *****************************************************************************/
+static const uint8_t ShiftRight[32] =
+{
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+};
+
+/******************************************************************************
+ * Convert 16 digit values (0-9, the most significant first) to a
+ * number.  Pairs, then quads, then octets are combined by multiply
+ * and add, and all the intermediate results fit in 16 (or 32) bits.
+ *****************************************************************************/
+__attribute__((target("sse4.1"), always_inline))
+static inline uint64_t Sse41Value(__m128i Digits)
+{ /* Sse41Value() */
+  Digits = _mm_maddubs_epi16(Digits,
+                             _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1,
+                                           10, 1, 10, 1, 10, 1, 10, 1));
+  Digits = _mm_madd_epi16(Digits,
+                          _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+  Digits = _mm_packus_epi32(Digits, Digits);
+  Digits = _mm_madd_epi16(Digits,
+                          _mm_setr_epi16(10000, 1, 10000, 1,
+                                         10000, 1, 10000, 1));
+  return ((uint64_t) (uint32_t) _mm_cvtsi128_si32(Digits) * 100000000u
+          + (uint32_t) _mm_extract_epi32(Digits, 1));
+} /* Sse41Value() */
+
+/******************************************************************************
+ * The vector versions.  16 characters are validated with one compare
+ * and, since 16 + 3 digits is enough for any 64-bit number, the rare
+ * 17th to 19th digits are done one at a time.  (Validating 32
+ * characters with AVX2 turns out to be slower: the wider load is
+ * often split across cache lines and it only saves at most 3 trips
+ * around a loop.)
+ *
+ * 'ScanVector()' is always inlined into the two versions below so
+ * the AVX2 one is VEX encoded throughout, which avoids the penalty
+ * for mixing legacy SSE and AVX instructions when the caller itself
+ * uses AVX.
+ *****************************************************************************/
+__attribute__((target("sse4.1"), always_inline))
+static inline size_t ScanVector(const char *Str, size_t Len, uint64_t *Val)
+{ /* ScanVector() */
+  __m128i Digits, IsDigit;
+  unsigned NonDigit;
+  size_t N;
+  char Buff[16];
+
+  /* As for SWAR, the padding stops the digits at the end. */
+  Len = Limit(Str, Len);
+  Digits = _mm_sub_epi8(_mm_loadu_si128((const __m128i *)
+                                        Padded(Str, Len, 16, Buff)),
+                        _mm_set1_epi8('0'));
+  IsDigit = _mm_cmpeq_epi8(_mm_min_epu8(Digits, _mm_set1_epi8(9)), Digits);
+  NonDigit = ~(unsigned) _mm_movemask_epi8(IsDigit) & 0xFFFFu;
+  N = (NonDigit == 0 ? 16 : (size_t) __builtin_ctz(NonDigit));
+  if (N == 0)
+  { /* No digits. */
+    *Val = 0;
+    return 0;
+  } /* No digits. */
+
+  Digits = _mm_shuffle_epi8(Digits,
+                            _mm_loadu_si128((const __m128i *) &ShiftRight[N]));
+  if (N < 16)
+  { /* Done. */
+    *Val = Sse41Value(Digits);
+    return N;
+  } /* Done. */
+
+  return ScanTail(Str, Len, 16, Sse41Value(Digits), Val);
+} /* ScanVector() */
+
+__attribute__((target("sse4.1")))
+static size_t ScanSse41(const char *Str, size_t Len, uint64_t *Val)
+{ /* ScanSse41() */
+  return ScanVector(Str, Len, Val);
+} /* ScanSse41() */
+
+__attribute__((target("avx2")))
+static size_t ScanAvx2(const char *Str, size_t Len, uint64_t *Val)
+{ /* ScanAvx2() */
+  return ScanVector(Str, Len, Val);
+} /* ScanAvx2() */
+
+/******************************************************************************
+ * Pick the best version for this CPU when the library is loaded.
+ *****************************************************************************/
+__attribute__((constructor))
+static void ScanInit(void)
+{ /* ScanInit() */
+  unsigned Features = CpuFeatures();
+
+  if (Features & CPU_AVX2)
+    StrToXDecScan = ScanAvx2;
+  else if (Features & CPU_SSE41)
+    StrToXDecScan = ScanSse41;
+} /* ScanInit() */
+#endif
@@ -0,0 +1,469 @@
+/******************************************************************************
+ * Fast, exactly rounded conversion of decimal strings to 'float' and
+ * 'double' for 'StrToF()' and 'StrToD()'.  See 'StrToXFastF()' and
+ * 'StrToXFastD()' in 'StrToXImpl.h' for the interface.
+ *
+ * The algorithm is that of Daniel Lemire, "Number Parsing at a
+ * Gigabyte per Second" (Software: Practice and Experience 51(8),
+ * 2021), which is based on work by Michael Eisel:
+ *
+ * 1) The significant digits (at most 19 of them) are accumulated in a
+ *    64-bit integer 'W', giving a value of 'W * 10^Q'.
+ *
+ * 2) If 'W' and '10^|Q|' are both exactly representable then one
+ *    correctly rounded multiplication or division gives the correctly
+ *    rounded result (Clinger's fast path).
+ *
+ * 3) Otherwise 'W' is multiplied by a 128-bit approximation of '5^Q'
+ *    and the top bits of the product are the mantissa.  The error in
+ *    the approximation is small enough that, except in a vanishingly
+ *    small number of cases which the algorithm detects, the result is
+ *    correctly rounded.
+ *
+ * If there are more than 19 significant digits we try both 'W' and
+ * 'W + 1'; if they give the same result so does every number between
+ * them.
+ *
+ * Anything the above can't handle, or where the answer would be out of
+ * range, subnormal, or not certainly correct, is left to the C library
+ * (see 'StrToD()'), so the results, including ERANGE, are always
+ * exactly those of 'strtod()' and 'strtof()' in the "C" locale.
+ *****************************************************************************/
+#include <float.h>
+#include <locale.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Pow10.h"
+#include "StrToXImpl.h"
+#include "StrToXPow5.h"
+
+/* Maximum number of significant decimal digits that fit in 'W'. */
+#define MAX_DIGITS 19
+
+/******************************************************************************
+ * Everything the algorithm needs to know about a binary floating point
+ * format.  Since the conversions below are inlined with a constant
+ * format these all fold.
+ *****************************************************************************/
+typedef struct
+{
+  int MantBits;         /* Explicit mantissa bits. */
+  int MinExp;           /* Exponent bias, negated. */
+  int InfPower;         /* Biased exponent of infinity. */
+  int MinRoundToEven;   /* Range of 'Q' where a product can be exact */
+  int MaxRoundToEven;   /* and we have to check for a tie. */
+  int MinPow10;         /* Anything below 10^MinPow10 is zero. */
+  int MaxPow10;         /* Anything above 10^MaxPow10 is infinite. */
+  int MaxFastPow10;     /* Largest exact power of 10. */
+  uint64_t MaxFastW;    /* Largest exact integer. */
+} FltFormat_t;
+
+static const FltFormat_t DoubleFormat =
+  { 52, -1023, 0x7FF, -4, 23, -342, 308, 22, (uint64_t) 1 << 53 };
+static const FltFormat_t FloatFormat =
+  { 23, -127, 0xFF, -17, 10, -64, 38, 10, (uint64_t) 1 << 24 };
+
+/******************************************************************************
+ * Exact powers of 10 for Clinger's fast path.
+ *****************************************************************************/
+static const double DoublePow10[] =
+{
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static const float FloatPow10[] =
+{
+  1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+/******************************************************************************
+ * The full 128-bit product of two 64-bit numbers.
+ *****************************************************************************/
+static inline uint64_t MulHiLo(uint64_t A, uint64_t B, uint64_t *Lo)
+{ /* MulHiLo() */
+#ifdef __SIZEOF_INT128__
+  unsigned __int128 Product = (unsigned __int128) A * B;
+
+  *Lo = (uint64_t) Product;
+  return (uint64_t) (Product >> 64);
+#else
+  uint64_t ALo = (uint32_t) A, AHi = A >> 32, BLo = (uint32_t) B, BHi = B >> 32;
+  uint64_t LL = ALo * BLo, LH = ALo * BHi, HL = AHi * BLo, HH = AHi * BHi;
+  uint64_t Mid = (LL >> 32) + (uint32_t) LH + (uint32_t) HL;
+
+  *Lo = (Mid << 32) | (uint32_t) LL;
+  return HH + (LH >> 32) + (HL >> 32) + (Mid >> 32);
+#endif
+} /* MulHiLo() */
+
+/******************************************************************************
+ * The heart of the algorithm.  'W' is non-zero and 'Q' is in
+ * ['Format->MinPow10', 'Format->MaxPow10'].  On success the biased
+ * exponent and mantissa (without the hidden bit), ready to be
+ * assembled into a float or double, are returned in '*Bits' and we
+ * return 'true'.  If the result might not be correctly rounded, or is
+ * subnormal or infinite, we return 'false'.
+ *****************************************************************************/
+static inline bool EiselLemire(uint64_t W, int Q, const FltFormat_t *Format,
+                               uint64_t *Bits)
+{ /* EiselLemire() */
+  const uint64_t *Pow5 = StrToXPow5[Q - STRTOX_POW5_MIN_Q];
+  uint64_t Hi, Lo, Hi2, Lo2, Mask, Mant;
+  int LeadZeros, UpperBit, Shift;
+  int64_t Power2;
+
+  /* Normalize 'W' and multiply by the high half of '5^Q'.  If the
+   * bits below the ones we need are all 1s, adding in the product
+   * with the low half might carry into them, so do that too. */
+  LeadZeros = __builtin_clzll(W);
+  W <<= LeadZeros;
+  Hi = MulHiLo(W, Pow5[0], &Lo);
+  Mask = UINT64_MAX >> (Format->MantBits + 3);
+  if ((Hi & Mask) == Mask)
+  { /* Need more precision. */
+    Hi2 = MulHiLo(W, Pow5[1], &Lo2);
+    Lo += Hi2;
+    Hi += (Lo < Hi2);
+  } /* Need more precision. */
+
+  /* The low half all 1s means the product could be just below a
+   * rounding boundary or just above it, and outside the range where
+   * '5^Q' is exact 128 bits can't tell us which. */
+  if (Lo == UINT64_MAX && (Q < -27 || Q > 55))
+    return false;
+
+  /* The product is in [2^126, 2^128) so its top bit is bit 127 or 126.
+   * Keep 'MantBits + 3' bits (the hidden bit, the mantissa, and two
+   * extra for rounding). */
+  UpperBit = (int) (Hi >> 63);
+  Shift = UpperBit + 64 - Format->MantBits - 3;
+  Mant = Hi >> Shift;
+  /* 'floor(log2(10^Q)) + 63 + UpperBit - LeadZeros', unbiased, via
+   * 217706 / 2^16 ~ log2(10). */
+  Power2 = (((int64_t) 217706 * Q) >> 16) + 63 + UpperBit - LeadZeros
+    - Format->MinExp;
+  if (Power2 <= 0)
+  { /* Subnormal or zero. */
+    return false;
+  } /* Subnormal or zero. */
+
+  /* If the product might be exact and we're exactly half way between
+   * two representable values round to even rather than up. */
+  if (Lo <= 1 && Q >= Format->MinRoundToEven && Q <= Format->MaxRoundToEven
+      && (Mant & 3) == 1 && (Mant << Shift) == Hi)
+  { /* Tie. */
+    Mant &= ~(uint64_t) 1;
+  } /* Tie. */
+
+  /* Round and drop the extra bit.  If rounding carried out of the
+   * mantissa bump the exponent. */
+  Mant += (Mant & 1);
+  Mant >>= 1;
+  if (Mant >= (uint64_t) 2 << Format->MantBits)
+  { /* Carry. */
+    Mant = (uint64_t) 1 << Format->MantBits;
+    ++Power2;
+  } /* Carry. */
+
+  if (Power2 >= Format->InfPower)
+  { /* Overflow. */
+    return false;
+  } /* Overflow. */
+
+  Mant &= ~((uint64_t) 1 << Format->MantBits);
+  *Bits = Mant | ((uint64_t) Power2 << Format->MantBits);
+  return true;
+} /* EiselLemire() */
+
+/******************************************************************************
+ * Parse a decimal number, i.e. an optional sign, digits with an
+ * optional '.' (at least one digit in all), and an optional exponent,
+ * from the first 'Len' characters of 'Str' ('SIZE_MAX' for a NUL
+ * terminated string).  Returns the number of characters matched, or
+ * 0 if there is no such number, with the value being '(*Neg ? -1 :
+ * 1) * *W * 10^*Q'.  If there were more
+ * than 'MAX_DIGITS' significant digits '*W' is truncated and '*Trunc'
+ * is set.  If the exponent is absurdly large '*Q' is only guaranteed
+ * to be outside any valid range.
+ *****************************************************************************/
+static inline size_t ParseDecimal(const char *Str, size_t Len, uint64_t *W,
+                                  int *Q, bool *Neg, bool *Trunc)
+{ /* ParseDecimal() */
+  size_t Pos = 0, NInt, NFrac = 0, Start;
+  uint64_t Acc, Frac;
+  int64_t Exp = 0, ExpVal;
+  unsigned Digit, NDigits;
+  bool ExpNeg, Long = false, Dropped = false;
+
+  *Neg = false;
+  if (Pos < Len && (Str[Pos] == '+' || Str[Pos] == '-'))
+  { /* Sign. */
+    *Neg = (Str[Pos] == '-');
+    ++Pos;
+  } /* Sign. */
+
+  /* The usual case: no more than 19 digits in all (counting leading
+   * zeros in the integer part).  Let 'StrToXDecScan()' do the work. */
+  Start = Pos;
+  NInt = StrToXDecScan(&Str[Pos], Len - Pos, &Acc);
+  Pos += NInt;
+  if (NInt == MAX_DIGITS)
+  { /* Too many digits. */
+    Long = true;
+  } /* Too many digits. */
+  else if (Pos < Len && Str[Pos] == '.')
+  { /* Fraction. */
+    ++Pos;
+    NFrac = StrToXDecScan(&Str[Pos], Len - Pos, &Frac);
+    Pos += NFrac;
+    if (NFrac == MAX_DIGITS || (Acc != 0 && NInt + NFrac > MAX_DIGITS))
+    { /* Too many digits. */
+      Long = true;
+    } /* Too many digits. */
+    else if (Acc == 0)
+    { /* Just the fraction. */
+      Acc = Frac;
+    } /* Just the fraction. */
+    else
+    { /* Both. */
+      Acc = Acc * Pow10[NFrac] + Frac;
+    } /* Both. */
+    Exp = -(int64_t) NFrac;
+  } /* Fraction. */
+
+  if (Long)
+  { /* Long number. */
+    /* Start again one digit at a time, ignoring leading zeros and
+     * keeping the first 19 significant digits.  We only need to know
+     * whether any of the others are non-zero. */
+    Pos = Start;
+    Acc = 0;
+    Exp = 0;
+    NDigits = 0;
+    NInt = NFrac = 0;
+    for (; Pos < Len && (Digit = (unsigned char) Str[Pos] - '0') <= 9; ++Pos)
+    { /* For each integer digit. */
+      ++NInt;
+      if (NDigits < MAX_DIGITS)
+      { /* Significant. */
+        Acc = Acc * 10 + Digit;
+        NDigits += (Acc != 0);
+      } /* Significant. */
+      else
+      { /* Dropped. */
+        ++Exp;
+        Dropped |= (Digit != 0);
+      } /* Dropped. */
+    } /* For each integer digit. */
+
+    if (Pos < Len && Str[Pos] == '.')
+    { /* Fraction. */
+      for (++Pos; Pos < Len && (Digit = (unsigned char) Str[Pos] - '0') <= 9;
+           ++Pos)
+      { /* For each fraction digit. */
+        ++NFrac;
+        if (NDigits < MAX_DIGITS)
+        { /* Significant. */
+          Acc = Acc * 10 + Digit;
+          NDigits += (Acc != 0);
+          --Exp;
+        } /* Significant. */
+        else
+        { /* Dropped. */
+          Dropped |= (Digit != 0);
+        } /* Dropped. */
+      } /* For each fraction digit. */
+    } /* Fraction. */
+  } /* Long number. */
+
+  if (NInt + NFrac == 0)
+  { /* No digits. */
+    return 0;
+  } /* No digits. */
+
+  if (Pos < Len && (Str[Pos] == 'e' || Str[Pos] == 'E'))
+  { /* Exponent. */
+    ++Pos;
+    ExpNeg = false;
+    if (Pos < Len && (Str[Pos] == '+' || Str[Pos] == '-'))
+    { /* Sign. */
+      ExpNeg = (Str[Pos] == '-');
+      ++Pos;
+    } /* Sign. */
+
+    Start = Pos;
+    for (ExpVal = 0;
+         Pos < Len && (Digit = (unsigned char) Str[Pos] - '0') <= 9; ++Pos)
+    { /* For each digit. */
+      /* Anything this big is out of range anyway. */
+      if (ExpVal < 100000)
+        ExpVal = ExpVal * 10 + Digit;
+    } /* For each digit. */
+
+    if (Pos == Start)
+    { /* No digits. */
+      return 0;
+    } /* No digits. */
+    Exp += (ExpNeg ? -ExpVal : ExpVal);
+  } /* Exponent. */
+
+  /* Clamp to something that's out of range but fits in an 'int'. */
+  if (Exp < -100000)
+    Exp = -100000;
+  else if (Exp > 100000)
+    Exp = 100000;
+
+  *W = Acc;
+  *Q = (int) Exp;
+  *Trunc = Dropped;
+  return Pos;
+} /* ParseDecimal() */
+
+/******************************************************************************
+ * Shared by 'StrToXFastD()' and 'StrToXFastF()'.  Returns 'true' and
+ * the bits of the result, without the sign, in '*Bits', or 'false' if
+ * the C library has to do it.
+ *****************************************************************************/
+static inline bool Convert(uint64_t W, int Q, bool Trunc,
+                           const FltFormat_t *Format, uint64_t *Bits)
+{ /* Convert() */
+  uint64_t Bits2 = 0;
+
+  if (W == 0)
+  { /* Zero. */
+    /* Exactly zero, whatever the exponent, so never ERANGE. */
+    *Bits = 0;
+    return true;
+  } /* Zero. */
+
+  if (Q < Format->MinPow10 || Q > Format->MaxPow10)
+  { /* Certainly out of range. */
+    return false;
+  } /* Certainly out of range. */
+
+  if (!EiselLemire(W, Q, Format, Bits))
+    return false;
+
+  /* The real value is in ['W', 'W + 1') * 10^Q. */
+  return (!Trunc
+          || (EiselLemire(W + 1, Q, Format, &Bits2) && Bits2 == *Bits));
+} /* Convert() */
+
+/******************************************************************************
+ * Shared by 'StrToXFastD()' and 'StrToXFastDPrefix()'.  If 'All' the
+ * number must use all of the field.  Returns the number of characters
+ * used, or 0 if the C library has to do it.
+ *****************************************************************************/
+static inline size_t FastD(const char *Str, size_t Len, bool All,
+                           double *Val)
+{ /* FastD() */
+  uint64_t W, Bits;
+  size_t Used;
+  int Q;
+  bool Neg, Trunc;
+  double Result;
+
+  if ((Used = ParseDecimal(Str, Len, &W, &Q, &Neg, &Trunc)) == 0
+      || (All && !StrToXAllUsed(Str, Len, Used)))
+    return 0;
+
+#if FLT_EVAL_METHOD == 0
+  /* Clinger's fast path.  Only valid if 'double' arithmetic really is
+   * done in 'double'. */
+  if (!Trunc && W <= DoubleFormat.MaxFastW
+      && Q >= -DoubleFormat.MaxFastPow10 && Q <= DoubleFormat.MaxFastPow10)
+  { /* Exact. */
+    Result = (double) W;
+    if (Q < 0)
+      Result /= DoublePow10[-Q];
+    else
+      Result *= DoublePow10[Q];
+    *Val = (Neg ? -Result : Result);
+    return Used;
+  } /* Exact. */
+#endif
+
+  if (!Convert(W, Q, Trunc, &DoubleFormat, &Bits))
+    return 0;
+
+  Bits |= (uint64_t) Neg << 63;
+  memcpy(&Result, &Bits, sizeof(Result));
+  *Val = Result;
+  return Used;
+} /* FastD() */
+
+bool StrToXFastD(const char *Str, size_t Len, double *Val)
+{ /* StrToXFastD() */
+  return (FastD(Str, Len, true, Val) != 0);
+} /* StrToXFastD() */
+
+size_t StrToXFastDPrefix(const char *Str, size_t Len, double *Val)
+{ /* StrToXFastDPrefix() */
+  return FastD(Str, Len, false, Val);
+} /* StrToXFastDPrefix() */
+
+bool StrToXFastF(const char *Str, size_t Len, float *Val)
+{ /* StrToXFastF() */
+  uint64_t W, Bits;
+  size_t Used;
+  uint32_t Bits32;
+  int Q;
+  bool Neg, Trunc;
+  float Result;
+
+  if ((Used = ParseDecimal(Str, Len, &W, &Q, &Neg, &Trunc)) == 0
+      || !StrToXAllUsed(Str, Len, Used))
+    return false;
+
+#if FLT_EVAL_METHOD == 0
+  /* Clinger's fast path, see 'StrToXFastD()'. */
+  if (!Trunc && W <= FloatFormat.MaxFastW
+      && Q >= -FloatFormat.MaxFastPow10 && Q <= FloatFormat.MaxFastPow10)
+  { /* Exact. */
+    Result = (float) W;
+    if (Q < 0)
+      Result /= FloatPow10[-Q];
+    else
+      Result *= FloatPow10[Q];
+    *Val = (Neg ? -Result : Result);
+    return true;
+  } /* Exact. */
+#endif
+
+  if (!Convert(W, Q, Trunc, &FloatFormat, &Bits))
+    return false;
+
+  Bits32 = (uint32_t) Bits | (uint32_t) Neg << 31;
+  memcpy(&Result, &Bits32, sizeof(Result));
+  *Val = Result;
+  return true;
+} /* StrToXFastF() */
+
+/******************************************************************************
+ * Get the "C" locale for the slow path.  It's created the first time
+ * we need it and then kept for the life of the process.  If two
+ * threads race to create it, the loser frees its copy.
+ *****************************************************************************/
+locale_t StrToXCLocale(void)
+{ /* StrToXCLocale() */
+  static locale_t CLocale = (locale_t) 0;
+  locale_t Locale, Expected = (locale_t) 0;
+
+  if ((Locale = __atomic_load_n(&CLocale, __ATOMIC_ACQUIRE)) != (locale_t) 0)
+    return Locale;
+
+  if ((Locale = newlocale(LC_ALL_MASK, "C", (locale_t) 0)) == (locale_t) 0)
+    return Locale;
+
+  if (!__atomic_compare_exchange_n(&CLocale, &Expected, Locale, false,
+                                   __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+  { /* Lost the race. */
+    freelocale(Locale);
+    Locale = Expected;
+  } /* Lost the race. */
+
+  return Locale;
+} /* StrToXCLocale() */
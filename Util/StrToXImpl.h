@@ -0,0 +1,604 @@
+#ifndef StrToXImpl_h
+#define StrToXImpl_h
+
+/******************************************************************************
+ * Private helpers shared by the 'StrToX()' family.  This header is
+ * _not_ installed and nothing in here is part of the public
+ * interface.  Everything is 'static inline' so that each conversion
+ * function gets its own copy with the limits of its target type
+ * folded in as constants.
+ *
+ * Unlike 'strtol()' and friends, the helpers here never look past
+ * 'Str[Len-1]' so the input does not have to be NUL terminated.
+ * Since '\0' is neither a digit nor a sign, a NUL terminated string
+ * can still be parsed by passing 'SIZE_MAX' as the length.
+ *****************************************************************************/
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <locale.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/******************************************************************************
+ * Return the value of the digit 'Char' or 36 if 'Char' is not a digit
+ * in any base we support.  Letters are case insensitive, as for
+ * 'strtol()'.
+ *****************************************************************************/
+static inline unsigned StrToXDigit(char Char)
+{ /* StrToXDigit() */
+  unsigned Digit;
+
+  Digit = (unsigned char) Char - '0';
+  if (Digit <= 9)
+    return Digit;
+
+  Digit = ((unsigned char) Char | 0x20) - 'a';
+  return (Digit < 26 ? Digit + 10 : 36);
+} /* StrToXDigit() */
+
+/******************************************************************************
+ * Convert the run of decimal digits at the start of the first 'Len'
+ * characters of 'Str', but no more than 'STRTOX_DEC_DIGITS' of them
+ * (so the result can't overflow), putting the value in '*Val' and
+ * returning the number of digits used.  '*Val' is 0 if there are no
+ * digits.  'Len' may be 'SIZE_MAX', or anything else greater than
+ * PTRDIFF_MAX, for a NUL terminated string.
+ *
+ * This points to the fastest version for the CPU we're running on
+ * (see StrToXDec.c).
+ *****************************************************************************/
+#define STRTOX_DEC_DIGITS 19
+
+extern size_t (*StrToXDecScan)(const char *Str, size_t Len, uint64_t *Val);
+
+/******************************************************************************
+ * Convert a decimal floating point number, exactly as 'strtod()' or
+ * 'strtof()' would in the "C" locale, from _all_ of the first 'Len'
+ * characters of 'Str' ('SIZE_MAX' for a NUL terminated string).
+ * These only handle the common cases (see StrToXFlt.c): if they
+ * return 'true' '*Val' is the correctly rounded result, in range and
+ * not subnormal.  If they return 'false' '*Val' is unchanged and the
+ * caller must fall back to the C library, which will also sort out
+ * malformed strings, hex, infinities, NaNs, and ERANGE.
+ *****************************************************************************/
+extern bool StrToXFastD(const char *Str, size_t Len, double *Val);
+extern bool StrToXFastF(const char *Str, size_t Len, float *Val);
+
+/******************************************************************************
+ * Like 'StrToXFastD()' but the number need only be at the start of the
+ * field.  Returns the number of characters used, or 0 (with '*Val'
+ * unchanged) if there's no number the fast path can handle there.
+ *****************************************************************************/
+extern size_t StrToXFastDPrefix(const char *Str, size_t Len, double *Val);
+
+/******************************************************************************
+ * Return the "C" locale, for the fallback, or '(locale_t) 0' with
+ * 'errno' set if it can't be created.  Never free it.
+ *****************************************************************************/
+extern locale_t StrToXCLocale(void);
+
+/******************************************************************************
+ * Parse an integer from the first 'Len' characters of 'Str'.  The
+ * accepted syntax is exactly the "subject sequence" of 'strtol()'
+ * _without_ the leading white space, i.e. an optional sign, an
+ * optional "0x"/"0X" prefix (only if 'Base' is 0 or 16), and one or
+ * more digits valid in 'Base'.  'Base' must be 0 or in [2, 36].
+ *
+ * The magnitude of the number is returned in '*Mag' and whether it
+ * was preceded by a '-' in '*Neg'.  The magnitude is checked against
+ * 'PosMax' (if positive) or 'NegMax' (if negative) as each digit is
+ * accumulated so overflow is detected exactly for whatever type the
+ * caller is converting to, without ever needing a wider type.  On
+ * overflow '*Mag' is clamped to the appropriate limit and '*Range' is
+ * set to 'true', but the remaining digits are still consumed.
+ *
+ * Returns the number of characters used, or 0 if no digits were found
+ * in which case '*Mag', '*Neg', and '*Range' are all unchanged.
+ *****************************************************************************/
+static inline size_t StrToXParseInt(const char *Str, size_t Len, int Base,
+                                    uintmax_t PosMax, uintmax_t NegMax,
+                                    uintmax_t *Mag, bool *Neg, bool *Range)
+{ /* StrToXParseInt() */
+  size_t Pos = 0, First;
+  bool IsNeg = false, Over = false;
+  uintmax_t Acc = 0, Max, Cutoff;
+  uint64_t Dec;
+  unsigned Digit, CutLim;
+
+  /* Optional sign. */
+  if (Pos < Len && (Str[Pos] == '+' || Str[Pos] == '-'))
+  { /* Sign. */
+    IsNeg = (Str[Pos] == '-');
+    ++Pos;
+  } /* Sign. */
+
+  /* Optional "0x" prefix.  Just like 'strtol()' the prefix only counts
+   * if it is followed by a hex digit.  Otherwise the '0' is the whole
+   * number and the 'x' is the first unused character. */
+  if ((Base == 0 || Base == 16) && Len - Pos > 2 && Str[Pos] == '0'
+      && (Str[Pos+1] == 'x' || Str[Pos+1] == 'X')
+      && StrToXDigit(Str[Pos+2]) < 16)
+  { /* Hex prefix. */
+    Base = 16;
+    Pos += 2;
+  } /* Hex prefix. */
+  else if (Base == 0)
+  { /* Octal or decimal. */
+    Base = (Pos < Len && Str[Pos] == '0' ? 8 : 10);
+  } /* Octal or decimal. */
+
+  /* Accumulate the digits.  'Cutoff' and 'CutLim' are the usual trick
+   * for detecting overflow _before_ it happens: 'Acc * Base + Digit'
+   * is at most 'Max' iff '(Acc < Cutoff || (Acc == Cutoff && Digit <=
+   * CutLim))'.  So in the common case the only overhead is one
+   * (well predicted) comparison per digit.  Once we've overflowed
+   * 'Acc' is 'Max' which is never less than 'Cutoff' so we stay
+   * overflowed. */
+  Max = (IsNeg ? NegMax : PosMax);
+  First = Pos;
+  if (Base == 10)
+  { /* Decimal. */
+    /* By far the most common case, so the first 19 digits, which is
+     * all of them for anything that fits in 64 bits, are converted
+     * many at a time by 'StrToXDecScan()' and only need one range
+     * check.  Anything left (leading zeros, or a number that's too big
+     * anyway) goes through the loop, which has a cheaper digit test
+     * than the general one.  Since this is all inlined with a constant
+     * 'Max', the compiler folds the division too. */
+    Cutoff = Max / 10;
+    CutLim = (unsigned) (Max % 10);
+    Pos += StrToXDecScan(&Str[Pos], Len - Pos, &Dec);
+    if ((Acc = Dec) > Max)
+    { /* Overflow. */
+      Over = true;
+      Acc = Max;
+    } /* Overflow. */
+    for (; Pos < Len && (Digit = (unsigned char) Str[Pos] - '0') <= 9; ++Pos)
+    { /* For each digit. */
+      if (Acc < Cutoff || (Acc == Cutoff && Digit <= CutLim))
+      { /* Still in range. */
+        Acc = Acc * 10 + Digit;
+      } /* Still in range. */
+      else
+      { /* Overflow. */
+        Over = true;
+        Acc = Max;
+      } /* Overflow. */
+    } /* For each digit. */
+  } /* Decimal. */
+  else
+  { /* Everything else. */
+    Cutoff = Max / (unsigned) Base;
+    CutLim = (unsigned) (Max % (unsigned) Base);
+    for (; Pos < Len && (Digit = StrToXDigit(Str[Pos])) < (unsigned) Base;
+         ++Pos)
+    { /* For each digit. */
+      if (Acc < Cutoff || (Acc == Cutoff && Digit <= CutLim))
+      { /* Still in range. */
+        Acc = Acc * (unsigned) Base + Digit;
+      } /* Still in range. */
+      else
+      { /* Overflow. */
+        Over = true;
+        Acc = Max;
+      } /* Overflow. */
+    } /* For each digit. */
+  } /* Everything else. */
+
+  if (Pos == First)
+  { /* No digits. */
+    return 0;
+  } /* No digits. */
+
+  *Mag = Acc;
+  *Neg = IsNeg;
+  *Range = Over;
+  return Pos;
+} /* StrToXParseInt() */
+
+/******************************************************************************
+ * The guts of the signed 'strtoX()' functions.  Exactly the semantics
+ * of 'strtol()' (leading white space, 'errno', '*End', and all) but
+ * for a type with range ['Min', 'Max'].  In particular, on overflow
+ * we return 'Max' or 'Min' and set 'errno' to ERANGE, for an invalid
+ * 'Base' we return 0 and set 'errno' to EINVAL, and if no conversion
+ * can be performed we return 0 and set '*End' to 'Str'.  Otherwise
+ * 'errno' is left strictly alone.  Since the result is in ['Min',
+ * 'Max'] the caller can simply cast it to the target type.
+ *****************************************************************************/
+static inline intmax_t StrToXSigned(const char *Str, char **End, int Base,
+                                    intmax_t Min, intmax_t Max)
+{ /* StrToXSigned() */
+  const char *Src;
+  size_t Used = 0;
+  uintmax_t Mag;
+  bool Neg, Range;
+
+  /* 'strtol()''s behavior is undefined for an invalid base.  We do
+   * what glibc does, which is to fail with EINVAL. */
+  if (Base != 0 && (Base < 2 || Base > 36))
+  { /* Invalid base. */
+    errno = EINVAL;
+  } /* Invalid base. */
+  else
+  { /* Valid base. */
+    for (Src = Str; isspace((unsigned char) *Src); ++Src)
+      ;
+
+    /* '-(Min + 1) + 1' is just '-Min' without overflowing. */
+    Used = StrToXParseInt(Src, SIZE_MAX, Base, (uintmax_t) Max,
+                          (uintmax_t) -(Min + 1) + 1, &Mag, &Neg, &Range);
+  } /* Valid base. */
+
+  if (Used == 0)
+  { /* No conversion. */
+    if (End != NULL)
+      *End = (char *) Str;
+    return 0;
+  } /* No conversion. */
+
+  if (End != NULL)
+    *End = (char *) &Src[Used];
+
+  if (Range)
+  { /* Out of range. */
+    errno = ERANGE;
+    return (Neg ? Min : Max);
+  } /* Out of range. */
+
+  /* Negate without overflowing when 'Mag' is '-Min'. */
+  return (Neg && Mag != 0 ? -(intmax_t) (Mag - 1) - 1 : (intmax_t) Mag);
+} /* StrToXSigned() */
+
+/******************************************************************************
+ * The guts of the unsigned 'strtoX()' functions.  Exactly the
+ * semantics of 'strtoul()' but for a type with range [0, 'Max'].
+ * Note that, like 'strtoul()', a leading '-' is accepted and the
+ * result negated (modulo 'Max + 1' once the caller casts it), with
+ * the magnitude still limited to 'Max'.
+ *****************************************************************************/
+static inline uintmax_t StrToXUnsigned(const char *Str, char **End, int Base,
+                                       uintmax_t Max)
+{ /* StrToXUnsigned() */
+  const char *Src;
+  size_t Used = 0;
+  uintmax_t Mag;
+  bool Neg, Range;
+
+  /* See 'StrToXSigned()'. */
+  if (Base != 0 && (Base < 2 || Base > 36))
+  { /* Invalid base. */
+    errno = EINVAL;
+  } /* Invalid base. */
+  else
+  { /* Valid base. */
+    for (Src = Str; isspace((unsigned char) *Src); ++Src)
+      ;
+
+    Used = StrToXParseInt(Src, SIZE_MAX, Base, Max, Max, &Mag, &Neg, &Range);
+  } /* Valid base. */
+
+  if (Used == 0)
+  { /* No conversion. */
+    if (End != NULL)
+      *End = (char *) Str;
+    return 0;
+  } /* No conversion. */
+
+  if (End != NULL)
+    *End = (char *) &Src[Used];
+
+  if (Range)
+  { /* Out of range. */
+    errno = ERANGE;
+    return Max;
+  } /* Out of range. */
+
+  return (Neg ? -Mag : Mag);
+} /* StrToXUnsigned() */
+
+/******************************************************************************
+ * Check that all of a field was used.  'Len' is either the length of
+ * the field, or 'SIZE_MAX' if it is a NUL terminated string.
+ *****************************************************************************/
+static inline bool StrToXAllUsed(const char *Str, size_t Len, size_t Used)
+{ /* StrToXAllUsed() */
+  return (Len == SIZE_MAX ? Str[Used] == '\0' : Used == Len);
+} /* StrToXAllUsed() */
+
+/******************************************************************************
+ * The guts of all the signed 'StrToX()' and 'StrNToX()' functions.
+ * Error semantics are exactly those of 'StrToX()' (see 'StrToX.h').
+ * 'Len' is either the length of the field, in which case "all of
+ * 'Str'" means all 'Len' characters, or 'SIZE_MAX' for a NUL
+ * terminated string.  The caller must already have checked that
+ * 'Str' is not NULL.  On success the result is in '*Val' and is
+ * guaranteed to lie in ['Min', 'Max'].  'errno' is never touched.
+ *****************************************************************************/
+static inline int StrNToXSigned(const char *Str, size_t Len, int Base,
+                                intmax_t Min, intmax_t Max, intmax_t *Val)
+{ /* StrNToXSigned() */
+  size_t Used;
+  uintmax_t Mag;
+  bool Neg, Range;
+
+  /* Empty strings and leading white space are both invalid. */
+  if (Len == 0 || *Str == '\0' || isspace((unsigned char) *Str))
+  { /* Error. */
+    return EINVAL;
+  } /* Error. */
+
+  if (Base != 0 && (Base < 2 || Base > 36))
+  { /* Invalid base. */
+    return EDOM;
+  } /* Invalid base. */
+
+  /* '-(Min + 1) + 1' is just '-Min' without overflowing. */
+  Used = StrToXParseInt(Str, Len, Base, (uintmax_t) Max,
+                        (uintmax_t) -(Min + 1) + 1, &Mag, &Neg, &Range);
+  if (Used == 0 || !StrToXAllUsed(Str, Len, Used))
+  { /* Malformed. */
+    return EINVAL;
+  } /* Malformed. */
+
+  if (Range)
+  { /* Out of range. */
+    return ERANGE;
+  } /* Out of range. */
+
+  /* Negate without overflowing when 'Mag' is '-Min'. */
+  *Val = (Neg && Mag != 0 ? -(intmax_t) (Mag - 1) - 1 : (intmax_t) Mag);
+  return 0;
+} /* StrNToXSigned() */
+
+/******************************************************************************
+ * Same as 'StrNToXSigned()' but for unsigned types.  As documented
+ * for 'StrToUX()', a leading '-' is an ERANGE error.
+ *****************************************************************************/
+static inline int StrNToXUnsigned(const char *Str, size_t Len, int Base,
+                                  uintmax_t Max, uintmax_t *Val)
+{ /* StrNToXUnsigned() */
+  size_t Used;
+  uintmax_t Mag;
+  bool Neg, Range;
+
+  /* Empty strings and leading white space are both invalid. */
+  if (Len == 0 || *Str == '\0' || isspace((unsigned char) *Str))
+  { /* Error. */
+    return EINVAL;
+  } /* Error. */
+
+  if (Base != 0 && (Base < 2 || Base > 36))
+  { /* Invalid base. */
+    return EDOM;
+  } /* Invalid base. */
+
+  if (*Str == '-')
+  { /* Negative number. */
+    return ERANGE;
+  } /* Negative number. */
+
+  Used = StrToXParseInt(Str, Len, Base, Max, 0, &Mag, &Neg, &Range);
+  if (Used == 0 || !StrToXAllUsed(Str, Len, Used))
+  { /* Malformed. */
+    return EINVAL;
+  } /* Malformed. */
+
+  if (Range)
+  { /* Out of range. */
+    return ERANGE;
+  } /* Out of range. */
+
+  *Val = Mag;
+  return 0;
+} /* StrNToXUnsigned() */
+
+/******************************************************************************
+ * The 'StrNToXDelimPar()' functions.  'Func' is called, possibly from
+ * several threads at once, to convert the fields in part of 'Buff'
+ * into an array of 'Size' byte values; it has the interface of
+ * 'StrNToXDelim()' with an 'End' of NULL ('Base' is just passed on).
+ * The results are stored in '*Vals' and '*Errs' (if 'Errs' isn't
+ * NULL), both malloc()ed.  See 'StrToXPar.c'.
+ *****************************************************************************/
+typedef int StrToXDelimFn_t(const char *Buff, size_t Len, char Delim,
+                            int Base, void *Vals, uint64_t *Errs,
+                            size_t *NVals);
+
+extern int StrToXDelimPar(const char *Buff, size_t Len, char Delim, int Base,
+                          unsigned NThreads, size_t Size,
+                          StrToXDelimFn_t *Func, void **Vals,
+                          uint64_t **Errs, size_t *NVals);
+
+/******************************************************************************
+ * Return a pointer to the first 'Delim' in ['Str', 'End'), or NULL if
+ * there isn't one.  Fields are usually short, so we look at the first
+ * few characters ourselves before paying for a call to 'memchr()'.
+ *****************************************************************************/
+static inline const char *StrToXFindDelim(const char *Str, const char *End,
+                                          char Delim)
+{ /* StrToXFindDelim() */
+  const char *Lim = (End - Str > 16 ? Str + 16 : End);
+
+  for (; Str < Lim; ++Str)
+  { /* For each character. */
+    if (*Str == Delim)
+      return Str;
+  } /* For each character. */
+
+  return (Str < End ? memchr(Str, Delim, (size_t) (End - Str)) : NULL);
+} /* StrToXFindDelim() */
+
+/******************************************************************************
+ * Parse one, possibly escaped, character from the first 'Len'
+ * characters of 'Str'.  Recognizes exactly the escape sequences
+ * documented in strtochar.c, including their quirks (e.g. "\x0x41" is
+ * 'A' since the hex digits are parsed as if by 'strtoul(..., 16)').
+ * All of the 'strtoXchar()' functions range check numeric escapes
+ * against 'UCHAR_MAX' so we just return the character code in
+ * '*Code' and let the caller cast it.  If a numeric escape is out of
+ * range, '*Code' is 'UCHAR_MAX' and '*Range' is set to 'true'.
+ *
+ * Returns the number of characters used, or 0 if there is no
+ * character (i.e. 'Str' is empty, is a lone '\', or is "\x" not
+ * followed by a hex digit) in which case '*Code' and '*Range' are
+ * unchanged.
+ *****************************************************************************/
+static inline size_t StrToXParseChar(const char *Str, size_t Len,
+                                     unsigned char *Code, bool *Range)
+{ /* StrToXParseChar() */
+  size_t Used;
+  uintmax_t Mag = 0;
+  bool Neg, Over = false;
+
+  if (Len == 0 || Str[0] == '\0')
+  { /* Empty string. */
+    return 0;
+  } /* Empty string. */
+
+  if (Str[0] != '\\')
+  { /* Plain character. */
+    *Code = (unsigned char) Str[0];
+    *Range = false;
+    return 1;
+  } /* Plain character. */
+
+  if (Len < 2 || Str[1] == '\0')
+  { /* Nothing to escape. */
+    return 0;
+  } /* Nothing to escape. */
+
+  Used = 2;
+  switch (Str[1])
+  { /* Select real char. */
+    case 'a': Mag = '\a'; break;
+    case 'b': Mag = '\b'; break;
+    case 'f': Mag = '\f'; break;
+    case 'n': Mag = '\n'; break;
+    case 'r': Mag = '\r'; break;
+    case 't': Mag = '\t'; break;
+    case 'v': Mag = '\v'; break;
+
+    case 'x':
+    { /* '\x' */
+      if (Len < 3 || StrToXDigit(Str[2]) >= 16)
+      { /* Not hex digit. */
+        return 0;
+      } /* Not hex digit. */
+      Used = 2 + StrToXParseInt(&Str[2], Len - 2, 16, UCHAR_MAX, UCHAR_MAX,
+                                &Mag, &Neg, &Over);
+    } /* '\x' */
+    break;
+
+    case '0': case '1': case '2': case '3':
+    case '4': case '5': case '6': case '7':
+    { /* Octal character code. */
+      Used = 1 + StrToXParseInt(&Str[1], Len - 1, 8, UCHAR_MAX, UCHAR_MAX,
+                                &Mag, &Neg, &Over);
+    } /* Octal character code. */
+    break;
+
+    default:
+      Mag = (unsigned char) Str[1];
+      break;
+  } /* Select real char. */
+
+  *Code = (unsigned char) Mag;
+  *Range = Over;
+  return Used;
+} /* StrToXParseChar() */
+
+/******************************************************************************
+ * The guts of the 'strtoXchar()' functions.  Returns the character
+ * code, or 0 (and sets '*End' to 'Str') if there is no character.  If
+ * a numeric escape is out of range, sets 'errno' to ERANGE and
+ * returns 'RangeVal' (i.e. 'CHAR_MAX', 'SCHAR_MAX', or 'UCHAR_MAX').
+ * Otherwise 'errno' is left alone.
+ *****************************************************************************/
+static inline unsigned char StrToXChar(const char *Str, char **End,
+                                       unsigned char RangeVal)
+{ /* StrToXChar() */
+  size_t Used;
+  unsigned char Code;
+  bool Range;
+
+  if ((Used = StrToXParseChar(Str, SIZE_MAX, &Code, &Range)) == 0)
+  { /* No character. */
+    if (End != NULL)
+      *End = (char *) Str;
+    return 0;
+  } /* No character. */
+
+  if (End != NULL)
+    *End = (char *) &Str[Used];
+
+  if (Range)
+  { /* Out of range. */
+    errno = ERANGE;
+    return RangeVal;
+  } /* Out of range. */
+
+  return Code;
+} /* StrToXChar() */
+
+/******************************************************************************
+ * The guts of the 'StrToXChar()' and 'StrNToXChar()' functions.
+ * 'Len' is as for 'StrNToXSigned()'.
+ *****************************************************************************/
+static inline int StrNToXChar(const char *Str, size_t Len, unsigned char *Val)
+{ /* StrNToXChar() */
+  size_t Used;
+  unsigned char Code;
+  bool Range;
+
+  Used = StrToXParseChar(Str, Len, &Code, &Range);
+  if (Used == 0 || !StrToXAllUsed(Str, Len, Used))
+  { /* Malformed. */
+    return EINVAL;
+  } /* Malformed. */
+
+  if (Range)
+  { /* Out of range. */
+    return ERANGE;
+  } /* Out of range. */
+
+  *Val = Code;
+  return 0;
+} /* StrNToXChar() */
+
+/******************************************************************************
+ * For conversions we can't (yet) do in place, make a NUL terminated
+ * copy of the 'Len' characters at 'Str'.  The copy goes in 'Buff' if
+ * it fits, otherwise it is 'malloc()'ed.  Returns NULL (with 'errno'
+ * set by 'malloc()') on failure.  The caller must pass the result to
+ * 'StrNToXFreeCopy()' when done.
+ *****************************************************************************/
+static inline char *StrNToXCopy(const char *Str, size_t Len,
+                                char *Buff, size_t BuffSize)
+{ /* StrNToXCopy() */
+  char *Copy;
+
+  if (Len < BuffSize)
+    Copy = Buff;
+  else if (Len == SIZE_MAX || (Copy = malloc(Len + 1)) == NULL)
+    return NULL;
+
+  memcpy(Copy, Str, Len);
+  Copy[Len] = '\0';
+  return Copy;
+} /* StrNToXCopy() */
+
+static inline void StrNToXFreeCopy(char *Copy, char *Buff)
+{ /* StrNToXFreeCopy() */
+  if (Copy != Buff)
+    free(Copy);
+} /* StrNToXFreeCopy() */
+
+/* Size of the local buffer used with 'StrNToXCopy()'.  Anything a
+ * sane program would want to convert to a floating point number fits. */
+#define STRNTOX_BUFF_SIZE 128
+
+#endif
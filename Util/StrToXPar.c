@@ -0,0 +1,271 @@
+/******************************************************************************
+ * Multi-threaded conversion of a buffer of delimited fields.  See
+ * 'StrToXDelimPar()' in 'StrToXImpl.h' for the interface.
+ *
+ * The buffer is split into one chunk per thread, each ending just
+ * after a delimiter so no field is split between two chunks.  This
+ * is done in two passes:
+ *
+ * 1) Each thread counts the fields in its chunk.  Counting is much
+ *    cheaper than converting, and it means the results can go
+ *    straight into one array of exactly the right size, in the right
+ *    place, with no copying.
+ *
+ * 2) Each thread converts its chunk, with the single threaded
+ *    'StrNToXDelim()' function, into its part of the array.  The error
+ *    bits for a chunk don't in general start on a word boundary, so
+ *    each thread has its own error bitmap and they are merged when
+ *    all the threads are done.
+ *
+ * The calling thread does the first chunk itself rather than waiting.
+ * If a thread can't be created its chunk is done by the calling
+ * thread, so that only costs time.
+ *****************************************************************************/
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "StrToX.h"
+#include "StrToXImpl.h"
+
+/* Don't start a thread for less than this many characters; it costs
+ * more than it saves. */
+#define MIN_CHUNK ((size_t) 256 * 1024)
+
+/* Everything one thread needs. */
+typedef struct Chunk
+{
+  const char *Buff;
+  size_t Len;
+  char Delim;
+  int Base;
+  StrToXDelimFn_t *Convert;
+  size_t NVals;                 /* Fields counted, then converted. */
+  void *Vals;
+  uint64_t *Errs;
+  int ErrNo;
+  pthread_t Thread;
+  bool Running;
+} Chunk_t;
+
+/******************************************************************************
+ * Return the number of 'Delim's in the 'Len' characters starting at
+ * 'Str'.  Eight characters at a time: after XORing with 'Delim' a
+ * matching byte is 0 and only a 0 byte has bit 7 clear after adding
+ * 0x7F to its low 7 bits and ORing in the byte itself (the masking
+ * means there are no carries between bytes).  The 0 or 1 for each byte
+ * is added up in the byte itself, which is safe for 255 words.
+ *****************************************************************************/
+static size_t CountDelims(const char *Str, size_t Len, char Delim)
+{ /* CountDelims() */
+  const uint64_t Ones = 0x0101010101010101u, Low7 = 0x7F7F7F7F7F7F7F7Fu;
+  uint64_t Pattern = Ones * (unsigned char) Delim, Word, Sums;
+  size_t N = 0, Pos = 0, Words;
+
+  while (Len - Pos >= 8)
+  { /* For each block of up to 255 words. */
+    Words = (Len - Pos) / 8;
+    if (Words > 255)
+      Words = 255;
+
+    for (Sums = 0; Words != 0; --Words, Pos += 8)
+    { /* For each word. */
+      memcpy(&Word, &Str[Pos], 8);
+      Word ^= Pattern;
+      Sums += (~(((Word & Low7) + Low7) | Word) >> 7) & Ones;
+    } /* For each word. */
+
+    /* Add up the bytes. */
+    Sums = (Sums & 0x00FF00FF00FF00FFu) + ((Sums >> 8) & 0x00FF00FF00FF00FFu);
+    N += (size_t) ((Sums * 0x0001000100010001u) >> 48);
+  } /* For each block of up to 255 words. */
+
+  for (; Pos < Len; ++Pos)
+    N += (Str[Pos] == Delim);
+
+  return N;
+} /* CountDelims() */
+
+/******************************************************************************
+ * Pass 1: count the fields.  Every chunk but the last ends with a
+ * 'Delim', and a 'Delim' at the very end doesn't start another field,
+ * so that's one per 'Delim' plus one for a last field with no 'Delim'
+ * after it.
+ *****************************************************************************/
+static void *Count(void *Arg)
+{ /* Count() */
+  Chunk_t *Chunk = Arg;
+
+  Chunk->NVals = CountDelims(Chunk->Buff, Chunk->Len, Chunk->Delim);
+  if (Chunk->Len != 0 && Chunk->Buff[Chunk->Len - 1] != Chunk->Delim)
+    ++Chunk->NVals;
+
+  return NULL;
+} /* Count() */
+
+/******************************************************************************
+ * Pass 2: convert the fields.  The chunk holds exactly 'NVals' fields
+ * so this can't run out of room.
+ *****************************************************************************/
+static void *Convert(void *Arg)
+{ /* Convert() */
+  Chunk_t *Chunk = Arg;
+
+  Chunk->ErrNo = Chunk->Convert(Chunk->Buff, Chunk->Len, Chunk->Delim,
+                                Chunk->Base, Chunk->Vals, Chunk->Errs,
+                                &Chunk->NVals);
+  return NULL;
+} /* Convert() */
+
+/******************************************************************************
+ * Run 'Func' on all 'NChunks' chunks, the first in this thread and the
+ * rest in threads of their own if possible.
+ *****************************************************************************/
+static void RunAll(Chunk_t *Chunks, size_t NChunks, void *(*Func)(void *))
+{ /* RunAll() */
+  size_t I;
+
+  for (I = 1; I < NChunks; ++I)
+  { /* Start the threads. */
+    Chunks[I].Running = (pthread_create(&Chunks[I].Thread, NULL, Func,
+                                        &Chunks[I]) == 0);
+  } /* Start the threads. */
+
+  Func(&Chunks[0]);
+
+  for (I = 1; I < NChunks; ++I)
+  { /* Wait for them (or do it ourselves). */
+    if (Chunks[I].Running)
+      pthread_join(Chunks[I].Thread, NULL);
+    else
+      Func(&Chunks[I]);
+  } /* Wait for them (or do it ourselves). */
+} /* RunAll() */
+
+/******************************************************************************
+ * OR the 'NBits' bit error bitmap 'Src' into 'Dest' starting at bit
+ * 'Offset'.  The unused bits at the end of 'Src' are 0 so we can just
+ * OR in whole words, as long as we don't go past the end of 'Dest'.
+ *****************************************************************************/
+static void MergeErrs(uint64_t *Dest, size_t DestWords, size_t Offset,
+                      const uint64_t *Src, size_t NBits)
+{ /* MergeErrs() */
+  size_t Word = Offset / 64, I;
+  unsigned Shift = (unsigned) (Offset % 64);
+
+  for (I = 0; I < STRTOX_ERR_WORDS(NBits); ++I, ++Word)
+  { /* For each word. */
+    Dest[Word] |= Src[I] << Shift;
+    if (Shift != 0 && Word + 1 < DestWords)
+      Dest[Word + 1] |= Src[I] >> (64 - Shift);
+  } /* For each word. */
+} /* MergeErrs() */
+
+/******************************************************************************
+ * See 'StrToXImpl.h'.
+ *****************************************************************************/
+int StrToXDelimPar(const char *Buff, size_t Len, char Delim, int Base,
+                   unsigned NThreads, size_t Size, StrToXDelimFn_t *Func,
+                   void **Vals, uint64_t **Errs, size_t *NVals)
+{ /* StrToXDelimPar() */
+  Chunk_t *Chunks;
+  uint64_t *Scratch = NULL, *AllErrs = NULL;
+  char *AllVals = NULL;
+  const char *Next;
+  size_t NChunks, Total = 0, Words = 0, Start, Pos, I;
+  long NCpus;
+  int ErrNo = 0;
+
+  /* How many threads? */
+  if (NThreads == 0)
+    NThreads = ((NCpus = sysconf(_SC_NPROCESSORS_ONLN)) > 0
+                ? (unsigned) NCpus : 1);
+  NChunks = Len / MIN_CHUNK;
+  if (NChunks > NThreads)
+    NChunks = NThreads;
+  if (NChunks == 0)
+    NChunks = 1;
+
+  if ((Chunks = calloc(NChunks, sizeof(*Chunks))) == NULL)
+  { /* Error. */
+    return ENOMEM;
+  } /* Error. */
+
+  /* Split 'Buff', each chunk ending just after the first 'Delim' at or
+   * after its share of 'Len'.  Chunks at the end may be empty. */
+  for (I = 0, Start = 0; I < NChunks; ++I)
+  { /* For each chunk. */
+    Pos = (I + 1 == NChunks ? Len : Len / NChunks * (I + 1));
+    if (Pos < Start)
+      Pos = Start;
+    if (Pos < Len && (Next = memchr(&Buff[Pos], Delim, Len - Pos)) != NULL)
+      Pos = (size_t) (Next - Buff) + 1;
+    else
+      Pos = Len;
+
+    Chunks[I].Buff = &Buff[Start];
+    Chunks[I].Len = Pos - Start;
+    Chunks[I].Delim = Delim;
+    Chunks[I].Base = Base;
+    Chunks[I].Convert = Func;
+    Start = Pos;
+  } /* For each chunk. */
+
+  RunAll(Chunks, NChunks, Count);
+
+  /* Allocate the results. */
+  for (I = 0; I < NChunks; ++I)
+  { /* For each chunk. */
+    Total += Chunks[I].NVals;
+    Words += STRTOX_ERR_WORDS(Chunks[I].NVals);
+  } /* For each chunk. */
+
+  if (Total != 0
+      && ((AllVals = malloc(Total * Size)) == NULL
+          || (Errs != NULL
+              && ((AllErrs = calloc(STRTOX_ERR_WORDS(Total),
+                                    sizeof(*AllErrs))) == NULL
+                  || (Scratch = malloc(Words * sizeof(*Scratch))) == NULL))))
+  { /* Error. */
+    ErrNo = ENOMEM;
+  } /* Error. */
+  else if (Total != 0)
+  { /* Convert. */
+    for (I = 0, Pos = 0, Words = 0; I < NChunks; ++I)
+    { /* For each chunk. */
+      Chunks[I].Vals = &AllVals[Pos * Size];
+      Chunks[I].Errs = (Scratch != NULL ? &Scratch[Words] : NULL);
+      Pos += Chunks[I].NVals;
+      Words += STRTOX_ERR_WORDS(Chunks[I].NVals);
+    } /* For each chunk. */
+
+    RunAll(Chunks, NChunks, Convert);
+
+    for (I = 0, Pos = 0; I < NChunks && ErrNo == 0; ++I)
+    { /* For each chunk. */
+      if ((ErrNo = Chunks[I].ErrNo) == 0 && AllErrs != NULL)
+        MergeErrs(AllErrs, STRTOX_ERR_WORDS(Total), Pos, Chunks[I].Errs,
+                  Chunks[I].NVals);
+      Pos += Chunks[I].NVals;
+    } /* For each chunk. */
+  } /* Convert. */
+
+  free(Scratch);
+  free(Chunks);
+  if (ErrNo != 0)
+  { /* Error. */
+    free(AllErrs);
+    free(AllVals);
+    return ErrNo;
+  } /* Error. */
+
+  *Vals = AllVals;
+  if (Errs != NULL)
+    *Errs = AllErrs;
+  *NVals = Total;
+  return 0;
+} /* StrToXDelimPar() */
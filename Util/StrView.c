@@ -0,0 +1,803 @@
+/******************************************************************************
+ * Function definitions for 'StrView_t' that are too big to inline: the
+ * searches, the split iterator built on them, and the hash.  See
+ * StrView.h.
+ *
+ * There are up to three versions of each:
+ *
+ * Portable: 'memchr()' (which the C library already vectorizes) to
+ *   find candidates, then 'memcmp()', or a loop.
+ *
+ * SSE2 (SSE4.1 for the sets): 16 characters at a time.
+ *
+ * AVX2: 32 characters at a time.
+ *
+ * A substring is found with a "two byte filter": the vectors of
+ * characters at 'Pos' and 'Pos + Needle.Size - 1' are compared with
+ * the needle's first and last characters, and only where both match is
+ * the rest compared.  That skips almost everything in one pass
+ * whatever the needle, and rarely calls 'memcmp()' for nothing.
+ *
+ * A character set is found with two 'PSHUFB' table lookups: one,
+ * indexed by the low nibble of each character, gives the set of high
+ * nibbles (as bits) that are in the set with it; the other, indexed by
+ * the high nibble, gives the bit for it.  A character is in the set if
+ * the two have a bit in common.  Eight bits cover high nibbles 0-7
+ * (ASCII), so a second pair of tables does 8-15.
+ *
+ * The version is picked once, when the library is loaded, by
+ * 'CpuFeatures()'.  All of them give exactly the same results, and
+ * none of them reads outside the view.
+ *****************************************************************************/
+#include <stdint.h>
+#include <string.h>
+
+#include "Cpu.h"
+#include "StrView.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+/* What a 'StrSplit_t' splits at. */
+#define SPLIT_CHAR 0
+#define SPLIT_ANY 1
+#define SPLIT_STR 2
+
+/* The bit for each high nibble, for 'StrViewSet_t.Lo' and 'LoHigh'. */
+static const uint8_t HiBit[16] =
+{
+  0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0, 0, 0, 0, 0, 0, 0, 0
+};
+static const uint8_t HiBitHigh[16] =
+{
+  0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80
+};
+
+/******************************************************************************
+ * These would be 'private' in C++.
+ *****************************************************************************/
+static void MakeStrViewSet(StrViewSet_t *This, StrView_t Set)
+{ /* MakeStrViewSet() */
+  size_t I;
+
+  memset(This, 0, sizeof(*This));
+  for (I = 0; I < Set.Size; ++I)
+  { /* Each character. */
+    unsigned Char = (unsigned char) Set.Ptr[I];
+
+    This->Bits[Char / 64] |= (uint64_t) 1 << (Char % 64);
+    if (Char < 0x80)
+      This->Lo[Char & 0x0F] |= HiBit[Char >> 4];
+    else
+      This->LoHigh[Char & 0x0F] |= HiBitHigh[Char >> 4];
+  } /* Each character. */
+} /* MakeStrViewSet() */
+
+static inline bool InCharSet(const StrViewSet_t *This, char Char)
+{ /* InCharSet() */
+  unsigned C = (unsigned char) Char;
+
+  return ((This->Bits[C / 64] >> (C % 64)) & 1) != 0;
+} /* InCharSet() */
+
+/******************************************************************************
+ * The portable versions.  'Find' and 'RFind' are only called with
+ * '2 <= N <= Size'.
+ *****************************************************************************/
+static size_t FindPortable(const char *Hay, size_t Size, const char *Needle,
+                           size_t N)
+{ /* FindPortable() */
+  const char *Ptr = Hay, *Last = Hay + (Size - N);
+
+  /* Let 'memchr()' find the candidates. */
+  while ((Ptr = memchr(Ptr, Needle[0], (size_t) (Last - Ptr) + 1)) != NULL)
+  { /* Candidate. */
+    if (memcmp(Ptr + 1, Needle + 1, N - 1) == 0)
+      return (size_t) (Ptr - Hay);
+    if (Ptr++ == Last)
+      break;
+  } /* Candidate. */
+
+  return STRVIEW_NPOS;
+} /* FindPortable() */
+
+/* The last of the first 'End' candidate positions that matches. */
+static size_t RFindTail(const char *Hay, size_t End, const char *Needle,
+                        size_t N)
+{ /* RFindTail() */
+  while (End-- > 0)
+    if (Hay[End] == Needle[0] && memcmp(Hay + End + 1, Needle + 1, N - 1) == 0)
+      return End;
+
+  return STRVIEW_NPOS;
+} /* RFindTail() */
+
+static size_t RFindPortable(const char *Hay, size_t Size, const char *Needle,
+                            size_t N)
+{ /* RFindPortable() */
+  return RFindTail(Hay, Size - N + 1, Needle, N);
+} /* RFindPortable() */
+
+static size_t RFindCharTail(const char *Hay, size_t End, char Char)
+{ /* RFindCharTail() */
+  while (End-- > 0)
+    if (Hay[End] == Char)
+      return End;
+
+  return STRVIEW_NPOS;
+} /* RFindCharTail() */
+
+static size_t RFindCharPortable(const char *Hay, size_t Size, char Char)
+{ /* RFindCharPortable() */
+  return RFindCharTail(Hay, Size, Char);
+} /* RFindCharPortable() */
+
+static size_t FindAnyTail(const char *Hay, size_t Pos, size_t Size,
+                          const StrViewSet_t *Set)
+{ /* FindAnyTail() */
+  for (; Pos < Size; ++Pos)
+    if (InCharSet(Set, Hay[Pos]))
+      return Pos;
+
+  return STRVIEW_NPOS;
+} /* FindAnyTail() */
+
+static size_t FindAnyPortable(const char *Hay, size_t Size,
+                              const StrViewSet_t *Set)
+{ /* FindAnyPortable() */
+  return FindAnyTail(Hay, 0, Size, Set);
+} /* FindAnyPortable() */
+
+static size_t RFindAnyTail(const char *Hay, size_t End, const StrViewSet_t *Set)
+{ /* RFindAnyTail() */
+  while (End-- > 0)
+    if (InCharSet(Set, Hay[End]))
+      return End;
+
+  return STRVIEW_NPOS;
+} /* RFindAnyTail() */
+
+static size_t RFindAnyPortable(const char *Hay, size_t Size,
+                               const StrViewSet_t *Set)
+{ /* RFindAnyPortable() */
+  return RFindAnyTail(Hay, Size, Set);
+} /* RFindAnyPortable() */
+
+/* Until 'StrViewInit()' runs (e.g. if another library's constructor
+ * calls us first) the portable versions are used. */
+static size_t (*Find)(const char *Hay, size_t Size, const char *Needle,
+                      size_t N) = FindPortable;
+static size_t (*RFind)(const char *Hay, size_t Size, const char *Needle,
+                       size_t N) = RFindPortable;
+static size_t (*RFindChar)(const char *Hay, size_t Size, char Char)
+  = RFindCharPortable;
+static size_t (*FindAny)(const char *Hay, size_t Size, const StrViewSet_t *Set)
+  = FindAnyPortable;
+static size_t (*RFindAny)(const char *Hay, size_t Size, const StrViewSet_t *Set)
+  = RFindAnyPortable;
+
+#ifdef CPU_X86
+/******************************************************************************
+ * The SSE2 versions.  Each block of 16 candidate positions gives a
+ * bit mask of the ones to look at.
+ *****************************************************************************/
+__attribute__((target("sse2")))
+static size_t FindSse2(const char *Hay, size_t Size, const char *Needle,
+                       size_t N)
+{ /* FindSse2() */
+  const __m128i First = _mm_set1_epi8(Needle[0]);
+  const __m128i Last = _mm_set1_epi8(Needle[N - 1]);
+  size_t Pos, Found;
+  unsigned Mask;
+
+  for (Pos = 0; Size - Pos >= N - 1 + 16; Pos += 16)
+  { /* Each block. */
+    __m128i A = _mm_loadu_si128((const __m128i *) (Hay + Pos));
+    __m128i B = _mm_loadu_si128((const __m128i *) (Hay + Pos + N - 1));
+
+    Mask = (unsigned) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(A, First),
+                                                      _mm_cmpeq_epi8(B, Last)));
+    for (; Mask != 0; Mask &= Mask - 1)
+    { /* Each candidate. */
+      size_t At = Pos + (unsigned) __builtin_ctz(Mask);
+
+      if (memcmp(Hay + At + 1, Needle + 1, N - 2) == 0)
+        return At;
+    } /* Each candidate. */
+  } /* Each block. */
+
+  if (Size - Pos < N)
+    return STRVIEW_NPOS;
+  Found = FindPortable(Hay + Pos, Size - Pos, Needle, N);
+  return (Found == STRVIEW_NPOS ? Found : Pos + Found);
+} /* FindSse2() */
+
+__attribute__((target("sse2")))
+static size_t RFindSse2(const char *Hay, size_t Size, const char *Needle,
+                        size_t N)
+{ /* RFindSse2() */
+  const __m128i First = _mm_set1_epi8(Needle[0]);
+  const __m128i Last = _mm_set1_epi8(Needle[N - 1]);
+  size_t End = Size - N + 1;    /* Candidate positions left. */
+  unsigned Mask;
+
+  for (; End >= 16; End -= 16)
+  { /* Each block. */
+    const char *Ptr = Hay + End - 16;
+    __m128i A = _mm_loadu_si128((const __m128i *) Ptr);
+    __m128i B = _mm_loadu_si128((const __m128i *) (Ptr + N - 1));
+
+    Mask = (unsigned) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(A, First),
+                                                      _mm_cmpeq_epi8(B, Last)));
+    while (Mask != 0)
+    { /* Each candidate, last first. */
+      unsigned Bit = 31 - (unsigned) __builtin_clz(Mask);
+
+      if (memcmp(Ptr + Bit + 1, Needle + 1, N - 2) == 0)
+        return (size_t) (Ptr - Hay) + Bit;
+      Mask &= ~(1u << Bit);
+    } /* Each candidate, last first. */
+  } /* Each block. */
+
+  return RFindTail(Hay, End, Needle, N);
+} /* RFindSse2() */
+
+__attribute__((target("sse2")))
+static size_t RFindCharSse2(const char *Hay, size_t Size, char Char)
+{ /* RFindCharSse2() */
+  const __m128i C = _mm_set1_epi8(Char);
+  unsigned Mask;
+
+  for (; Size >= 16; Size -= 16)
+  { /* Each block. */
+    __m128i A = _mm_loadu_si128((const __m128i *) (Hay + Size - 16));
+
+    if ((Mask = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(A, C))) != 0)
+      return Size - 16 + 31 - (unsigned) __builtin_clz(Mask);
+  } /* Each block. */
+
+  return RFindCharTail(Hay, Size, Char);
+} /* RFindCharSse2() */
+
+/******************************************************************************
+ * The SSE4.1 versions of the character set searches.  Only 'PSHUFB'
+ * (SSSE3) is needed, but that's not one of the 'CpuFeatures()'.
+ *****************************************************************************/
+__attribute__((target("sse4.1"), always_inline))
+static inline unsigned AnyMaskSse41(__m128i Chars, __m128i Lo, __m128i LoHigh,
+                                    __m128i Hi, __m128i HiHigh)
+{ /* AnyMaskSse41() */
+  const __m128i Nibble = _mm_set1_epi8(0x0F);
+  __m128i L = _mm_and_si128(Chars, Nibble);
+  __m128i H = _mm_and_si128(_mm_srli_epi16(Chars, 4), Nibble);
+  __m128i In = _mm_or_si128(_mm_and_si128(_mm_shuffle_epi8(Lo, L),
+                                          _mm_shuffle_epi8(Hi, H)),
+                            _mm_and_si128(_mm_shuffle_epi8(LoHigh, L),
+                                          _mm_shuffle_epi8(HiHigh, H)));
+
+  return ~(unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(In,
+                                                      _mm_setzero_si128()))
+    & 0xFFFFu;
+} /* AnyMaskSse41() */
+
+#define SSE41_TABLES                                                    \
+  const __m128i Lo = _mm_loadu_si128((const __m128i *) Set->Lo);        \
+  const __m128i LoHigh = _mm_loadu_si128((const __m128i *) Set->LoHigh); \
+  const __m128i Hi = _mm_loadu_si128((const __m128i *) HiBit);          \
+  const __m128i HiHigh = _mm_loadu_si128((const __m128i *) HiBitHigh)
+
+__attribute__((target("sse4.1")))
+static size_t FindAnySse41(const char *Hay, size_t Size, const StrViewSet_t *Set)
+{ /* FindAnySse41() */
+  SSE41_TABLES;
+  size_t Pos;
+  unsigned Mask;
+
+  for (Pos = 0; Size - Pos >= 16; Pos += 16)
+  { /* Each block. */
+    Mask = AnyMaskSse41(_mm_loadu_si128((const __m128i *) (Hay + Pos)),
+                        Lo, LoHigh, Hi, HiHigh);
+    if (Mask != 0)
+      return Pos + (unsigned) __builtin_ctz(Mask);
+  } /* Each block. */
+
+  return FindAnyTail(Hay, Pos, Size, Set);
+} /* FindAnySse41() */
+
+__attribute__((target("sse4.1")))
+static size_t RFindAnySse41(const char *Hay, size_t Size,
+                            const StrViewSet_t *Set)
+{ /* RFindAnySse41() */
+  SSE41_TABLES;
+  unsigned Mask;
+
+  for (; Size >= 16; Size -= 16)
+  { /* Each block. */
+    Mask = AnyMaskSse41(_mm_loadu_si128((const __m128i *) (Hay + Size - 16)),
+                        Lo, LoHigh, Hi, HiHigh);
+    if (Mask != 0)
+      return Size - 16 + 31 - (unsigned) __builtin_clz(Mask);
+  } /* Each block. */
+
+  return RFindAnyTail(Hay, Size, Set);
+} /* RFindAnySse41() */
+
+/******************************************************************************
+ * The AVX2 versions.  The same as the above but 32 characters at a
+ * time.  'VPSHUFB' looks up each 128-bit half separately, so the
+ * tables are repeated in both.
+ *****************************************************************************/
+__attribute__((target("avx2")))
+static size_t FindAvx2(const char *Hay, size_t Size, const char *Needle,
+                       size_t N)
+{ /* FindAvx2() */
+  const __m256i First = _mm256_set1_epi8(Needle[0]);
+  const __m256i Last = _mm256_set1_epi8(Needle[N - 1]);
+  size_t Pos, Found;
+  unsigned Mask;
+
+  for (Pos = 0; Size - Pos >= N - 1 + 32; Pos += 32)
+  { /* Each block. */
+    __m256i A = _mm256_loadu_si256((const __m256i *) (Hay + Pos));
+    __m256i B = _mm256_loadu_si256((const __m256i *) (Hay + Pos + N - 1));
+
+    Mask = (unsigned) _mm256_movemask_epi8(
+      _mm256_and_si256(_mm256_cmpeq_epi8(A, First),
+                       _mm256_cmpeq_epi8(B, Last)));
+    for (; Mask != 0; Mask &= Mask - 1)
+    { /* Each candidate. */
+      size_t At = Pos + (unsigned) __builtin_ctz(Mask);
+
+      if (memcmp(Hay + At + 1, Needle + 1, N - 2) == 0)
+        return At;
+    } /* Each candidate. */
+  } /* Each block. */
+
+  if (Size - Pos < N)
+    return STRVIEW_NPOS;
+  Found = FindPortable(Hay + Pos, Size - Pos, Needle, N);
+  return (Found == STRVIEW_NPOS ? Found : Pos + Found);
+} /* FindAvx2() */
+
+__attribute__((target("avx2")))
+static size_t RFindAvx2(const char *Hay, size_t Size, const char *Needle,
+                        size_t N)
+{ /* RFindAvx2() */
+  const __m256i First = _mm256_set1_epi8(Needle[0]);
+  const __m256i Last = _mm256_set1_epi8(Needle[N - 1]);
+  size_t End = Size - N + 1;    /* Candidate positions left. */
+  unsigned Mask;
+
+  for (; End >= 32; End -= 32)
+  { /* Each block. */
+    const char *Ptr = Hay + End - 32;
+    __m256i A = _mm256_loadu_si256((const __m256i *) Ptr);
+    __m256i B = _mm256_loadu_si256((const __m256i *) (Ptr + N - 1));
+
+    Mask = (unsigned) _mm256_movemask_epi8(
+      _mm256_and_si256(_mm256_cmpeq_epi8(A, First),
+                       _mm256_cmpeq_epi8(B, Last)));
+    while (Mask != 0)
+    { /* Each candidate, last first. */
+      unsigned Bit = 31 - (unsigned) __builtin_clz(Mask);
+
+      if (memcmp(Ptr + Bit + 1, Needle + 1, N - 2) == 0)
+        return (size_t) (Ptr - Hay) + Bit;
+      Mask &= ~(1u << Bit);
+    } /* Each candidate, last first. */
+  } /* Each block. */
+
+  return RFindTail(Hay, End, Needle, N);
+} /* RFindAvx2() */
+
+__attribute__((target("avx2")))
+static size_t RFindCharAvx2(const char *Hay, size_t Size, char Char)
+{ /* RFindCharAvx2() */
+  const __m256i C = _mm256_set1_epi8(Char);
+  unsigned Mask;
+
+  for (; Size >= 32; Size -= 32)
+  { /* Each block. */
+    __m256i A = _mm256_loadu_si256((const __m256i *) (Hay + Size - 32));
+
+    if ((Mask = (unsigned) _mm256_movemask_epi8(_mm256_cmpeq_epi8(A, C))) != 0)
+      return Size - 32 + 31 - (unsigned) __builtin_clz(Mask);
+  } /* Each block. */
+
+  return RFindCharTail(Hay, Size, Char);
+} /* RFindCharAvx2() */
+
+__attribute__((target("avx2"), always_inline))
+static inline unsigned AnyMaskAvx2(__m256i Chars, __m256i Lo, __m256i LoHigh,
+                                   __m256i Hi, __m256i HiHigh)
+{ /* AnyMaskAvx2() */
+  const __m256i Nibble = _mm256_set1_epi8(0x0F);
+  __m256i L = _mm256_and_si256(Chars, Nibble);
+  __m256i H = _mm256_and_si256(_mm256_srli_epi16(Chars, 4), Nibble);
+  __m256i In = _mm256_or_si256(_mm256_and_si256(_mm256_shuffle_epi8(Lo, L),
+                                                _mm256_shuffle_epi8(Hi, H)),
+                               _mm256_and_si256(_mm256_shuffle_epi8(LoHigh, L),
+                                                _mm256_shuffle_epi8(HiHigh,
+                                                                    H)));
+
+  return ~(unsigned) _mm256_movemask_epi8(
+    _mm256_cmpeq_epi8(In, _mm256_setzero_si256()));
+} /* AnyMaskAvx2() */
+
+#define AVX2_TABLE(Table) \
+  _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *) (Table)))
+
+#define AVX2_TABLES                                             \
+  const __m256i Lo = AVX2_TABLE(Set->Lo);                       \
+  const __m256i LoHigh = AVX2_TABLE(Set->LoHigh);               \
+  const __m256i Hi = AVX2_TABLE(HiBit);                         \
+  const __m256i HiHigh = AVX2_TABLE(HiBitHigh)
+
+__attribute__((target("avx2")))
+static size_t FindAnyAvx2(const char *Hay, size_t Size, const StrViewSet_t *Set)
+{ /* FindAnyAvx2() */
+  AVX2_TABLES;
+  size_t Pos;
+  unsigned Mask;
+
+  for (Pos = 0; Size - Pos >= 32; Pos += 32)
+  { /* Each block. */
+    Mask = AnyMaskAvx2(_mm256_loadu_si256((const __m256i *) (Hay + Pos)),
+                       Lo, LoHigh, Hi, HiHigh);
+    if (Mask != 0)
+      return Pos + (unsigned) __builtin_ctz(Mask);
+  } /* Each block. */
+
+  return FindAnyTail(Hay, Pos, Size, Set);
+} /* FindAnyAvx2() */
+
+__attribute__((target("avx2")))
+static size_t RFindAnyAvx2(const char *Hay, size_t Size, const StrViewSet_t *Set)
+{ /* RFindAnyAvx2() */
+  AVX2_TABLES;
+  unsigned Mask;
+
+  for (; Size >= 32; Size -= 32)
+  { /* Each block. */
+    Mask = AnyMaskAvx2(_mm256_loadu_si256((const __m256i *) (Hay + Size - 32)),
+                       Lo, LoHigh, Hi, HiHigh);
+    if (Mask != 0)
+      return Size - 32 + 31 - (unsigned) __builtin_clz(Mask);
+  } /* Each block. */
+
+  return RFindAnyTail(Hay, Size, Set);
+} /* RFindAnyAvx2() */
+
+/******************************************************************************
+ * Pick the best versions for this CPU when the library is loaded.
+ *****************************************************************************/
+__attribute__((constructor))
+static void StrViewInit(void)
+{ /* StrViewInit() */
+  unsigned Features = CpuFeatures();
+
+  if (Features & CPU_AVX2)
+  { /* AVX2. */
+    Find = FindAvx2;
+    RFind = RFindAvx2;
+    RFindChar = RFindCharAvx2;
+    FindAny = FindAnyAvx2;
+    RFindAny = RFindAnyAvx2;
+    return;
+  } /* AVX2. */
+
+  if (Features & CPU_SSE2)
+  { /* SSE2. */
+    Find = FindSse2;
+    RFind = RFindSse2;
+    RFindChar = RFindCharSse2;
+  } /* SSE2. */
+
+  if (Features & CPU_SSE41)
+  { /* SSE4.1. */
+    FindAny = FindAnySse41;
+    RFindAny = RFindAnySse41;
+  } /* SSE4.1. */
+} /* StrViewInit() */
+#endif
+
+/******************************************************************************
+ * Public methods.  The trivial cases are done here so the versions
+ * above don't have to.
+ *****************************************************************************/
+size_t StrViewFind(StrView_t This, StrView_t Needle)
+{ /* StrViewFind() */
+  if (Needle.Size == 0)
+    return 0;
+  if (Needle.Size > This.Size)
+    return STRVIEW_NPOS;
+  if (Needle.Size == 1)
+    return StrViewFindChar(This, Needle.Ptr[0]);
+
+  return Find(This.Ptr, This.Size, Needle.Ptr, Needle.Size);
+} /* StrViewFind() */
+
+size_t StrViewRFind(StrView_t This, StrView_t Needle)
+{ /* StrViewRFind() */
+  if (Needle.Size > This.Size)
+    return STRVIEW_NPOS;
+  if (Needle.Size == 0)
+    return This.Size;
+  if (Needle.Size == 1)
+    return StrViewRFindChar(This, Needle.Ptr[0]);
+
+  return RFind(This.Ptr, This.Size, Needle.Ptr, Needle.Size);
+} /* StrViewRFind() */
+
+size_t StrViewRFindChar(StrView_t This, char Char)
+{ /* StrViewRFindChar() */
+  return RFindChar(This.Ptr, This.Size, Char);
+} /* StrViewRFindChar() */
+
+size_t StrViewFindAny(StrView_t This, StrView_t Set)
+{ /* StrViewFindAny() */
+  StrViewSet_t CharSet;
+
+  if (Set.Size <= 1)
+    return (Set.Size == 0 ? STRVIEW_NPOS : StrViewFindChar(This, Set.Ptr[0]));
+
+  MakeStrViewSet(&CharSet, Set);
+  return FindAny(This.Ptr, This.Size, &CharSet);
+} /* StrViewFindAny() */
+
+size_t StrViewRFindAny(StrView_t This, StrView_t Set)
+{ /* StrViewRFindAny() */
+  StrViewSet_t CharSet;
+
+  if (Set.Size <= 1)
+    return (Set.Size == 0 ? STRVIEW_NPOS : StrViewRFindChar(This, Set.Ptr[0]));
+
+  MakeStrViewSet(&CharSet, Set);
+  return RFindAny(This.Ptr, This.Size, &CharSet);
+} /* StrViewRFindAny() */
+
+/******************************************************************************
+ * The hash is wyhash (final version 4, by Wang Yi, public domain): 48
+ * bytes a round in three independent lanes, each mixed with a 64 x
+ * 64 -> 128 bit multiply whose halves are folded together.  Short
+ * strings are read with (at most) two overlapping loads from each end,
+ * so nothing outside the view is read and there's no loop.
+ *****************************************************************************/
+static const uint64_t HashSecret[4] =
+{
+  0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+  0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+static inline void HashMul(uint64_t *A, uint64_t *B)
+{ /* HashMul() */
+#ifdef __SIZEOF_INT128__
+  unsigned __int128 R = (unsigned __int128) *A * *B;
+
+  *A = (uint64_t) R;
+  *B = (uint64_t) (R >> 64);
+#else
+  uint64_t Ha = *A >> 32, La = (uint32_t) *A, Hb = *B >> 32, Lb = (uint32_t) *B;
+  uint64_t Rh = Ha * Hb, Rm0 = Ha * Lb, Rm1 = Hb * La, Rl = La * Lb;
+  uint64_t T = Rl + (Rm0 << 32), Lo = T + (Rm1 << 32);
+  uint64_t Carry = (T < Rl) + (Lo < T);
+
+  *A = Lo;
+  *B = Rh + (Rm0 >> 32) + (Rm1 >> 32) + Carry;
+#endif
+} /* HashMul() */
+
+static inline uint64_t HashMix(uint64_t A, uint64_t B)
+{ /* HashMix() */
+  HashMul(&A, &B);
+  return A ^ B;
+} /* HashMix() */
+
+static inline uint64_t Read8(const uint8_t *Ptr)
+{ /* Read8() */
+  uint64_t Val;
+
+  memcpy(&Val, Ptr, sizeof(Val));
+  return Val;
+} /* Read8() */
+
+static inline uint64_t Read4(const uint8_t *Ptr)
+{ /* Read4() */
+  uint32_t Val;
+
+  memcpy(&Val, Ptr, sizeof(Val));
+  return Val;
+} /* Read4() */
+
+/******************************************************************************
+ * The split iterator.
+ *****************************************************************************/
+/* The position of the next separator in 'View', or 'STRVIEW_NPOS'. */
+static size_t FindSep(const StrSplit_t *This, StrView_t View)
+{ /* FindSep() */
+  switch (This->Mode)
+  { /* Mode. */
+  case SPLIT_CHAR:
+    return StrViewFindChar(View, This->Char);
+  case SPLIT_ANY:
+    return FindAny(View.Ptr, View.Size, &This->Set);
+  default:
+    return (This->Sep.Size == 0 ? STRVIEW_NPOS : StrViewFind(View, This->Sep));
+  } /* Mode. */
+} /* FindSep() */
+
+/* Carry on after the separator at 'Pos' in 'View', if there is one. */
+static void SkipSep(StrSplit_t *This, StrView_t View, size_t Pos)
+{ /* SkipSep() */
+  if (Pos == STRVIEW_NPOS)
+  { /* Last field. */
+    This->Rest = StrView(View.Ptr + View.Size, 0);
+    This->Done = true;
+    return;
+  } /* Last field. */
+
+  This->Rest = StrViewSub(View, Pos + (This->Mode == SPLIT_STR ?
+                                       This->Sep.Size : 1), STRVIEW_NPOS);
+} /* SkipSep() */
+
+/* The position of the 'Quote' closing the one 'View' starts with, or
+ * 'STRVIEW_NPOS'. */
+static size_t FindCloseQuote(StrView_t View, char Quote)
+{ /* FindCloseQuote() */
+  size_t Pos = 1, Found;
+
+  for (;;)
+  { /* Each 'Quote'. */
+    if ((Found = StrViewFindChar(StrViewSub(View, Pos, STRVIEW_NPOS),
+                                 Quote)) == STRVIEW_NPOS)
+      return STRVIEW_NPOS;
+    Pos += Found;
+    if (Pos + 1 >= View.Size || View.Ptr[Pos + 1] != Quote)
+      return Pos;
+    Pos += 2;                   /* Doubled. */
+  } /* Each 'Quote'. */
+} /* FindCloseQuote() */
+
+static void StrSplitStart(StrSplit_t *Split, StrView_t This, int Mode,
+                          unsigned Flags)
+{ /* StrSplitStart() */
+  Split->Rest = This;
+  Split->Flags = Flags;
+  Split->Mode = Mode;
+  Split->Quote = '"';
+  Split->Quoted = false;
+  Split->Done = false;
+} /* StrSplitStart() */
+
+void StrSplitChar(StrSplit_t *Split, StrView_t This, char Sep, unsigned Flags)
+{ /* StrSplitChar() */
+  StrSplitStart(Split, This, SPLIT_CHAR, Flags);
+  Split->Char = Sep;
+  Split->Sep = StrView(NULL, 0);
+} /* StrSplitChar() */
+
+void StrSplitAny(StrSplit_t *Split, StrView_t This, StrView_t Set,
+                 unsigned Flags)
+{ /* StrSplitAny() */
+  if (Set.Size == 1)
+  { /* Just the one. */
+    StrSplitChar(Split, This, Set.Ptr[0], Flags);
+    return;
+  } /* Just the one. */
+
+  /* An empty set matches nothing, as an empty string does. */
+  StrSplitStart(Split, This, (Set.Size == 0 ? SPLIT_STR : SPLIT_ANY), Flags);
+  Split->Sep = Set;
+  MakeStrViewSet(&Split->Set, Set);
+} /* StrSplitAny() */
+
+void StrSplitStr(StrSplit_t *Split, StrView_t This, StrView_t Sep,
+                 unsigned Flags)
+{ /* StrSplitStr() */
+  if (Sep.Size == 1)
+  { /* Just the one. */
+    StrSplitChar(Split, This, Sep.Ptr[0], Flags);
+    return;
+  } /* Just the one. */
+
+  StrSplitStart(Split, This, SPLIT_STR, Flags);
+  Split->Sep = Sep;
+} /* StrSplitStr() */
+
+bool StrSplitNext(StrSplit_t *Split, StrView_t *Field)
+{ /* StrSplitNext() */
+  StrView_t Rest;
+  size_t Pos;
+
+  while (!Split->Done)
+  { /* Each field. */
+    Rest = Split->Rest;
+    Split->Quoted = ((Split->Flags & STRSPLIT_QUOTES) && Rest.Size > 0 &&
+                     Rest.Ptr[0] == Split->Quote);
+
+    if (Split->Quoted)
+    { /* Quoted. */
+      if ((Pos = FindCloseQuote(Rest, Split->Quote)) == STRVIEW_NPOS)
+      { /* Not closed. */
+        *Field = StrViewSub(Rest, 1, STRVIEW_NPOS);
+        SkipSep(Split, Rest, STRVIEW_NPOS);
+        return true;
+      } /* Not closed. */
+
+      /* Even an empty quoted field was asked for. */
+      *Field = StrView(Rest.Ptr + 1, Pos - 1);
+      Rest = StrViewSub(Rest, Pos + 1, STRVIEW_NPOS);
+      SkipSep(Split, Rest, FindSep(Split, Rest));
+      return true;
+    } /* Quoted. */
+
+    Pos = FindSep(Split, Rest);
+    *Field = StrViewSub(Rest, 0, Pos);
+    SkipSep(Split, Rest, Pos);
+    if (Field->Size > 0 || !(Split->Flags & STRSPLIT_COLLAPSE))
+      return true;
+  } /* Each field. */
+
+  return false;
+} /* StrSplitNext() */
+
+/******************************************************************************
+ * Hashing.  See above.
+ *****************************************************************************/
+uint64_t StrViewHashSeed(StrView_t This, uint64_t Seed)
+{ /* StrViewHashSeed() */
+  const uint8_t *Ptr = (const uint8_t *) This.Ptr;
+  size_t Len = This.Size, Left = Len;
+  uint64_t A, B, Seed1, Seed2;
+
+  Seed ^= HashMix(Seed ^ HashSecret[0], HashSecret[1]);
+  if (Len <= 16)
+  { /* Short. */
+    if (Len >= 4)
+    { /* 4 to 16. */
+      size_t Mid = (Len >> 3) << 2;
+
+      A = (Read4(Ptr) << 32) | Read4(Ptr + Mid);
+      B = (Read4(Ptr + Len - 4) << 32) | Read4(Ptr + Len - 4 - Mid);
+    } /* 4 to 16. */
+    else if (Len > 0)
+    { /* 1 to 3. */
+      A = ((uint64_t) Ptr[0] << 16) | ((uint64_t) Ptr[Len >> 1] << 8) |
+          Ptr[Len - 1];
+      B = 0;
+    } /* 1 to 3. */
+    else
+      A = B = 0;
+  } /* Short. */
+  else
+  { /* Long. */
+    if (Left > 48)
+    { /* Three lanes. */
+      Seed1 = Seed2 = Seed;
+      do
+      { /* Each round. */
+        Seed = HashMix(Read8(Ptr) ^ HashSecret[1], Read8(Ptr + 8) ^ Seed);
+        Seed1 = HashMix(Read8(Ptr + 16) ^ HashSecret[2],
+                        Read8(Ptr + 24) ^ Seed1);
+        Seed2 = HashMix(Read8(Ptr + 32) ^ HashSecret[3],
+                        Read8(Ptr + 40) ^ Seed2);
+        Ptr += 48;
+        Left -= 48;
+      } while (Left > 48); /* Each round. */
+      Seed ^= Seed1 ^ Seed2;
+    } /* Three lanes. */
+
+    for (; Left > 16; Ptr += 16, Left -= 16)
+      Seed = HashMix(Read8(Ptr) ^ HashSecret[1], Read8(Ptr + 8) ^ Seed);
+
+    /* The last 16, which may overlap what's been done. */
+    A = Read8(Ptr + Left - 16);
+    B = Read8(Ptr + Left - 8);
+  } /* Long. */
+
+  A ^= HashSecret[1];
+  B ^= Seed;
+  HashMul(&A, &B);
+  return HashMix(A ^ HashSecret[0] ^ Len, B ^ HashSecret[1]);
+} /* StrViewHashSeed() */
@@ -0,0 +1,268 @@
+#ifndef StrView_h
+#define StrView_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/******************************************************************************
+ * A string view: a pointer to some characters and how many there are,
+ * borrowed from a 'String_t', a C string, or any other buffer, like
+ * 'std::string_view'.  A view isn't NUL terminated (use '"%.*s"' with
+ * '(int) View.Size' to print one) and doesn't own anything, so it
+ * must not outlive what it points into.  Views are passed and
+ * returned by value.
+ *
+ * None of these functions allocate memory or fail.  Positions and
+ * lengths past the end are cut back to the end, and searches that find
+ * nothing return 'STRVIEW_NPOS'.
+ *****************************************************************************/
+#include <ctype.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef struct StrView
+{ /* StrView */
+  const char *Ptr;
+  size_t Size;
+} StrView_t; /* StrView */
+
+/* "Not found". */
+#define STRVIEW_NPOS SIZE_MAX
+
+/* A set of characters, ready to search for.  Private. */
+typedef struct StrViewSet
+{ /* StrViewSet */
+  uint8_t Lo[16];               /* High nibbles 0-7 by low nibble. */
+  uint8_t LoHigh[16];           /* High nibbles 8-15 by low nibble. */
+  uint64_t Bits[4];             /* One bit per character. */
+} StrViewSet_t; /* StrViewSet */
+
+/******************************************************************************
+ * A split iterator, for going through the fields of a record one at a
+ * time without copying (or allocating) anything:
+ *
+ *   StrSplit_t Split;
+ *   StrView_t Field;
+ *   int64_t Val;
+ *
+ *   StrSplitChar(&Split, StringView(&Line), ',', STRSPLIT_QUOTES);
+ *   while (StrSplitNext(&Split, &Field))
+ *     if (StrNToI64(Field.Ptr, Field.Size, 10, &Val) != 0)
+ *       ...
+ *
+ * The fields are separated by a character, any character in a set, or
+ * a string.  "a,,b" has three fields, the second empty, unless
+ * 'STRSPLIT_COLLAPSE' is given, when empty fields are skipped
+ * altogether.  An empty record has one (empty) field.
+ *
+ * With 'STRSPLIT_QUOTES' a field starting with 'Quote' ('"' unless
+ * changed after the 'StrSplit' call) runs to the matching 'Quote', and
+ * any separators in it are part of the field, as in a CSV file.  Two
+ * 'Quote's in a row are a 'Quote' in the field.  The field given back
+ * doesn't include the outer quotes, but the doubled ones are left as
+ * they are (it's a view, so there's nowhere to undouble them) and
+ * 'Quoted' is set so the caller knows to.  Anything after the closing
+ * 'Quote', up to the separator, is ignored.  A field with no closing
+ * 'Quote' runs to the end of the record.
+ *
+ * The searches are 'StrViewFindChar()', 'StrViewFind()', or the same
+ * as 'StrViewFindAny()' (with the set made once, up front), so they're
+ * vectorized as those are.  What's being split mustn't change, or go
+ * away, while the 'StrSplit_t' is in use.
+ *****************************************************************************/
+#define STRSPLIT_COLLAPSE 0x01  /* Skip empty fields. */
+#define STRSPLIT_QUOTES 0x02    /* Separators may be quoted. */
+
+typedef struct StrSplit
+{ /* StrSplit */
+  StrView_t Rest;               /* What's left to split. */
+  StrView_t Sep;                /* The separator, or set of them. */
+  StrViewSet_t Set;             /* 'Sep' for a 'StrSplitAny()'. */
+  unsigned Flags;               /* 'STRSPLIT_*'. */
+  int Mode;                     /* Private. */
+  char Char;                    /* The separator for a 'StrSplitChar()'. */
+  char Quote;
+  bool Quoted;                  /* The last field was quoted. */
+  bool Done;                    /* No more fields. */
+} StrSplit_t; /* StrSplit */
+
+  /* Start splitting 'This' at 'Sep', at any character in 'Set', or at
+   * the string 'Sep' (an empty one never matches). */
+  extern void StrSplitChar(StrSplit_t *Split, StrView_t This, char Sep,
+                           unsigned Flags);
+  extern void StrSplitAny(StrSplit_t *Split, StrView_t This, StrView_t Set,
+                          unsigned Flags);
+  extern void StrSplitStr(StrSplit_t *Split, StrView_t This, StrView_t Sep,
+                          unsigned Flags);
+
+  /* Set '*Field' to the next field and return 'true', or return
+   * 'false' if there are no more. */
+  extern bool StrSplitNext(StrSplit_t *Split, StrView_t *Field);
+
+  /* Views of 'Size' characters at 'Ptr', and of a C string. */
+  static inline StrView_t StrView(const char *Ptr, size_t Size);
+  static inline StrView_t StrViewCStr(const char *CStr);
+
+  /* Up to 'Len' characters from 'Pos'. */
+  static inline StrView_t StrViewSub(StrView_t This, size_t Pos, size_t Len);
+
+  /* Without leading and/or trailing white space (as for 'isspace()'). */
+  static inline StrView_t StrViewTrimLeft(StrView_t This);
+  static inline StrView_t StrViewTrimRight(StrView_t This);
+  static inline StrView_t StrViewTrim(StrView_t This);
+
+  /* Compare as 'strcmp()' would (a prefix comes first), and for
+   * equality. */
+  static inline int StrViewCompare(StrView_t This, StrView_t That);
+  static inline bool StrViewEqual(StrView_t This, StrView_t That);
+
+  static inline bool StrViewStartsWith(StrView_t This, StrView_t Prefix);
+  static inline bool StrViewEndsWith(StrView_t This, StrView_t Suffix);
+
+  /* The position of the first (or, for the 'RFind' versions, the
+   * last) 'Needle', 'Char', or character in 'Set', or 'STRVIEW_NPOS'.
+   * An empty 'Needle' is found at 0 (or 'This.Size').  These use SSE2,
+   * SSE4.1, or AVX2 if the CPU has them (see StrView.c). */
+  extern size_t StrViewFind(StrView_t This, StrView_t Needle);
+  extern size_t StrViewRFind(StrView_t This, StrView_t Needle);
+  static inline size_t StrViewFindChar(StrView_t This, char Char);
+  extern size_t StrViewRFindChar(StrView_t This, char Char);
+  extern size_t StrViewFindAny(StrView_t This, StrView_t Set);
+  extern size_t StrViewRFindAny(StrView_t This, StrView_t Set);
+
+  /* A 64-bit hash of the contents, for hash tables etc..  It's
+   * wyhash (see StrView.c), which is fast (around 20 GB/s on long
+   * strings, and no loop at all up to 16 bytes) and passes SMHasher.
+   * Tables that might be fed keys chosen to collide can pick a random
+   * 'Seed'.  The hash is the same from run to run, but not between
+   * machines of different byte order. */
+  extern uint64_t StrViewHashSeed(StrView_t This, uint64_t Seed);
+  static inline uint64_t StrViewHash(StrView_t This);
+
+  /* Split 'This' at the first 'Delim' into '*Head', before it, and
+   * '*Tail', after it, and return 'true'.  If there's no 'Delim',
+   * '*Head' is 'This', '*Tail' is empty, and we return 'false'.  So
+   * the fields of a line are
+   *
+   *   for (More = true; More; )
+   *   { // Each field.
+   *     More = StrViewSplit(Line, ',', &Field, &Line);
+   *     ...
+   *   } // Each field.
+   */
+  static inline bool StrViewSplit(StrView_t This, char Delim,
+                                  StrView_t *Head, StrView_t *Tail);
+
+/******************************************************************************
+ * Inline method definitions.
+ *****************************************************************************/
+  static inline StrView_t StrView(const char *Ptr, size_t Size)
+  { /* StrView() */
+    StrView_t View = { Ptr, Size };
+
+    return View;
+  } /* StrView() */
+
+  static inline StrView_t StrViewCStr(const char *CStr)
+  { /* StrViewCStr() */
+    return StrView(CStr, strlen(CStr));
+  } /* StrViewCStr() */
+
+  static inline StrView_t StrViewSub(StrView_t This, size_t Pos, size_t Len)
+  { /* StrViewSub() */
+    if (Pos > This.Size)
+      Pos = This.Size;
+    if (Len > This.Size - Pos)
+      Len = This.Size - Pos;
+    return StrView(This.Ptr + Pos, Len);
+  } /* StrViewSub() */
+
+  static inline StrView_t StrViewTrimLeft(StrView_t This)
+  { /* StrViewTrimLeft() */
+    while (This.Size > 0 && isspace((unsigned char) This.Ptr[0]))
+    { /* Drop one. */
+      This.Ptr++;
+      This.Size--;
+    } /* Drop one. */
+    return This;
+  } /* StrViewTrimLeft() */
+
+  static inline StrView_t StrViewTrimRight(StrView_t This)
+  { /* StrViewTrimRight() */
+    while (This.Size > 0 && isspace((unsigned char) This.Ptr[This.Size - 1]))
+      This.Size--;
+    return This;
+  } /* StrViewTrimRight() */
+
+  static inline StrView_t StrViewTrim(StrView_t This)
+  { /* StrViewTrim() */
+    return StrViewTrimRight(StrViewTrimLeft(This));
+  } /* StrViewTrim() */
+
+  static inline int StrViewCompare(StrView_t This, StrView_t That)
+  { /* StrViewCompare() */
+    size_t Len = (This.Size < That.Size ? This.Size : That.Size);
+    int Cmp = (Len == 0 ? 0 : memcmp(This.Ptr, That.Ptr, Len));
+
+    if (Cmp != 0)
+      return Cmp;
+    return (This.Size < That.Size ? -1 : This.Size > That.Size);
+  } /* StrViewCompare() */
+
+  static inline bool StrViewEqual(StrView_t This, StrView_t That)
+  { /* StrViewEqual() */
+    return (This.Size == That.Size &&
+            (This.Size == 0 || memcmp(This.Ptr, That.Ptr, This.Size) == 0));
+  } /* StrViewEqual() */
+
+  static inline bool StrViewStartsWith(StrView_t This, StrView_t Prefix)
+  { /* StrViewStartsWith() */
+    return (This.Size >= Prefix.Size &&
+            StrViewEqual(StrView(This.Ptr, Prefix.Size), Prefix));
+  } /* StrViewStartsWith() */
+
+  static inline bool StrViewEndsWith(StrView_t This, StrView_t Suffix)
+  { /* StrViewEndsWith() */
+    return (This.Size >= Suffix.Size &&
+            StrViewEqual(StrView(This.Ptr + This.Size - Suffix.Size,
+                                 Suffix.Size), Suffix));
+  } /* StrViewEndsWith() */
+
+  static inline size_t StrViewFindChar(StrView_t This, char Char)
+  { /* StrViewFindChar() */
+    const char *Found;
+
+    if (This.Size == 0 || (Found = memchr(This.Ptr, Char, This.Size)) == NULL)
+      return STRVIEW_NPOS;
+    return (size_t) (Found - This.Ptr);
+  } /* StrViewFindChar() */
+
+  static inline uint64_t StrViewHash(StrView_t This)
+  { /* StrViewHash() */
+    return StrViewHashSeed(This, 0);
+  } /* StrViewHash() */
+
+  static inline bool StrViewSplit(StrView_t This, char Delim,
+                                  StrView_t *Head, StrView_t *Tail)
+  { /* StrViewSplit() */
+    size_t Pos = StrViewFindChar(This, Delim);
+
+    if (Pos == STRVIEW_NPOS)
+    { /* No 'Delim'. */
+      *Head = This;
+      *Tail = StrView(This.Ptr + This.Size, 0);
+      return false;
+    } /* No 'Delim'. */
+
+    *Head = StrView(This.Ptr, Pos);
+    *Tail = StrView(This.Ptr + Pos + 1, This.Size - Pos - 1);
+    return true;
+  } /* StrViewSplit() */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif
@@ -1,8 +1,14 @@
 /******************************************************************************
  * Function definitions for our 'struct String' "class".
  *****************************************************************************/
+#include <limits.h>
+
+#include "Diag.h"
 #include "Errors.h"
 #include "String.h"
+#include "StringImpl.h"
+#include "XToStr.h"
+#include "XToStrImpl.h"
 
 /******************************************************************************
  * These would be 'private' in C++.  WARNING: Programmer beware!  We
@@ -10,6 +16,11 @@
  * interface has already checked for NULL pointer arguments, etc..  We
  * still check for errors that can occur within the function
  * (e.g.'malloc()' returning NULL, etc.) but that's all.
+ *
+ * NOTE: Buffers come from the string's allocator, 'This->Alloc' (see
+ * 'Alloc.h'), which is 'malloc()', 'realloc()', and 'free()' unless
+ * it was constructed with 'ConstructStringAlloc()'.  That's what
+ * 'malloc()' etc. mean in the comments below.
  *****************************************************************************/
 static inline bool IsLocalBuff(String_t *This)
 { /* IsLocalBuff() */
@@ -63,15 +74,15 @@ static bool MallocBuffExact(String_t *This, size_t NewSize)
    */
   if (NewSize > STRING_MIN_BUFF_SIZE)
   { /* Need to call 'malloc()' */
-    if ((NewBuff = malloc(NewSize)) == NULL)
+    if ((NewBuff = AllocMalloc(This->Alloc, NewSize)) == NULL)
     { /* Error. */
       ErrNo = errno;
-      printf("%s %s %d: malloc(%zu) failed.  %s.\n",
-             __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
+      Diag("%s %s %d: malloc(%zu) failed.  %s.\n",
+           __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
       EXIT(false);
     } /* Error. */
     if (!IsLocalBuff(This))
-      free(This->Ptr);
+      AllocFree(This->Alloc, This->Ptr, CurSize);
     This->Ptr = NewBuff;
     This->Buff.Size = NewSize;
   } /* Need to call 'malloc()' */
@@ -80,7 +91,7 @@ static bool MallocBuffExact(String_t *This, size_t NewSize)
     /* Since we're here we know the following: '(CurSize >
      * STRING_MIN_BUFF_SIZE && NewSize == STRING_MIN_BUFF_SIZE)'.
      * Therefore, we can 'free(Buff->Ptr)' without checking. */
-    free(This->Ptr);
+    AllocFree(This->Alloc, This->Ptr, CurSize);
     This->Ptr = This->Buff.Data;
   } /* Need to use 'Buff.Data'. */
   RETURN(true);
@@ -137,11 +148,11 @@ static bool ReallocBuffExact(String_t *This, size_t NewSize)
   { /* Need to call 'malloc()' or 'realloc()' depending. */
     if (IsLocalBuff(This))
     { /* Currently using the local buffer so we have to call 'malloc()'. */
-      if ((NewBuff = malloc(NewSize)) == NULL)
+      if ((NewBuff = AllocMalloc(This->Alloc, NewSize)) == NULL)
       { /* Error. */
         ErrNo = errno;
-        printf("%s %s %d: malloc(%zu) failed.  %s.\n",
-               __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
+        Diag("%s %s %d: malloc(%zu) failed.  %s.\n",
+             __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
         EXIT(false);
       } /* Error. */
 
@@ -151,11 +162,12 @@ static bool ReallocBuffExact(String_t *This, size_t NewSize)
     } /* Currently using the local buffer.  Use 'malloc()'. */
     else
     { /* Not using the local buffer. */
-      if ((NewBuff = realloc(This->Ptr, NewSize)) == NULL)
+      if ((NewBuff = AllocRealloc(This->Alloc, This->Ptr, CurSize,
+                                  NewSize)) == NULL)
       { /* Error. */
         ErrNo = errno;
-        printf("%s %s %d: realloc(%zu) failed.  %s.\n",
-               __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
+        Diag("%s %s %d: realloc(%zu) failed.  %s.\n",
+             __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
         EXIT(false);
       } /* Error. */
 
@@ -188,7 +200,7 @@ static bool ReallocBuffExact(String_t *This, size_t NewSize)
     /* Since we're here we know the following: '(CurSize >
      * STRING_MIN_BUFF_SIZE && NewSize == STRING_MIN_BUFF_SIZE)'.
      * Therefore, we can 'free(Buff->Ptr)' without checking. */
-    free(This->Ptr);
+    AllocFree(This->Alloc, This->Ptr, CurSize);
     This->Ptr = This->Buff.Data;
   } /* Need to use 'Buff.Data'. */
   RETURN(true);
@@ -256,8 +268,8 @@ static bool MallocBuff(String_t *This, size_t MinSize)
     if (!MallocBuffExact(This, NewSize))
     { /* Error. */
       ErrNo = errno;
-      printf("%s %s %d: MallocBuffExact(%zu) failed.  %s.\n",
-             __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
+      Diag("%s %s %d: MallocBuffExact(%zu) failed.  %s.\n",
+           __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
       EXIT(false);
     } /* Error. */
   } /* Grow buffer. */
@@ -281,8 +293,8 @@ static bool MallocBuff(String_t *This, size_t MinSize)
     if (!MallocBuffExact(This, NewSize))
     { /* Error. */
       ErrNo = errno;
-      printf("%s %s %d: MallocBuffExact(%zu) failed.  %s.\n",
-             __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
+      Diag("%s %s %d: MallocBuffExact(%zu) failed.  %s.\n",
+           __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
       EXIT(false);
     } /* Error. */
   } /* Shrink buffer. */
@@ -341,8 +353,8 @@ static bool ReallocBuff(String_t *This, size_t MinSize)
     if (!ReallocBuffExact(This, NewSize))
     { /* Error. */
       ErrNo = errno;
-      printf("%s %s %d: ReallocBuffExact(%zu) failed.  %s.\n",
-             __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
+      Diag("%s %s %d: ReallocBuffExact(%zu) failed.  %s.\n",
+           __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
       EXIT(false);
     } /* Error. */
   } /* Grow buffer. */
@@ -366,8 +378,8 @@ static bool ReallocBuff(String_t *This, size_t MinSize)
     if (!ReallocBuffExact(This, NewSize))
     { /* Error. */
       ErrNo = errno;
-      printf("%s %s %d: ReallocBuff(%zu) failed.  %s.\n",
-             __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
+      Diag("%s %s %d: ReallocBuff(%zu) failed.  %s.\n",
+           __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
       EXIT(false);
     } /* Error. */
   } /* Shrink buffer. */
@@ -381,6 +393,50 @@ Return:
   return _RetVal;
 } /* ReallocBuff() */
 
+/******************************************************************************
+ * Append the 'Len' characters starting at 'Src', which need not be NUL
+ * terminated, and may be part of 'This', to 'This'.  If the buffer
+ * can't be resized we return 'false' and leave 'This' unchanged.
+ * Otherwise we return 'true'.
+ *****************************************************************************/
+static bool AppendChars(String_t *This, const char *Src, size_t Len)
+{ /* AppendChars() */
+  bool _RetVal;
+  int ErrNo;
+  size_t Off;
+
+  /* As usual, we have to worry about overflow detection/prevention. */
+  if (SIZE_MAX - (This->Size + 1) < Len)
+  { /* Result would overflow. */
+    ErrNo = ERANGE;
+    EXIT(false);
+  } /* Result would overflow. */
+
+  /* Allocte a bigger buffer if we need to.  If 'Src' is part of
+   * 'This' it may move. */
+  Off = (uintptr_t) Src - (uintptr_t) This->Ptr;
+  if (!ReallocBuff(This, This->Size + Len + 1))
+  { /* Error. */
+    ErrNo = errno;
+    EXIT(false);
+  } /* Error. */
+  if (Off < This->Size)
+    Src = &This->Ptr[Off];
+
+  /* Now we know we have enough space. */
+  if (Len != 0)
+    memcpy(&This->Ptr[This->Size], Src, Len);
+  This->Size += Len;
+  This->Ptr[This->Size] = '\0';
+  RETURN(true);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* AppendChars() */
+
 /******************************************************************************
  * These would be 'public' in C++.
  *****************************************************************************/
@@ -393,9 +449,9 @@ String_t *NewString()
   if ((This = malloc(sizeof(String_t))) == NULL)
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: malloc(%zu) failed.  %s.\n",
-           __FILE__, __func__, __LINE__, sizeof(String_t),
-           StrError(ErrNo));
+    Diag("%s %s %d: malloc(%zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, sizeof(String_t),
+         StrError(ErrNo));
     EXIT(NULL);
   } /* Error. */
 
@@ -411,6 +467,32 @@ Return:
   return _RetVal;
 } /* NewString() */
 
+/* Dynamic constructor with an allocator. */
+String_t *NewStringAlloc(const Alloc_t *Alloc)
+{ /* NewStringAlloc() */
+  int ErrNo;
+  String_t *This, *_RetVal;
+
+  if ((This = AllocMalloc(Alloc, sizeof(String_t))) == NULL)
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: malloc(%zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, sizeof(String_t),
+         StrError(ErrNo));
+    EXIT(NULL);
+  } /* Error. */
+
+  /* We know this never fails if '(This != NULL)'. */
+  ConstructStringAlloc(This, Alloc);
+  RETURN(This);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* NewStringAlloc() */
+
 /* Copy construstor. */
 bool ConstructStringStr(String_t *This, const String_t *Src)
 { /* ConstructStringStr() */
@@ -420,16 +502,16 @@ bool ConstructStringStr(String_t *This, const String_t *Src)
   /* Error checking. */
   if (This == NULL)
   { /* Error. */
-    printf("%s %s %d: 'This' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
     
   if (Src == NULL)
   { /* Error. */
-    printf("%s %s %d: 'Src' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'Src' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
@@ -441,9 +523,9 @@ bool ConstructStringStr(String_t *This, const String_t *Src)
   if (!MallocBuff(This, Src->Size + 1))
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: MallocBuff(This, %zu) failed.  %s.\n",
-           __FILE__, __func__, __LINE__, Src->Size + 1,
-           StrError(ErrNo));
+    Diag("%s %s %d: MallocBuff(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, Src->Size + 1,
+         StrError(ErrNo));
     EXIT(false);
   } /* Error. */
   memcpy(This->Ptr, Src->Ptr, Src->Size + 1);
@@ -466,17 +548,17 @@ String_t *NewStringStr(const String_t *Src)
   if ((This = malloc(sizeof(String_t))) == NULL)
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: malloc(%zu) failed.  %s.\n",
-           __FILE__, __func__, __LINE__, sizeof(String_t),
-           StrError(ErrNo));
+    Diag("%s %s %d: malloc(%zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, sizeof(String_t),
+         StrError(ErrNo));
     EXIT(NULL);
   } /* Error. */
 
   if (!ConstructStringStr(This, Src))
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: StringConstuctStr() failed.  %s.\n",
-           __FILE__, __func__, __LINE__, StrError(ErrNo));
+    Diag("%s %s %d: StringConstuctStr() failed.  %s.\n",
+         __FILE__, __func__, __LINE__, StrError(ErrNo));
     EXIT(NULL);
   } /* Error. */
   RETURN(This);
@@ -498,16 +580,16 @@ bool ConstructStringCStr(String_t *This, const char *Src)
   /* Error checking. */
   if (This == NULL)
   { /* Error. */
-    printf("%s %s %d: 'This' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
 
   if (Src == NULL)
   { /* Error. */
-    printf("%s %s %d: 'Src' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'Src' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
@@ -520,8 +602,8 @@ bool ConstructStringCStr(String_t *This, const char *Src)
   if (!MallocBuff(This, SrcSize + 1))
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: MallocBuff(This, %zu) failed.  %s.\n",
-           __FILE__, __func__, __LINE__, SrcSize + 1, StrError(ErrNo));
+    Diag("%s %s %d: MallocBuff(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, SrcSize + 1, StrError(ErrNo));
     EXIT(false);
   } /* Error. */
   memcpy(This->Ptr, Src, SrcSize + 1);
@@ -544,17 +626,17 @@ String_t *NewStringCStr(const char *Src)
   if ((This = malloc(sizeof(String_t))) == NULL)
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: malloc(%zu) failed.  %s.\n",
-           __FILE__, __func__, __LINE__, sizeof(String_t),
-           StrError(ErrNo));
+    Diag("%s %s %d: malloc(%zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, sizeof(String_t),
+         StrError(ErrNo));
     EXIT(NULL);
   } /* Error. */
 
   if (!ConstructStringCStr(This, Src))
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: StringConstuctCStr() failed.  %s.\n",
-           __FILE__, __func__, __LINE__, StrError(ErrNo));
+    Diag("%s %s %d: StringConstuctCStr() failed.  %s.\n",
+         __FILE__, __func__, __LINE__, StrError(ErrNo));
     EXIT(NULL);
   } /* Error. */
   RETURN(This);
@@ -567,6 +649,80 @@ Return:
   return _RetVal;
 } /* NewStringCStr() */
 
+bool ConstructStringView(String_t *This, StrView_t View)
+{ /* ConstructStringView() */
+  int ErrNo;
+  bool Init = false, _RetVal;
+
+  /* Error checking. */
+  if (This == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    ErrNo = EFAULT;
+    EXIT(false);
+  } /* Error. */
+
+  if (View.Ptr == NULL && View.Size != 0)
+  { /* Error. */
+    Diag("%s %s %d: 'View.Ptr' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    ErrNo = EFAULT;
+    EXIT(false);
+  } /* Error. */
+
+  /* Default consstructor. This never fails if '(This != NULL)'. */
+  Init = ConstructString(This);
+
+  /* Assign 'View' as our value. */
+  if (!AppendChars(This, View.Ptr, View.Size))
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: AppendChars(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, View.Size, StrError(ErrNo));
+    EXIT(false);
+  } /* Error. */
+  RETURN(true);
+
+Exit:
+  if (Init) DestroyString(This);
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* ConstructStringView() */
+
+String_t *NewStringView(StrView_t View)
+{ /* NewStringView() */
+  int ErrNo;
+  String_t *This = NULL, *_RetVal;
+
+  if ((This = malloc(sizeof(String_t))) == NULL)
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: malloc(%zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, sizeof(String_t),
+         StrError(ErrNo));
+    EXIT(NULL);
+  } /* Error. */
+
+  if (!ConstructStringView(This, View))
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: ConstructStringView() failed.  %s.\n",
+         __FILE__, __func__, __LINE__, StrError(ErrNo));
+    EXIT(NULL);
+  } /* Error. */
+  RETURN(This);
+
+Exit:
+  free(This);
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* NewStringView() */
+
 bool ConstructStringChar(String_t *This, char Char, size_t Count)
 { /* ConstructStringChar() */
   bool Init = false, ErrNo, _RetVal;
@@ -574,8 +730,8 @@ bool ConstructStringChar(String_t *This, char Char, size_t Count)
   /* Error checking. */
   if (This == NULL)
   { /* Error. */
-    printf("%s %s %d: 'This' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
@@ -587,8 +743,8 @@ bool ConstructStringChar(String_t *This, char Char, size_t Count)
    * terminating NUL. */
   if (Count == SIZE_MAX)
   { /* Error. */
-    printf("%s %s %d: Overflow.  'Count' is SIZE_MAX.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: Overflow.  'Count' is SIZE_MAX.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = ERANGE;
     EXIT(false);
   } /* Error. */
@@ -597,8 +753,8 @@ bool ConstructStringChar(String_t *This, char Char, size_t Count)
   if (!MallocBuff(This, Count + 1))
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: 'MallocBuff(This, %zu)' failed.\n",
-           __FILE__, __func__, __LINE__, Count + 1);
+    Diag("%s %s %d: 'MallocBuff(This, %zu)' failed.\n",
+         __FILE__, __func__, __LINE__, Count + 1);
     EXIT(false);
   } /* Error. */
   /* Assign 'Char' as our value. */
@@ -625,17 +781,17 @@ String_t *NewStringChar(char Char, size_t Count)
   if ((This = malloc(sizeof(String_t))) == NULL)
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: malloc(%zu) failed.  %s.\n",
-           __FILE__, __func__, __LINE__, sizeof(String_t),
-           StrError(ErrNo));
+    Diag("%s %s %d: malloc(%zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, sizeof(String_t),
+         StrError(ErrNo));
     EXIT(NULL);
   } /* Error. */
 
   if (!ConstructStringChar(This, Char, Count))
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: ConstructStringChar(This, '%c', %zu) failed..\n",
-           __FILE__, __func__, __LINE__, Char, Count);
+    Diag("%s %s %d: ConstructStringChar(This, '%c', %zu) failed..\n",
+         __FILE__, __func__, __LINE__, Char, Count);
     EXIT(NULL);
   } /* Error. */
   RETURN(This);
@@ -653,7 +809,7 @@ void DestroyString(String_t *This)
 { /* DestroyString() */
   if (This != NULL && !IsLocalBuff(This))
   { /* Exists, and not local buffer. */
-    free(This->Ptr);
+    AllocFree(This->Alloc, This->Ptr, This->Buff.Size);
   } /* Exists, and not local buffer. */
 } /* DestroyString() */
 
@@ -665,8 +821,8 @@ bool StringReserve(String_t *This, size_t NewSize)
   /* Error checking */
   if (This == NULL)
   { /* Error. */
-    printf("%s %s %d: 'This' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
@@ -674,8 +830,8 @@ bool StringReserve(String_t *This, size_t NewSize)
   if (!ReallocBuff(This, NewSize))
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: ReallocBuff(This, %zu) failed.  %s.\n",
-           __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
+    Diag("%s %s %d: ReallocBuff(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, NewSize, StrError(ErrNo));
     EXIT(false);
   } /* Error. */
   RETURN(true);
@@ -695,8 +851,8 @@ bool StringResizeToFit(String_t *This)
   /* Error checking. */
   if (This == NULL)
   { /* Error. */
-    printf("%s %s %d: 'This' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
@@ -705,8 +861,8 @@ bool StringResizeToFit(String_t *This)
   if (!ReallocBuffExact(This, This->Size + 1))
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: ReallocBuff(This, %zu) failed.  %s.\n",
-           __FILE__, __func__, __LINE__, This->Size + 1, StrError(ErrNo));
+    Diag("%s %s %d: ReallocBuff(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, This->Size + 1, StrError(ErrNo));
     EXIT(false);
   } /* Error. */
   RETURN(true);
@@ -731,16 +887,16 @@ bool StringSetCStr(String_t *This, const char *Src)
   /* Error checking. */
   if (This == NULL)
   { /* Error. */
-    printf("%s %s %d: 'This' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
 
   if (Src == NULL)
   { /* Error. */
-    printf("%s %s %d: 'Src' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'Src' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
@@ -752,8 +908,8 @@ bool StringSetCStr(String_t *This, const char *Src)
   if (!MallocBuff(This, SrcSize + 1))
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: MallocBuff(This, %zu) failed.  %s.\n",
-           __FILE__, __func__, __LINE__, SrcSize + 1, StrError(ErrNo));
+    Diag("%s %s %d: MallocBuff(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, SrcSize + 1, StrError(ErrNo));
     EXIT(false);
   } /* Error. */
 
@@ -781,16 +937,16 @@ bool StringSetStr(String_t *This, const String_t *Src)
   /* Error checking. */
   if (This == NULL)
   { /* Error. */
-    printf("%s %s %d: 'This' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
 
   if (Src == NULL)
   { /* Error. */
-    printf("%s %s %d: 'Src' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'Src' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
@@ -799,8 +955,8 @@ bool StringSetStr(String_t *This, const String_t *Src)
   if (!MallocBuff(This, Src->Size + 1))
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: MallocBuff(This, %zu) failed.  %s.\n",
-           __FILE__, __func__, __LINE__, Src->Size + 1, StrError(ErrNo));
+    Diag("%s %s %d: MallocBuff(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, Src->Size + 1, StrError(ErrNo));
     EXIT(false);
   } /* Error. */
 
@@ -830,16 +986,16 @@ bool StringAppendCStr(String_t *This, const char *Src)
   /* Error checking. */
   if (This == NULL)
   { /* Error. */
-    printf("%s %s %d: 'This' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
 
   if (Src == NULL)
   { /* Error. */
-    printf("%s %s %d: 'Src' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'Src' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
@@ -849,8 +1005,8 @@ bool StringAppendCStr(String_t *This, const char *Src)
   SrcSize = strlen(Src);
   if (SIZE_MAX - (This->Size + 1) < SrcSize)
   { /* Result would overflow. */
-    printf("%s %s %d: Size overflow.  This->Size: %zu  SrcSize: %zu.\n",
-           __FILE__, __func__, __LINE__, This->Size, SrcSize);
+    Diag("%s %s %d: Size overflow.  This->Size: %zu  SrcSize: %zu.\n",
+         __FILE__, __func__, __LINE__, This->Size, SrcSize);
     ErrNo = ERANGE;
     EXIT(false);
   } /* Result would overflow. */
@@ -860,8 +1016,8 @@ bool StringAppendCStr(String_t *This, const char *Src)
   if (!ReallocBuff(This, NewSize + 1))
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: MallocBuff(This, %zu) failed.  %s.\n",
-           __FILE__, __func__, __LINE__, SrcSize + 1, StrError(ErrNo));
+    Diag("%s %s %d: MallocBuff(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, SrcSize + 1, StrError(ErrNo));
     EXIT(false);
   } /* Error. */
 
@@ -891,16 +1047,16 @@ bool StringAppendStr(String_t *This, const String_t *Src)
   /* Error checking. */
   if (This == NULL)
   { /* Error. */
-    printf("%s %s %d: 'This' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
 
   if (Src == NULL)
   { /* Error. */
-    printf("%s %s %d: 'Src' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'Src' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(false);
   } /* Error. */
@@ -909,8 +1065,8 @@ bool StringAppendStr(String_t *This, const String_t *Src)
    * detection/prevention. */
   if (SIZE_MAX - (This->Size + 1) < Src->Size)
   { /* Result would overflow. */
-    printf("%s %s %d: Size overflow.  This->Size: %zu  Src->Size: %zu.\n",
-           __FILE__, __func__, __LINE__, This->Size, Src->Size);
+    Diag("%s %s %d: Size overflow.  This->Size: %zu  Src->Size: %zu.\n",
+         __FILE__, __func__, __LINE__, This->Size, Src->Size);
     ErrNo = ERANGE;
     EXIT(false);
   } /* Result would overflow. */
@@ -920,8 +1076,8 @@ bool StringAppendStr(String_t *This, const String_t *Src)
   if (!ReallocBuff(This, NewSize + 1))
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: MallocBuff(This, %zu) failed.  %s.\n",
-           __FILE__, __func__, __LINE__, Src->Size + 1, StrError(ErrNo));
+    Diag("%s %s %d: MallocBuff(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, Src->Size + 1, StrError(ErrNo));
     EXIT(false);
   } /* Error. */
 
@@ -937,6 +1093,309 @@ Return:
   return _RetVal;
 } /* StringAppendStr() */
 
+/*
+ * Set 'This' to the characters in 'View', which may be part of 'This'.
+ * Returns 'true' if successful, 'false' otherwise.  On error, 'errno'
+ * is set to non-zero (probably ENOMEM).
+ */
+bool StringSetView(String_t *This, StrView_t View)
+{ /* StringSetView() */
+  bool _RetVal;
+  int ErrNo;
+
+  /* Error checking. */
+  if (This == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    ErrNo = EFAULT;
+    EXIT(false);
+  } /* Error. */
+
+  if (View.Ptr == NULL && View.Size != 0)
+  { /* Error. */
+    Diag("%s %s %d: 'View.Ptr' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    ErrNo = EFAULT;
+    EXIT(false);
+  } /* Error. */
+
+  /* A view of part of 'This' already fits, and mustn't be freed by
+   * shrinking the buffer. */
+  if ((uintptr_t) View.Ptr - (uintptr_t) This->Ptr < This->Size)
+  { /* Part of 'This'. */
+    memmove(This->Ptr, View.Ptr, View.Size);
+    This->Size = View.Size;
+    This->Ptr[This->Size] = '\0';
+    RETURN(true);
+  } /* Part of 'This'. */
+
+  /* Allocte a bigger buffer if we need to. */
+  if (!MallocBuff(This, View.Size + 1))
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: MallocBuff(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, View.Size + 1, StrError(ErrNo));
+    EXIT(false);
+  } /* Error. */
+
+  /* Now we know we have enough space. */
+  if (View.Size != 0)
+    memcpy(This->Ptr, View.Ptr, View.Size);
+  This->Size = View.Size;
+  This->Ptr[This->Size] = '\0';
+  RETURN(true);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* StringSetView() */
+
+/*
+ * Append the characters in 'View', which may be part of 'This', to
+ * 'This'.  Returns 'true' if successful, 'false' otherwise.  On error,
+ * 'errno' is set to non-zero (probably ENOMEM).
+ */
+bool StringAppendView(String_t *This, StrView_t View)
+{ /* StringAppendView() */
+  bool _RetVal;
+  int ErrNo;
+
+  /* Error checking. */
+  if (This == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    ErrNo = EFAULT;
+    EXIT(false);
+  } /* Error. */
+
+  if (View.Ptr == NULL && View.Size != 0)
+  { /* Error. */
+    Diag("%s %s %d: 'View.Ptr' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    ErrNo = EFAULT;
+    EXIT(false);
+  } /* Error. */
+
+  if (!AppendChars(This, View.Ptr, View.Size))
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: AppendChars(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, View.Size, StrError(ErrNo));
+    EXIT(false);
+  } /* Error. */
+  RETURN(true);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* StringAppendView() */
+
+/*
+ * Append 'Val', converted to a string in base 'Base' as by
+ * 'UMaxToStr()' (see 'XToStr.h'), to 'This'.  Returns 'true' if
+ * successful, 'false' otherwise.  On error, 'errno' is set to non-zero
+ * (EDOM for a bad 'Base', otherwise probably ENOMEM).
+ */
+bool StringAppendUMax(String_t *This, uintmax_t Val, int Base)
+{ /* StringAppendUMax() */
+  bool _RetVal;
+  int ErrNo;
+  char Temp[XTOSTR_BUFF_SIZE], *End = &Temp[sizeof(Temp)], *Str;
+
+  /* Error checking. */
+  if (This == NULL)
+  { /* Error. */
+    ErrNo = EFAULT;
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    EXIT(false);
+  } /* Error. */
+
+  if (Base < 2 || Base > 36)
+  { /* Error. */
+    ErrNo = EDOM;
+    Diag("%s %s %d: 'Base' is %d.\n",
+         __FILE__, __func__, __LINE__, Base);
+    EXIT(false);
+  } /* Error. */
+
+  Str = XToStrUMax(Val, (unsigned) Base, End);
+  if (!AppendChars(This, Str, (size_t) (End - Str)))
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: AppendChars(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, (size_t) (End - Str),
+         StrError(ErrNo));
+    EXIT(false);
+  } /* Error. */
+  RETURN(true);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* StringAppendUMax() */
+
+/*
+ * Append 'Val', converted to a string in base 'Base' as by
+ * 'IMaxToStr()' (see 'XToStr.h'), to 'This'.  Returns 'true' if
+ * successful, 'false' otherwise.  On error, 'errno' is set to non-zero
+ * (EDOM for a bad 'Base', otherwise probably ENOMEM).
+ */
+bool StringAppendIMax(String_t *This, intmax_t Val, int Base)
+{ /* StringAppendIMax() */
+  bool _RetVal;
+  int ErrNo;
+  char Temp[XTOSTR_BUFF_SIZE], *End = &Temp[sizeof(Temp)], *Str;
+
+  /* Error checking. */
+  if (This == NULL)
+  { /* Error. */
+    ErrNo = EFAULT;
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    EXIT(false);
+  } /* Error. */
+
+  if (Base < 2 || Base > 36)
+  { /* Error. */
+    ErrNo = EDOM;
+    Diag("%s %s %d: 'Base' is %d.\n",
+         __FILE__, __func__, __LINE__, Base);
+    EXIT(false);
+  } /* Error. */
+
+  /* Negating in 'uintmax_t' is fine for INTMAX_MIN too. */
+  Str = XToStrUMax(Val < 0 ? -(uintmax_t) Val : (uintmax_t) Val,
+                   (unsigned) Base, End);
+  if (Val < 0)
+    *--Str = '-';
+  if (!AppendChars(This, Str, (size_t) (End - Str)))
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: AppendChars(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, (size_t) (End - Str),
+         StrError(ErrNo));
+    EXIT(false);
+  } /* Error. */
+  RETURN(true);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* StringAppendIMax() */
+
+/*
+ * Append 'Val' to 'This' as the shortest string that reads back as
+ * exactly 'Val', as by 'DToStr()' (see 'XToStr.h').  The digits are
+ * written straight into the buffer, which is grown (at most once)
+ * first if it might not have room for the longest possible result.
+ * Returns 'true' if successful, 'false' otherwise.  On error, 'errno'
+ * is set to non-zero (probably ENOMEM).
+ */
+bool StringAppendDouble(String_t *This, double Val)
+{ /* StringAppendDouble() */
+  bool _RetVal;
+  int ErrNo;
+
+  /* Error checking. */
+  if (This == NULL)
+  { /* Error. */
+    ErrNo = EFAULT;
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    EXIT(false);
+  } /* Error. */
+
+  /* As usual, we have to worry about overflow detection/prevention. */
+  if (SIZE_MAX - (This->Size + 1) < XTOSTR_FLT_MAX)
+  { /* Result might overflow. */
+    ErrNo = ERANGE;
+    Diag("%s %s %d: Size overflow.  This->Size: %zu.\n",
+         __FILE__, __func__, __LINE__, This->Size);
+    EXIT(false);
+  } /* Result might overflow. */
+
+  /* Allocte a bigger buffer if we need to. */
+  if (!ReallocBuff(This, This->Size + XTOSTR_FLT_MAX + 1))
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: ReallocBuff(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, This->Size + XTOSTR_FLT_MAX + 1,
+         StrError(ErrNo));
+    EXIT(false);
+  } /* Error. */
+
+  /* Now we know we have enough space. */
+  This->Size += XToStrD(Val, &This->Ptr[This->Size]);
+  This->Ptr[This->Size] = '\0';
+  RETURN(true);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* StringAppendDouble() */
+
+/*
+ * Like 'StringAppendDouble()' but for a 'float', i.e. as by 'FToStr()'
+ * so the result reads back as 'Val' with 'StrToF()'.
+ */
+bool StringAppendFloat(String_t *This, float Val)
+{ /* StringAppendFloat() */
+  bool _RetVal;
+  int ErrNo;
+
+  /* Error checking. */
+  if (This == NULL)
+  { /* Error. */
+    ErrNo = EFAULT;
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
+    EXIT(false);
+  } /* Error. */
+
+  /* As usual, we have to worry about overflow detection/prevention. */
+  if (SIZE_MAX - (This->Size + 1) < XTOSTR_FLT_MAX)
+  { /* Result might overflow. */
+    ErrNo = ERANGE;
+    Diag("%s %s %d: Size overflow.  This->Size: %zu.\n",
+         __FILE__, __func__, __LINE__, This->Size);
+    EXIT(false);
+  } /* Result might overflow. */
+
+  /* Allocte a bigger buffer if we need to. */
+  if (!ReallocBuff(This, This->Size + XTOSTR_FLT_MAX + 1))
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: ReallocBuff(This, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, This->Size + XTOSTR_FLT_MAX + 1,
+         StrError(ErrNo));
+    EXIT(false);
+  } /* Error. */
+
+  /* Now we know we have enough space. */
+  This->Size += XToStrF(Val, &This->Ptr[This->Size]);
+  This->Ptr[This->Size] = '\0';
+  RETURN(true);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* StringAppendFloat() */
+
 /*
  * Create a new 'String_t' containing 'Str' concatenated with
  * 'CStr'.  Returns the new 'struct Strng' if successful, NULL
@@ -951,14 +1410,14 @@ String_t *StringConcatCStr(String_t *Str, const char *CStr)
   /* Error checking. */
   if (Str == NULL)
   { /* Error. */
-    printf("%s %s %d: 'Str' is NULL.\n", __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'Str' is NULL.\n", __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(NULL);
   } /* Error. */
 
   if (CStr == NULL)
   { /* Error. */
-    printf("%s %s %d: 'CStr' is NULL.\n", __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'CStr' is NULL.\n", __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(NULL);
   } /* Error. */
@@ -968,8 +1427,8 @@ String_t *StringConcatCStr(String_t *Str, const char *CStr)
   CStrSize = strlen(CStr);
   if (SIZE_MAX - (Str->Size + 1) < CStrSize)
   { /* Result would overflow. */
-    printf("%s %s %d: Size overflow.  Str->Size: %zu  CStrSize: %zu.\n",
-           __FILE__, __func__, __LINE__, Str->Size, CStrSize);
+    Diag("%s %s %d: Size overflow.  Str->Size: %zu  CStrSize: %zu.\n",
+         __FILE__, __func__, __LINE__, Str->Size, CStrSize);
     ErrNo = ERANGE;
     EXIT(NULL);
   } /* Result would overflow. */
@@ -979,8 +1438,8 @@ String_t *StringConcatCStr(String_t *Str, const char *CStr)
   if ((NewStr = NewString()) == NULL)
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: StringNew() failed.  %s.\n",
-           __FILE__, __func__, __LINE__, StrError(ErrNo));
+    Diag("%s %s %d: StringNew() failed.  %s.\n",
+         __FILE__, __func__, __LINE__, StrError(ErrNo));
     EXIT(NULL);
   } /* Error. */
   
@@ -988,8 +1447,8 @@ String_t *StringConcatCStr(String_t *Str, const char *CStr)
   if (!MallocBuff(NewStr, NewSize + 1))
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: MallocBuff(Str, %zu) failed.  %s.\n",
-           __FILE__, __func__, __LINE__, NewSize + 1, StrError(ErrNo));
+    Diag("%s %s %d: MallocBuff(Str, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, NewSize + 1, StrError(ErrNo));
     EXIT(NULL);
   } /* Error. */
 
@@ -1021,16 +1480,16 @@ String_t *StringConcatStr(String_t *Str0, const String_t *Str1)
   /* Error checking. */
   if (Str0 == NULL)
   { /* Error. */
-    printf("%s %s %d: 'Str0' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'Str0' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(NULL);
   } /* Error. */
 
   if (Str1 == NULL)
   { /* Error. */
-    printf("%s %s %d: 'Str1' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'Str1' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(NULL);
   } /* Error. */
@@ -1039,8 +1498,8 @@ String_t *StringConcatStr(String_t *Str0, const String_t *Str1)
    * detection/prevention. */
   if (SIZE_MAX - (Str0->Size + 1) < Str1->Size)
   { /* Result would overflow. */
-    printf("%s %s %d: Size overflow.  Str0->Size: %zu  Str1Size: %zu.\n",
-           __FILE__, __func__, __LINE__, Str0->Size, Str1->Size);
+    Diag("%s %s %d: Size overflow.  Str0->Size: %zu  Str1Size: %zu.\n",
+         __FILE__, __func__, __LINE__, Str0->Size, Str1->Size);
     ErrNo = ERANGE;
     EXIT(NULL);
   } /* Result would overflow. */
@@ -1050,8 +1509,8 @@ String_t *StringConcatStr(String_t *Str0, const String_t *Str1)
   if ((NewStr = NewString()) == NULL)
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: NewString() failed.  %s.\n",
-           __FILE__, __func__, __LINE__, StrError(ErrNo));
+    Diag("%s %s %d: NewString() failed.  %s.\n",
+         __FILE__, __func__, __LINE__, StrError(ErrNo));
     EXIT(NULL);
   } /* Error. */
   
@@ -1059,8 +1518,8 @@ String_t *StringConcatStr(String_t *Str0, const String_t *Str1)
   if (!MallocBuff(NewStr, NewSize + 1))
   { /* Error. */
     ErrNo = errno;
-    printf("%s %s %d: MallocBuff(Str0, %zu) failed.  %s.\n",
-           __FILE__, __func__, __LINE__, NewSize + 1, StrError(ErrNo));
+    Diag("%s %s %d: MallocBuff(Str0, %zu) failed.  %s.\n",
+         __FILE__, __func__, __LINE__, NewSize + 1, StrError(ErrNo));
     EXIT(NULL);
   } /* Error. */
 
@@ -1078,94 +1537,59 @@ Return:
   return _RetVal;
 } /* StringConcatStr() */
 
-/* Analogous to sprintf(). */
+/* Analogous to sprintf().  The output is written straight into the
+ * buffer, growing it as required, in a single pass over 'Fmt' (see
+ * 'StringVFormat()' in StringFmt.c). */
 int StringPrintf(String_t *This, const char *Fmt, ...)
 { /* StringPrintf() */
-  int FullSize, NewFullSize, _RetVal, ErrNo;
-  size_t CurSize;
+  int _RetVal, ErrNo;
   va_list ap;
+  bool Ok;
 
   /* Error checking. */
   if (This == NULL)
   { /* Error. */
-    printf("%s %s %d: 'This' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(EOF);
   } /* Error. */
 
   if (Fmt == NULL)
   { /* Error. */
-    printf("%s %s %d: 'Fmt' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'Fmt' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(EOF);
   } /* Error. */
 
-  CurSize = BuffSize(This);
-  
+  StringClear(This);
+
   va_start(ap, Fmt);
-  FullSize = vsnprintf(This->Ptr, CurSize, Fmt, ap);
+  Ok = StringVFormat(This, Fmt, ap);
   va_end(ap);
 
-  if (FullSize < 0)
-  { /* Error (other than buffer overflow). */
+  if (!Ok)
+  { /* Error. */
     ErrNo = errno;
-    
+
     /* We dunno what state the string is in so we clear it. */
     StringClear(This);
 
-    printf("%s %s %d: vsnprint(This->Ptr, %zu, Fmt, ap) failed.  %s.\n",
-           __FILE__,  __func__, __LINE__, CurSize, StrError(ErrNo));
-    EXIT(FullSize);
-  } /* Error (other than buffer overflow). */
-  
-  if (FullSize >= CurSize)
-  { /* Ran out off space. */
-    /* Make 'This' is consistent. */
-    This->Ptr[CurSize-1] = '\0';
-
-    /* Resize the buffer. */
-    if (!MallocBuff(This, FullSize + 1))
-    { /* Error. */
-      ErrNo = errno;
-      printf("%s %s %d: MallocBuff(This, %d) failed.  %s.\n",
-             __FILE__,  __func__, __LINE__, FullSize + 1, StrError(ErrNo));
-      EXIT(EOF);
-    } /* Error. */
-
-    /* Try with our new buffer. */
-    va_start(ap, Fmt);
-    NewFullSize = vsnprintf(This->Ptr, BuffSize(This), Fmt, ap);
-    va_end(ap);
+    Diag("%s %s %d: StringVFormat(This, Fmt, ap) failed.  %s.\n",
+         __FILE__,  __func__, __LINE__, StrError(ErrNo));
+    EXIT(EOF);
+  } /* Error. */
 
-    if (NewFullSize < 0)
-    { /* Error (other than buffer overflow). */
-      ErrNo = errno;
-      
-      /* We dunno what state the string is in so we clear it. */
-      StringClear(This);
-
-      printf("%s %s %d: vsnprint(This->Ptr, %zu, Fmt, ap) failed.  %s.\n",
-             __FILE__,  __func__, __LINE__, CurSize, StrError(ErrNo));
-      EXIT(NewFullSize);
-    } /* Error (other than buffer overflow). */
-
-    if (NewFullSize != FullSize)
-    { /* Error.  This should never happen! */
-      /* Fix string. */
-      This->Ptr[BuffSize(This)-1] = '\0';
-      
-      printf("%s %s %d: Size returned by 'vsnprintf(This->Ptr, %zu, Fmt, ap)'"
-             " changed.  Was: %d  Is: %d"
-             "  This should never happen!\n", __FILE__, __func__, __LINE__,
-             BuffSize(This), FullSize, NewFullSize);
-      ErrNo = ENOMEM;
-      EXIT(EOF);
-    } /* Error.  This should never happen! */
-  } /* Ran out off space. */
-  This->Size = FullSize;
-  RETURN(FullSize);
+  if (This->Size > INT_MAX)
+  { /* Error.  Too long to return. */
+    StringClear(This);
+    Diag("%s %s %d: Result too long for an 'int'.\n",
+         __FILE__,  __func__, __LINE__);
+    ErrNo = EOVERFLOW;
+    EXIT(EOF);
+  } /* Error.  Too long to return. */
+  RETURN((int) This->Size);
 
 Exit:
   errno = ErrNo;
@@ -1178,100 +1602,157 @@ Return:
  * 'This'. */
 int StringStreamf(String_t *This, const char *Fmt, ...)
 { /* StringStreamf() */
-  int FullSize, NewFullSize, ErrNo, _RetVal;
-  size_t CurSize;
+  int ErrNo, _RetVal;
+  size_t OldSize;
   va_list ap;
+  bool Ok;
 
   /* Error checking. */
   if (This == NULL)
   { /* Error. */
-    printf("%s %s %d: 'This' is NULL.\n", __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'This' is NULL.\n", __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(EOF);
   } /* Error. */
 
   if (Fmt == NULL)
   { /* Error. */
-    printf("%s %s %d: 'Fmt' is NULL.\n", __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: 'Fmt' is NULL.\n", __FILE__, __func__, __LINE__);
     ErrNo = EFAULT;
     EXIT(EOF);
   } /* Error. */
 
-  CurSize = BuffSize(This);
-  
+  OldSize = This->Size;
+
   va_start(ap, Fmt);
-  FullSize = vsnprintf(&This->Ptr[This->Size], CurSize - This->Size, Fmt, ap);
+  Ok = StringVFormat(This, Fmt, ap);
   va_end(ap);
 
-  if (FullSize < 0)
-  { /* Error (other than buffer overflow). */
+  if (!Ok)
+  { /* Error. */
     ErrNo = errno;
-    
+
     /* We dunno what happened so we return things to their previous state. */
+    This->Size = OldSize;
     This->Ptr[This->Size] = '\0';
 
-    printf("%s %s %d: 'vsnprint(&This->Ptr[%zu], %zu, Fmt, ap)' failed.  %s.\n",
-           __FILE__,  __func__, __LINE__, This->Size, CurSize - This->Size,
-           StrError(ErrNo));
-    EXIT(FullSize);
-  } /* Error (other than buffer overflow). */
-
-  /* Add size of existing contents. */
-  FullSize += This->Size;
+    Diag("%s %s %d: StringVFormat(This, Fmt, ap) failed.  %s.\n",
+         __FILE__,  __func__, __LINE__, StrError(ErrNo));
+    EXIT(EOF);
+  } /* Error. */
 
-  /* See whether we overflowed our current buffer. */
-  if (FullSize >= CurSize)
-  { /* Ran out off space. */
-    /* Restore buffer to previous state. */
+  if (This->Size > INT_MAX)
+  { /* Error.  Too long to return. */
+    This->Size = OldSize;
     This->Ptr[This->Size] = '\0';
+    Diag("%s %s %d: Result too long for an 'int'.\n",
+         __FILE__,  __func__, __LINE__);
+    ErrNo = EOVERFLOW;
+    EXIT(EOF);
+  } /* Error.  Too long to return. */
+  RETURN((int) This->Size);
 
-    /* Resize the buffer. */
-    if (!ReallocBuff(This, FullSize + 1))
-    { /* Error. */
-      ErrNo = errno;
-      printf("%s %s %d: ReallocBuff(This, %d) failed.  %s.\n",
-             __FILE__,  __func__, __LINE__, FullSize + 1, StrError(ErrNo));
-      EXIT(EOF);
-    } /* Error. */
+Exit:
+  errno = ErrNo;
 
-    /* Try with our new buffer. */
-    va_start(ap, Fmt);
-    NewFullSize = vsnprintf(&This->Ptr[This->Size],
-                            BuffSize(This) - This->Size, Fmt, ap);
-    va_end(ap);
+Return:
+  return _RetVal;
+} /* StringStreamf() */
 
-    if (NewFullSize < 0)
-    { /* Error (other than buffer overflow). */
-      ErrNo = errno;
-      
-      /* Restore string to previous state. */
-      This->Ptr[This->Size] = '\0';
-
-      printf("%s %s %d: 'vsnprint(This->Ptr, %zu, Fmt, ap)' failed.  %s.\n",
-             __FILE__,  __func__, __LINE__, CurSize, StrError(ErrNo));
-      EXIT(NewFullSize);
-    } /* Error (other than buffer overflow). */
-    NewFullSize += This->Size;
-    
-    if (NewFullSize != FullSize)
-    { /* Error.  This should never happen! */
-      /* Restore string to previous state. */
-      This->Ptr[This->Size] = '\0';
-      
-      printf("%s %s %d: Size returned by 'vsnprintf(This->Ptr, %zu, Fmt, ap)'"
-             " changed.  Was: %d  Is: %d"
-             "  This should never happen!\n", __FILE__, __func__, __LINE__,
-             BuffSize(This) - This->Size, FullSize, NewFullSize);
-      ErrNo = ENOMEM;
-      EXIT(EOF);
-    } /* Error.  This should never happen! */
-  } /* Ran out off space. */
-  This->Size = FullSize;
-  RETURN(FullSize);
+/* Like 'StringPrintf()' but with a compiled format. */
+int StringPrintFmt(String_t *This, const StringFmt_t *Fmt, ...)
+{ /* StringPrintFmt() */
+  int _RetVal, ErrNo;
+  va_list ap;
+  bool Ok;
+
+  /* Error checking. */
+  if (This == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'This' is NULL.\n", __FILE__, __func__, __LINE__);
+    ErrNo = EFAULT;
+    EXIT(EOF);
+  } /* Error. */
+
+  if (Fmt == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'Fmt' is NULL.\n", __FILE__, __func__, __LINE__);
+    ErrNo = EFAULT;
+    EXIT(EOF);
+  } /* Error. */
+
+  StringClear(This);
+
+  va_start(ap, Fmt);
+  Ok = StringVFormatFmt(This, Fmt, ap);
+  va_end(ap);
+
+  if (!Ok || This->Size > INT_MAX)
+  { /* Error. */
+    ErrNo = (Ok ? EOVERFLOW : errno);
+
+    /* We dunno what state the string is in so we clear it. */
+    StringClear(This);
+
+    Diag("%s %s %d: StringVFormatFmt(This, Fmt, ap) failed.  %s.\n",
+         __FILE__,  __func__, __LINE__, StrError(ErrNo));
+    EXIT(EOF);
+  } /* Error. */
+  RETURN((int) This->Size);
 
 Exit:
   errno = ErrNo;
 
 Return:
   return _RetVal;
-} /* StringStreamf() */
+} /* StringPrintFmt() */
+
+/* Like 'StringStreamf()' but with a compiled format. */
+int StringStreamFmt(String_t *This, const StringFmt_t *Fmt, ...)
+{ /* StringStreamFmt() */
+  int _RetVal, ErrNo;
+  size_t OldSize;
+  va_list ap;
+  bool Ok;
+
+  /* Error checking. */
+  if (This == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'This' is NULL.\n", __FILE__, __func__, __LINE__);
+    ErrNo = EFAULT;
+    EXIT(EOF);
+  } /* Error. */
+
+  if (Fmt == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'Fmt' is NULL.\n", __FILE__, __func__, __LINE__);
+    ErrNo = EFAULT;
+    EXIT(EOF);
+  } /* Error. */
+
+  OldSize = This->Size;
+
+  va_start(ap, Fmt);
+  Ok = StringVFormatFmt(This, Fmt, ap);
+  va_end(ap);
+
+  if (!Ok || This->Size > INT_MAX)
+  { /* Error. */
+    ErrNo = (Ok ? EOVERFLOW : errno);
+
+    /* Return things to their previous state. */
+    This->Size = OldSize;
+    This->Ptr[This->Size] = '\0';
+
+    Diag("%s %s %d: StringVFormatFmt(This, Fmt, ap) failed.  %s.\n",
+         __FILE__,  __func__, __LINE__, StrError(ErrNo));
+    EXIT(EOF);
+  } /* Error. */
+  RETURN((int) This->Size);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* StringStreamFmt() */
@@ -24,6 +24,10 @@ extern "C" {
 #include <stdlib.h>
 #include <string.h>
 
+#include <Alloc.h>
+#include <Diag.h>
+#include <StrView.h>
+
 /******************************************************************************
  * The 'struct' that holds the data for our 'class'.
  *****************************************************************************/
@@ -52,6 +56,11 @@ struct String
 
   /* Pointer to the string/buffer. */
   char *Ptr;
+
+  /* Where a buffer that isn't 'Buff.Data' comes from, NULL for
+   * 'malloc()' (see 'Alloc.h').  Set by the constructor and never
+   * changed. */
+  const Alloc_t *Alloc;
 }; /* String */
 typedef struct String String_t;
 
@@ -74,8 +83,8 @@ static inline bool ConstructString(String_t *This)
 #ifndef NDEBUG
   if (This == NULL)
   { /* Error. */
-    printf("%s %s %d: Internal error.  'This' is NULL.\n",
-           __FILE__, __func__, __LINE__);
+    Diag("%s %s %d: Internal error.  'This' is NULL.\n",
+         __FILE__, __func__, __LINE__);
     errno = EFAULT;
     return false;
   } /* Error. */
@@ -84,11 +93,29 @@ static inline bool ConstructString(String_t *This)
   This->Ptr = This->Buff.Data;
   This->Ptr[0] = '\0';
   This->Size = 0;
+  This->Alloc = NULL;
 
   return true;
 } /* ConstructString() */
 extern String_t *NewString();
 
+/* Like the default constructor but the buffer, if it outgrows
+ * 'Buff.Data', is allocated from 'Alloc' (see 'Alloc.h') instead of
+ * with 'malloc()'.  'Alloc' must outlive the string.  Strings copied or
+ * concatenated from this one use 'malloc()' unless they too were
+ * constructed with an allocator.  'NewStringAlloc()' gets the
+ * 'String_t' itself from 'Alloc' too, and 'DeleteString()' gives it
+ * back. */
+static inline bool ConstructStringAlloc(String_t *This, const Alloc_t *Alloc)
+{ /* ConstructStringAlloc() */
+  if (!ConstructString(This))
+    return false;
+
+  This->Alloc = Alloc;
+  return true;
+} /* ConstructStringAlloc() */
+extern String_t *NewStringAlloc(const Alloc_t *Alloc);
+
 /* Copy construstor. */
 extern bool ConstructStringStr(String_t *This, const String_t *Src);
 extern String_t *NewStringStr(const String_t *Src);
@@ -97,6 +124,10 @@ extern String_t *NewStringStr(const String_t *Src);
 extern bool ConstructStringCStr(String_t *This, const char *Src);
 extern String_t *NewStringCStr(const char *Src);
 
+/* Construct a 'String_t' from a view (see 'StrView.h'). */
+extern bool ConstructStringView(String_t *This, StrView_t View);
+extern String_t *NewStringView(StrView_t View);
+
 /* Construct a 'String_t' containing 'Count' repetitions of 'Char'. */
 extern bool ConstructStringChar(String_t *This, char Char, size_t Count);
 extern String_t *NewStringChar(char Char, size_t Count);
@@ -108,7 +139,7 @@ static inline void DeleteString(String_t *This)
   if (This != NULL)
   { /* Exists. */
     DestroyString(This);
-    free(This);
+    AllocFree(This->Alloc, This, sizeof(*This));
   } /* Exists. */
 } /* DeleteString() */
 
@@ -146,6 +177,158 @@ static inline const char *StringGetCStr(String_t *This) {
   return This->Ptr;
 }
 
+/* A view of the current contents (see 'StrView.h'), or of up to 'Len'
+ * characters from 'Pos', without copying anything.  WARNING: As for
+ * 'StringGetCStr()'! */
+static inline StrView_t StringView(const String_t *This)
+{ /* StringView() */
+  return StrView(This->Ptr, This->Size);
+} /* StringView() */
+
+static inline StrView_t StringSubView(const String_t *This, size_t Pos,
+                                      size_t Len)
+{ /* StringSubView() */
+  return StrViewSub(StringView(This), Pos, Len);
+} /* StringSubView() */
+
+/* Compare with a view, as 'strcmp()' would. */
+static inline int StringCompareView(const String_t *This, StrView_t View)
+{ /* StringCompareView() */
+  return StrViewCompare(StringView(This), View);
+} /* StringCompareView() */
+
+/* Compare two strings, as 'strcmp()' would but with 'Size' bounding
+ * the 'memcmp()', and for equality, which checks the sizes before
+ * looking at a single character. */
+static inline int StringCompare(const String_t *This, const String_t *That)
+{ /* StringCompare() */
+  if (This == That)
+    return 0;
+  return StrViewCompare(StringView(This), StringView(That));
+} /* StringCompare() */
+
+static inline bool StringEqual(const String_t *This, const String_t *That)
+{ /* StringEqual() */
+  if (This->Size != That->Size)
+    return false;
+  return (This == That || This->Size == 0 ||
+          memcmp(This->Ptr, That->Ptr, This->Size) == 0);
+} /* StringEqual() */
+
+/* The hash of the contents (see 'StrViewHash()'), for use as a hash
+ * table key. */
+static inline uint64_t StringHash(const String_t *This)
+{ /* StringHash() */
+  return StrViewHash(StringView(This));
+} /* StringHash() */
+
+/* A string with its hash kept alongside it, for a key that's looked up
+ * (or moved to a bigger table) over and over, so it's only hashed once.
+ * Only strings wrapped in one pay for the hash.  'StringKeyHash()'
+ * works it out the first time it's asked.  Anything that changes 'Str'
+ * (including through 'Str.Ptr') must then call 'StringKeyChanged()'.
+ * 'StringKeyEqual()' checks the hashes before comparing any
+ * characters. */
+typedef struct StringKey
+{ /* StringKey */
+  String_t Str;
+  uint64_t Hash;                /* 0 until it's been worked out. */
+} StringKey_t; /* StringKey */
+
+static inline uint64_t StringKeyHash(StringKey_t *This)
+{ /* StringKeyHash() */
+  if (This->Hash == 0)
+    This->Hash = StringHash(&This->Str);
+  return This->Hash;
+} /* StringKeyHash() */
+
+static inline void StringKeyChanged(StringKey_t *This)
+{ /* StringKeyChanged() */
+  This->Hash = 0;
+} /* StringKeyChanged() */
+
+static inline bool StringKeyEqual(StringKey_t *This, StringKey_t *That)
+{ /* StringKeyEqual() */
+  return (This == That || (StringKeyHash(This) == StringKeyHash(That) &&
+                           StringEqual(&This->Str, &That->Str)));
+} /* StringKeyEqual() */
+
+/* The position of the first 'Needle' in 'This', or 'STRVIEW_NPOS'. */
+static inline size_t StringFindView(const String_t *This, StrView_t Needle)
+{ /* StringFindView() */
+  return StrViewFind(StringView(This), Needle);
+} /* StringFindView() */
+
+/*
+ * Searches using the known 'Size' (so no 'strlen()' or scanning for the
+ * '\0') and the vector code in StrView.c.  Each returns the position
+ * of the first 'Needle', 'Char', or character in 'Set' at or after
+ * 'Pos', or for the 'RFind' versions the last one at or before 'Pos'
+ * (so 'STRVIEW_NPOS' means anywhere), or 'STRVIEW_NPOS' if there's
+ * none.
+ */
+static inline size_t StringFind(const String_t *This, const char *Needle,
+                                size_t Pos)
+{ /* StringFind() */
+  size_t Found;
+
+  if (Pos > This->Size)
+    return STRVIEW_NPOS;
+  Found = StrViewFind(StringSubView(This, Pos, STRVIEW_NPOS),
+                      StrViewCStr(Needle));
+  return (Found == STRVIEW_NPOS ? Found : Pos + Found);
+} /* StringFind() */
+
+static inline size_t StringRFind(const String_t *This, const char *Needle,
+                                 size_t Pos)
+{ /* StringRFind() */
+  StrView_t View = StrViewCStr(Needle);
+
+  if (View.Size > This->Size)
+    return STRVIEW_NPOS;
+  if (Pos > This->Size - View.Size)
+    Pos = This->Size - View.Size;
+  return StrViewRFind(StringSubView(This, 0, Pos + View.Size), View);
+} /* StringRFind() */
+
+static inline size_t StringFindChar(const String_t *This, char Char,
+                                    size_t Pos)
+{ /* StringFindChar() */
+  size_t Found;
+
+  if (Pos > This->Size)
+    return STRVIEW_NPOS;
+  Found = StrViewFindChar(StringSubView(This, Pos, STRVIEW_NPOS), Char);
+  return (Found == STRVIEW_NPOS ? Found : Pos + Found);
+} /* StringFindChar() */
+
+static inline size_t StringRFindChar(const String_t *This, char Char,
+                                     size_t Pos)
+{ /* StringRFindChar() */
+  return StrViewRFindChar(StringSubView(This, 0, (Pos < This->Size ?
+                                                  Pos + 1 : Pos)), Char);
+} /* StringRFindChar() */
+
+static inline size_t StringFindAny(const String_t *This, const char *Set,
+                                   size_t Pos)
+{ /* StringFindAny() */
+  size_t Found;
+
+  if (Pos > This->Size)
+    return STRVIEW_NPOS;
+  Found = StrViewFindAny(StringSubView(This, Pos, STRVIEW_NPOS),
+                         StrViewCStr(Set));
+  return (Found == STRVIEW_NPOS ? Found : Pos + Found);
+} /* StringFindAny() */
+
+static inline size_t StringRFindAny(const String_t *This, const char *Set,
+                                    size_t Pos)
+{ /* StringRFindAny() */
+  return StrViewRFindAny(StringSubView(This, 0, (Pos < This->Size ?
+                                                 Pos + 1 : Pos)),
+                         StrViewCStr(Set));
+} /* StringRFindAny() */
+
 /*
  * Returns 'This' if successful, NULL otherwise.  On error, 'errno' is
  * set to non-zero (probably ENOMEM).
@@ -158,6 +341,25 @@ extern bool StringAppendCStr(String_t *This, const char *Str);
 /* Append a 'const String_t *' to 'This'. */
 extern bool StringAppendStr(String_t *This, const String_t *Str);
 
+/* Set 'This' to, or append, a view.  Unlike the 'CStr' versions there's
+ * no 'strlen()', and 'View' may be part of 'This'. */
+extern bool StringSetView(String_t *This, StrView_t View);
+extern bool StringAppendView(String_t *This, StrView_t View);
+
+/* Append an integer in base 'Base' (2 to 36) to 'This', as written by
+ * 'IMaxToStr()' and 'UMaxToStr()' (see 'XToStr.h').  Any integer type
+ * can be passed to one or the other. */
+extern bool StringAppendIMax(String_t *This, intmax_t Val, int Base);
+extern bool StringAppendUMax(String_t *This, uintmax_t Val, int Base);
+
+/* Append the shortest string that reads back (with 'StrToD()' or
+ * 'StrToF()') as exactly 'Val', as written by 'DToStr()' and
+ * 'FToStr()'.  This is usually much shorter, and much faster, than
+ * 'StringStreamf(This, "%.17g", Val)'.  The buffer is grown at most
+ * once and no temporary is used. */
+extern bool StringAppendDouble(String_t *This, double Val);
+extern bool StringAppendFloat(String_t *This, float Val);
+
 /* Append a 'const char *' to 'This' returning the result in a new
  * 'String_t'.  Returns NULL and sets 'errno' on error. */
 extern String_t *
@@ -168,7 +370,10 @@ StringConcatCStr(String_t *Str, const char *CStr);
 extern String_t *
 StringConcatStr(String_t *Str0, const String_t *Str1);
 
-/* Analogous to sprintf(). */
+/* Analogous to sprintf().  Returns the length of the result, or EOF
+ * (and sets 'errno') on error.  The output is exactly that of
+ * 'sprintf()' but it is written straight into the buffer in a single
+ * pass over 'Fmt', growing the buffer as needed. */
 extern int StringPrintf(String_t *This, const char *Fmt, ...);
 
 /* Like 'StringPrintf()' but appends output to the current contents of
@@ -176,4 +381,21 @@ extern int StringPrintf(String_t *This, const char *Fmt, ...);
  * except missing all the file-like funcctionality (i.e. 'seek()',
  * 'putback()', etc..). */
 int StringStreamf(String_t *This, const char *Fmt, ...);
+
+/* A 'printf()' format compiled once by 'NewStringFmt()' for use by
+ * 'StringPrintFmt()' and 'StringStreamFmt()' as often as needed.  The
+ * conversions and literal text are worked out up front so using it
+ * just copies the text and formats the arguments.  The output is
+ * exactly that of 'StringPrintf()' and 'StringStreamf()' with the
+ * same format.  NOTE: The compiler can't check the arguments against
+ * a compiled format. */
+typedef struct StringFmt StringFmt_t;
+
+/* Returns NULL and sets 'errno' on error. */
+extern StringFmt_t *NewStringFmt(const char *Fmt);
+extern void DeleteStringFmt(StringFmt_t *This);
+
+/* Like 'StringPrintf()' and 'StringStreamf()' respectively. */
+extern int StringPrintFmt(String_t *This, const StringFmt_t *Fmt, ...);
+extern int StringStreamFmt(String_t *This, const StringFmt_t *Fmt, ...);
 #endif
@@ -0,0 +1,921 @@
+/******************************************************************************
+ * A 'printf()' engine that writes straight into a 'String_t', for
+ * 'StringPrintf()' and 'StringStreamf()'.  See 'StringImpl.h' for the
+ * interface.
+ *
+ * Formatting with 'vsnprintf()' into a buffer that might be too small
+ * means formatting everything twice whenever it is.  Instead we walk
+ * the format once, growing the buffer as we go (by doubling, as for
+ * everything else), and append each piece where it belongs:
+ *
+ * 1) Literal text is copied.
+ *
+ * 2) Integers, characters, strings, pointers, '%n', and '%%' are
+ *    formatted here, with the digits from 'XToStrUMax()'.
+ *
+ * 3) '%e', '%f', and '%g' of a 'double' are formatted here too, by
+ *    'FastFloat()', which works out the correctly rounded digits with
+ *    128-bit integer arithmetic, so they are exactly those of
+ *    'printf()'.  That's only done when the locale's decimal point
+ *    ('nl_langinfo(RADIXCHAR)') is ".", and the compiler has a 128-bit
+ *    integer type.  Everything else ('%a', 'long double', precisions
+ *    over 19, '%f' of huge numbers, other decimal points) is left to
+ *    'snprintf()', one conversion at a time, after first making room
+ *    for the longest result that conversion can have.
+ *
+ * A format can also be parsed once, by 'NewStringFmt()', into a list
+ * of literal text and parsed conversions, which 'StringVFormatFmt()'
+ * then just replays.
+ *
+ * The output is exactly what 'vsnprintf()' would write.  The few
+ * things we don't do ourselves (positional arguments, wide characters,
+ * and GNU extensions like '%m' and the ''' flag) are found before any
+ * output of the call is kept, and the whole call is then handed to
+ * 'vsnprintf()', so they still work, just not any faster.
+ *****************************************************************************/
+#include <errno.h>
+#include <langinfo.h>
+#include <limits.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Diag.h"
+#include "Errors.h"
+#include "Pow10.h"
+#include "String.h"
+#include "StringImpl.h"
+#include "XToStr.h"
+#include "XToStrImpl.h"
+
+/******************************************************************************
+ * Make sure 'This' has room for 'N' more characters plus the '\0'.
+ *****************************************************************************/
+static inline bool Room(String_t *This, size_t N)
+{ /* Room() */
+  if (N < StringCapacity(This) - This->Size)
+    return true;
+
+  if (SIZE_MAX - (This->Size + 1) < N)
+  { /* Result would overflow. */
+    errno = ERANGE;
+    return false;
+  } /* Result would overflow. */
+
+  return StringReserve(This, This->Size + N + 1);
+} /* Room() */
+
+/******************************************************************************
+ * Append 'Prefix' (a sign or "0x"), 'NZeros' zeros, and 'Str' to
+ * 'This', padded to 'Width' with 'Pad' on the left, or spaces on the
+ * right if 'STRING_FMT_MINUS' is set.
+ *****************************************************************************/
+static bool Emit(String_t *This, const char *Prefix, size_t NPrefix,
+                 size_t NZeros, const char *Str, size_t N, unsigned Flags,
+                 int Width, char Pad)
+{ /* Emit() */
+  size_t Total = NPrefix + NZeros + N, NPad = 0;
+  char *Ptr;
+
+  if ((size_t) Width > Total)
+    NPad = (size_t) Width - Total;
+
+  if (!Room(This, Total + NPad))
+    return false;
+
+  Ptr = &This->Ptr[This->Size];
+  if ((Flags & STRING_FMT_MINUS) == 0)
+  { /* Right justify. */
+    memset(Ptr, Pad, NPad);
+    Ptr += NPad;
+  } /* Right justify. */
+
+  memcpy(Ptr, Prefix, NPrefix);
+  Ptr += NPrefix;
+  memset(Ptr, '0', NZeros);
+  Ptr += NZeros;
+  memcpy(Ptr, Str, N);
+  Ptr += N;
+
+  if ((Flags & STRING_FMT_MINUS) != 0)
+    memset(Ptr, ' ', NPad);
+
+  This->Size += Total + NPad;
+  return true;
+} /* Emit() */
+
+/******************************************************************************
+ * Append an integer conversion ('d', 'i', 'o', 'u', 'x', 'X', or 'p')
+ * of the magnitude 'Mag'.  'Sign' is the sign character, or '\0'.
+ *****************************************************************************/
+static bool Integer(String_t *This, char Conv, unsigned Flags, int Width,
+                    int Prec, uintmax_t Mag, char Sign)
+{ /* Integer() */
+  char Digits[XTOSTR_BUFF_SIZE], *End = &Digits[sizeof(Digits)], *Ptr;
+  char Prefix[3];
+  size_t NPrefix = 0, NDigits, NZeros = 0;
+  bool ZeroPad;
+  unsigned Base;
+
+  /* Zero padding only applies with no precision. */
+  ZeroPad = (Prec < 0 && (Flags & (STRING_FMT_ZERO | STRING_FMT_MINUS))
+             == STRING_FMT_ZERO);
+
+  Base = (Conv == 'o' ? 8 : (Conv == 'x' || Conv == 'X' || Conv == 'p'
+                             ? 16 : 10));
+
+  /* An explicit precision of 0 means no digits at all for 0. */
+  Ptr = (Prec == 0 && Mag == 0 ? End : XToStrUMax(Mag, Base, End));
+  NDigits = (size_t) (End - Ptr);
+  if (Conv == 'X')
+  { /* Upper case. */
+    for (; Ptr != End; ++Ptr)
+      if (*Ptr >= 'a')
+        *Ptr = (char) (*Ptr - 'a' + 'A');
+    Ptr = End - NDigits;
+  } /* Upper case. */
+
+  if (Sign != '\0')
+    Prefix[NPrefix++] = Sign;
+
+  if ((Flags & STRING_FMT_HASH) != 0)
+  { /* Alternate form. */
+    if (Conv == 'o')
+    { /* First digit must be 0. */
+      if ((NDigits == 0 || *Ptr != '0') && Prec <= (int) NDigits)
+        Prec = (int) NDigits + 1;
+    } /* First digit must be 0. */
+    else if (Conv != 'd' && Conv != 'i' && Conv != 'u' && Mag != 0)
+    { /* "0x" or "0X". */
+      Prefix[NPrefix++] = '0';
+      Prefix[NPrefix++] = (Conv == 'X' ? 'X' : 'x');
+    } /* "0x" or "0X". */
+  } /* Alternate form. */
+
+  if (Prec > (int) NDigits)
+    NZeros = (size_t) Prec - NDigits;
+  if (ZeroPad && (size_t) Width > NPrefix + NDigits + NZeros)
+    NZeros = (size_t) Width - NPrefix - NDigits;
+
+  return Emit(This, Prefix, NPrefix, NZeros, Ptr, NDigits, Flags, Width,
+              ' ');
+} /* Integer() */
+
+#ifdef __SIZEOF_INT128__
+typedef unsigned __int128 UInt128_t;
+
+/* 10^N for N up to 38, the most that fits in 128 bits. */
+static inline UInt128_t Pow10Wide(int N)
+{ /* Pow10Wide() */
+  return (N < 20 ? (UInt128_t) Pow10[N]
+          : (UInt128_t) Pow10[19] * Pow10[N - 19]);
+} /* Pow10Wide() */
+
+/******************************************************************************
+ * Set '*Q' to 'M * 2^E2 * 10^S' rounded to an integer, ties to even,
+ * exactly as 'printf()' rounds.  Returns 'false' if that can't be done
+ * exactly in 128 bits, 'true' otherwise.  'M' is less than 2^53.
+ *****************************************************************************/
+static bool Scale(uint64_t M, int E2, int S, UInt128_t *Q)
+{ /* Scale() */
+  UInt128_t N, D, Rem, Half;
+
+  if (S >= 0)
+  { /* Multiply by 10^S, then by 2^E2. */
+    if (S >= 20)
+      return false;
+    N = (UInt128_t) M * Pow10[S];     /* Less than 2^117. */
+
+    if (E2 >= 0)
+    { /* Exact. */
+      if (E2 > 127 || (E2 != 0 && (N >> (128 - E2)) != 0))
+        return false;
+      *Q = N << E2;
+      return true;
+    } /* Exact. */
+
+    if (E2 <= -118)
+    { /* Less than a half. */
+      *Q = 0;
+      return true;
+    } /* Less than a half. */
+
+    *Q = N >> -E2;
+    Rem = N & (((UInt128_t) 1 << -E2) - 1);
+    Half = (UInt128_t) 1 << (-E2 - 1);
+    *Q += (Rem > Half || (Rem == Half && (*Q & 1) != 0));
+    return true;
+  } /* Multiply by 10^S, then by 2^E2. */
+
+  /* Divide 'M * 2^E2' by '10^-S' (or 'M' by '10^-S * 2^-E2'). */
+  if (S < -38)
+    return false;
+  D = Pow10Wide(-S);
+  if (E2 >= 0)
+  { /* Integer numerator. */
+    if (E2 > 74)
+      return false;
+    N = (UInt128_t) M << E2;
+  } /* Integer numerator. */
+  else
+  { /* Bigger denominator. */
+    if (E2 < -127 || (D >> (128 + E2)) != 0)
+      return false;
+    D <<= -E2;
+    N = M;
+  } /* Bigger denominator. */
+
+  *Q = N / D;
+  Rem = N - *Q * D;
+  *Q += (Rem > D - Rem || (Rem == D - Rem && (*Q & 1) != 0));
+  return true;
+} /* Scale() */
+
+/******************************************************************************
+ * Like 'XToStrUMax(Q, 10, End)' for a 128-bit 'Q'.
+ *****************************************************************************/
+static char *Digits128(UInt128_t Q, char *End)
+{ /* Digits128() */
+  char *Ptr;
+
+  while ((Q >> 64) != 0)
+  { /* Nineteen digits at a time. */
+    Ptr = XToStrUMax((uint64_t) (Q % Pow10[19]), 10, End);
+    End -= 19;
+    while (Ptr > End)
+      *--Ptr = '0';
+    Q /= Pow10[19];
+  } /* Nineteen digits at a time. */
+
+  return XToStrUMax((uint64_t) Q, 10, End);
+} /* Digits128() */
+
+/******************************************************************************
+ * Write a '%e', '%f', or '%g' conversion ('Conv' may be upper case) of
+ * 'Val' to 'Buff' without the sign, padding, or '\0', and return its
+ * length.  Returns 0 if the digits can't be had exactly with 128-bit
+ * arithmetic (precisions over 19, and '%f' of huge numbers), in which
+ * case the C library has to do it.  'Buff' needs room for 64
+ * characters.
+ *****************************************************************************/
+static size_t FastFloat(double Val, char Conv, unsigned Flags, int Prec,
+                        char *Buff)
+{ /* FastFloat() */
+  char Digits[48], *End = &Digits[sizeof(Digits)], *Dig, *Ptr = Buff;
+  char Lower = (char) (Conv | 0x20);
+  uint64_t Bits, M;
+  int E2, K = 0, NSig, Point, NDig;
+  bool Exponent;
+  UInt128_t Q;
+
+  memcpy(&Bits, &Val, sizeof(Bits));
+  M = Bits & (((uint64_t) 1 << 52) - 1);
+  E2 = (int) ((Bits >> 52) & 0x7FF);
+  if (E2 == 0x7FF)
+  { /* Infinity or NaN. */
+    memcpy(Buff, (M != 0 ? (Conv == Lower ? "nan" : "NAN")
+                  : (Conv == Lower ? "inf" : "INF")), 3);
+    return 3;
+  } /* Infinity or NaN. */
+
+  if (E2 == 0)
+    E2 = 1;
+  else
+    M |= (uint64_t) 1 << 52;
+  E2 -= 1075;
+
+  if (Prec < 0)
+    Prec = 6;
+  if (Lower == 'g' && Prec == 0)
+    Prec = 1;
+
+  if (Lower == 'f')
+  { /* Fixed number of decimals. */
+    if (!Scale(M, E2, Prec, &Q))
+      return 0;
+    NSig = Prec + 1;
+  } /* Fixed number of decimals. */
+  else
+  { /* Fixed number of significant digits. */
+    NSig = (Lower == 'e' ? Prec + 1 : Prec);
+    if (NSig > 38)
+      return 0;
+
+    if (M == 0)
+    { /* Zero. */
+      Q = 0;
+    } /* Zero. */
+    else
+    { /* 'K' is the decimal exponent, or 1 less. */
+      K = ((E2 + 63 - __builtin_clzll(M)) * 1262611) >> 22;
+      if (!Scale(M, E2, NSig - 1 - K, &Q))
+        return 0;
+
+      /* glibc writes '%#g' of values that round up to a power of 10
+       * as "1.e+06", so let it (these might be). */
+      if (Lower == 'g' && (Flags & STRING_FMT_HASH) != 0
+          && Q == Pow10Wide(NSig))
+        return 0;
+
+      if (Q >= Pow10Wide(NSig) && (++K, !Scale(M, E2, NSig - 1 - K, &Q)))
+        return 0;
+      if (Q >= Pow10Wide(NSig))
+      { /* Rounded up to the next power of 10. */
+        if (Lower == 'g' && (Flags & STRING_FMT_HASH) != 0)
+          return 0;
+        Q /= 10;
+        ++K;
+      } /* Rounded up to the next power of 10. */
+    } /* 'K' is the decimal exponent, or 1 less. */
+  } /* Fixed number of significant digits. */
+
+  /* At least 'NSig' digits. */
+  Dig = Digits128(Q, End);
+  while (End - Dig < NSig)
+    *--Dig = '0';
+  NDig = (int) (End - Dig);
+
+  Exponent = (Lower == 'e' || (Lower == 'g' && (K < -4 || K >= Prec)));
+  Point = (Lower == 'f' ? NDig - Prec : (Exponent ? 1 : K + 1));
+
+  if (Point <= 0)
+  { /* "0.000ddd". */
+    memcpy(Ptr, "0.", 2);
+    Ptr += 2;
+    memset(Ptr, '0', (size_t) -Point);
+    Ptr += -Point;
+    memcpy(Ptr, Dig, (size_t) NDig);
+    Ptr += NDig;
+  } /* "0.000ddd". */
+  else
+  { /* "ddd.ddd" */
+    memcpy(Ptr, Dig, (size_t) Point);
+    Ptr += Point;
+    if (NDig > Point || (Flags & STRING_FMT_HASH) != 0)
+      *Ptr++ = '.';
+    memcpy(Ptr, &Dig[Point], (size_t) (NDig - Point));
+    Ptr += NDig - Point;
+  } /* "ddd.ddd" */
+
+  if (Lower == 'g' && (Flags & STRING_FMT_HASH) == 0 && (Point <= 0
+                                                         || NDig > Point))
+  { /* Drop trailing zeros, and the point if that's all. */
+    while (Ptr[-1] == '0')
+      --Ptr;
+    if (Ptr[-1] == '.')
+      --Ptr;
+  } /* Drop trailing zeros, and the point if that's all. */
+
+  if (Exponent)
+  { /* "e+dd". */
+    *Ptr++ = (Conv == Lower ? 'e' : 'E');
+    *Ptr++ = (K < 0 ? '-' : '+');
+    if (K < 0)
+      K = -K;
+    if (K >= 100)
+    { /* Three digits. */
+      *Ptr++ = (char) ('0' + K / 100);
+      K %= 100;
+    } /* Three digits. */
+    *Ptr++ = (char) ('0' + K / 10);
+    *Ptr++ = (char) ('0' + K % 10);
+  } /* "e+dd". */
+
+  return (size_t) (Ptr - Buff);
+} /* FastFloat() */
+#endif
+
+/******************************************************************************
+ * Append a floating point conversion.  '%e', '%f', and '%g' of a
+ * 'double' are done by 'FastFloat()' when it can (and the decimal
+ * point is '.').  Anything else is done by having 'snprintf()' write
+ * it straight into the buffer.  We make room for the longest possible
+ * result first, so that only goes round twice if we got that wrong.
+ *****************************************************************************/
+static bool Float(String_t *This, const StringSpec_t *Spec, unsigned Flags,
+                  int Width, int Prec, va_list *Ap)
+{ /* Float() */
+  char Fmt[16], *Ptr = Fmt;
+  long double LVal = 0;
+  double Val = 0;
+  size_t Max, Avail;
+  int N, Exp = 0, Pass;
+  bool HaveVal = false;
+#ifdef __SIZEOF_INT128__
+  const char *Point;
+  char Buff[64], Sign;
+  size_t Len, NZeros = 0;
+
+  if (Spec->Len != STRING_LEN_LD && (Spec->Conv | 0x20) != 'a')
+  { /* Maybe we can do it ourselves. */
+    Val = va_arg(*Ap, double);
+    HaveVal = true;
+    if ((Point = nl_langinfo(RADIXCHAR))[0] == '.' && Point[1] == '\0'
+        && (Len = FastFloat(Val, Spec->Conv, Flags, Prec, Buff)) != 0)
+    { /* Done. */
+      Sign = (signbit(Val) ? '-' : ((Flags & STRING_FMT_PLUS) != 0 ? '+'
+                                    : ((Flags & STRING_FMT_SPACE) != 0
+                                       ? ' ' : '\0')));
+      if ((Flags & (STRING_FMT_ZERO | STRING_FMT_MINUS)) == STRING_FMT_ZERO
+          && isfinite(Val) && (size_t) Width > Len + (Sign != '\0'))
+        NZeros = (size_t) Width - Len - (Sign != '\0');
+      return Emit(This, &Sign, (Sign != '\0'), NZeros, Buff, Len, Flags,
+                  Width, ' ');
+    } /* Done. */
+  } /* Maybe we can do it ourselves. */
+#endif
+
+  /* Rebuild the specification, taking width and precision from the
+   * arguments. */
+  *Ptr++ = '%';
+  if ((Flags & STRING_FMT_MINUS) != 0)
+    *Ptr++ = '-';
+  if ((Flags & STRING_FMT_PLUS) != 0)
+    *Ptr++ = '+';
+  if ((Flags & STRING_FMT_SPACE) != 0)
+    *Ptr++ = ' ';
+  if ((Flags & STRING_FMT_HASH) != 0)
+    *Ptr++ = '#';
+  if ((Flags & STRING_FMT_ZERO) != 0)
+    *Ptr++ = '0';
+  memcpy(Ptr, "*.*", 3);
+  Ptr += 3;
+  if (Spec->Len == STRING_LEN_LD)
+    *Ptr++ = 'L';
+  *Ptr++ = Spec->Conv;
+  *Ptr = '\0';
+
+  if (Spec->Len == STRING_LEN_LD)
+  { /* long double. */
+    LVal = va_arg(*Ap, long double);
+    if (isfinite(LVal))
+      frexpl(LVal, &Exp);
+  } /* long double. */
+  else
+  { /* double. */
+    if (!HaveVal)
+      Val = va_arg(*Ap, double);
+    if (isfinite(Val))
+      frexp(Val, &Exp);
+  } /* double. */
+
+  /* The longest result: sign, digits, point, exponent (or "0x") and a
+   * few to spare (e.g. for a multibyte decimal point).  For '%f' the
+   * integer part has at most 'Exp * log10(2) + 1' digits, plus one if
+   * rounding carries. */
+  Max = (size_t) (Prec < 0 ? 6 : Prec) + 16;
+  if ((Spec->Conv == 'f' || Spec->Conv == 'F') && Exp > 0)
+    Max += (size_t) Exp * 30103 / 100000 + 2;
+  else if ((Spec->Conv == 'a' || Spec->Conv == 'A') && Prec < 0)
+    Max += 16;
+  if ((size_t) Width > Max)
+    Max = (size_t) Width;
+
+  for (Pass = 0; Pass < 2; ++Pass)
+  { /* Until it fits. */
+    if (!Room(This, Max))
+      return false;
+
+    Avail = StringCapacity(This) - This->Size;
+    if (Spec->Len == STRING_LEN_LD)
+      N = snprintf(&This->Ptr[This->Size], Avail, Fmt, Width, Prec, LVal);
+    else
+      N = snprintf(&This->Ptr[This->Size], Avail, Fmt, Width, Prec, Val);
+
+    if (N < 0)
+      return false;
+    if ((size_t) N < Avail)
+    { /* Done. */
+      This->Size += (size_t) N;
+      return true;
+    } /* Done. */
+    Max = (size_t) N;
+  } /* Until it fits. */
+
+  /* Can't happen. */
+  errno = EOVERFLOW;
+  return false;
+} /* Float() */
+
+/******************************************************************************
+ * Parse a decimal field width or precision.  Returns NULL if it's too
+ * big for an 'int'.
+ *****************************************************************************/
+static const char *Number(const char *Fmt, int *Num)
+{ /* Number() */
+  int N = 0;
+
+  for (; *Fmt >= '0' && *Fmt <= '9'; ++Fmt)
+  { /* For each digit. */
+    if (N > (INT_MAX - (*Fmt - '0')) / 10)
+      return NULL;
+    N = N * 10 + (*Fmt - '0');
+  } /* For each digit. */
+
+  *Num = N;
+  return Fmt;
+} /* Number() */
+
+/******************************************************************************
+ * See 'StringImpl.h'.
+ *****************************************************************************/
+const char *StringParseSpec(const char *Fmt, StringSpec_t *Spec)
+{ /* StringParseSpec() */
+  const char *Flag;
+  static const char Flags[] = "-+ #0";
+
+  Spec->Flags = 0;
+  Spec->Width = -1;
+  Spec->Prec = -1;
+  Spec->Len = STRING_LEN_NONE;
+
+  for (; *Fmt != '\0' && (Flag = strchr(Flags, *Fmt)) != NULL; ++Fmt)
+    Spec->Flags |= 1u << (Flag - Flags);
+
+  /* Width.  A number followed by '$' is a positional argument. */
+  if (*Fmt == '*')
+  { /* From the arguments. */
+    Spec->Width = STRING_FMT_ARG;
+    ++Fmt;
+  } /* From the arguments. */
+  else if (*Fmt >= '1' && *Fmt <= '9')
+  { /* Given. */
+    if ((Fmt = Number(Fmt, &Spec->Width)) == NULL)
+      return NULL;
+  } /* Given. */
+  if (*Fmt == '$' || (*Fmt >= '0' && *Fmt <= '9'))
+    return NULL;
+
+  if (*Fmt == '.')
+  { /* Precision. */
+    if (*++Fmt == '*')
+    { /* From the arguments. */
+      Spec->Prec = STRING_FMT_ARG;
+      ++Fmt;
+    } /* From the arguments. */
+    else if ((Fmt = Number(Fmt, &Spec->Prec)) == NULL)
+    { /* Error. */
+      return NULL;
+    } /* Error. */
+    if (*Fmt == '$' || (*Fmt >= '0' && *Fmt <= '9'))
+      return NULL;
+  } /* Precision. */
+
+  switch (*Fmt)
+  { /* Length. */
+  case 'h':
+    Spec->Len = (*++Fmt == 'h' ? (++Fmt, STRING_LEN_HH) : STRING_LEN_H);
+    break;
+  case 'l':
+    Spec->Len = (*++Fmt == 'l' ? (++Fmt, STRING_LEN_LL) : STRING_LEN_L);
+    break;
+  case 'j':
+    Spec->Len = STRING_LEN_J;
+    ++Fmt;
+    break;
+  case 'z':
+    Spec->Len = STRING_LEN_Z;
+    ++Fmt;
+    break;
+  case 't':
+    Spec->Len = STRING_LEN_T;
+    ++Fmt;
+    break;
+  case 'L':
+    Spec->Len = STRING_LEN_LD;
+    ++Fmt;
+    break;
+  } /* Length. */
+
+  Spec->Conv = *Fmt;
+  switch (Spec->Conv)
+  { /* Which conversions go with which lengths. */
+  case 'd': case 'i': case 'o': case 'u': case 'x': case 'X': case 'n':
+    if (Spec->Len == STRING_LEN_LD)
+      return NULL;
+    break;
+  case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a':
+  case 'A':
+    if (Spec->Len != STRING_LEN_NONE && Spec->Len != STRING_LEN_L
+        && Spec->Len != STRING_LEN_LD)
+      return NULL;
+    break;
+  case 'c': case 's': case 'p':
+    if (Spec->Len != STRING_LEN_NONE)
+      return NULL;
+    break;
+  case '%':
+    if (Spec->Flags != 0 || Spec->Width != -1 || Spec->Prec != -1
+        || Spec->Len != STRING_LEN_NONE)
+      return NULL;
+    break;
+  default:
+    return NULL;
+  } /* Which conversions go with which lengths. */
+
+  return Fmt + 1;
+} /* StringParseSpec() */
+
+/******************************************************************************
+ * See 'StringImpl.h'.
+ *****************************************************************************/
+bool StringFormatArg(String_t *This, const StringSpec_t *Spec, size_t Start,
+                     va_list *Ap)
+{ /* StringFormatArg() */
+  unsigned Flags = Spec->Flags;
+  int Width = (Spec->Width < 0 ? 0 : Spec->Width), Prec = Spec->Prec;
+  const char *Str;
+  intmax_t Val;
+  uintmax_t Mag;
+  size_t N;
+  void *Ptr;
+  char Sign;
+  char Char;
+
+  if (Spec->Width == STRING_FMT_ARG)
+  { /* A negative width means '-'. */
+    if ((Width = va_arg(*Ap, int)) < 0)
+    { /* Negative. */
+      if (Width == INT_MIN)
+      { /* Error. */
+        errno = EOVERFLOW;
+        return false;
+      } /* Error. */
+      Flags |= STRING_FMT_MINUS;
+      Width = -Width;
+    } /* Negative. */
+  } /* A negative width means '-'. */
+
+  if (Prec == STRING_FMT_ARG && (Prec = va_arg(*Ap, int)) < 0)
+    Prec = -1;
+
+  switch (Spec->Conv)
+  { /* Conversion. */
+  case 'd': case 'i':
+    switch (Spec->Len)
+    { /* Get the argument. */
+    case STRING_LEN_HH: Val = (signed char) va_arg(*Ap, int); break;
+    case STRING_LEN_H: Val = (short) va_arg(*Ap, int); break;
+    case STRING_LEN_L: Val = va_arg(*Ap, long); break;
+    case STRING_LEN_LL: Val = va_arg(*Ap, long long); break;
+    case STRING_LEN_J: Val = va_arg(*Ap, intmax_t); break;
+    case STRING_LEN_Z: Val = (intmax_t) va_arg(*Ap, size_t); break;
+    case STRING_LEN_T: Val = va_arg(*Ap, ptrdiff_t); break;
+    default: Val = va_arg(*Ap, int); break;
+    } /* Get the argument. */
+
+    Mag = (Val < 0 ? -(uintmax_t) Val : (uintmax_t) Val);
+    Sign = (Val < 0 ? '-' : ((Flags & STRING_FMT_PLUS) != 0 ? '+'
+                             : ((Flags & STRING_FMT_SPACE) != 0 ? ' '
+                                : '\0')));
+    return Integer(This, Spec->Conv, Flags, Width, Prec, Mag, Sign);
+
+  case 'o': case 'u': case 'x': case 'X':
+    switch (Spec->Len)
+    { /* Get the argument. */
+    case STRING_LEN_HH: Mag = (unsigned char) va_arg(*Ap, unsigned); break;
+    case STRING_LEN_H: Mag = (unsigned short) va_arg(*Ap, unsigned); break;
+    case STRING_LEN_L: Mag = va_arg(*Ap, unsigned long); break;
+    case STRING_LEN_LL: Mag = va_arg(*Ap, unsigned long long); break;
+    case STRING_LEN_J: Mag = va_arg(*Ap, uintmax_t); break;
+    case STRING_LEN_Z: Mag = va_arg(*Ap, size_t); break;
+    case STRING_LEN_T: Mag = (uintmax_t) va_arg(*Ap, ptrdiff_t); break;
+    default: Mag = va_arg(*Ap, unsigned); break;
+    } /* Get the argument. */
+    return Integer(This, Spec->Conv, Flags, Width, Prec, Mag, '\0');
+
+  case 'p':
+    /* Like '%#lx', except that NULL is "(nil)". */
+    if ((Ptr = va_arg(*Ap, void *)) == NULL)
+      return Emit(This, "", 0, 0, "(nil)", 5, Flags, Width, ' ');
+    Sign = ((Flags & STRING_FMT_PLUS) != 0 ? '+'
+            : ((Flags & STRING_FMT_SPACE) != 0 ? ' ' : '\0'));
+    return Integer(This, 'p', Flags | STRING_FMT_HASH, Width, Prec,
+                   (uintptr_t) Ptr, Sign);
+
+  case 'c':
+    Char = (char) va_arg(*Ap, int);
+    return Emit(This, "", 0, 0, &Char, 1, Flags, Width, ' ');
+
+  case 's':
+    /* NULL is "(null)", unless the precision cuts that short. */
+    if ((Str = va_arg(*Ap, const char *)) == NULL)
+      Str = (Prec < 0 || Prec >= 6 ? "(null)" : "");
+    if (Prec < 0)
+      N = strlen(Str);
+    else
+      N = ((Ptr = memchr(Str, '\0', (size_t) Prec)) != NULL
+           ? (size_t) ((const char *) Ptr - Str) : (size_t) Prec);
+    return Emit(This, "", 0, 0, Str, N, Flags, Width, ' ');
+
+  case 'n':
+    N = This->Size - Start;
+    switch (Spec->Len)
+    { /* Store the count. */
+    case STRING_LEN_HH: *va_arg(*Ap, signed char *) = (signed char) N; break;
+    case STRING_LEN_H: *va_arg(*Ap, short *) = (short) N; break;
+    case STRING_LEN_L: *va_arg(*Ap, long *) = (long) N; break;
+    case STRING_LEN_LL: *va_arg(*Ap, long long *) = (long long) N; break;
+    case STRING_LEN_J: *va_arg(*Ap, intmax_t *) = (intmax_t) N; break;
+    case STRING_LEN_Z: *va_arg(*Ap, size_t *) = N; break;
+    case STRING_LEN_T: *va_arg(*Ap, ptrdiff_t *) = (ptrdiff_t) N; break;
+    default: *va_arg(*Ap, int *) = (int) N; break;
+    } /* Store the count. */
+    return true;
+
+  case '%':
+    return Emit(This, "", 0, 0, "%", 1, 0, 0, ' ');
+
+  default:
+    return Float(This, Spec, Flags, Width, Prec, Ap);
+  } /* Conversion. */
+} /* StringFormatArg() */
+
+/******************************************************************************
+ * The whole call, for formats 'StringParseSpec()' doesn't handle:
+ * 'vsnprintf()' into whatever room there is, and again if that wasn't
+ * enough.
+ *****************************************************************************/
+static bool Fallback(String_t *This, const char *Fmt, va_list Ap)
+{ /* Fallback() */
+  size_t Avail = StringCapacity(This) - This->Size;
+  va_list Args;
+  int N;
+
+  va_copy(Args, Ap);
+  N = vsnprintf(&This->Ptr[This->Size], Avail, Fmt, Args);
+  va_end(Args);
+
+  if (N >= 0 && (size_t) N >= Avail)
+  { /* Too small. */
+    if (!Room(This, (size_t) N))
+      return false;
+
+    va_copy(Args, Ap);
+    N = vsnprintf(&This->Ptr[This->Size], (size_t) N + 1, Fmt, Args);
+    va_end(Args);
+  } /* Too small. */
+
+  if (N < 0)
+    return false;
+
+  This->Size += (size_t) N;
+  return true;
+} /* Fallback() */
+
+/******************************************************************************
+ * See 'StringImpl.h'.
+ *****************************************************************************/
+bool StringVFormat(String_t *This, const char *Fmt, va_list Ap)
+{ /* StringVFormat() */
+  const char *Ptr = Fmt, *Lit, *Next;
+  size_t Start = This->Size;
+  StringSpec_t Spec;
+  va_list Args;
+  bool Ok = true;
+
+  va_copy(Args, Ap);
+  while (Ok && *Ptr != '\0')
+  { /* For each piece. */
+    for (Lit = Ptr; *Ptr != '\0' && *Ptr != '%'; ++Ptr)
+      ;
+
+    if (Ptr != Lit)
+    { /* Literal text. */
+      if ((Ok = Room(This, (size_t) (Ptr - Lit))))
+      { /* Copy it. */
+        memcpy(&This->Ptr[This->Size], Lit, (size_t) (Ptr - Lit));
+        This->Size += (size_t) (Ptr - Lit);
+      } /* Copy it. */
+    } /* Literal text. */
+    else if ((Next = StringParseSpec(Ptr + 1, &Spec)) != NULL)
+    { /* A conversion. */
+      Ok = StringFormatArg(This, &Spec, Start, &Args);
+      Ptr = Next;
+    } /* A conversion. */
+    else
+    { /* Not one of ours; start again. */
+      This->Size = Start;
+      Ok = Fallback(This, Fmt, Ap);
+      break;
+    } /* Not one of ours; start again. */
+  } /* For each piece. */
+  va_end(Args);
+
+  if (Ok)
+    This->Ptr[This->Size] = '\0';
+
+  return Ok;
+} /* StringVFormat() */
+
+/******************************************************************************
+ * See 'StringImpl.h'.
+ *****************************************************************************/
+bool StringVFormatFmt(String_t *This, const StringFmt_t *Fmt, va_list Ap)
+{ /* StringVFormatFmt() */
+  const StringPiece_t *Piece, *End = &Fmt->Pieces[Fmt->NPieces];
+  size_t Start = This->Size;
+  va_list Args;
+  bool Ok = true;
+
+  if (Fmt->Fallback)
+    return Fallback(This, Fmt->Fmt, Ap);
+
+  va_copy(Args, Ap);
+  for (Piece = Fmt->Pieces; Ok && Piece != End; ++Piece)
+  { /* For each piece. */
+    if (Piece->Len != 0 && (Ok = Room(This, Piece->Len)))
+    { /* Literal text. */
+      memcpy(&This->Ptr[This->Size], Piece->Lit, Piece->Len);
+      This->Size += Piece->Len;
+    } /* Literal text. */
+
+    if (Ok && Piece->Spec.Conv != '\0')
+      Ok = StringFormatArg(This, &Piece->Spec, Start, &Args);
+  } /* For each piece. */
+  va_end(Args);
+
+  if (Ok)
+    This->Ptr[This->Size] = '\0';
+
+  return Ok;
+} /* StringVFormatFmt() */
+
+/******************************************************************************
+ * Compile 'Fmt'.  Each '%' starts at most one new piece, so we know
+ * how many we might need, and they and our copy of 'Fmt' all go in one
+ * allocation.  "%%" ends a piece with the first '%'.
+ *****************************************************************************/
+StringFmt_t *NewStringFmt(const char *Fmt)
+{ /* NewStringFmt() */
+  StringFmt_t *This = NULL, *_RetVal;
+  StringPiece_t *Piece;
+  const char *Next;
+  size_t Len, Max;
+  int ErrNo;
+
+  if (Fmt == NULL)
+  { /* Error. */
+    Diag("%s %s %d: 'Fmt' is NULL.\n", __FILE__, __func__, __LINE__);
+    ErrNo = EFAULT;
+    EXIT(NULL);
+  } /* Error. */
+
+  Len = strlen(Fmt);
+  for (Max = 1, Next = Fmt; (Next = strchr(Next, '%')) != NULL; ++Next)
+    ++Max;
+
+  if ((This = malloc(sizeof(*This) + Max * sizeof(This->Pieces[0])
+                     + Len + 1)) == NULL)
+  { /* Error. */
+    ErrNo = errno;
+    Diag("%s %s %d: malloc() failed.  %s.\n",
+         __FILE__, __func__, __LINE__, StrError(ErrNo));
+    EXIT(NULL);
+  } /* Error. */
+
+  This->Fmt = (char *) &This->Pieces[Max];
+  memcpy(This->Fmt, Fmt, Len + 1);
+  This->Fallback = false;
+
+  Piece = This->Pieces;
+  Piece->Lit = This->Fmt;
+  while (!This->Fallback && (Next = strchr(Piece->Lit, '%')) != NULL)
+  { /* For each '%'. */
+    Piece->Len = (size_t) (Next - Piece->Lit);
+    if (Next[1] == '%')
+    { /* Literal '%'. */
+      ++Piece->Len;
+      Piece->Spec.Conv = '\0';
+      (++Piece)->Lit = &Next[2];
+    } /* Literal '%'. */
+    else if ((Next = StringParseSpec(&Next[1], &Piece->Spec)) == NULL)
+    { /* Not one of ours. */
+      This->Fallback = true;
+    } /* Not one of ours. */
+    else
+    { /* A conversion. */
+      (++Piece)->Lit = Next;
+    } /* A conversion. */
+  } /* For each '%'. */
+
+  Piece->Len = strlen(Piece->Lit);
+  Piece->Spec.Conv = '\0';
+  This->NPieces = (size_t) (Piece - This->Pieces) + 1;
+  RETURN(This);
+
+Exit:
+  errno = ErrNo;
+
+Return:
+  return _RetVal;
+} /* NewStringFmt() */
+
+void DeleteStringFmt(StringFmt_t *This)
+{ /* DeleteStringFmt() */
+  free(This);
+} /* DeleteStringFmt() */
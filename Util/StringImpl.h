@@ -0,0 +1,101 @@
+#ifndef StringImpl_h
+#define StringImpl_h
+
+/******************************************************************************
+ * Private helpers shared by the 'String_t' functions that format
+ * ('StringPrintf()', 'StringStreamf()').  This header is _not_
+ * installed and nothing in here is part of the public interface.
+ *****************************************************************************/
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "String.h"
+
+/* Flags in 'StringSpec_t.Flags'. */
+#define STRING_FMT_MINUS 0x01   /* '-' Left justify. */
+#define STRING_FMT_PLUS  0x02   /* '+' Always write a sign. */
+#define STRING_FMT_SPACE 0x04   /* ' ' Space if there's no sign. */
+#define STRING_FMT_HASH  0x08   /* '#' Alternate form. */
+#define STRING_FMT_ZERO  0x10   /* '0' Pad with zeros. */
+
+/* 'Width' or 'Prec' is taken from the argument list ('*'). */
+#define STRING_FMT_ARG (-2)
+
+/* Length modifiers. */
+typedef enum StringFmtLen
+{
+  STRING_LEN_NONE,
+  STRING_LEN_HH,                /* hh */
+  STRING_LEN_H,                 /* h */
+  STRING_LEN_L,                 /* l */
+  STRING_LEN_LL,                /* ll */
+  STRING_LEN_J,                 /* j */
+  STRING_LEN_Z,                 /* z */
+  STRING_LEN_T,                 /* t */
+  STRING_LEN_LD                 /* L */
+} StringFmtLen_t;
+
+/* One parsed conversion specification. */
+typedef struct StringSpec
+{
+  unsigned Flags;               /* STRING_FMT_xxx. */
+  int Width;                    /* -1 if none. */
+  int Prec;                     /* -1 if none. */
+  StringFmtLen_t Len;
+  char Conv;                    /* 'd', 's', 'g', etc.. */
+} StringSpec_t;
+
+/* A compiled format ('StringFmt_t' in 'String.h') is a list of
+ * pieces, each some literal text followed by a conversion, if
+ * 'Spec.Conv' isn't '\0'. */
+typedef struct StringPiece
+{
+  const char *Lit;              /* Points into 'StringFmt_t.Fmt'. */
+  size_t Len;
+  StringSpec_t Spec;
+} StringPiece_t;
+
+struct StringFmt
+{
+  char *Fmt;                    /* Our copy of the format. */
+  bool Fallback;                /* Only 'vsnprintf()' can do it. */
+  size_t NPieces;
+  StringPiece_t Pieces[];
+};
+
+/******************************************************************************
+ * Parse the conversion specification starting just after a '%' at
+ * 'Fmt' into '*Spec' and return a pointer to the character after it.
+ * Returns NULL for anything 'StringFormatArg()' doesn't handle itself
+ * (positional arguments, wide characters, GNU extensions, and
+ * mistakes), which are left to 'vsnprintf()'.  See StringFmt.c.
+ *****************************************************************************/
+extern const char *StringParseSpec(const char *Fmt, StringSpec_t *Spec);
+
+/******************************************************************************
+ * Take the argument(s) for '*Spec' from '*Ap' and append them to
+ * 'This', formatted exactly as 'printf()' would.  'Start' is where the
+ * output of the current call started (for '%n').  Returns 'true' if
+ * successful, 'false' (with 'errno' set) otherwise, in which case
+ * 'This' may hold part of the result.  See StringFmt.c.
+ *****************************************************************************/
+extern bool StringFormatArg(String_t *This, const StringSpec_t *Spec,
+                            size_t Start, va_list *Ap);
+
+/******************************************************************************
+ * Append 'Fmt' formatted with the arguments 'Ap' to 'This' in a
+ * single pass, as 'vsnprintf()' would write it.  Returns 'true' if
+ * successful, 'false' (with 'errno' set) otherwise, in which case
+ * 'This' may hold part of the result.  See StringFmt.c.
+ *****************************************************************************/
+extern bool StringVFormat(String_t *This, const char *Fmt, va_list Ap);
+
+/******************************************************************************
+ * Like 'StringVFormat()' but for a format compiled by 'NewStringFmt()'.
+ * See StringFmt.c.
+ *****************************************************************************/
+extern bool StringVFormatFmt(String_t *This, const StringFmt_t *Fmt,
+                             va_list Ap);
+
+#endif
@@ -0,0 +1,29 @@
+#include <errno.h>
+#include <stdint.h>
+
+#include "XToStr.h"
+#include "XToStrImpl.h"
+
+/******************************************************************************
+ * Convert 'Val' to a string in base 'Base'.  See 'XToStr.h'.
+ *****************************************************************************/
+int UMaxToStr(uintmax_t Val, int Base, char *Buff, size_t Size, size_t *Len)
+{ /* UMaxToStr(uintmax_t, int, char *, size_t, size_t *) */
+  char Temp[XTOSTR_BUFF_SIZE], *End = &Temp[sizeof(Temp)], *Str;
+
+  /* NULL pointer checking. */
+  if (Buff == NULL)
+  { /* Error. */
+    return EFAULT;
+  } /* Error. */
+
+  if (Base < 2 || Base > 36)
+  { /* Invalid base. */
+    if (Size != 0)
+      Buff[0] = '\0';
+    return EDOM;
+  } /* Invalid base. */
+
+  Str = XToStrUMax(Val, (unsigned) Base, End);
+  return XToStrCopy(Str, (size_t) (End - Str), Buff, Size, Len);
+} /* UMaxToStr(uintmax_t, int, char *, size_t, size_t *) */
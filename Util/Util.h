@@ -5,7 +5,17 @@
  * This file just '#include's all the separate .h files.
  *****************************************************************************/
 #include <Errors.h>
+#include <Diag.h>
 #include <StrToX.h>
+#include <XToStr.h>
+#include <Alloc.h>
+#include <Arena.h>
+#include <Pool.h>
+#include <StrView.h>
 #include <String.h>
+#include <CompactString.h>
+#include <Intern.h>
+#include <StrMap.h>
+#include <Log.h>
 
 #endif
@@ -0,0 +1,217 @@
+#ifndef XToStr_h
+#define XToStr_h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/******************************************************************************
+ * Functions for converting various numeric types to strings, i.e. the
+ * inverse of the 'StrToX()' functions in 'StrToX.h'.  Anything these
+ * write can be read back by the corresponding 'StrToX()' function (with
+ * the same 'Base') and gives exactly the value that was written.  (The
+ * one exception is that, like 'strtod()', 'StrToD()' and 'StrToF()'
+ * report ERANGE for subnormal values; 'strtod()' and 'strtof()' read
+ * them back exactly.)
+ *
+ * The semantics are:
+ *
+ * 1) On success, the functions return 0, the NUL terminated string is
+ *    in 'Buff', and if 'Len' is not NULL its length (_not_ including
+ *    the '\0') is returned in '*Len'.
+ *
+ * 2) On error an 'errno' value is returned, '*Len' is unchanged, and
+ *    'Buff' holds an empty string (if 'Size' isn't 0).
+ *
+ *   2.1) If 'Buff == NULL' then EFAULT is returned.
+ *
+ *   2.2) If '(Base < 2 || Base > 36)' then EDOM is returned.  (Unlike
+ *        'StrToX()' there is no 'Base' 0.)
+ *
+ *   2.3) If the string (including the '\0') doesn't fit in the 'Size'
+ *        characters of 'Buff' then ENOBUFS is returned.
+ *        'XTOSTR_BUFF_SIZE' characters are always enough.
+ *
+ * 3) The global 'errno' is never touched.
+ *
+ * Integers are written with a leading '-' if negative, no leading
+ * zeros, and lower case letters for digits above 9.  Use
+ * 'StringAppendIMax()' or 'StringAppendUMax()' (see 'String.h') to
+ * append them to a 'String_t' instead.
+ *
+ * 'float' and 'double' values are written with the fewest significant
+ * digits that read back (with 'StrToF()' and 'StrToD()' respectively)
+ * as exactly the same value, and of those the one closest to the
+ * value.  So 0.1 is "0.1", not "0.10000000000000001".  The notation is
+ * that of the '%g' format with a precision of 17, i.e. an exponent is
+ * only used for very large or very small values ("1e+17", "1e-05").
+ * Infinities and NaNs are written as "inf", "-inf", "nan", and "-nan"
+ * (for a NaN with the sign bit set).  The conversion uses the
+ * Schubfach algorithm and never calls the C library.
+ *
+ * For example:
+ *
+ *   char Buff[XTOSTR_BUFF_SIZE];
+ *   size_t Len;
+ *
+ *   I32ToStr(-42, 10, Buff, sizeof(Buff), &Len);  // "-42", Len == 3
+ *   UI8ToStr(255, 16, Buff, sizeof(Buff), NULL);  // "ff"
+ *   DToStr(1.0 / 3, Buff, sizeof(Buff), &Len);    // "0.3333333333333333"
+ *****************************************************************************/
+  /* Big enough for any of these conversions, including the '\0'. */
+#define XTOSTR_BUFF_SIZE (sizeof(uintmax_t) * CHAR_BIT + 2)
+
+  extern int UMaxToStr(uintmax_t Val, int Base, char *Buff, size_t Size,
+                       size_t *Len);
+  extern int IMaxToStr(intmax_t Val, int Base, char *Buff, size_t Size,
+                       size_t *Len);
+
+  extern int FToStr(float Val, char *Buff, size_t Size, size_t *Len);
+  extern int DToStr(double Val, char *Buff, size_t Size, size_t *Len);
+
+  /* These all just call 'IMaxToStr()' or 'UMaxToStr()'.  WARNING: As
+   * for 'StrToC()', 'CToStr()' behaves like either 'SCToStr()' or
+   * 'UCToStr()' depending on whether 'char' is signed. */
+  static inline int CToStr(char Val, int Base, char *Buff, size_t Size,
+                           size_t *Len);
+  static inline int SCToStr(signed char Val, int Base, char *Buff,
+                            size_t Size, size_t *Len);
+  static inline int UCToStr(unsigned char Val, int Base, char *Buff,
+                            size_t Size, size_t *Len);
+  static inline int SToStr(short Val, int Base, char *Buff, size_t Size,
+                           size_t *Len);
+  static inline int USToStr(unsigned short Val, int Base, char *Buff,
+                            size_t Size, size_t *Len);
+  static inline int IToStr(int Val, int Base, char *Buff, size_t Size,
+                           size_t *Len);
+  static inline int UIToStr(unsigned int Val, int Base, char *Buff,
+                            size_t Size, size_t *Len);
+  static inline int LToStr(long Val, int Base, char *Buff, size_t Size,
+                           size_t *Len);
+  static inline int ULToStr(unsigned long Val, int Base, char *Buff,
+                            size_t Size, size_t *Len);
+  static inline int LLToStr(long long Val, int Base, char *Buff, size_t Size,
+                            size_t *Len);
+  static inline int ULLToStr(unsigned long long Val, int Base, char *Buff,
+                             size_t Size, size_t *Len);
+
+  /* Conversions for types defined in stdint.h. */
+  static inline int I8ToStr(int8_t Val, int Base, char *Buff, size_t Size,
+                            size_t *Len);
+  static inline int UI8ToStr(uint8_t Val, int Base, char *Buff, size_t Size,
+                             size_t *Len);
+  static inline int I16ToStr(int16_t Val, int Base, char *Buff, size_t Size,
+                             size_t *Len);
+  static inline int UI16ToStr(uint16_t Val, int Base, char *Buff,
+                              size_t Size, size_t *Len);
+  static inline int I32ToStr(int32_t Val, int Base, char *Buff, size_t Size,
+                             size_t *Len);
+  static inline int UI32ToStr(uint32_t Val, int Base, char *Buff,
+                              size_t Size, size_t *Len);
+  static inline int I64ToStr(int64_t Val, int Base, char *Buff, size_t Size,
+                             size_t *Len);
+  static inline int UI64ToStr(uint64_t Val, int Base, char *Buff,
+                              size_t Size, size_t *Len);
+
+  static inline int IL8ToStr(int_least8_t Val, int Base, char *Buff,
+                             size_t Size, size_t *Len);
+  static inline int UIL8ToStr(uint_least8_t Val, int Base, char *Buff,
+                              size_t Size, size_t *Len);
+  static inline int IL16ToStr(int_least16_t Val, int Base, char *Buff,
+                              size_t Size, size_t *Len);
+  static inline int UIL16ToStr(uint_least16_t Val, int Base, char *Buff,
+                               size_t Size, size_t *Len);
+  static inline int IL32ToStr(int_least32_t Val, int Base, char *Buff,
+                              size_t Size, size_t *Len);
+  static inline int UIL32ToStr(uint_least32_t Val, int Base, char *Buff,
+                               size_t Size, size_t *Len);
+  static inline int IL64ToStr(int_least64_t Val, int Base, char *Buff,
+                              size_t Size, size_t *Len);
+  static inline int UIL64ToStr(uint_least64_t Val, int Base, char *Buff,
+                               size_t Size, size_t *Len);
+
+  static inline int IF8ToStr(int_fast8_t Val, int Base, char *Buff,
+                             size_t Size, size_t *Len);
+  static inline int UIF8ToStr(uint_fast8_t Val, int Base, char *Buff,
+                              size_t Size, size_t *Len);
+  static inline int IF16ToStr(int_fast16_t Val, int Base, char *Buff,
+                              size_t Size, size_t *Len);
+  static inline int UIF16ToStr(uint_fast16_t Val, int Base, char *Buff,
+                               size_t Size, size_t *Len);
+  static inline int IF32ToStr(int_fast32_t Val, int Base, char *Buff,
+                              size_t Size, size_t *Len);
+  static inline int UIF32ToStr(uint_fast32_t Val, int Base, char *Buff,
+                               size_t Size, size_t *Len);
+  static inline int IF64ToStr(int_fast64_t Val, int Base, char *Buff,
+                              size_t Size, size_t *Len);
+  static inline int UIF64ToStr(uint_fast64_t Val, int Base, char *Buff,
+                               size_t Size, size_t *Len);
+
+/******************************************************************************
+ * Inline method definitions.
+ *****************************************************************************/
+  static inline int CToStr(char Val, int Base, char *Buff, size_t Size,
+                           size_t *Len)
+  { /* CToStr() */
+#if CHAR_MIN < 0
+    return IMaxToStr(Val, Base, Buff, Size, Len);
+#else
+    return UMaxToStr(Val, Base, Buff, Size, Len);
+#endif
+  } /* CToStr() */
+
+#define XTOSTR_INLINE(Name, Type, Func)                                     \
+  static inline int Name(Type Val, int Base, char *Buff, size_t Size,       \
+                         size_t *Len)                                       \
+  {                                                                         \
+    return Func(Val, Base, Buff, Size, Len);                                \
+  }
+
+  XTOSTR_INLINE(SCToStr, signed char, IMaxToStr)
+  XTOSTR_INLINE(UCToStr, unsigned char, UMaxToStr)
+  XTOSTR_INLINE(SToStr, short, IMaxToStr)
+  XTOSTR_INLINE(USToStr, unsigned short, UMaxToStr)
+  XTOSTR_INLINE(IToStr, int, IMaxToStr)
+  XTOSTR_INLINE(UIToStr, unsigned int, UMaxToStr)
+  XTOSTR_INLINE(LToStr, long, IMaxToStr)
+  XTOSTR_INLINE(ULToStr, unsigned long, UMaxToStr)
+  XTOSTR_INLINE(LLToStr, long long, IMaxToStr)
+  XTOSTR_INLINE(ULLToStr, unsigned long long, UMaxToStr)
+
+  XTOSTR_INLINE(I8ToStr, int8_t, IMaxToStr)
+  XTOSTR_INLINE(UI8ToStr, uint8_t, UMaxToStr)
+  XTOSTR_INLINE(I16ToStr, int16_t, IMaxToStr)
+  XTOSTR_INLINE(UI16ToStr, uint16_t, UMaxToStr)
+  XTOSTR_INLINE(I32ToStr, int32_t, IMaxToStr)
+  XTOSTR_INLINE(UI32ToStr, uint32_t, UMaxToStr)
+  XTOSTR_INLINE(I64ToStr, int64_t, IMaxToStr)
+  XTOSTR_INLINE(UI64ToStr, uint64_t, UMaxToStr)
+
+  XTOSTR_INLINE(IL8ToStr, int_least8_t, IMaxToStr)
+  XTOSTR_INLINE(UIL8ToStr, uint_least8_t, UMaxToStr)
+  XTOSTR_INLINE(IL16ToStr, int_least16_t, IMaxToStr)
+  XTOSTR_INLINE(UIL16ToStr, uint_least16_t, UMaxToStr)
+  XTOSTR_INLINE(IL32ToStr, int_least32_t, IMaxToStr)
+  XTOSTR_INLINE(UIL32ToStr, uint_least32_t, UMaxToStr)
+  XTOSTR_INLINE(IL64ToStr, int_least64_t, IMaxToStr)
+  XTOSTR_INLINE(UIL64ToStr, uint_least64_t, UMaxToStr)
+
+  XTOSTR_INLINE(IF8ToStr, int_fast8_t, IMaxToStr)
+  XTOSTR_INLINE(UIF8ToStr, uint_fast8_t, UMaxToStr)
+  XTOSTR_INLINE(IF16ToStr, int_fast16_t, IMaxToStr)
+  XTOSTR_INLINE(UIF16ToStr, uint_fast16_t, UMaxToStr)
+  XTOSTR_INLINE(IF32ToStr, int_fast32_t, IMaxToStr)
+  XTOSTR_INLINE(UIF32ToStr, uint_fast32_t, UMaxToStr)
+  XTOSTR_INLINE(IF64ToStr, int_fast64_t, IMaxToStr)
+  XTOSTR_INLINE(UIF64ToStr, uint_fast64_t, UMaxToStr)
+
+#undef XTOSTR_INLINE
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif
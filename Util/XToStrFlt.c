@@ -0,0 +1,297 @@
+/******************************************************************************
+ * Shortest round trip conversion of 'float' and 'double' to strings
+ * for 'FToStr()' and 'DToStr()'.  See 'XToStrF()' and 'XToStrD()' in
+ * 'XToStrImpl.h' for the interface.
+ *
+ * The algorithm is Raffaello Giulietti's Schubfach ("The Schubfach way
+ * to render doubles", 2020), as used by Java's 'Double.toString()':
+ *
+ * 1) A finite, non-zero value is 'C * 2^Q' for integers 'C' and 'Q',
+ *    and every real number within half a unit in the last place of it
+ *    (the "rounding interval") reads back as the same value.
+ *
+ * 2) Choose 'K' so that the interval scaled by '10^-K' is a little
+ *    wider than 1 (and narrower than 10).  It then contains at least
+ *    one integer, and at most one multiple of 10.
+ *
+ * 3) If it contains a multiple of 10, that (divided by 10) is the
+ *    shortest answer.  Otherwise the integer nearest the scaled value
+ *    is, or the nearer of the two integers either side of it that are
+ *    in the interval.
+ *
+ * The scaling is a 64 by 128-bit multiplication by an approximation of
+ * '10^-K' from 'XToStrPow10.h', "rounded to odd" so that the three
+ * comparisons needed come out exactly as they would with exact
+ * arithmetic.  There are no big integers and there is no fallback.
+ *****************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "Pow10.h"
+#include "XToStrImpl.h"
+#include "XToStrPow10.h"
+
+/******************************************************************************
+ * Everything the algorithm needs to know about a binary floating point
+ * format.  Since the conversions below are inlined with a constant
+ * format these all fold.
+ *****************************************************************************/
+typedef struct
+{
+  int MantBits;         /* Explicit mantissa bits. */
+  int Bias;             /* Exponent bias plus 'MantBits'. */
+  unsigned ExpMask;     /* Biased exponent of infinity. */
+  int SignBit;          /* Bit number of the sign. */
+} FltFormat_t;
+
+static const FltFormat_t DoubleFormat = { 52, 1075, 0x7FF, 63 };
+static const FltFormat_t FloatFormat = { 23, 150, 0xFF, 31 };
+
+/******************************************************************************
+ * The full 128-bit product of two 64-bit numbers.
+ *****************************************************************************/
+static inline uint64_t MulHiLo(uint64_t A, uint64_t B, uint64_t *Lo)
+{ /* MulHiLo() */
+#ifdef __SIZEOF_INT128__
+  unsigned __int128 Product = (unsigned __int128) A * B;
+
+  *Lo = (uint64_t) Product;
+  return (uint64_t) (Product >> 64);
+#else
+  uint64_t ALo = (uint32_t) A, AHi = A >> 32, BLo = (uint32_t) B, BHi = B >> 32;
+  uint64_t LL = ALo * BLo, LH = ALo * BHi, HL = AHi * BLo, HH = AHi * BHi;
+  uint64_t Mid = (LL >> 32) + (uint32_t) LH + (uint32_t) HL;
+
+  *Lo = (Mid << 32) | (uint32_t) LL;
+  return HH + (LH >> 32) + (HL >> 32) + (Mid >> 32);
+#endif
+} /* MulHiLo() */
+
+/******************************************************************************
+ * floor(log2(10^E)) for the range of 'E' we need, by fixed point
+ * multiplication.  (Right shifts of negative numbers are arithmetic on
+ * everything we run on.)
+ *****************************************************************************/
+static inline int FloorLog2Pow10(int E)
+{ /* FloorLog2Pow10() */
+  return (E * 1741647) >> 19;
+} /* FloorLog2Pow10() */
+
+/******************************************************************************
+ * The top 64 bits of the 192-bit product 'G * Cp', with the lowest bit
+ * set if the rest isn't zero (i.e. "rounded to odd").  Since 'G' is an
+ * overestimate by less than 1 the rest is at most 1 when the exact
+ * product is an integer, hence the '> 1'.
+ *****************************************************************************/
+static inline uint64_t RoundToOdd(const uint64_t *G, uint64_t Cp)
+{ /* RoundToOdd() */
+  uint64_t XHi, XLo, YHi, YLo, Mid;
+
+  XHi = MulHiLo(G[1], Cp, &XLo);
+  YHi = MulHiLo(G[0], Cp, &YLo);
+  Mid = YLo + XHi;
+  YHi += (Mid < YLo);
+
+  return YHi | (Mid > 1);
+} /* RoundToOdd() */
+
+/******************************************************************************
+ * The heart of the algorithm.  'C * 2^Q' is a positive finite value
+ * and 'Closer' says whether it is a power of 2 (other than the
+ * smallest normal number), in which case the next value down is
+ * closer than the next one up.  Returns 'D' with '*K' set so that
+ * 'D * 10^K' is the shortest decimal in the rounding interval (and the
+ * closest to 'C * 2^Q' of those).  'D' may have trailing zeros.
+ *****************************************************************************/
+static inline uint64_t Schubfach(uint64_t C, int Q, bool Closer, int *K)
+{ /* Schubfach() */
+  const uint64_t *G;
+  uint64_t Cb, Vbl, Vb, Vbr, Lower, Upper, S, Sp, Mid;
+  bool Even, UIn, WIn;
+  int Exp10, H;
+
+  /* The interval is [Cbl, Cbr] * 2^(Q - 2).  Its ends are included
+   * if 'C' is even, since then a tie reads back as 'C'. */
+  Even = ((C & 1) == 0);
+  Cb = C << 2;
+
+  /* floor(log10(2^Q)), or floor(log10(3/4 * 2^Q)) if 'Closer', as
+   * for 'FloorLog2Pow10()'. */
+  Exp10 = (Q * 1262611 - (Closer ? 524031 : 0)) >> 22;
+  H = Q + FloorLog2Pow10(-Exp10) + 1;
+  G = XToStrPow10[-Exp10 - XTOSTR_POW10_MIN_E];
+
+  Vbl = RoundToOdd(G, (Cb - 2 + Closer) << H);
+  Vb = RoundToOdd(G, Cb << H);
+  Vbr = RoundToOdd(G, (Cb + 2) << H);
+  Lower = Vbl + !Even;
+  Upper = Vbr - !Even;
+
+  /* 'Vb' is 4 times the scaled value. */
+  S = Vb >> 2;
+  if (S >= 10)
+  { /* Try one digit less. */
+    Sp = S / 10;
+    UIn = (Lower <= 40 * Sp);
+    WIn = (40 * Sp + 40 <= Upper);
+    if (UIn != WIn)
+    { /* Exactly one multiple of 10 in range. */
+      *K = Exp10 + 1;
+      return Sp + WIn;
+    } /* Exactly one multiple of 10 in range. */
+  } /* Try one digit less. */
+
+  *K = Exp10;
+  UIn = (Lower <= 4 * S);
+  WIn = (4 * S + 4 <= Upper);
+  if (UIn != WIn)
+    return S + WIn;
+
+  /* Both in range, so take the nearer, breaking ties to even. */
+  Mid = 4 * S + 2;
+  return S + (Vb > Mid || (Vb == Mid && (S & 1) != 0));
+} /* Schubfach() */
+
+/******************************************************************************
+ * Write 'D * 10^K' as '%.17g' would if it only printed the significant
+ * digits of 'D'.  'D' is not 0.  The digits are written straight to
+ * where they belong, and then the few before the decimal point (if
+ * any) are moved up to make room for it.
+ *****************************************************************************/
+static size_t WriteDecimal(uint64_t D, int K, bool Neg, char *Buff)
+{ /* WriteDecimal() */
+  char *Ptr = Buff;
+  int N, Exp, I;
+
+  for (; D % 10 == 0; D /= 10)
+    ++K;
+
+  /* Number of digits: log10(D) from log2(D), maybe 1 too small. */
+  N = ((64 - __builtin_clzll(D)) * 1233) >> 12;
+  N += (D >= Pow10[N]);
+  Exp = K + N - 1;
+
+  if (Neg)
+    *Ptr++ = '-';
+
+  if (Exp < -4 || Exp >= 17)
+  { /* Exponential. */
+    XToStrUMax(D, 10, &Ptr[N + 1]);
+    Ptr[0] = Ptr[1];
+    if (N > 1)
+    { /* More digits. */
+      Ptr[1] = '.';
+      Ptr += N + 1;
+    } /* More digits. */
+    else
+    { /* Just the one. */
+      Ptr += 1;
+    } /* Just the one. */
+
+    *Ptr++ = 'e';
+    *Ptr++ = (Exp < 0 ? '-' : '+');
+    if (Exp < 0)
+      Exp = -Exp;
+    if (Exp >= 100)
+    { /* Three digits. */
+      *Ptr++ = (char) ('0' + Exp / 100);
+      Exp %= 100;
+    } /* Three digits. */
+    *Ptr++ = (char) ('0' + Exp / 10);
+    *Ptr++ = (char) ('0' + Exp % 10);
+  } /* Exponential. */
+  else if (K >= 0)
+  { /* Integer. */
+    Ptr = XToStrUMax(D, 10, &Ptr[N]) + N;
+    for (I = 0; I < K; ++I)
+      *Ptr++ = '0';
+  } /* Integer. */
+  else if (Exp >= 0)
+  { /* Point within the digits. */
+    XToStrUMax(D, 10, &Ptr[N + 1]);
+    for (I = 0; I <= Exp; ++I)
+      Ptr[I] = Ptr[I + 1];
+    Ptr[Exp + 1] = '.';
+    Ptr += N + 1;
+  } /* Point within the digits. */
+  else
+  { /* Leading zeros. */
+    *Ptr++ = '0';
+    *Ptr++ = '.';
+    for (I = -1; I > Exp; --I)
+      *Ptr++ = '0';
+    Ptr = XToStrUMax(D, 10, &Ptr[N]) + N;
+  } /* Leading zeros. */
+
+  return (size_t) (Ptr - Buff);
+} /* WriteDecimal() */
+
+/******************************************************************************
+ * Convert the bits of a 'float' or 'double'.
+ *****************************************************************************/
+static inline size_t Convert(uint64_t Bits, const FltFormat_t *Format,
+                             char *Buff)
+{ /* Convert() */
+  uint64_t Mant, C, D;
+  unsigned Exp;
+  bool Neg;
+  int Q, K;
+
+  Neg = ((Bits >> Format->SignBit) & 1) != 0;
+  Mant = Bits & (((uint64_t) 1 << Format->MantBits) - 1);
+  Exp = (unsigned) (Bits >> Format->MantBits) & Format->ExpMask;
+
+  if (Exp == Format->ExpMask)
+  { /* Infinity or NaN. */
+    memcpy(Buff, (Mant != 0 ? "-nan" : "-inf"), 4);
+    if (Neg)
+      return 4;
+    memmove(Buff, &Buff[1], 3);
+    return 3;
+  } /* Infinity or NaN. */
+
+  if (Exp == 0 && Mant == 0)
+  { /* Zero. */
+    memcpy(Buff, "-0", 2);
+    if (Neg)
+      return 2;
+    Buff[0] = '0';
+    return 1;
+  } /* Zero. */
+
+  if (Exp != 0)
+  { /* Normal. */
+    C = Mant | ((uint64_t) 1 << Format->MantBits);
+    Q = (int) Exp - Format->Bias;
+
+    /* Small integers are their own shortest representation. */
+    if (Q <= 0 && Q > -(Format->MantBits + 1)
+        && (C & (((uint64_t) 1 << -Q) - 1)) == 0)
+      return WriteDecimal(C >> -Q, 0, Neg, Buff);
+  } /* Normal. */
+  else
+  { /* Subnormal. */
+    C = Mant;
+    Q = 1 - Format->Bias;
+  } /* Subnormal. */
+
+  D = Schubfach(C, Q, Mant == 0 && Exp > 1, &K);
+  return WriteDecimal(D, K, Neg, Buff);
+} /* Convert() */
+
+size_t XToStrD(double Val, char *Buff)
+{ /* XToStrD() */
+  uint64_t Bits;
+
+  memcpy(&Bits, &Val, sizeof(Bits));
+  return Convert(Bits, &DoubleFormat, Buff);
+} /* XToStrD() */
+
+size_t XToStrF(float Val, char *Buff)
+{ /* XToStrF() */
+  uint32_t Bits;
+
+  memcpy(&Bits, &Val, sizeof(Bits));
+  return Convert(Bits, &FloatFormat, Buff);
+} /* XToStrF() */
@@ -0,0 +1,57 @@
+#ifndef XToStrImpl_h
+#define XToStrImpl_h
+
+/******************************************************************************
+ * Private helpers shared by the 'XToStr()' family (and the 'String_t'
+ * functions that append numbers).  This header is _not_ installed and
+ * nothing in here is part of the public interface.
+ *****************************************************************************/
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* The longest string 'XToStrD()' and 'XToStrF()' write, _not_
+ * including the '\0', e.g. "-2.2250738585072014e-308". */
+#define XTOSTR_FLT_MAX 24
+
+/******************************************************************************
+ * Write the digits of 'Val' in base 'Base' (2 to 36, not checked)
+ * _backwards_ ending just before 'End' and return a pointer to the
+ * first one.  Nothing is NUL terminated.  See XToStrInt.c.
+ *****************************************************************************/
+extern char *XToStrUMax(uintmax_t Val, unsigned Base, char *End);
+
+/******************************************************************************
+ * Write the shortest string that reads back as 'Val' to 'Buff', which
+ * must have room for 'XTOSTR_FLT_MAX' characters, and return its
+ * length.  Nothing is NUL terminated.  See XToStrFlt.c.
+ *****************************************************************************/
+extern size_t XToStrD(double Val, char *Buff);
+extern size_t XToStrF(float Val, char *Buff);
+
+/******************************************************************************
+ * Copy the 'N' characters at 'Str' to 'Buff', NUL terminated, if they
+ * fit in 'Size' and return 0, or return ENOBUFS (and leave 'Buff'
+ * empty) if they don't.
+ *****************************************************************************/
+static inline int XToStrCopy(const char *Str, size_t N, char *Buff,
+                             size_t Size, size_t *Len)
+{ /* XToStrCopy() */
+  if (N >= Size)
+  { /* Too small. */
+    if (Size != 0)
+      Buff[0] = '\0';
+    return ENOBUFS;
+  } /* Too small. */
+
+  memcpy(Buff, Str, N);
+  Buff[N] = '\0';
+  if (Len != NULL)
+    *Len = N;
+
+  return 0;
+} /* XToStrCopy() */
+
+#endif
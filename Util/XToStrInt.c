@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Integer to string conversion for the 'XToStr()' family.  See
+ * 'XToStrUMax()' in 'XToStrImpl.h' for the interface.
+ *
+ * Base 10 is done eight digits at a time, each block as four pairs of
+ * digits from a table.  The four pairs don't depend on each other so
+ * the CPU can work on them at the same time, rather than waiting for
+ * one division (well, multiplication; the compiler turns division by a
+ * constant into one) after another.  Powers of 2 are done with shifts
+ * and masks.  Anything else needs a real division per digit.
+ *****************************************************************************/
+#include <stdint.h>
+
+#include "XToStrImpl.h"
+
+static const char Digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+static const char DigitPairs[] =
+  "00010203040506070809101112131415161718192021222324"
+  "25262728293031323334353637383940414243444546474849"
+  "50515253545556575859606162636465666768697071727374"
+  "75767778798081828384858687888990919293949596979899";
+
+/******************************************************************************
+ * Write exactly eight digits of 'Val' (which is less than 10^8),
+ * including any leading zeros, at 'Buff'.
+ *****************************************************************************/
+static inline void Write8(uint32_t Val, char *Buff)
+{ /* Write8() */
+  uint32_t Hi = Val / 10000, Lo = Val % 10000;
+
+  memcpy(&Buff[0], &DigitPairs[2 * (Hi / 100)], 2);
+  memcpy(&Buff[2], &DigitPairs[2 * (Hi % 100)], 2);
+  memcpy(&Buff[4], &DigitPairs[2 * (Lo / 100)], 2);
+  memcpy(&Buff[6], &DigitPairs[2 * (Lo % 100)], 2);
+} /* Write8() */
+
+char *XToStrUMax(uintmax_t Val, unsigned Base, char *End)
+{ /* XToStrUMax() */
+  unsigned Shift;
+  uintmax_t Mask;
+
+  if (Base == 10)
+  { /* Decimal. */
+    for (; Val >= 100000000; Val /= 100000000)
+    { /* Eight digits at a time. */
+      End -= 8;
+      Write8((uint32_t) (Val % 100000000), End);
+    } /* Eight digits at a time. */
+
+    for (; Val >= 100; Val /= 100)
+    { /* Two digits at a time. */
+      End -= 2;
+      memcpy(End, &DigitPairs[2 * (Val % 100)], 2);
+    } /* Two digits at a time. */
+
+    if (Val >= 10)
+    { /* Last two. */
+      End -= 2;
+      memcpy(End, &DigitPairs[2 * Val], 2);
+    } /* Last two. */
+    else
+    { /* Last one. */
+      *--End = (char) ('0' + Val);
+    } /* Last one. */
+  } /* Decimal. */
+  else if ((Base & (Base - 1)) == 0)
+  { /* Power of 2. */
+    Shift = (unsigned) __builtin_ctz(Base);
+    Mask = Base - 1;
+    do
+    { /* For each digit. */
+      *--End = Digits[Val & Mask];
+    } while ((Val >>= Shift) != 0);
+  } /* Power of 2. */
+  else
+  { /* Anything else. */
+    do
+    { /* For each digit. */
+      *--End = Digits[Val % Base];
+    } while ((Val /= Base) != 0);
+  } /* Anything else. */
+
+  return End;
+} /* XToStrUMax() */
@@ -3,6 +3,7 @@
 #include <stdint.h>
 
 #include "StrToX.h"
+#include "StrToXImpl.h"
 
 /******************************************************************************
  * Function equivalent to strtoul() but for 'uint_fast32_t'.  See
@@ -10,48 +11,5 @@
  *****************************************************************************/
 uint_fast32_t strtouif32(const char *Str, char **End, int Base)
 { /* strtouif32(const char *, char **, int) */
-  /* We really have no idea what basic C type uint_fast32_t might be
-   * so we need to check against both 'unsigned long' and 'unsigned
-   * long long'. */
-  
-#if UINT_FAST32_MAX == ULONG_MAX
-  /* In the event that 'uint_fast32_t' and 'unsigned long' are the
-   * same size just call strtoul() and cast the result. */
-  return (uint_fast32_t) strtoul(Str, End, Base);
-
-#elif UINT_FAST32_MAX == ULLONG_MAX
-  /* In the event that 'uint_fast32_t' and 'unsigned long long' are
-   * the same size just call strtoull() and cast the result. */
-  return (uint_fast32_t) strtoull(Str, End, Base);
-
-#elif UINT_FAST32_MAX < LONG_MAX
-  int SavedErrNo;
-  long Val;
-
-  /* Save initial value of 'errno' */
-  SavedErrNo = errno;
-
-  /* Convert to 'long'. */
-  errno = 0;
-  Val = strtol(Str, End, Base);
-
-  /* Clamp the converted value to the range of an 'uint_fast32_t'.  If
-   * 'errno' is not already set, set it to 'ERANGE' */
-  if (Val > (long) UINT_FAST32_MAX || Val < -((long) UINT_FAST32_MAX))
-  { /* Overflow. */
-    Val = UINT_FAST32_MAX;
-    if (errno == 0)
-      errno = ERANGE;
-  } /* Overflow. */
-
-  else if (errno == 0)
-  { /* No other error so restore saved 'errno'. */
-    errno = SavedErrNo;
-  } /* No other error so restore saved 'errno'. */
-
-  /* Return the result. */
-  return (uint_fast32_t) Val;
-#else
-#error "Can not implement strtouif32()."
-#endif
+  return (uint_fast32_t) StrToXUnsigned(Str, End, Base, UINT_FAST32_MAX);
 } /* strtouif32(const char *, char **, int) */